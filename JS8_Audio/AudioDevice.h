@@ -2,6 +2,7 @@
 #define AUDIODEVICE_HPP__
 
 #include <QIODevice>
+#include <algorithm>
 
 class QDataStream;
 
@@ -100,6 +101,44 @@ protected:
     return dest;
   }
 
+  // block form of load (), with the channel layout resolved once per
+  // block rather than once per sample
+  qint16 * load (qint16 const * source, size_t numFrames, qint16 * dest)
+  {
+    qint16 const * const end (source + numFrames);
+    switch (m_channel)
+      {
+      case Mono:
+	dest = std::copy (source, end, dest);
+	break;
+
+      case Left:
+	for (; source != end; ++source)
+	  {
+	    *dest++ = *source;
+	    *dest++ = 0;
+	  }
+	break;
+
+      case Right:
+	for (; source != end; ++source)
+	  {
+	    *dest++ = 0;
+	    *dest++ = *source;
+	  }
+	break;
+
+      case Both:
+	for (; source != end; ++source)
+	  {
+	    *dest++ = *source;
+	    *dest++ = *source;
+	  }
+	break;
+      }
+    return dest;
+  }
+
 private:
   Channel m_channel;
 };
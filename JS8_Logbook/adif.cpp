@@ -3,6 +3,10 @@
  * @brief Implementation of the ADIF class for handling ADIF log files.
  */
 #include "adif.h"
+#include "JS8_Main/Intern.h"
+
+#include <algorithm>
+#include <cstring>
 
 #include <QFile>
 #include <QTextStream>
@@ -174,6 +178,87 @@ const QStringList ADIF_FIELDS = {
 <CALL:6:S>W4ABC> ...
 */
 
+namespace
+{
+    // Tag names are ASCII, and compared without regard to case.
+
+    bool tagIs(QByteArrayView const tag, QByteArrayView const name)
+    {
+        return tag.compare(name, Qt::CaseInsensitive) == 0;
+    }
+
+    // Offset just past the <EOH> tag ending the header, if there's a
+    // header; ADIF has one if the first character isn't a '<'. A header
+    // without an <EOH> is taken to be no header at all.
+
+    qsizetype skipHeader(QByteArrayView const data)
+    {
+        if (data.isEmpty() || data.front() == '<') return 0;
+
+        for (qsizetype at = data.indexOf('<'); at >= 0; at = data.indexOf('<', at + 1))
+        {
+            if (tagIs(data.sliced(at, std::min<qsizetype>(5, data.size() - at)), "<EOH>"))
+            {
+                return at + 5;
+            }
+        }
+        return 0;
+    }
+
+    // Visit each field of each record of the ADIF data, in a single pass
+    // over its bytes, calling the end visitor at each <EOR>, and at the
+    // end of the data, for any record left unterminated there. Values are
+    // sliced out by their declared lengths, so may contain anything at all,
+    // '<' included, and are never copied here.
+
+    template <typename Field, typename End>
+    void tokenize(QByteArrayView const data, Field && field, End && end)
+    {
+        auto       p    = data.data() + skipHeader(data);
+        auto const last = data.data() + data.size();
+
+        while ((p = static_cast<char const *>(std::memchr(p, '<', last - p))))
+        {
+            auto const name = ++p;
+            while (p < last && *p != ':' && *p != '>') ++p;
+            if (p == last) break;
+
+            QByteArrayView const tag(name, p - name);
+
+            // <EOR>, or any other tag without a value.
+
+            if (*p++ == '>')
+            {
+                if (tagIs(tag, "EOR")) end();
+                continue;
+            }
+
+            // <NAME:LENGTH> or <NAME:LENGTH:TYPE>
+
+            qsizetype length = 0;
+            while (p < last && *p >= '0' && *p <= '9')
+            {
+                length = length * 10 + (*p++ - '0');
+            }
+            while (p < last && *p != '>') ++p;
+            if (p == last) break;
+
+            length = std::min<qsizetype>(length, last - ++p);
+            field(tag, QByteArrayView(p, length));
+            p += length;
+        }
+
+        end();
+    }
+
+    // Key of a callsign and band in the band index.
+
+    quint64 callBand(quint32 const call, quint32 const band)
+    {
+        return (quint64 {call} << 32) | band;
+    }
+}
+
 /**
  * @brief Initialize the ADIF instance with the specified filename.
  * @param filename The path to the ADIF log file.
@@ -181,107 +266,68 @@ const QStringList ADIF_FIELDS = {
 void ADIF::init(QString const& filename)
 {
     _filename = filename;
-    _data.clear();
+    _qsos.clear();
+    _byCall.clear();
+    _byCallBand.clear();
+    _anyBand.clear();
+    _bands.clear();
+    _details.clear();
 }
 
 /**
- * @brief Extract the value of a specified field from an ADIF record.
- * @param record The ADIF record as a string.
- * @param fieldName The name of the field to extract.
- * @return The extracted field value, or an empty string if not found.
+ * @brief Add the QSOs in ADIF data to the internal data structure.
+ * @param data The contents of an ADIF file.
  */
-QString ADIF::extractField(QString const& record, QString const& fieldName) const
+void ADIF::parse(QByteArrayView const data)
 {
-    qsizetype fieldNameIndex = record.indexOf ('<' + fieldName + ':', 0, Qt::CaseInsensitive);
-    if (fieldNameIndex >=0)
-    {
-        qsizetype closingBracketIndex = record.indexOf('>',fieldNameIndex);
-        qsizetype fieldLengthIndex    = record.indexOf(':',fieldNameIndex);  // find the size delimiter
-        qsizetype dataTypeIndex       = -1;
-        if (fieldLengthIndex >= 0)
-        {
-          dataTypeIndex = record.indexOf(':',fieldLengthIndex+1);  // check for a second : indicating there is a data type
-          if (dataTypeIndex > closingBracketIndex)
-            dataTypeIndex = -1; // second : was found but it was beyond the closing >
-        }
+    QSO q;
 
-        if ((closingBracketIndex > fieldNameIndex) && (fieldLengthIndex > fieldNameIndex) && (fieldLengthIndex< closingBracketIndex))
-        {
-            qsizetype fieldLengthCharCount = closingBracketIndex - fieldLengthIndex -1;
-            if (dataTypeIndex >= 0)
-              fieldLengthCharCount -= 2; // data type indicator is always a colon followed by a single character
-            QString fieldLengthString = record.mid(fieldLengthIndex+1,fieldLengthCharCount);
-            int fieldLength = fieldLengthString.toInt();
-            if (fieldLength > 0)
-            {
-              QString field = record.mid(closingBracketIndex+1,fieldLength);
-              return field;
-            }
-       }
-    }
-    return "";
+    tokenize(data,
+             [&q](QByteArrayView const tag, QByteArrayView const value)
+             {
+                 if      (tagIs(tag, "CALL"))       q.call    = QString::fromUtf8(value);
+                 else if (tagIs(tag, "BAND"))       q.band    = QString::fromUtf8(value);
+                 else if (tagIs(tag, "MODE"))       q.mode    = QString::fromUtf8(value);
+                 else if (tagIs(tag, "SUBMODE"))    q.submode = QString::fromUtf8(value);
+                 else if (tagIs(tag, "GRIDSQUARE")) q.grid    = QString::fromUtf8(value);
+                 else if (tagIs(tag, "QSO_DATE"))   q.date    = QString::fromUtf8(value);
+                 else if (tagIs(tag, "NAME"))       q.name    = QString::fromUtf8(value);
+                 else if (tagIs(tag, "COMMENT"))    q.comment = QString::fromUtf8(value);
+             },
+             [this, &q]()
+             {
+                 add(q.call, q.band, q.mode, q.submode, q.grid, q.date, q.name, q.comment);
+                 q = {};
+             });
 }
 
 /**
  * @brief Load ADIF records from the specified file into the internal data structure.
+ *
+ * The file is mapped, where the platform allows, rather than read, and
+ * parsed in a single pass; large contest logs used to take seconds here.
  */
 void ADIF::load()
 {
-    _data.clear();
+    init(_filename);
+
     QFile inputFile(_filename);
-    if (inputFile.open(QIODevice::ReadOnly))
-    {
-      QTextStream in(&inputFile);
-      QString buffer;
-      bool pre_read {false};
-      qsizetype end_position {-1};
+    if (!inputFile.open(QIODevice::ReadOnly)) return;
 
-      // skip optional header record
-      do
-        {
-          buffer += in.readLine () + '\n';
-          if (buffer.startsWith (QChar {'<'})) // denotes no header
-            {
-              pre_read = true;
-            }
-          else
-            {
-              end_position = buffer.indexOf ("<EOH>", 0, Qt::CaseInsensitive);
-            }
-        }
-      while (!in.atEnd () && !pre_read && end_position < 0);
-      if (!pre_read)            // found header
+    if (auto const size = inputFile.size(); size > 0)
+    {
+        if (auto const data = inputFile.map(0, size))
         {
-          buffer.remove (0, end_position + 5);
+            parse(QByteArrayView(data, size));
         }
-      while (buffer.size () || !in.atEnd ())
+        else
         {
-          do
-            {
-              end_position = buffer.indexOf ("<EOR>", 0, Qt::CaseInsensitive);
-              if (!in.atEnd () && end_position < 0)
-                {
-                  buffer += in.readLine () + '\n';
-                }
-            }
-          while (!in.atEnd () && end_position < 0);
-          qsizetype record_length {end_position >= 0 ? end_position + 5 : -1};
-          auto record = buffer.left (record_length).trimmed ();
-          auto next_record = buffer.indexOf (QChar {'<'}, record_length);
-          buffer.remove (0, next_record >=0 ? next_record : buffer.size ());
-          record = record.mid (record.indexOf (QChar {'<'}));
-          add (extractField (record, "CALL")
-               , extractField (record, "BAND")
-               , extractField (record, "MODE")
-               , extractField (record, "SUBMODE")
-               , extractField (record, "GRIDSQUARE")
-               , extractField (record, "QSO_DATE")
-               , extractField (record, "NAME")
-               , extractField (record, "COMMENT")
-               );
+            parse(inputFile.readAll());
         }
-        inputFile.close ();
     }
+
+    qCDebug(adif_js8) << "Loaded" << _qsos.size() << "QSOs with"
+                      << _byCall.size() << "callsigns from" << _filename;
 }
 
 /**
@@ -297,71 +343,113 @@ void ADIF::load()
  */
 void ADIF::add(QString const& call, QString const& band, QString const& mode, QString const& submode, QString const &grid, QString const& date, QString const& name, QString const& comment)
 {
+    if (call.isEmpty()) return;
+
     QSO q;
-    q.call = call;
-    q.band = band;
-    q.mode = mode;
-    q.submode = submode;
-    q.grid = grid;
+    q.call = Intern::string(call);
+    q.band = Intern::string(band);
+    q.mode = Intern::string(mode);
+    q.submode = Intern::string(submode);
+    q.grid = Intern::string(grid);
     q.date = date;
     q.name = name;
     q.comment = comment;
 
-    if (q.call.size ())
-      {
-        _data.insert(q.call,q);
-        // qCDebug(adif_js8) << "Added as worked:" << call << band << mode << date;
-      }
+    auto const id = Intern::id(q.call);
+
+    _byCall[id].append(_qsos.size());
+    if (q.band.isEmpty())
+    {
+        _anyBand.insert(id);
+    }
+    else
+    {
+        auto const band = q.band.toLower();
+        if (!_bands.contains(band)) _bands.insert(band, _bands.size());
+        _byCallBand.insert(callBand(id, _bands.value(band)));
+    }
+
+    auto & d = _details[id];
+    if (!q.grid.isEmpty()) d.grid = q.grid;
+    if (!q.date.isEmpty()) d.date = q.date;
+    if (!q.name.isEmpty()) d.name = q.name;
+    if (!q.comment.isEmpty()) d.comment = q.comment;
+
+    _qsos.append(q);
+    // qCDebug(adif_js8) << "Added as worked:" << call << band << mode << date;
 }
 
 /**
  * @brief Check if a callsign and band combination exists in the internal data structure.
  * @param call The callsign to search for.
- * @param band The band to search for.
+ * @param band The band to search for, or empty for any band.
  * @return True if a matching QSO is found, false otherwise.
  */
 bool ADIF::match(QString const& call, QString const& band) const
 {
-    QList<QSO> qsos = _data.values(call);
-    if (qsos.size()>0)
-    {
-        QSO q;
-        foreach(q,qsos)
-        {
-            if (     (band.compare(q.band,Qt::CaseInsensitive) == 0)
-                  || (band=="")
-                  || (q.band==""))
-            {
-                return true;
-            }
-        }
-    }
-    return false;
+    auto const id = Intern::find(call);
+
+    if (id == Intern::None || !_byCall.contains(id)) return false;
+    if (band.isEmpty() || _anyBand.contains(id)) return true;
+
+    auto const it = _bands.constFind(band.toLower());
+    return it != _bands.constEnd()
+        && _byCallBand.contains(callBand(id, *it));
 }
 
 /**
  * @brief Find QSOs associated with a given callsign.
  * @param call The callsign to search for.
- * @return A list of QSOs associated with the callsign.
+ * @return A list of QSOs associated with the callsign, most recent first.
  */
 QList<ADIF::QSO> ADIF::find(QString const& call) const
 {
-    return _data.values(call);
+    QList<QSO> qsos;
+    auto const id = Intern::find(call);
+    if (id == Intern::None) return qsos;
+
+    auto const indices = _byCall.value(id);
+
+    qsos.reserve(indices.size());
+    for (auto i = indices.crbegin(); i != indices.crend(); ++i)
+    {
+        qsos.append(_qsos.at(*i));
+    }
+    return qsos;
+}
+
+/**
+ * @brief Get the details most recently logged for a callsign.
+ * @param call The callsign to search for.
+ * @param qso Output parameter; the most recent non-empty grid, date, name,
+ *            and comment logged for the callsign, each from whichever QSO
+ *            last had one.
+ * @return True if the callsign has been logged, false otherwise.
+ */
+bool ADIF::details(QString const& call, QSO& qso) const
+{
+    auto const id = Intern::find(call);
+    if (id == Intern::None) return false;
+
+    auto const it = _details.constFind(id);
+    if (it == _details.constEnd()) return false;
+
+    qso = *it;
+    return true;
 }
 
 /**
  * @brief Get a list of all callsigns in the internal data structure.
- * @return A list of callsigns.
+ * @return A list of callsigns, each listed once.
  */
 QList<QString> ADIF::getCallList() const
 {
     QList<QString> p;
-    QMultiHash<QString,QSO>::const_iterator i = _data.constBegin();
-     while (i != _data.constEnd())
-     {
-         p << i.key();
-         ++i;
-     }
+    p.reserve(_byCall.size());
+    for (auto const& indices : _byCall)
+    {
+        p << _qsos.at(indices.first()).call;
+    }
     return p;
 }
 
@@ -371,7 +459,7 @@ QList<QString> ADIF::getCallList() const
  */
 qsizetype ADIF::getCount() const
 {
-    return _data.size();
+    return _qsos.size();
 }
 
 /**
@@ -18,6 +18,10 @@
 #include <QtGui>
 #endif
 
+#include <QByteArrayView>
+#include <QHash>
+#include <QSet>
+
 #include "JS8_Main/fileutils.h"
 
 class QDateTime;
@@ -35,6 +39,7 @@ class ADIF
     void add(QString const& call, QString const& band, QString const& mode, const QString &submode, QString const& grid, QString const& date, const QString &name, const QString &comment);
     bool match(QString const& call, QString const& band) const;
     QList<ADIF::QSO> find(QString const& call) const;
+    bool details(QString const& call, ADIF::QSO& qso) const;
 	QList<QString> getCallList() const;
 	qsizetype getCount() const;
 
@@ -54,10 +59,23 @@ class ADIF
     };
 
     private:
-		QMultiHash<QString, QSO> _data;
+		// QSOs in the order read or added, indexed by interned callsign,
+		// and by interned callsign and band number; bands are numbered
+		// in the order seen, lower cased, as they compare without regard
+		// to case. A QSO logged without a band counts as worked on every
+		// band. Per callsign, the most recent non-empty grid, date, name,
+		// and comment logged. The callsigns held in the QSOs keep their
+		// intern ids valid.
+
+		QList<QSO> _qsos;
+		QHash<quint32, QList<qsizetype>> _byCall;
+		QSet<quint64> _byCallBand;
+		QSet<quint32> _anyBand;
+		QHash<QString, quint32> _bands;
+		QHash<quint32, QSO> _details;
 		QString _filename;
 
-		QString extractField(QString const& line, QString const& fieldName) const;
+		void parse(QByteArrayView data);
 };
 
 
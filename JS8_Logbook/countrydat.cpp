@@ -21,18 +21,51 @@
 
 #include "countrydat.h"
 #include "JS8_Main/Radio.h"
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDateTime>
 #include <QDebug>
 #include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
 #include <QTextStream>
+#include <algorithm>
+
+namespace
+{
+  // Binary cache of the compiled table; bump the version on any change
+  // to what's written.
+
+  constexpr quint32 CACHE_MAGIC = 0x43545944; // "CTYD"
+  constexpr quint32 CACHE_VERSION = 1;
+}
 
 /**
  * @brief Initialize the CountryDat instance with the specified filename.
  * @param filename The path to the country data file.
+ * @param cacheFilename The path of the binary cache of the compiled
+ *                      country data, or empty for none.
  */
-void CountryDat::init(const QString filename)
+void CountryDat::init(const QString filename, const QString cacheFilename)
 {
     _filename = filename;
-    _data.clear();
+    _cacheFilename = cacheFilename;
+    _clear();
+}
+
+/**
+ * @brief Discard the loaded country data, and any cached resolutions.
+ */
+void CountryDat::_clear()
+{
+    _countryNames.clear();
+    _exact.clear();
+    _entity.clear();
+    _first.clear();
+    _count.clear();
+    _label.clear();
+    _next.clear();
+    _cache.clear();
 }
 
 /**
@@ -98,12 +131,33 @@ QStringList CountryDat::_extractPrefix(QString &line, bool &more) const
 }
 
 /**
- * @brief Load country data from the specified file.
+ * @brief Load country data, from the binary cache if it's current, from
+ *        the specified file otherwise, compiling it and updating the cache.
  */
 void CountryDat::load()
 {
-    _data.clear();
-    _countryNames.clear(); //used by countriesWorked
+    _clear();
+
+    QFileInfo const source(_filename);
+    if (!_cacheFilename.isEmpty() && _loadCache(source))
+    {
+        return;
+    }
+
+    _parse();
+
+    if (!_cacheFilename.isEmpty() && !_entity.isEmpty())
+    {
+        _saveCache(source);
+    }
+}
+
+/**
+ * @brief Parse the country data file and compile its prefixes.
+ */
+void CountryDat::_parse()
+{
+    QHash<QString, qint32> prefixes;
 
     QFile inputFile(_filename);
     if (inputFile.open(QIODevice::ReadOnly))
@@ -124,6 +178,7 @@ void CountryDat::load()
               int i1=principalPrefix.indexOf(":");
               if(i1>0) principalPrefix=principalPrefix.mid(0,i1);
               name += "; " + principalPrefix + "; " + continent;
+                qint32 const entity = _countryNames.size();
                 _countryNames << name;
                 bool more = true;
                 QStringList prefixs;
@@ -138,14 +193,162 @@ void CountryDat::load()
                 QString p;
                 foreach(p,prefixs)
                 {
-                    if (p.length() > 0)
-                        _data.insert(p,name);
+                    if (p.startsWith('='))
+                        _exact.insert(p.mid(1),entity);
+                    else if (p.length() > 0)
+                        prefixes.insert(p,entity);
                 }
             }
           }
        }
     inputFile.close();
     }
+
+    // Compile the prefixes, in order, into the trie; the root always
+    // exists, so that a walk needn't check for an empty trie.
+
+    QList<QPair<QString, qint32>> sorted;
+    sorted.reserve(prefixes.size());
+    for (auto i = prefixes.constBegin(); i != prefixes.constEnd(); ++i)
+    {
+        sorted.append({i.key(), i.value()});
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    _build(sorted.cbegin(), sorted.cend(), 0);
+}
+
+/**
+ * @brief Build the trie node for a range of sorted prefixes, all of which
+ *        share their first depth characters.
+ * @param first The first prefix in the range.
+ * @param last One past the last prefix in the range.
+ * @param depth The length of the prefix shared by the range.
+ * @return The index of the node built.
+ */
+qint32 CountryDat::_build(QList<QPair<QString, qint32>>::const_iterator first,
+                          QList<QPair<QString, qint32>>::const_iterator const last,
+                          qsizetype const depth)
+{
+    qint32 const node = _entity.size();
+    _entity.append(-1);
+    _first.append(0);
+    _count.append(0);
+
+    // Sorted, the prefix ending here, if any, comes first.
+
+    if (first != last && first->first.size() == depth)
+    {
+        _entity[node] = first->second;
+        ++first;
+    }
+
+    // One edge per distinct character at this depth; the edges of a node
+    // are allotted together, before building the nodes they lead to.
+
+    QList<decltype(first)> groups;
+    for (auto i = first; i != last; ++i)
+    {
+        if (groups.isEmpty() || i->first.at(depth) != groups.last()->first.at(depth))
+        {
+            groups.append(i);
+        }
+    }
+
+    qint32 const edges = _next.size();
+    _first[node] = edges;
+    _count[node] = groups.size();
+    _label.resize(edges + groups.size());
+    _next.resize(edges + groups.size());
+
+    for (qsizetype g = 0; g < groups.size(); ++g)
+    {
+        auto const end = g + 1 < groups.size() ? groups.at(g + 1) : last;
+        _label[edges + g] = groups.at(g)->first.at(depth).toLatin1();
+        _next[edges + g] = _build(groups.at(g), end, depth + 1);
+    }
+
+    return node;
+}
+
+/**
+ * @brief Load the compiled country data from the binary cache.
+ * @param source The country data file the cache must have been compiled from.
+ * @return True if the cache was current, and loaded.
+ */
+bool CountryDat::_loadCache(QFileInfo const& source)
+{
+    QFile file(_cacheFilename);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_5);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString path;
+    qint64 size = 0;
+    qint64 modified = 0;
+    QString application;
+
+    in >> magic >> version >> path >> size >> modified >> application;
+
+    if (in.status() != QDataStream::Ok
+        || magic != CACHE_MAGIC
+        || version != CACHE_VERSION
+        || path != source.absoluteFilePath()
+        || size != source.size()
+        || modified != source.lastModified().toMSecsSinceEpoch()
+        || application != QCoreApplication::applicationVersion())
+    {
+        return false;
+    }
+
+    in >> _countryNames >> _exact >> _entity >> _first >> _count >> _label >> _next;
+
+    if (in.status() != QDataStream::Ok
+        || _entity.isEmpty()
+        || _first.size() != _entity.size()
+        || _count.size() != _entity.size()
+        || _label.size() != _next.size())
+    {
+        qWarning() << "CountryDat: ignoring damaged cache" << _cacheFilename;
+        _clear();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Save the compiled country data to the binary cache.
+ * @param source The country data file it was compiled from.
+ */
+void CountryDat::_saveCache(QFileInfo const& source) const
+{
+    QSaveFile file(_cacheFilename);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_5);
+
+    out << CACHE_MAGIC << CACHE_VERSION
+        << source.absoluteFilePath()
+        << source.size()
+        << source.lastModified().toMSecsSinceEpoch()
+        << QCoreApplication::applicationVersion()
+        << _countryNames << _exact << _entity << _first << _count << _label << _next;
+
+    if (out.status() != QDataStream::Ok || !file.commit())
+    {
+        qWarning() << "CountryDat: failed to write cache" << _cacheFilename;
+    }
 }
 
 /**
@@ -157,23 +360,60 @@ QString CountryDat::find(QString call) const
 {
   call = call.toUpper ();
 
+  if (auto const cached = _cache.object (call))
+    {
+      return *cached;
+    }
+
+  auto const country = _find (call);
+  _cache.insert (call, new QString {country});
+  return country;
+}
+
+/**
+ * @brief Resolve an upper case callsign to its country, uncached.
+ * @param call The callsign.
+ * @return The corresponding country name, or an empty string if not found.
+ */
+QString CountryDat::_find (QString const& call) const
+{
   // check for exact match first
-  if (_data.contains ("=" + call))
+  if (auto const exact = _exact.constFind (call); exact != _exact.constEnd ())
     {
-      return fixup (_data.value ("=" + call), call);
+      return fixup (_countryNames.at (*exact), call);
     }
 
-  auto prefix = Radio::effective_prefix (call);
-  auto match_candidate = prefix;
-  while (match_candidate.size () >= 1)
+  if (_entity.isEmpty ())
     {
-      if (_data.contains (match_candidate))
-        {
-          return fixup (_data.value (match_candidate), prefix);
-        }
-      match_candidate = match_candidate.left (match_candidate.size () - 1);
+      return QString {};
+    }
+
+  // Walk the trie along the effective prefix; the deepest country on the
+  // way is that of the longest matching prefix.
+
+  auto const prefix = Radio::effective_prefix (call);
+  qint32 node = 0;
+  qint32 entity = _entity.at (node);
+
+  for (auto const c : prefix)
+    {
+      auto const label = c.toLatin1 ();
+      auto const first = _first.at (node);
+      auto const end = first + _count.at (node);
+      auto edge = first;
+
+      while (edge < end && _label.at (edge) != label) ++edge;
+      if (edge == end) break;
+
+      node = _next.at (edge);
+      if (_entity.at (node) >= 0) entity = _entity.at (node);
+    }
+
+  if (entity < 0)
+    {
+      return QString {};
     }
-  return QString {};
+  return fixup (_countryNames.at (entity), prefix);
 }
 
 /**
@@ -12,12 +12,32 @@
 #include <QString>
 #include <QStringList>
 #include <QHash>
+#include <QByteArray>
+#include <QCache>
+#include <QList>
+#include <QPair>
 
+class QFileInfo;
+
+/*
+ * Prefixes are compiled, on loading, into a trie, so that resolving a
+ * callsign to its country is a single walk down the trie along its
+ * effective prefix, the deepest country found on the way being the
+ * longest matching prefix's; exact callsign overrides are consulted
+ * first. Recent resolutions are kept in a small LRU cache.
+ *
+ * Given the name of a cache file, the compiled table is saved there in
+ * binary form, and loaded from there in place of reparsing the country
+ * file, for as long as the country file and the application are the
+ * same ones that it was compiled from.
+ *
+ * Not thread-safe; find() updates the LRU cache.
+ */
 
 class CountryDat
 {
 public:
-  void init(const QString filename);
+  void init(const QString filename, const QString cacheFilename = {});
   void load();
   QString find(QString prefix) const; // return country name or ""
   QStringList  getCountryNames() const { return _countryNames; };
@@ -27,10 +47,33 @@ private:
   void _removeBrackets(QString &line, const QString a, const QString b) const;
   QStringList _extractPrefix(QString &line, bool &more) const;
   QString fixup (QString country, QString const& call) const;
+  QString _find(QString const& call) const;
+
+  void _clear();
+  void _parse();
+  qint32 _build(QList<QPair<QString, qint32>>::const_iterator first,
+                QList<QPair<QString, qint32>>::const_iterator last,
+                qsizetype depth);
+  bool _loadCache(QFileInfo const& source);
+  void _saveCache(QFileInfo const& source) const;
 
   QString _filename;
+  QString _cacheFilename;
   QStringList _countryNames;
-  QHash<QString, QString> _data;
+
+  // Exact callsigns, and the prefix trie, flattened: node n has country
+  // _entity[n], an index into _countryNames, or -1 if none, and children
+  // along the _count[n] edges from _first[n], each edge having a label
+  // character and the node it leads to. Node 0 is the root.
+
+  QHash<QString, qint32> _exact;
+  QList<qint32> _entity;
+  QList<qint32> _first;
+  QList<qint32> _count;
+  QByteArray _label;
+  QList<qint32> _next;
+
+  mutable QCache<QString, QString> _cache {1000};
 };
 
 #endif
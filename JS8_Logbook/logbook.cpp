@@ -12,6 +12,7 @@ namespace
 {
   auto logFileName = "js8call_log.adi";
   auto countryFileName = "cty.dat";
+  auto countryCacheFileName = "cty.cache";
 }
 
 /**
@@ -32,7 +33,7 @@ void LogBook::init()
       countryDataFilename = QString {":/"} + countryFileName;
     }
 
-  _countries.init(countryDataFilename);
+  _countries.init(countryDataFilename, dataPath.absoluteFilePath (countryCacheFileName));
   _countries.load();
 
   _worked.init(_countries.getCountryNames());
@@ -120,17 +121,15 @@ bool LogBook::findCallDetails(
         return false;
     }
 
-    auto qsos = _log.find(call);
-    if(qsos.isEmpty()){
+    ADIF::QSO qso;
+    if(!_log.details(call, qso)){
         return false;
     }
 
-    foreach(auto qso, qsos){
-        if(grid.isEmpty() && !qso.grid.isEmpty()) grid = qso.grid;
-        if(date.isEmpty() && !qso.date.isEmpty()) date = qso.date;
-        if(name.isEmpty() && !qso.name.isEmpty()) name = qso.name;
-        if(comment.isEmpty() && !qso.comment.isEmpty()) comment = qso.comment;
-    }
+    if(grid.isEmpty()) grid = qso.grid;
+    if(date.isEmpty()) date = qso.date;
+    if(name.isEmpty()) name = qso.name;
+    if(comment.isEmpty()) comment = qso.comment;
 
     return true;
 }
@@ -0,0 +1,133 @@
+#ifndef BIT_BUFFER_HPP__
+#define BIT_BUFFER_HPP__
+
+#include <QtGlobal>
+#include <array>
+#include <initializer_list>
+
+// Fixed-capacity bit vector used for frame packing, which needs at most
+// 72 bits; storage is two words, with bits held most significant first,
+// i.e., the first bit appended is the most significant bit of the first
+// word. Appending beyond capacity is a programming error.
+//
+// Fields of up to 64 bits can be appended or extracted as a unit, so a
+// frame is built or taken apart a field at a time rather than a bit at
+// a time, and nothing here ever allocates.
+
+class BitBuffer {
+  public:
+    static constexpr int Capacity = 128;
+
+    // Constructors
+
+    constexpr BitBuffer() noexcept = default;
+
+    constexpr BitBuffer(std::initializer_list<bool> const bits) noexcept {
+        for (auto const bit : bits)
+            append(bit);
+    }
+
+    // Inline accessors
+
+    constexpr int size() const noexcept { return m_size; }
+    constexpr bool isEmpty() const noexcept { return m_size == 0; }
+
+    constexpr bool at(int const pos) const noexcept {
+        return (m_words[pos >> 6] >> (63 - (pos & 63))) & 1;
+    }
+
+    // Extract the field of `width` bits, at most 64, that begins at `pos`,
+    // as an unsigned value of which the first bit is most significant.
+
+    constexpr quint64 field(int const pos, int const width) const noexcept {
+        if (width == 0)
+            return 0;
+
+        auto const word = pos >> 6;
+        auto const offset = pos & 63;
+        auto value = m_words[word] << offset;
+
+        if (offset && word + 1 < static_cast<int>(m_words.size()))
+            value |= m_words[word + 1] >> (64 - offset);
+
+        return value >> (64 - width);
+    }
+
+    // Index of the last bit having the supplied value, or -1 if none do.
+
+    constexpr int lastIndexOf(bool const value) const noexcept {
+        for (int i = m_size - 1; i >= 0; --i) {
+            if (at(i) == value)
+                return i;
+        }
+        return -1;
+    }
+
+    // Bits in the range [pos, pos + len); as with QVector::mid(), if the
+    // length is negative or runs past the end, the rest of the bits.
+
+    constexpr BitBuffer mid(int const pos, int len = -1) const noexcept {
+        if (len < 0 || len > m_size - pos)
+            len = m_size - pos;
+
+        BitBuffer bits;
+
+        for (int i = 0; i < len; i += 64) {
+            auto const width = len - i < 64 ? len - i : 64;
+            bits.append(field(pos + i, width), width);
+        }
+
+        return bits;
+    }
+
+    constexpr bool operator==(BitBuffer const &) const noexcept = default;
+
+    // Manipulators
+
+    constexpr void clear() noexcept { *this = BitBuffer(); }
+
+    constexpr void append(bool const bit) noexcept {
+        Q_ASSERT(m_size < Capacity);
+
+        if (bit)
+            m_words[m_size >> 6] |= quint64{1} << (63 - (m_size & 63));
+        ++m_size;
+    }
+
+    // Append the low `width` bits of `value`, at most 64, most significant
+    // first.
+
+    constexpr void append(quint64 value, int const width) noexcept {
+        Q_ASSERT(width >= 0 && width <= 64);
+        Q_ASSERT(m_size + width <= Capacity);
+
+        if (width == 0)
+            return;
+
+        if (width < 64)
+            value &= (quint64{1} << width) - 1;
+
+        auto const word = m_size >> 6;
+        auto const offset = m_size & 63;
+
+        m_words[word] |= (value << (64 - width)) >> offset;
+
+        if (offset + width > 64)
+            m_words[word + 1] |= value << (128 - offset - width);
+
+        m_size += width;
+    }
+
+    constexpr void append(BitBuffer const &bits) noexcept {
+        for (int i = 0; i < bits.m_size; i += 64) {
+            auto const width = bits.m_size - i < 64 ? bits.m_size - i : 64;
+            append(bits.field(i, width), width);
+        }
+    }
+
+  private:
+    std::array<quint64, 2> m_words = {};
+    int m_size = 0;
+};
+
+#endif
@@ -0,0 +1,522 @@
+#include "DecodeJournal.h"
+#include "Bands.h"
+#include "JS8_Include/commons.h"
+#include "JS8_Mode/DecodedText.h"
+#include <QDataStream>
+#include <QDir>
+#include <QLoggingCategory>
+#include <QSaveFile>
+#include <QTime>
+#include <QTimeZone>
+#include <QTimer>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+Q_DECLARE_LOGGING_CATEGORY(decodejournal_js8)
+
+namespace DecodeJournal {
+/******************************************************************************/
+// Local Routines
+/******************************************************************************/
+
+namespace {
+constexpr auto DATE_FORMAT = u"yyyy-MM-dd";
+
+QString path(QString const &directory, QDate const &date,
+             QString const &suffix) {
+    return QDir(directory).absoluteFilePath(date.toString(DATE_FORMAT) +
+                                            suffix);
+}
+} // namespace
+
+/******************************************************************************/
+// Record
+/******************************************************************************/
+
+Record Record::from(JS8::Event::Decoded const &decoded, QDateTime const &now,
+                    quint64 const dial) {
+    auto const utc = now.toUTC();
+    auto const hms = decode_time(decoded.utc);
+    auto time =
+        QDateTime(utc.date(), QTime(hms.hour, hms.minute, hms.second),
+                  QTimeZone::utc());
+
+    // A period that started before midnight, decoded after it.
+
+    if (!time.isValid()) {
+        time = utc;
+    } else if (time > utc.addSecs(60)) {
+        time = time.addDays(-1);
+    }
+
+    Record record;
+
+    record.utc = time.toMSecsSinceEpoch();
+    record.dial = dial;
+    record.dt = decoded.xdt;
+    record.frequency = decoded.frequency;
+    record.quality = decoded.quality;
+    record.snr = static_cast<qint16>(decoded.snr);
+    record.submode = static_cast<quint8>(decoded.mode);
+    record.type = static_cast<quint8>(decoded.type);
+    record.receiver = static_cast<quint8>(decoded.receiver);
+    std::copy_n(decoded.data.begin(),
+                std::min<std::size_t>(decoded.data.size(), FrameSize),
+                record.frame.begin());
+
+    return record;
+}
+
+JS8::Event::Decoded Record::decoded() const {
+    auto const time =
+        QDateTime::fromMSecsSinceEpoch(utc, QTimeZone::utc()).time();
+
+    return {.utc = code_time(time.hour(), time.minute(), time.second()),
+            .snr = snr,
+            .xdt = dt,
+            .frequency = frequency,
+            .data = std::string(frame.data(), FrameSize),
+            .type = type,
+            .quality = quality,
+            .mode = submode,
+            .receiver = receiver};
+}
+
+QVariantMap Record::toVariantMap() const {
+    return {{"UTC", utc},
+            {"DIAL", dial},
+            {"OFFSET", frequency},
+            {"SNR", snr},
+            {"TDRIFT", dt},
+            {"SPEED", submode},
+            {"BITS", type},
+            {"QUALITY", quality},
+            {"RECEIVER", receiver},
+            {"FRAME", QString::fromLatin1(frame.data(), FrameSize)}};
+}
+
+Record Record::fromVariantMap(QVariantMap const &params) {
+    Record record;
+
+    record.utc = params.value("UTC").toLongLong();
+    record.dial = params.value("DIAL").toULongLong();
+    record.frequency = params.value("OFFSET").toFloat();
+    record.snr = static_cast<qint16>(params.value("SNR").toInt());
+    record.dt = params.value("TDRIFT").toFloat();
+    record.submode = static_cast<quint8>(params.value("SPEED").toUInt());
+    record.type = static_cast<quint8>(params.value("BITS").toUInt());
+    record.quality = params.value("QUALITY").toFloat();
+    record.receiver = static_cast<quint8>(params.value("RECEIVER").toUInt());
+
+    auto const frame = params.value("FRAME").toString().toLatin1();
+    std::copy_n(frame.begin(), std::min(frame.size(), FrameSize),
+                record.frame.begin());
+
+    return record;
+}
+
+void Record::serialize(char *const out) const {
+    qToLittleEndian(utc, out + 0);
+    qToLittleEndian(dial, out + 8);
+    qToLittleEndian(dt, out + 16);
+    qToLittleEndian(frequency, out + 20);
+    qToLittleEndian(quality, out + 24);
+    qToLittleEndian(snr, out + 28);
+    out[30] = static_cast<char>(submode);
+    out[31] = static_cast<char>(type);
+    out[32] = static_cast<char>(receiver);
+    std::memcpy(out + 33, frame.data(), FrameSize);
+    std::memset(out + 45, 0, RecordSize - 45);
+}
+
+Record Record::deserialize(char const *const in) {
+    Record record;
+
+    record.utc = qFromLittleEndian<qint64>(in + 0);
+    record.dial = qFromLittleEndian<quint64>(in + 8);
+    record.dt = qFromLittleEndian<float>(in + 16);
+    record.frequency = qFromLittleEndian<float>(in + 20);
+    record.quality = qFromLittleEndian<float>(in + 24);
+    record.snr = qFromLittleEndian<qint16>(in + 28);
+    record.submode = static_cast<quint8>(in[30]);
+    record.type = static_cast<quint8>(in[31]);
+    record.receiver = static_cast<quint8>(in[32]);
+    std::memcpy(record.frame.data(), in + 33, FrameSize);
+
+    return record;
+}
+
+/******************************************************************************/
+// Index Keys
+/******************************************************************************/
+
+// Callsigns of a heartbeat or compound frame, and both ends of a directed
+// one; data frames have none. Unpacking is cached by DecodedText, so the
+// frames of a busy band cost little to unpack again.
+
+QStringList calls(Record const &record) {
+    DecodedText const text(QString::fromLatin1(record.frame.data(), FrameSize),
+                           record.type, record.submode);
+    QStringList calls;
+
+    if (auto const compound = text.compoundCall(); !compound.isEmpty()) {
+        calls.append(compound.trimmed().toUpper());
+    }
+    if (auto const directed = text.directedMessage(); directed.size() > 1) {
+        calls.append(directed.at(0).trimmed().toUpper());
+        calls.append(directed.at(1).trimmed().toUpper());
+    }
+
+    calls.removeAll(QString());
+    calls.removeDuplicates();
+
+    return calls;
+}
+
+QString band(Record const &record) {
+    static Bands const bands;
+    return bands.find(record.dial);
+}
+
+// FNV-1a, over the callsign in UTF-8; stable across runs and platforms,
+// which the index, written by one run and read by another, requires.
+
+quint32 callId(QString const &call) {
+    quint32 hash = 2166136261u;
+
+    for (auto const byte : call.toUpper().toUtf8()) {
+        hash ^= static_cast<quint8>(byte);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/******************************************************************************/
+// Index
+/******************************************************************************/
+
+void Index::add(Record const &record) {
+    for (auto const &call : DecodeJournal::calls(record)) {
+        calls[callId(call)].append(count);
+    }
+    if (auto const name = DecodeJournal::band(record); !name.isEmpty()) {
+        bands[name].append(count);
+    }
+    ++count;
+}
+
+bool Index::load(QString const &path) {
+    QFile file(path);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_5);
+
+    quint32 magic = 0;
+    in >> magic;
+    if (magic != IndexMagic) {
+        return false;
+    }
+
+    Index index;
+    in >> index.count >> index.calls >> index.bands;
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    *this = std::move(index);
+    return true;
+}
+
+// Written to a temporary file that replaces the index only once complete,
+// so a reader never sees half an index.
+
+bool Index::save(QString const &path) const {
+    QSaveFile file(path);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_5);
+    out << IndexMagic << count << calls << bands;
+
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+QString segmentPath(QString const &directory, QDate const &date) {
+    return path(directory, date, QStringLiteral(".j8j"));
+}
+
+QString indexPath(QString const &directory, QDate const &date) {
+    return path(directory, date, QStringLiteral(".j8x"));
+}
+
+/******************************************************************************/
+// Writer
+/******************************************************************************/
+
+Writer::Writer(QString const &directory, QObject *parent)
+    : QObject(parent), m_directory(directory) {}
+
+// Runs in the writer's thread, on its finish.
+
+Writer::~Writer() { close(); }
+
+void Writer::append(Record const &record) {
+    QMetaObject::invokeMethod(this, [this, record] { write(record); });
+}
+
+void Writer::write(Record const &record) {
+    if (auto const date =
+            QDateTime::fromMSecsSinceEpoch(record.utc, QTimeZone::utc()).date();
+        date != m_date) {
+        close();
+        open(date);
+    }
+
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    char bytes[RecordSize];
+    record.serialize(bytes);
+    m_buffer.append(bytes, RecordSize);
+    m_index.add(record);
+    m_dirty = true;
+
+    if (m_buffer.size() >= FlushBytes) {
+        flush();
+    }
+
+    if (!m_timer) {
+        m_timer = new QTimer(this);
+        m_timer->setSingleShot(true);
+        connect(m_timer, &QTimer::timeout, this, &Writer::flush);
+    }
+    if (!m_timer->isActive()) {
+        m_timer->start(FlushInterval);
+    }
+}
+
+// Open the segment for the date, creating it if need be; a partial record
+// at its end, left by a crash in the middle of a write, is dropped, and
+// the index brought up to date with any records it doesn't yet cover. If
+// the segment can't be opened, records for the date are dropped; that's
+// reported once, on the attempt.
+
+bool Writer::open(QDate const &date) {
+    m_date = date;
+    m_index = {};
+    m_file.setFileName(segmentPath(m_directory, date));
+
+    if (!QDir().mkpath(m_directory) || !m_file.open(QIODevice::ReadWrite)) {
+        qCWarning(decodejournal_js8) << "Failed to open" << m_file.fileName()
+                                     << ":" << m_file.errorString();
+        emit error(m_file.fileName(), m_file.errorString());
+        return false;
+    }
+
+    if (m_file.size() < HeaderSize) {
+        char header[HeaderSize];
+        qToLittleEndian(SegmentMagic, header);
+        qToLittleEndian(static_cast<quint32>(RecordSize), header + 4);
+
+        m_file.resize(0);
+        m_file.write(header, HeaderSize);
+    } else if (auto const header = m_file.read(HeaderSize);
+               qFromLittleEndian<quint32>(header.constData()) !=
+                   SegmentMagic ||
+               qFromLittleEndian<quint32>(header.constData() + 4) !=
+                   RecordSize) {
+        qCWarning(decodejournal_js8)
+            << "Not a journal segment:" << m_file.fileName();
+        emit error(m_file.fileName(), tr("Not a journal segment"));
+        m_file.close();
+        return false;
+    }
+
+    auto const count =
+        static_cast<quint32>((m_file.size() - HeaderSize) / RecordSize);
+    m_file.resize(HeaderSize + qint64{count} * RecordSize);
+
+    if (!m_index.load(indexPath(m_directory, date)) || m_index.count > count) {
+        m_index = {};
+    }
+
+    m_file.seek(HeaderSize + qint64{m_index.count} * RecordSize);
+    while (m_index.count < count) {
+        auto const bytes = m_file.read(RecordSize);
+        if (bytes.size() != RecordSize) {
+            break;
+        }
+        m_index.add(Record::deserialize(bytes.constData()));
+        m_dirty = true;
+    }
+
+    return m_file.seek(m_file.size());
+}
+
+void Writer::flush() {
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    if (!m_buffer.isEmpty()) {
+        if (m_file.write(m_buffer) != m_buffer.size() || !m_file.flush()) {
+            qCWarning(decodejournal_js8)
+                << "Failed to write" << m_file.fileName() << ":"
+                << m_file.errorString();
+            emit error(m_file.fileName(), m_file.errorString());
+        }
+        m_buffer.clear();
+    }
+}
+
+// Write out the records, then the index, if it has anything new, and close
+// the segment.
+
+void Writer::close() {
+    flush();
+
+    if (m_file.isOpen() && m_dirty) {
+        if (auto const path = indexPath(m_directory, m_date);
+            !m_index.save(path)) {
+            qCWarning(decodejournal_js8) << "Failed to write" << path;
+        }
+    }
+    m_dirty = false;
+    m_file.close();
+}
+
+/******************************************************************************/
+// Reader
+/******************************************************************************/
+
+Reader::Reader(QString const &directory) : m_directory(directory) {}
+
+QList<QDate> Reader::segments() const {
+    QList<QDate> segments;
+
+    for (auto const &name : QDir(m_directory).entryList(
+             {QStringLiteral("*.j8j")}, QDir::Files, QDir::Name)) {
+        if (auto const date =
+                QDate::fromString(name.chopped(4), DATE_FORMAT);
+            date.isValid()) {
+            segments.append(date);
+        }
+    }
+
+    return segments;
+}
+
+qsizetype Reader::scan(Query const &query,
+                       std::function<bool(Record const &)> const &visit) const {
+    auto const from = query.from.isValid() ? query.from.toMSecsSinceEpoch()
+                                           : std::numeric_limits<qint64>::min();
+    auto const to = query.to.isValid() ? query.to.toMSecsSinceEpoch()
+                                       : std::numeric_limits<qint64>::max();
+    auto const call = query.call.trimmed().toUpper();
+    auto const indexed = !call.isEmpty() || !query.band.isEmpty();
+
+    // Whether the record matches the query; index hits are checked too,
+    // as call ids may collide, and a call query may have been answered
+    // with the band's list.
+
+    auto const matches = [&](Record const &record) {
+        return record.utc >= from && record.utc <= to &&
+               (call.isEmpty() || calls(record).contains(call)) &&
+               (query.band.isEmpty() ||
+                band(record).compare(query.band, Qt::CaseInsensitive) == 0);
+    };
+
+    qsizetype visited = 0;
+
+    for (auto const &date : segments()) {
+        if (query.from.isValid() && date < query.from.toUTC().date()) {
+            continue;
+        }
+        if (query.to.isValid() && date > query.to.toUTC().date()) {
+            break;
+        }
+
+        QFile file(segmentPath(m_directory, date));
+        if (!file.open(QIODevice::ReadOnly) || file.size() < HeaderSize) {
+            continue;
+        }
+
+        QByteArray contents;
+        auto data = reinterpret_cast<char const *>(file.map(0, file.size()));
+        if (!data) {
+            contents = file.readAll();
+            data = contents.constData();
+        }
+
+        if (qFromLittleEndian<quint32>(data) != SegmentMagic ||
+            qFromLittleEndian<quint32>(data + 4) != RecordSize) {
+            qCWarning(decodejournal_js8)
+                << "Not a journal segment:" << file.fileName();
+            continue;
+        }
+
+        auto const count =
+            static_cast<quint32>((file.size() - HeaderSize) / RecordSize);
+
+        // Record numbers to look at; everything, or what the index has for
+        // the call or band, and whatever the index doesn't yet cover.
+
+        QList<quint32> candidates;
+        if (indexed) {
+            Index index;
+            if (index.load(indexPath(m_directory, date)) &&
+                index.count <= count) {
+                candidates = call.isEmpty()
+                                 ? index.bands.value(query.band.toLower())
+                                 : index.calls.value(callId(call));
+            } else {
+                index = {};
+            }
+            for (auto n = index.count; n < count; ++n) {
+                candidates.append(n);
+            }
+        }
+
+        auto const visitRecord = [&](quint32 const n) {
+            auto const record =
+                Record::deserialize(data + HeaderSize + qint64{n} * RecordSize);
+            if (!matches(record)) {
+                return true;
+            }
+            ++visited;
+            return visit(record);
+        };
+
+        if (indexed) {
+            for (auto const n : std::as_const(candidates)) {
+                if (!visitRecord(n)) {
+                    return visited;
+                }
+            }
+        } else {
+            for (quint32 n = 0; n < count; ++n) {
+                if (!visitRecord(n)) {
+                    return visited;
+                }
+            }
+        }
+    }
+
+    return visited;
+}
+} // namespace DecodeJournal
+
+/******************************************************************************/
+
+Q_LOGGING_CATEGORY(decodejournal_js8, "decodejournal.js8", QtWarningMsg)
@@ -0,0 +1,199 @@
+#ifndef DECODEJOURNAL_H
+#define DECODEJOURNAL_H
+
+#include "JS8_Mode/JS8.h"
+#include <QByteArray>
+#include <QDate>
+#include <QDateTime>
+#include <QFile>
+#include <QList>
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+#include <array>
+#include <functional>
+
+class QTimer;
+
+/**
+ * Append-only binary journal of decodes.
+ *
+ * Every decode is written to the journal as a fixed-size record, in
+ * segments of a UTC day each, named for the day, e.g., 2024-06-01.j8j,
+ * alongside a small index of the segment, 2024-06-01.j8x, by callsign
+ * and by band. Questions such as what was heard from a station on 20m
+ * last week are then answered by reading a few index entries and the
+ * records they point to, rather than by parsing years of ALL.TXT.
+ *
+ * A segment is an 8-byte header, the magic and the record size, followed
+ * by records. All values are little endian. Records are 48 bytes:
+ *
+ *    0  qint64   UTC of the decode, in milliseconds since the epoch
+ *    8  quint64  dial frequency, in Hz
+ *   16  float    time delta, in seconds
+ *   20  float    frequency offset, in Hz
+ *   24  float    decoder quality
+ *   28  qint16   SNR
+ *   30  quint8   submode
+ *   31  quint8   frame type bits
+ *   32  quint8   receiver
+ *   33  char[12] frame
+ *   45           reserved, zero
+ *
+ * Callsigns are indexed by a stable hash of the callsign, rather than
+ * by interned id, which is valid only within the running process; index
+ * hits are checked against the record, so collisions cost only time.
+ *
+ * The index is written only on closing its segment, when the day changes
+ * or the writer goes away; rewriting it as records arrive would cost more
+ * than the records do. Records beyond those an index covers, i.e., those
+ * of the current day, or those left by a crash, are still found, by
+ * reading them; the writer brings the index up to date when it next
+ * opens the segment.
+ **/
+namespace DecodeJournal {
+constexpr quint32 SegmentMagic = 0x314a384a; // "J8J1"
+constexpr quint32 IndexMagic = 0x3158384a;   // "J8X1"
+constexpr qsizetype HeaderSize = 8;
+constexpr qsizetype RecordSize = 48;
+constexpr qsizetype FrameSize = 12;
+
+struct Record {
+    qint64 utc = 0;
+    quint64 dial = 0;
+    float dt = 0;
+    float frequency = 0;
+    float quality = 0;
+    qint16 snr = 0;
+    quint8 submode = 0;
+    quint8 type = 0;
+    quint8 receiver = 0;
+    std::array<char, FrameSize> frame = {};
+
+    // Record of the decode, made at the time given, on the dial frequency
+    // given; the decode carries only the time of day of its period, so the
+    // date is taken from the time given.
+
+    static Record from(JS8::Event::Decoded const &decoded,
+                       QDateTime const &now, quint64 dial);
+
+    // Decode event equivalent to the record, as the decoder would emit it.
+
+    JS8::Event::Decoded decoded() const;
+
+    // Conversion to and from the parameters of an API message.
+
+    QVariantMap toVariantMap() const;
+    static Record fromVariantMap(QVariantMap const &params);
+
+    // Binary form, per the layout above.
+
+    void serialize(char *out) const;
+    static Record deserialize(char const *in);
+};
+
+// Index keys of the record; the callsigns in its frame, and the name of
+// the band that its dial frequency lies in.
+
+QStringList calls(Record const &record);
+QString band(Record const &record);
+quint32 callId(QString const &call);
+
+// Index of a segment; record numbers by callsign id and by band, and the
+// number of records, from the start of the segment, that it covers.
+
+struct Index {
+    quint32 count = 0;
+    QMap<quint32, QList<quint32>> calls;
+    QMap<QString, QList<quint32>> bands;
+
+    void add(Record const &record);
+    bool load(QString const &path);
+    bool save(QString const &path) const;
+};
+
+// Paths of the segment and index files for the date.
+
+QString segmentPath(QString const &directory, QDate const &date);
+QString indexPath(QString const &directory, QDate const &date);
+
+/**
+ * Writes records to the journal, from the thread it lives in.
+ *
+ * Records are buffered, and written when the buffer fills, after a short
+ * interval, when the day changes, or when the writer goes away. Move the
+ * writer to its thread, and connect the thread's finished() signal to its
+ * deleteLater() slot; it closes its segment on destruction.
+ **/
+class Writer : public QObject {
+    Q_OBJECT
+
+  public:
+    // Bytes buffered before writing, and interval, in milliseconds, after
+    // which buffered records are written regardless.
+
+    static constexpr qsizetype FlushBytes = 64 * 1024;
+    static constexpr int FlushInterval = 10000;
+
+    explicit Writer(QString const &directory, QObject *parent = nullptr);
+    ~Writer();
+
+    // Thread-safe; may be called from any thread.
+
+    void append(Record const &record);
+
+  signals:
+    void error(QString const &path, QString const &message);
+
+  private:
+    void write(Record const &record);
+    bool open(QDate const &date);
+    void flush();
+    void close();
+
+    QString m_directory;
+    QDate m_date;
+    QFile m_file;
+    QByteArray m_buffer;
+    Index m_index;
+    bool m_dirty = false;
+    QTimer *m_timer = nullptr;
+};
+
+// Query of the journal. Invalid times leave the range open on that side;
+// an empty call or band matches any.
+
+struct Query {
+    QDateTime from;
+    QDateTime to;
+    QString call;
+    QString band;
+};
+
+/**
+ * Reads records from the journal; segments are mapped, rather than read,
+ * where the platform allows, and only the records the index points to are
+ * looked at when querying by callsign or band.
+ **/
+class Reader {
+  public:
+    explicit Reader(QString const &directory);
+
+    // Dates of the segments in the journal, in order.
+
+    QList<QDate> segments() const;
+
+    // Visit the records matching the query, in order, until the visitor
+    // returns false; returns the number of records visited.
+
+    qsizetype scan(Query const &query,
+                   std::function<bool(Record const &)> const &visit) const;
+
+  private:
+    QString m_directory;
+};
+} // namespace DecodeJournal
+
+#endif // DECODEJOURNAL_H
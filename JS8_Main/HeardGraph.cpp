@@ -0,0 +1,139 @@
+#include "HeardGraph.h"
+#include "Intern.h"
+
+#include <algorithm>
+#include <utility>
+
+/******************************************************************************/
+// Local Routines
+/******************************************************************************/
+
+namespace {
+constexpr quint64 edge(quint32 const from, quint32 const to) {
+    return (quint64{from} << 32) | to;
+}
+
+constexpr quint32 edgeFrom(quint64 const edge) { return edge >> 32; }
+
+constexpr quint32 edgeTo(quint64 const edge) { return edge & 0xffffffff; }
+} // namespace
+
+/******************************************************************************/
+// Private Implementation
+/******************************************************************************/
+
+QStringList HeardGraph::names(Partition const &partition,
+                              Adjacency const &adjacency,
+                              QString const &call) {
+    QStringList names;
+
+    for (auto const other : adjacency.value(Intern::find(call))) {
+        names.append(partition.names.value(other));
+    }
+    names.sort();
+
+    return names;
+}
+
+// The current partition, for writing; if it's shared with the band cache,
+// it's copied first, so that the cached graph is unaffected.
+
+HeardGraph::Partition &HeardGraph::writable() {
+    if (m_current.use_count() > 1) {
+        m_current = std::make_shared<Partition>(*m_current);
+    }
+    return *m_current;
+}
+
+void HeardGraph::remove(Partition &partition, Edge const edge) {
+    auto const unlink = [](Adjacency &adjacency, quint32 const key,
+                           quint32 const value) {
+        if (auto it = adjacency.find(key); it != adjacency.end()) {
+            it->remove(value);
+            if (it->isEmpty()) {
+                adjacency.erase(it);
+            }
+        }
+    };
+
+    // Let go of the callsigns of stations left without any edges.
+
+    auto const release = [&partition](quint32 const id) {
+        if (!partition.outgoing.contains(id) &&
+            !partition.incoming.contains(id)) {
+            partition.names.remove(id);
+        }
+    };
+
+    unlink(partition.outgoing, edgeFrom(edge), edgeTo(edge));
+    unlink(partition.incoming, edgeTo(edge), edgeFrom(edge));
+    release(edgeFrom(edge));
+    release(edgeTo(edge));
+    partition.edges.remove(edge);
+}
+
+/******************************************************************************/
+// Public Implementation
+/******************************************************************************/
+
+HeardGraph::HeardGraph() : m_current(std::make_shared<Partition>()) {}
+
+void HeardGraph::add(QString const &from, QString const &to,
+                     qint64 const secsSinceEpoch) {
+    auto &partition = writable();
+    auto const bucket = secsSinceEpoch / BucketSeconds;
+    auto const fromName = Intern::string(from);
+    auto const toName = Intern::string(to);
+    auto const key = edge(Intern::id(fromName), Intern::id(toName));
+
+    // Move the edge to the current bucket, or add it if it's new.
+
+    if (auto it = partition.edges.find(key); it != partition.edges.end()) {
+        if (*it != bucket) {
+            partition.buckets[*it].remove(key);
+            *it = bucket;
+        }
+    } else {
+        partition.edges.insert(key, bucket);
+        partition.outgoing[edgeFrom(key)].insert(edgeTo(key));
+        partition.incoming[edgeTo(key)].insert(edgeFrom(key));
+        partition.names.insert(edgeFrom(key), fromName);
+        partition.names.insert(edgeTo(key), toName);
+    }
+    partition.buckets[bucket].insert(key);
+
+    // Drop buckets that have aged out, then the oldest of those remaining
+    // while we're over the limit; the current bucket always stays.
+
+    auto it = partition.buckets.begin();
+    while (it != partition.buckets.end() && it.key() != bucket &&
+           (it.key() <= bucket - RetainedBuckets || it->isEmpty() ||
+            partition.edges.size() > MaxEdges)) {
+        for (auto const old : std::as_const(*it)) {
+            remove(partition, old);
+        }
+        it = partition.buckets.erase(it);
+    }
+}
+
+QStringList HeardGraph::hearing(QString const &call) const {
+    return names(*m_current, m_current->outgoing, call);
+}
+
+QStringList HeardGraph::heardBy(QString const &call) const {
+    return names(*m_current, m_current->incoming, call);
+}
+
+void HeardGraph::clear() { m_current = std::make_shared<Partition>(); }
+
+void HeardGraph::cacheBand(QString const &band) { m_bands[band] = m_current; }
+
+// A band's graph is current from here until it's cached again on leaving
+// the band, so it's taken from the cache, rather than shared with it.
+
+void HeardGraph::restoreBand(QString const &band) {
+    if (auto const it = m_bands.find(band); it != m_bands.end()) {
+        m_current = std::move(it->second);
+        m_bands.erase(it);
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef HEARDGRAPH_H
+#define HEARDGRAPH_H
+
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <map>
+#include <memory>
+
+/**
+ * Graph of which stations have been heard by which, kept per band.
+ *
+ * Callsigns are interned, see Intern.h, so the graph itself is held as
+ * integer ids; each partition holds the interned callsigns of the stations
+ * in it, which keeps their ids valid, and names them for queries. Each edge remembers when it was last heard, in hour-long
+ * buckets, and edges that haven't been heard for a day are dropped, as are
+ * the oldest when there are more than the graph will hold; a station
+ * running around the clock doesn't see the graph grow without bound.
+ *
+ * Each band has its own partition. Changing bands moves partitions in and
+ * out of the band cache by pointer, copying nothing; a partition shared
+ * with the cache is copied only if written to, as with the implicitly
+ * shared maps used for the rest of the band activity.
+ **/
+class HeardGraph {
+  public:
+    // Bucket granularity, number of buckets retained, and most edges held.
+
+    static constexpr qint64 BucketSeconds = 60 * 60;
+    static constexpr qint64 RetainedBuckets = 24;
+    static constexpr qsizetype MaxEdges = 20000;
+
+    HeardGraph();
+
+    // Record that `from` heard `to` at the time, given in seconds since
+    // the epoch.
+
+    void add(QString const &from, QString const &to, qint64 secsSinceEpoch);
+
+    // Stations the callsign is hearing, and stations that have heard it.
+
+    QStringList hearing(QString const &call) const;
+    QStringList heardBy(QString const &call) const;
+
+    void clear();
+
+    // Band changes; park the current graph as that of the band, and take
+    // the band's parked graph, if any, as the current one.
+
+    void cacheBand(QString const &band);
+    void restoreBand(QString const &band);
+
+  private:
+    using Edge = quint64;
+    using Adjacency = QHash<quint32, QSet<quint32>>;
+
+    struct Partition {
+        QHash<Edge, qint64> edges;       // edge -> bucket last heard
+        QMap<qint64, QSet<Edge>> buckets; // bucket -> edges last heard
+        Adjacency outgoing;              // from -> to
+        Adjacency incoming;              // to -> from
+        QHash<quint32, QString> names;   // id -> callsign
+    };
+
+    static QStringList names(Partition const &partition,
+                             Adjacency const &adjacency, QString const &call);
+    Partition &writable();
+    static void remove(Partition &partition, Edge edge);
+
+    std::shared_ptr<Partition> m_current;
+    std::map<QString, std::shared_ptr<Partition>> m_bands;
+};
+
+#endif // HEARDGRAPH_H
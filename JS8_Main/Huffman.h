@@ -0,0 +1,186 @@
+#ifndef HUFFMAN_HPP__
+#define HUFFMAN_HPP__
+
+#include "JS8_Main/BitBuffer.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+// Huffman code for the uncompressed data frame alphabet. From the codes,
+// we compile at build time an encoding table indexed by character, and a
+// decoding table indexed by the next LOOKUP_BITS bits of a frame. The
+// code is complete, and no code is longer than the lookup, so every code
+// is decoded by a single table lookup.
+//
+// Nothing here depends on anything but BitBuffer, so the code can be
+// checked on its own; see tools/huffman_check.cpp.
+
+namespace Huffman {
+struct Entry {
+    char ch;
+    std::string_view code;
+};
+
+inline constexpr std::array<Entry, 44> CODES = {{
+    // char code             weight
+    {' ', "01"},         // 1.0
+    {'E', "100"},        // 0.5
+    {'T', "1101"},       // 0.333333333333
+    {'A', "0011"},       // 0.25
+    {'O', "11111"},      // 0.2
+    {'I', "11100"},      // 0.166666666667
+    {'N', "10111"},      // 0.142857142857
+    {'S', "10100"},      // 0.125
+    {'H', "00011"},      // 0.111111111111
+    {'R', "00000"},      // 0.1
+    {'D', "111011"},     // 0.0909090909091
+    {'L', "110011"},     // 0.0833333333333
+    {'C', "110001"},     // 0.0769230769231
+    {'U', "101101"},     // 0.0714285714286
+    {'M', "101011"},     // 0.0666666666667
+    {'W', "001011"},     // 0.0625
+    {'F', "001001"},     // 0.0588235294118
+    {'G', "000101"},     // 0.0555555555556
+    {'Y', "000011"},     // 0.0526315789474
+    {'P', "1111011"},    // 0.05
+    {'B', "1111001"},    // 0.047619047619
+    {'.', "1110100"},    // 0.0434782608696
+    {'V', "1100101"},    // 0.0416666666667
+    {'K', "1100100"},    // 0.04
+    {'-', "1100001"},    // 0.0384615384615
+    {'+', "1100000"},    // 0.037037037037
+    {'?', "1011001"},    // 0.0344827586207
+    {'!', "1011000"},    // 0.0333333333333
+    {'"', "1010101"},    // 0.0322580645161
+    {'X', "1010100"},    // 0.03125
+    {'0', "0010101"},    // 0.030303030303
+    {'J', "0010100"},    // 0.0294117647059
+    {'1', "0010001"},    // 0.0285714285714
+    {'Q', "0010000"},    // 0.0277777777778
+    {'2', "0001001"},    // 0.027027027027
+    {'Z', "0001000"},    // 0.0263157894737
+    {'3', "0000101"},    // 0.025641025641
+    {'5', "0000100"},    // 0.025
+    {'4', "11110101"},   // 0.0243902439024
+    {'9', "11110100"},   // 0.0238095238095
+    {'8', "11110001"},   // 0.0232558139535
+    {'6', "11110000"},   // 0.0227272727273
+    {'7', "11101011"},   // 0.0222222222222
+    {'/', "11101010"},   // 0.0217391304348
+}};
+
+struct Code {
+    std::uint8_t bits = 0; // right-aligned
+    std::uint8_t length = 0;
+};
+
+struct Symbol {
+    char ch = 0;
+    std::uint8_t length = 0;
+};
+
+inline constexpr int LOOKUP_BITS = 8;
+
+inline constexpr auto ENCODE = [] {
+    std::array<Code, 128> table{};
+
+    for (auto const &[ch, code] : CODES) {
+        auto &entry = table[static_cast<unsigned char>(ch)];
+
+        for (auto const bit : code) {
+            entry.bits = static_cast<std::uint8_t>((entry.bits << 1) |
+                                                   (bit == '1'));
+        }
+        entry.length = static_cast<std::uint8_t>(code.size());
+    }
+
+    return table;
+}();
+
+inline constexpr auto DECODE = [] {
+    std::array<Symbol, 1 << LOOKUP_BITS> table{};
+
+    for (auto const &[ch, code] : CODES) {
+        auto const [bits, length] = ENCODE[static_cast<unsigned char>(ch)];
+        auto const shift = LOOKUP_BITS - length;
+
+        for (unsigned i = 0; i < (1u << shift); ++i) {
+            table[(bits << shift) | i] = {ch, length};
+        }
+    }
+
+    return table;
+}();
+
+static_assert(std::ranges::all_of(CODES,
+                                  [](auto const &entry) {
+                                      return entry.code.size() <=
+                                             LOOKUP_BITS;
+                                  }),
+              "Codes must fit within the decoding lookup");
+static_assert(std::ranges::all_of(DECODE,
+                                  [](auto const &symbol) {
+                                      return symbol.length != 0;
+                                  }),
+              "Code must be complete");
+
+// Returns the code for the provided UTF-16 code unit; the length of the
+// code is zero if the character has none.
+
+constexpr Code code(char16_t const ch) {
+    return ch < ENCODE.size() ? ENCODE[ch] : Code{};
+}
+
+// Appends the codes of the text to the bits, skipping characters without
+// a code, and stopping at the first that would take the bits to the limit
+// or past it; returns the number of characters encoded.
+
+constexpr int encode(std::u16string_view const text, BitBuffer &bits,
+                     int const limit) {
+    int n = 0;
+
+    for (auto const ch : text) {
+        auto const [value, length] = code(ch);
+
+        if (!length) {
+            continue;
+        }
+        if (bits.size() + length >= limit) {
+            break;
+        }
+
+        bits.append(value, length);
+        ++n;
+    }
+
+    return n;
+}
+
+// Decodes the bits, passing each character to the provided function, up
+// to the end of the bits or the first incomplete code.
+
+template <typename Emit>
+constexpr void decode(BitBuffer const &bits, Emit &&emit) {
+    // Every code fits within a lookup's worth of bits, so take that many
+    // at a time, zero-filled past the end.
+
+    for (int pos = 0; pos < bits.size();) {
+        auto const available = bits.size() - pos;
+        auto const index = available >= LOOKUP_BITS
+                               ? bits.field(pos, LOOKUP_BITS)
+                               : bits.field(pos, available)
+                                     << (LOOKUP_BITS - available);
+        auto const [ch, length] = DECODE[index];
+
+        if (length > available) {
+            break;
+        }
+
+        emit(ch);
+        pos += length;
+    }
+}
+} // namespace Huffman
+
+#endif
@@ -26,16 +26,12 @@ Q_DECLARE_LOGGING_CATEGORY(inbox_js8)
 
 namespace {
 constexpr char SCHEMA[] =
+    "PRAGMA journal_mode = WAL;"
+    "PRAGMA synchronous = NORMAL;"
     "CREATE TABLE IF NOT EXISTS inbox_v1 ("
     "  id INTEGER PRIMARY KEY AUTOINCREMENT, "
     "  blob TEXT"
     ");"
-    "CREATE INDEX IF NOT EXISTS idx_inbox_v1__type ON"
-    "  inbox_v1(json_extract(blob, '$.type'));"
-    "CREATE INDEX IF NOT EXISTS idx_inbox_v1__params_from ON"
-    "  inbox_v1(json_extract(blob, '$.params.FROM'));"
-    "CREATE INDEX IF NOT EXISTS idx_inbox_v1__params_to ON"
-    "  inbox_v1(json_extract(blob, '$.params.TO'));"
     "CREATE TABLE IF NOT EXISTS inbox_group_recip_v1 ("
     "  id INTEGER PRIMARY KEY AUTOINCREMENT, "
     "  msg_id INTEGER, "
@@ -45,6 +41,46 @@ constexpr char SCHEMA[] =
     "CREATE INDEX IF NOT EXISTS idx_inbox_group_recip_v1__callsign ON"
     "  inbox_group_recip_v1(callsign);";
 
+// Schema version 1; the fields that we query on are generated columns,
+// indexed in the combinations that we query them in, replacing indexes
+// on the bare expressions. Callsigns compare without regard to case, so
+// that LIKE, which does likewise, can use their indexes. The columns are
+// virtual, so the table itself remains readable by earlier versions.
+
+constexpr char MIGRATION_1[] =
+    "BEGIN;"
+    "ALTER TABLE inbox_v1 ADD COLUMN msg_type TEXT"
+    "  GENERATED ALWAYS AS (json_extract(blob, '$.type')) VIRTUAL;"
+    "ALTER TABLE inbox_v1 ADD COLUMN msg_from TEXT COLLATE NOCASE"
+    "  GENERATED ALWAYS AS (json_extract(blob, '$.params.FROM')) VIRTUAL;"
+    "ALTER TABLE inbox_v1 ADD COLUMN msg_to TEXT COLLATE NOCASE"
+    "  GENERATED ALWAYS AS (json_extract(blob, '$.params.TO')) VIRTUAL;"
+    "ALTER TABLE inbox_v1 ADD COLUMN msg_utc TEXT"
+    "  GENERATED ALWAYS AS (json_extract(blob, '$.params.UTC')) VIRTUAL;"
+    "CREATE INDEX idx_inbox_v1__type_from ON inbox_v1(msg_type, msg_from);"
+    "CREATE INDEX idx_inbox_v1__type_to_utc ON"
+    "  inbox_v1(msg_type, msg_to, msg_utc);"
+    "DROP INDEX IF EXISTS idx_inbox_v1__type;"
+    "DROP INDEX IF EXISTS idx_inbox_v1__params_from;"
+    "DROP INDEX IF EXISTS idx_inbox_v1__params_to;"
+    "PRAGMA user_version = 1;"
+    "COMMIT;";
+
+// Generated column holding the value at the JSON path, if there's one;
+// the path is otherwise extracted from the blob, row by row.
+
+QByteArray column(QString const &query) {
+    if (query == "$.type")
+        return "msg_type";
+    if (query == "$.params.FROM")
+        return "msg_from";
+    if (query == "$.params.TO")
+        return "msg_to";
+    if (query == "$.params.UTC")
+        return "msg_utc";
+    return "json_extract(blob, ?2)";
+}
+
 // Attempt to retrieve a Message object previously serialized as a
 // JSON object to the specified column; will throw on failure to
 // deserialize the object.
@@ -73,21 +109,65 @@ bool Inbox::open() {
         return false;
     }
 
+    sqlite3_busy_timeout(db_, 5000);
+
     rc = sqlite3_exec(db_, SCHEMA, nullptr, nullptr, nullptr);
     if (rc != SQLITE_OK) {
         return false;
     }
 
+    int version = 0;
+    if (auto stmt = statement("PRAGMA user_version;");
+        stmt && sqlite3_step(stmt) == SQLITE_ROW) {
+        version = sqlite3_column_int(stmt, 0);
+    }
+
+    if (version < 1) {
+        rc = sqlite3_exec(db_, MIGRATION_1, nullptr, nullptr, nullptr);
+        if (rc != SQLITE_OK) {
+            qCWarning(inbox_js8) << "migration failed:" << error();
+            sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
+            return false;
+        }
+    }
+
     return true;
 }
 
 void Inbox::close() {
+    for (auto const stmt : std::as_const(statements_)) {
+        sqlite3_finalize(stmt);
+    }
+    statements_.clear();
+
     if (db_) {
         sqlite3_close(db_);
         db_ = nullptr;
     }
 }
 
+// Statements are prepared once, on first use, and kept for the life of the
+// connection; those we use are few, and used over and over.
+
+Inbox::Statement Inbox::statement(QByteArray const &sql) {
+    if (auto const it = statements_.constFind(sql);
+        it != statements_.constEnd()) {
+        sqlite3_clear_bindings(*it);
+        return Statement(*it);
+    }
+
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v3(db_, sql.constData(), sql.size() + 1,
+                           SQLITE_PREPARE_PERSISTENT, &stmt,
+                           nullptr) != SQLITE_OK) {
+        qCWarning(inbox_js8) << "prepare failed:" << error();
+        return Statement(nullptr);
+    }
+
+    statements_.insert(sql, stmt);
+    return Statement(stmt);
+}
+
 QString Inbox::error() {
     if (db_) {
         return QString::fromLocal8Bit(sqlite3_errmsg(db_));
@@ -100,16 +180,18 @@ int Inbox::count(QString type, QString query, QString match) {
         return -1;
     }
 
-    const char *sql = "SELECT COUNT(*) FROM inbox_v1 "
-                      "WHERE json_extract(blob, '$.type') = ? "
-                      "AND json_extract(blob, ?) LIKE ?;";
+    QByteArray const sql = "SELECT COUNT(*) FROM inbox_v1 "
+                           "WHERE msg_type = ?1 "
+                           "AND " +
+                           column(query) + " LIKE ?3;";
 
-    sqlite3_stmt *stmt;
-    int rc = sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    auto stmt = statement(sql);
+    if (!stmt) {
         return -1;
     }
 
+    int rc;
+
     auto t8 = type.toLocal8Bit();
     auto q8 = query.toLocal8Bit();
     auto m8 = match.toLocal8Bit();
@@ -123,7 +205,7 @@ int Inbox::count(QString type, QString query, QString match) {
         count = sqlite3_column_int(stmt, 0);
     }
 
-    rc = sqlite3_finalize(stmt);
+    rc = stmt.reset();
     if (rc != SQLITE_OK) {
         return -1;
     }
@@ -137,18 +219,21 @@ QList<QPair<int, Message>> Inbox::values(QString type, QString query,
         return {};
     }
 
-    const char *sql = "SELECT id, blob FROM inbox_v1 "
-                      "WHERE json_extract(blob, '$.type') = ? "
-                      "AND json_extract(blob, ?) LIKE ? "
-                      "ORDER BY id ASC "
-                      "LIMIT ? OFFSET ?;";
+    QByteArray const sql = "SELECT id, blob FROM inbox_v1 "
+                           "WHERE msg_type = ?1 "
+                           "AND " +
+                           column(query) +
+                           " LIKE ?3 "
+                           "ORDER BY id ASC "
+                           "LIMIT ?4 OFFSET ?5;";
 
-    sqlite3_stmt *stmt;
-    int rc = sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    auto stmt = statement(sql);
+    if (!stmt) {
         return {};
     }
 
+    int rc;
+
     auto t8 = type.toLocal8Bit();
     auto q8 = query.toLocal8Bit();
     auto m8 = match.toLocal8Bit();
@@ -171,7 +256,7 @@ QList<QPair<int, Message>> Inbox::values(QString type, QString query,
         }
     }
 
-    rc = sqlite3_finalize(stmt);
+    rc = stmt.reset();
     if (rc != SQLITE_OK) {
         return {};
     }
@@ -186,12 +271,13 @@ Message Inbox::value(int key) {
 
     const char *sql = "SELECT blob FROM inbox_v1 WHERE id = ? LIMIT 1;";
 
-    sqlite3_stmt *stmt;
-    int rc = sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    auto stmt = statement(sql);
+    if (!stmt) {
         return {};
     }
 
+    int rc;
+
     rc = sqlite3_bind_int(stmt, 1, key);
 
     Message m;
@@ -203,7 +289,7 @@ Message Inbox::value(int key) {
         }
     }
 
-    rc = sqlite3_finalize(stmt);
+    rc = stmt.reset();
     if (rc != SQLITE_OK) {
         return {};
     }
@@ -218,17 +304,18 @@ int Inbox::append(Message value) {
 
     const char *sql = "INSERT INTO inbox_v1 (blob) VALUES (?);";
 
-    sqlite3_stmt *stmt;
-    int rc = sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    auto stmt = statement(sql);
+    if (!stmt) {
         return -2;
     }
 
+    int rc;
+
     auto j8 = value.toJson();
     rc = sqlite3_bind_text(stmt, 1, j8.data(), -1, nullptr);
     rc = sqlite3_step(stmt);
 
-    rc = sqlite3_finalize(stmt);
+    rc = stmt.reset();
     if (rc != SQLITE_OK) {
         return -1;
     }
@@ -243,19 +330,20 @@ bool Inbox::set(int key, Message value) {
 
     const char *sql = "UPDATE inbox_v1 SET blob = ? WHERE id = ?;";
 
-    sqlite3_stmt *stmt;
-    int rc = sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    auto stmt = statement(sql);
+    if (!stmt) {
         return false;
     }
 
+    int rc;
+
     auto j8 = value.toJson();
     rc = sqlite3_bind_text(stmt, 1, j8.data(), -1, nullptr);
     rc = sqlite3_bind_int(stmt, 2, key);
 
     rc = sqlite3_step(stmt);
 
-    rc = sqlite3_finalize(stmt);
+    rc = stmt.reset();
     if (rc != SQLITE_OK) {
         return false;
     }
@@ -270,16 +358,17 @@ bool Inbox::del(int key) {
 
     const char *sql = "DELETE FROM inbox_v1 WHERE id = ?;";
 
-    sqlite3_stmt *stmt;
-    int rc = sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    auto stmt = statement(sql);
+    if (!stmt) {
         return false;
     }
 
+    int rc;
+
     rc = sqlite3_bind_int(stmt, 1, key);
     rc = sqlite3_step(stmt);
 
-    rc = sqlite3_finalize(stmt);
+    rc = stmt.reset();
     if (rc != SQLITE_OK) {
         return false;
     }
@@ -295,17 +384,18 @@ int Inbox::getLookaheadMessageIdForCallsign(const QString &callsign,
 
     const char *sql = "SELECT inbox_v1.id, inbox_v1.blob FROM inbox_v1 "
                       "WHERE inbox_v1.id > ? "
-                      "AND json_extract(blob, '$.type') = 'STORE' "
-                      "AND json_extract(blob, '$.params.TO') LIKE ? "
+                      "AND msg_type = 'STORE' "
+                      "AND msg_to LIKE ? "
                       "ORDER BY inbox_v1.id ASC "
                       "LIMIT ? OFFSET ?;";
 
-    sqlite3_stmt *stmt;
-    int rc = sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    auto stmt = statement(sql);
+    if (!stmt) {
         return -1;
     }
 
+    int rc;
+
     auto c8 = callsign.toLocal8Bit();
 
     rc = sqlite3_bind_int(stmt, 1, afterMsgId);
@@ -334,7 +424,7 @@ int Inbox::getLookaheadMessageIdForCallsign(const QString &callsign,
         }
     }
 
-    rc = sqlite3_finalize(stmt);
+    rc = stmt.reset();
     if (rc != SQLITE_OK) {
         return -1;
     }
@@ -365,19 +455,20 @@ QMap<QString, int> Inbox::getGroupMessageCounts() {
 
     QMap<QString, int> messageCounts;
 
-    const char *sql = "SELECT count(id) as msg_count, json_extract(blob, "
-                      "'$.params.TO') as group_name FROM inbox_v1 "
-                      "WHERE json_extract(blob, '$.type') = 'STORE' "
-                      "AND group_name LIKE '@%' "
-                      "AND json_extract(blob, '$.params.UTC') > ? "
+    const char *sql = "SELECT count(id) as msg_count, msg_to as group_name "
+                      "FROM inbox_v1 "
+                      "WHERE msg_type = 'STORE' "
+                      "AND msg_to LIKE '@%' "
+                      "AND msg_utc > ? "
                       "GROUP BY group_name";
 
-    sqlite3_stmt *stmt;
-    int rc = sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    auto stmt = statement(sql);
+    if (!stmt) {
         return messageCounts;
     }
 
+    int rc;
+
     // Set a floor or 48 hours for group message retrieval
     // TODO: date formatting with the "yyyy-MM-dd HH:mm:ss" string happens
     // elsewhere as well, centralize
@@ -402,7 +493,7 @@ QMap<QString, int> Inbox::getGroupMessageCounts() {
             count);
     }
 
-    rc = sqlite3_finalize(stmt);
+    rc = stmt.reset();
 
     return messageCounts;
 }
@@ -415,12 +506,13 @@ bool Inbox::markGroupMsgDeliveredForCallsign(int msgId, QString callsign) {
     const char *sql = "SELECT count(id) as msg_count FROM inbox_group_recip_v1 "
                       "WHERE msg_id = ? AND callsign = ? LIMIT 1;";
 
-    sqlite3_stmt *exists_stmt;
-    int rc = sqlite3_prepare_v2(db_, sql, -1, &exists_stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    auto exists_stmt = statement(sql);
+    if (!exists_stmt) {
         return false;
     }
 
+    int rc;
+
     auto cs8 = callsign.toLocal8Bit();
 
     rc = sqlite3_bind_int(exists_stmt, 1, msgId);
@@ -431,15 +523,14 @@ bool Inbox::markGroupMsgDeliveredForCallsign(int msgId, QString callsign) {
     int count = sqlite3_column_int(exists_stmt, 0);
     recordExists = (count > 0);
 
-    rc = sqlite3_finalize(exists_stmt);
+    rc = exists_stmt.reset();
 
     if (!recordExists) {
         sql =
             "INSERT INTO inbox_group_recip_v1 (msg_id, callsign) VALUES (?,?);";
 
-        sqlite3_stmt *insert_stmt;
-        rc = sqlite3_prepare_v2(db_, sql, -1, &insert_stmt, nullptr);
-        if (rc != SQLITE_OK) {
+        auto insert_stmt = statement(sql);
+        if (!insert_stmt) {
             return false;
         }
 
@@ -448,7 +539,7 @@ bool Inbox::markGroupMsgDeliveredForCallsign(int msgId, QString callsign) {
 
         rc = sqlite3_step(insert_stmt);
 
-        rc = sqlite3_finalize(insert_stmt);
+        rc = insert_stmt.reset();
         if (rc != SQLITE_OK) {
             return false;
         }
@@ -467,19 +558,20 @@ int Inbox::getNextGroupMessageIdForCallsign(const QString &group_name,
                       "LEFT JOIN inbox_group_recip_v1 ON "
                       "(inbox_group_recip_v1.msg_id=inbox_v1.id AND "
                       "inbox_group_recip_v1.callsign = ?) "
-                      "WHERE json_extract(blob, '$.type') = 'STORE' "
-                      "AND json_extract(blob, '$.params.TO') LIKE ? "
-                      "AND json_extract(blob, '$.params.UTC') > ? "
+                      "WHERE msg_type = 'STORE' "
+                      "AND msg_to LIKE ? "
+                      "AND msg_utc > ? "
                       "AND inbox_group_recip_v1.id IS NULL "
                       "ORDER BY inbox_v1.id ASC "
                       "LIMIT ? OFFSET ?;";
 
-    sqlite3_stmt *stmt;
-    int rc = sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    auto stmt = statement(sql);
+    if (!stmt) {
         return -1;
     }
 
+    int rc;
+
     auto c8 = callsign.toLocal8Bit();
     auto g8 = group_name.toLocal8Bit();
 
@@ -519,7 +611,7 @@ int Inbox::getNextGroupMessageIdForCallsign(const QString &group_name,
         }
     }
 
-    rc = sqlite3_finalize(stmt);
+    rc = stmt.reset();
     if (rc != SQLITE_OK) {
         return -1;
     }
@@ -539,19 +631,20 @@ int Inbox::getLookaheadGroupMessageIdForCallsign(const QString &group_name,
                       "(inbox_group_recip_v1.msg_id=inbox_v1.id AND "
                       "inbox_group_recip_v1.callsign = ?) "
                       "WHERE inbox_v1.id > ? "
-                      "AND json_extract(blob, '$.type') = 'STORE' "
-                      "AND json_extract(blob, '$.params.TO') LIKE ? "
-                      "AND json_extract(blob, '$.params.UTC') > ? "
+                      "AND msg_type = 'STORE' "
+                      "AND msg_to LIKE ? "
+                      "AND msg_utc > ? "
                       "AND inbox_group_recip_v1.id IS NULL "
                       "ORDER BY inbox_v1.id ASC "
                       "LIMIT ? OFFSET ?;";
 
-    sqlite3_stmt *stmt;
-    int rc = sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    auto stmt = statement(sql);
+    if (!stmt) {
         return -1;
     }
 
+    int rc;
+
     auto c8 = callsign.toLocal8Bit();
     auto g8 = group_name.toLocal8Bit();
 
@@ -592,7 +685,7 @@ int Inbox::getLookaheadGroupMessageIdForCallsign(const QString &group_name,
         }
     }
 
-    rc = sqlite3_finalize(stmt);
+    rc = stmt.reset();
     if (rc != SQLITE_OK) {
         return -1;
     }
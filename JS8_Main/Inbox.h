@@ -5,6 +5,8 @@
  * (C) 2018 Jordan Sherer <kn4crd@gmail.com> - All Rights Reserved
  **/
 
+#include <QByteArray>
+#include <QHash>
 #include <QObject>
 #include <QPair>
 #include <QString>
@@ -51,8 +53,31 @@ class Inbox {
   public slots:
 
   private:
+    // Prepared statement, from the cache; reset, releasing any read lock
+    // it holds, when it goes out of scope, ready for its next use.
+
+    class Statement {
+      public:
+        explicit Statement(sqlite3_stmt *stmt) : stmt_{stmt} {}
+        Statement(Statement const &) = delete;
+        Statement &operator=(Statement const &) = delete;
+        ~Statement() { reset(); }
+
+        operator sqlite3_stmt *() const { return stmt_; }
+        explicit operator bool() const { return stmt_ != nullptr; }
+
+        // Result of the last step, as sqlite3_finalize() would have had it.
+        int reset() { return stmt_ ? sqlite3_reset(stmt_) : SQLITE_OK; }
+
+      private:
+        sqlite3_stmt *stmt_;
+    };
+
+    Statement statement(QByteArray const &sql);
+
     QString path_;
     sqlite3 *db_;
+    QHash<QByteArray, sqlite3_stmt *> statements_;
 };
 
 #endif // INBOX_H
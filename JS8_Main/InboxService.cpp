@@ -0,0 +1,28 @@
+#include "InboxService.h"
+#include <QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(inboxservice_js8)
+
+/******************************************************************************/
+// Public Implementation
+/******************************************************************************/
+
+InboxService::InboxService(QString const &path, QObject *parent)
+    : QObject(parent), m_inbox(path) {}
+
+// Should the open fail, it's reported, and tried again on the next use;
+// until then, the inbox's functions return their empty results, just as
+// they did when each use opened it anew.
+
+Inbox &InboxService::inbox() {
+    if (!m_inbox.isOpen() && !m_inbox.open()) {
+        qCWarning(inboxservice_js8)
+            << "Failed to open inbox:" << m_inbox.error();
+        m_inbox.close();
+    }
+    return m_inbox;
+}
+
+/******************************************************************************/
+
+Q_LOGGING_CATEGORY(inboxservice_js8, "inboxservice.js8", QtWarningMsg)
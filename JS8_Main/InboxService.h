@@ -0,0 +1,104 @@
+#ifndef INBOXSERVICE_H
+#define INBOXSERVICE_H
+
+#include "Inbox.h"
+#include <QMetaObject>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QThread>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Owns the one connection to the inbox database, and runs everything
+ * done with it on a thread of its own.
+ *
+ * Each use of the inbox formerly opened the database, ran the schema,
+ * prepared its statements, and closed it again, on the GUI thread; that
+ * was most of the cost of what were, for the most part, indexed lookups.
+ * The connection is now opened once, on first use, and its statements
+ * prepared once and cached, for the life of the service.
+ *
+ * Work is handed to the service as a function of the inbox, in one of
+ * three ways:
+ *
+ *   - post(fn), to run it without waiting;
+ *   - post(context, fn, callback), to run it without waiting, and hand
+ *     its result to the callback, on the context object's thread, if
+ *     the context object still exists;
+ *   - call(fn), to run it and wait for its result; reserved for those
+ *     few places, in the middle of composing a reply, that can't proceed
+ *     without it.
+ *
+ * Work runs in the order handed over, whichever way it was. Create the
+ * service, move it to its thread, and connect the thread's finished()
+ * signal to its deleteLater() slot; it closes the database on destruction.
+ **/
+class InboxService : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit InboxService(QString const &path, QObject *parent = nullptr);
+
+    // The inbox, opened if it isn't already; for use only on the service's
+    // thread, i.e., from within the functions handed to it.
+
+    Inbox &inbox();
+
+    template <typename F> void post(F &&fn) {
+        QMetaObject::invokeMethod(
+            this,
+            [this, fn = std::forward<F>(fn)]() mutable { fn(inbox()); },
+            Qt::QueuedConnection);
+    }
+
+    template <typename F, typename C>
+    void post(QObject *context, F &&fn, C &&callback) {
+        QMetaObject::invokeMethod(
+            this,
+            [this, context = QPointer<QObject>(context),
+             fn = std::forward<F>(fn),
+             callback = std::forward<C>(callback)]() mutable {
+                auto result = fn(inbox());
+                if (context) {
+                    QMetaObject::invokeMethod(
+                        context,
+                        [callback = std::move(callback),
+                         result = std::move(result)]() mutable {
+                            callback(std::move(result));
+                        },
+                        Qt::QueuedConnection);
+                }
+            },
+            Qt::QueuedConnection);
+    }
+
+    // If we're already on the service's thread, or it's not running, i.e.,
+    // at startup or on shutdown, the function's run directly.
+
+    template <typename F> auto call(F &&fn) {
+        using Result = std::invoke_result_t<F &, Inbox &>;
+
+        if (QThread::currentThread() == thread() || !thread()->isRunning()) {
+            return fn(inbox());
+        }
+
+        if constexpr (std::is_void_v<Result>) {
+            QMetaObject::invokeMethod(
+                this, [this, &fn]() { fn(inbox()); },
+                Qt::BlockingQueuedConnection);
+        } else {
+            Result result{};
+            QMetaObject::invokeMethod(
+                this, [this, &fn, &result]() { result = fn(inbox()); },
+                Qt::BlockingQueuedConnection);
+            return result;
+        }
+    }
+
+  private:
+    Inbox m_inbox;
+};
+
+#endif // INBOXSERVICE_H
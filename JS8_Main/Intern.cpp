@@ -0,0 +1,100 @@
+#include "Intern.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStringView>
+
+#include <algorithm>
+
+/******************************************************************************/
+// Local Routines
+/******************************************************************************/
+
+namespace {
+// Size below which the table is never pruned.
+
+constexpr qsizetype MinPruneSize = 1024;
+
+struct Table {
+    QMutex mutex;
+    QHash<quint32, QString> names;
+    QHash<QStringView, quint32> ids; // views of the strings in names
+    quint32 next = 0;
+    qsizetype pruneAt = MinPruneSize;
+
+    // Caller must hold the mutex.
+
+    quint32 find(QStringView const string) const {
+        return ids.value(string, Intern::None);
+    }
+
+    quint32 id(QString const &string) {
+        if (auto const it = ids.constFind(string); it != ids.constEnd()) {
+            return *it;
+        }
+
+        if (names.size() >= pruneAt) {
+            prune();
+        }
+
+        auto const id = next++;
+        auto const name = names.insert(id, string);
+        ids.insert(QStringView(*name), id);
+        return id;
+    }
+
+    // Drop the entries whose strings are held nowhere but here; nothing
+    // else can then take a copy, since copies are only handed out under
+    // the mutex.
+
+    void prune() {
+        for (auto it = names.begin(); it != names.end();) {
+            if (it->isDetached()) {
+                ids.remove(QStringView(*it));
+                it = names.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        pruneAt = std::max(MinPruneSize, 2 * names.size());
+    }
+};
+
+Table &table() {
+    static Table table;
+    return table;
+}
+} // namespace
+
+/******************************************************************************/
+// Public Implementation
+/******************************************************************************/
+
+quint32 Intern::id(QString const &string) {
+    auto &t = table();
+    QMutexLocker lock(&t.mutex);
+    return t.id(string);
+}
+
+quint32 Intern::find(QString const &string) {
+    auto &t = table();
+    QMutexLocker lock(&t.mutex);
+    return t.find(string);
+}
+
+QString Intern::name(quint32 const id) {
+    auto &t = table();
+    QMutexLocker lock(&t.mutex);
+    return t.names.value(id);
+}
+
+QString Intern::string(QString const &string) {
+    if (string.isEmpty()) {
+        return string;
+    }
+
+    auto &t = table();
+    QMutexLocker lock(&t.mutex);
+    return t.names.value(t.id(string));
+}
@@ -0,0 +1,43 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <QString>
+
+/**
+ * Application-wide intern table for callsigns and grids.
+ *
+ * The same few hundred callsigns and grids arrive over and over again, in
+ * every decode, and each decode used to bring its own copy of each string,
+ * held onward by every activity and command record built from it. Strings
+ * interned here are instead copies of a single, implicitly shared instance,
+ * and the table hands out a 32-bit id for each, for structures that would
+ * rather hold integers; the string is then materialised from the id only
+ * where it's needed for display or the API.
+ *
+ * An entry lasts only as long as a copy of its string, as returned by
+ * string(), is held outside the table; whenever the table has doubled in
+ * size since it was last pruned, entries that nothing else holds are
+ * dropped. Anything keeping an id must therefore keep the string as well.
+ * Ids are never reused, so an id outliving its entry names nothing, rather
+ * than some other string. Only strings from a bounded vocabulary, such as
+ * callsigns, should be interned; never free text. Thread-safe.
+ **/
+namespace Intern {
+// Id returned by find() for a string that's not in the table.
+inline constexpr quint32 None = 0xffffffff;
+
+// Id of the string, which is added to the table if it's not already there.
+quint32 id(QString const &string);
+
+// Id of the string, or None if it's not in the table; never adds to it.
+quint32 find(QString const &string);
+
+// String having the id; an empty string if there's no such id.
+QString name(quint32 id);
+
+// Canonical instance of the string, sharing its data with every other
+// string interned with the same value.
+QString string(QString const &string);
+} // namespace Intern
+
+#endif // INTERN_H
@@ -0,0 +1,238 @@
+#include "LogWriter.h"
+#include "DriftingDateTime.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QMutexLocker>
+#include <QTimer>
+#include <utility>
+
+Q_DECLARE_LOGGING_CATEGORY(logwriter_js8)
+
+/******************************************************************************/
+// Local Routines
+/******************************************************************************/
+
+namespace {
+// Date, in UTC, of the file's last write, if it exists, today otherwise.
+
+QDate lastWritten(QString const &path) {
+    if (QFileInfo const info(path); info.exists()) {
+        return info.lastModified().toUTC().date();
+    }
+    return DriftingDateTime::currentDateTimeUtc().date();
+}
+
+// Name to which a log last written on the date is moved on rotation,
+// e.g., ALL.TXT, last written on the 1st of June, 2024, becomes
+// ALL-2024-06-01.TXT.
+
+QString rotatedName(QString const &path, QDate const &date) {
+    QFileInfo const info(path);
+    auto const suffix = info.completeSuffix();
+
+    return info.dir().absoluteFilePath(
+        info.baseName() + date.toString(u"-yyyy-MM-dd") +
+        (suffix.isEmpty() ? QString() : u'.' + suffix));
+}
+} // namespace
+
+/******************************************************************************/
+// Private Implementation
+/******************************************************************************/
+
+// Runs in the writer's thread; takes everything queued, in one go, so
+// that the lock is held only long enough to swap the queue out.
+
+void LogWriter::drain() {
+    QList<Request> queue;
+    quint64 dropped;
+    {
+        QMutexLocker lock(&m_mutex);
+        queue.swap(m_queue);
+        dropped = std::exchange(m_dropped, 0);
+    }
+
+    if (dropped) {
+        qCWarning(logwriter_js8) << "Writer behind; dropped" << dropped
+                                 << "log lines";
+    }
+
+    if (queue.isEmpty()) {
+        return;
+    }
+
+    for (auto &request : queue) {
+        if (request.remove) {
+            // Anything buffered was bound for the file being removed,
+            // so goes with it.
+
+            m_handles.erase(request.path);
+            if (QFile::exists(request.path) && !QFile::remove(request.path)) {
+                qCWarning(logwriter_js8)
+                    << "Failed to remove" << request.path;
+            }
+        } else if (auto const h = handle(request.path)) {
+            h->buffer.append(request.line.toUtf8());
+            h->buffer.append('\n');
+            if (h->buffer.size() >= FlushBytes) {
+                write(request.path, *h);
+            }
+        }
+    }
+
+    if (!m_timer) {
+        m_timer = new QTimer(this);
+        m_timer->setSingleShot(true);
+        connect(m_timer, &QTimer::timeout, this, &LogWriter::flush);
+    }
+    if (!m_timer->isActive()) {
+        m_timer->start(FlushInterval);
+    }
+}
+
+void LogWriter::flush() {
+    for (auto &[path, handle] : m_handles) {
+        write(path, handle);
+    }
+}
+
+void LogWriter::write(QString const &path, Handle &handle) {
+    if (handle.buffer.isEmpty()) {
+        return;
+    }
+
+    if (handle.file->write(handle.buffer) != handle.buffer.size() ||
+        !handle.file->flush()) {
+        qCWarning(logwriter_js8) << "Failed to write" << path << ":"
+                                 << handle.file->errorString();
+        emit error(path, handle.file->errorString());
+    }
+    handle.buffer.clear();
+}
+
+// Open handle for the path, opening the file if we don't yet hold it, and
+// rotating it first if that's called for. If the file can't be opened,
+// the failure is reported once, and the open retried on the next line.
+
+LogWriter::Handle *LogWriter::handle(QString const &path) {
+    auto [it, inserted] = m_handles.try_emplace(path);
+    auto &handle = it->second;
+
+    if (inserted || handle.failed) {
+        if (m_rotate) {
+            handle.date = lastWritten(path);
+            rotate(path, handle);
+        }
+
+        handle.file = std::make_unique<QFile>(path);
+        if (!handle.file->open(QIODevice::WriteOnly | QIODevice::Text |
+                               QIODevice::Append)) {
+            if (!std::exchange(handle.failed, true)) {
+                qCWarning(logwriter_js8) << "Failed to open" << path << ":"
+                                         << handle.file->errorString();
+                emit error(path, handle.file->errorString());
+            }
+            return nullptr;
+        }
+        handle.failed = false;
+    } else if (m_rotate) {
+        rotate(path, handle);
+        if (handle.failed) {
+            return nullptr;
+        }
+    }
+
+    return &handle;
+}
+
+// If the date has changed since the file was last written, move it aside
+// under a name carrying that date, and start a new one.
+
+void LogWriter::rotate(QString const &path, Handle &handle) {
+    auto const today = DriftingDateTime::currentDateTimeUtc().date();
+
+    if (handle.date == today) {
+        return;
+    }
+
+    // The file's closed while it's moved; some platforms won't rename a
+    // file that's open.
+
+    auto const open = handle.file && handle.file->isOpen();
+    if (open) {
+        write(path, handle);
+        handle.file->close();
+    }
+
+    if (QFile::exists(path)) {
+        if (auto const rotated = rotatedName(path, handle.date);
+            QFile::exists(rotated) || !QFile::rename(path, rotated)) {
+            qCWarning(logwriter_js8)
+                << "Failed to rotate" << path << "to" << rotated;
+        }
+    }
+
+    if (open && !handle.file->open(QIODevice::WriteOnly | QIODevice::Text |
+                                   QIODevice::Append)) {
+        qCWarning(logwriter_js8) << "Failed to reopen" << path << ":"
+                                 << handle.file->errorString();
+        emit error(path, handle.file->errorString());
+        handle.failed = true;
+    }
+
+    handle.date = today;
+}
+
+/******************************************************************************/
+// Public Implementation
+/******************************************************************************/
+
+LogWriter::LogWriter(QObject *parent)
+    : QObject(parent),
+      m_rotate(qEnvironmentVariableIntValue("JS8_LOG_ROTATE")) {}
+
+// Runs in the writer's thread, on its finish; whatever remains queued is
+// written out, and the files closed, before we go.
+
+LogWriter::~LogWriter() {
+    drain();
+    flush();
+}
+
+// Queue the line for appending to the file at the path; the writer is
+// prodded only when the queue goes from empty to not, so a burst of
+// lines, e.g., a full decode cycle, costs it one wakeup.
+
+void LogWriter::append(QString const &path, QString const &line) {
+    QMutexLocker lock(&m_mutex);
+
+    if (m_queue.size() >= MaxQueued) {
+        ++m_dropped;
+        return;
+    }
+
+    m_queue.append({path, line, false});
+    if (m_queue.size() == 1) {
+        QMetaObject::invokeMethod(this, &LogWriter::drain,
+                                  Qt::QueuedConnection);
+    }
+}
+
+// Queue removal of the file at the path; it's removed in order with the
+// lines queued for it, those before discarded, those after starting anew.
+
+void LogWriter::remove(QString const &path) {
+    QMutexLocker lock(&m_mutex);
+
+    m_queue.append({path, QString(), true});
+    if (m_queue.size() == 1) {
+        QMetaObject::invokeMethod(this, &LogWriter::drain,
+                                  Qt::QueuedConnection);
+    }
+}
+
+/******************************************************************************/
+
+Q_LOGGING_CATEGORY(logwriter_js8, "logwriter.js8", QtWarningMsg)
@@ -0,0 +1,89 @@
+#ifndef LOGWRITER_H
+#define LOGWRITER_H
+
+#include <QByteArray>
+#include <QDate>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <map>
+#include <memory>
+
+class QFile;
+class QTimer;
+
+/**
+ * Appends lines to the text logs, ALL.TXT, DIRECTED.TXT, and the like,
+ * from a thread of its own, so that the GUI thread never waits on a disk.
+ *
+ * Files are held open for append, and lines are batched, written when a
+ * file's buffer fills, after a short interval, or when the writer goes
+ * away; opening, flushing, and closing a file for every line was a source
+ * of both UI hitches and wear on the SD cards many stations run from.
+ *
+ * Lines are queued to the writer without blocking. The queue is bounded;
+ * if the writer falls that far behind, lines are dropped, and counted.
+ *
+ * If the environment variable JS8_LOG_ROTATE is set to a non-zero value,
+ * logs are rotated daily: the first line written on a new UTC day moves
+ * the existing file aside, with the date it was last written to appended
+ * to its base name, e.g., ALL-2024-06-01.TXT.
+ *
+ * Create the writer, move it to its thread, and connect the thread's
+ * finished() signal to its deleteLater() slot; it flushes and closes its
+ * files on destruction.
+ **/
+class LogWriter : public QObject {
+    Q_OBJECT
+
+  public:
+    // Bytes buffered per file before writing, interval in milliseconds
+    // after which buffered lines are written regardless, and most lines
+    // that may be queued awaiting the writer.
+
+    static constexpr qsizetype FlushBytes = 64 * 1024;
+    static constexpr int FlushInterval = 2000;
+    static constexpr qsizetype MaxQueued = 10000;
+
+    explicit LogWriter(QObject *parent = nullptr);
+    ~LogWriter();
+
+    // Thread-safe; may be called from any thread.
+
+    void append(QString const &path, QString const &line);
+    void remove(QString const &path);
+
+  signals:
+    void error(QString const &path, QString const &message);
+
+  private:
+    struct Request {
+        QString path;
+        QString line;
+        bool remove;
+    };
+
+    struct Handle {
+        std::unique_ptr<QFile> file;
+        QByteArray buffer;
+        QDate date;
+        bool failed = false;
+    };
+
+    void drain();
+    void flush();
+    void write(QString const &path, Handle &handle);
+    Handle *handle(QString const &path);
+    void rotate(QString const &path, Handle &handle);
+
+    QMutex m_mutex;
+    QList<Request> m_queue;
+    quint64 m_dropped = 0;
+
+    std::map<QString, Handle> m_handles;
+    QTimer *m_timer = nullptr;
+    bool m_rotate;
+};
+
+#endif // LOGWRITER_H
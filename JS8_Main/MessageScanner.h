@@ -0,0 +1,299 @@
+#ifndef MESSAGE_SCANNER_HPP__
+#define MESSAGE_SCANNER_HPP__
+
+#include <QStringView>
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <string_view>
+
+// Scanners for the directed, heartbeat, and compound message grammars.
+// These run for every transmit preview update, so rather than regular
+// expressions, they're hand-written, matching exactly as the expressions
+// they replace did, captures included, which are returned as views of the
+// text. Character classes are ASCII, as in the expressions.
+//
+//   directed   ^(?<callsign>[@]?[A-Z0-9/]+)<cmd>?<num>?
+//   heartbeat  ^\s*(?<callsign>[@](?:ALLCALL|HB)\s+)?(?<type>...)
+//              (?:\s(?<grid>[A-R]{2}[0-9]{2}))?\b
+//   compound   ^\s*[`](?<callsign>[@]?[A-Z0-9/]+)
+//              (?<extra>(?<grid>\s?[A-R]{2}[0-9]{2})?<cmd>?<num>?)
+//
+// where a command is an optional whitespace character followed by the
+// first of the alternatives below that matches, and a number is an SNR
+// value, valid only directly after "SNR".
+//
+// Nothing here depends on more of Qt than QStringView, so the scanners can
+// be checked against the expressions on their own; see
+// tools/message_scanner_diff.cpp.
+
+namespace MessageScanner {
+// commands, in order of preference, that are complete as they stand
+inline constexpr std::array<std::string_view, 10> CMD_TERMINATED = {
+    "AGN?",    "QSL?",   "HW CPY?", "MSG TO:",     "SNR?",
+    "INFO?",   "GRID?",  "STATUS?", "QUERY MSGS?", "HEARING?"};
+
+// commands, in order of preference, that must be followed by a space or
+// the end of the text
+inline constexpr std::array<std::string_view, 21> CMD_WORDS = {
+    "STATUS", "HEARING", "QUERY CALL", "QUERY MSGS",    "QUERY", "CMD",
+    "MSG",    "NACK",    "ACK",        "73",            "YES",   "NO",
+    "HEARTBEAT SNR",     "SNR",        "QSL",           "RR",    "SK",
+    "FB",     "INFO",    "GRID",       "DIT DIT"};
+
+// heartbeat types, in order of preference
+inline constexpr std::array<std::string_view, 10> HB_TYPES = {
+    "CQ CQ CQ", "CQ DX", "CQ QRP", "CQ CONTEST", "CQ FIELD",
+    "CQ FD",    "CQ CQ", "CQ",     "HB",         "HEARTBEAT"};
+
+inline bool isSpace(QChar const c) {
+    auto const u = c.unicode();
+    return u == ' ' || (u >= '\t' && u <= '\r');
+}
+
+inline bool isDigit(QChar const c) {
+    auto const u = c.unicode();
+    return u >= '0' && u <= '9';
+}
+
+inline bool isUpper(QChar const c, char const last = 'Z') {
+    auto const u = c.unicode();
+    return u >= 'A' && u <= last;
+}
+
+inline bool isWord(QChar const c) {
+    return isDigit(c) || isUpper(c) || (c.unicode() >= 'a' && c.unicode() <= 'z') ||
+           c.unicode() == '_';
+}
+
+inline bool at(QStringView const text, qsizetype const pos, char const c) {
+    return pos < text.size() && text[pos].unicode() == c;
+}
+
+inline bool startsWith(QStringView const text, qsizetype const pos,
+                std::string_view const word) {
+    if (text.size() - pos < static_cast<qsizetype>(word.size())) {
+        return false;
+    }
+    for (qsizetype i = 0; i < static_cast<qsizetype>(word.size()); ++i) {
+        if (text[pos + i].unicode() != static_cast<unsigned char>(word[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// `$`, which matches before a final newline, as well as at the end
+inline bool atEnd(QStringView const text, qsizetype const pos) {
+    return pos == text.size() || (pos == text.size() - 1 && at(text, pos, '\n'));
+}
+
+// `\b`
+inline bool atBoundary(QStringView const text, qsizetype const pos) {
+    bool const before = pos > 0 && isWord(text[pos - 1]);
+    bool const after = pos < text.size() && isWord(text[pos]);
+    return before != after;
+}
+
+inline qsizetype skipSpace(QStringView const text, qsizetype pos) {
+    while (pos < text.size() && isSpace(text[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+// End of the match, or -1 if none, for each of the grammar's elements.
+
+// [@]?[A-Z0-9/]+
+inline qsizetype scanCallsign(QStringView const text, qsizetype pos) {
+    if (at(text, pos, '@')) {
+        ++pos;
+    }
+    auto const start = pos;
+    while (pos < text.size() &&
+           (isUpper(text[pos]) || isDigit(text[pos]) || text[pos] == '/')) {
+        ++pos;
+    }
+    return pos > start ? pos : -1;
+}
+
+// [A-R]{2}[0-9]{2}
+inline qsizetype scanGrid(QStringView const text, qsizetype const pos) {
+    if (text.size() - pos < 4 || !isUpper(text[pos], 'R') ||
+        !isUpper(text[pos + 1], 'R') || !isDigit(text[pos + 2]) ||
+        !isDigit(text[pos + 3])) {
+        return -1;
+    }
+    return pos + 4;
+}
+
+inline qsizetype scanCmdWord(QStringView const text, qsizetype const pos) {
+    for (auto const word : CMD_TERMINATED) {
+        if (startsWith(text, pos, word)) {
+            return pos + word.size();
+        }
+    }
+    for (auto const word : CMD_WORDS) {
+        auto const end = pos + static_cast<qsizetype>(word.size());
+        if (startsWith(text, pos, word) &&
+            (at(text, end, ' ') || atEnd(text, end))) {
+            return end;
+        }
+    }
+    if (at(text, pos, '?') || at(text, pos, '>') || at(text, pos, ' ')) {
+        return pos + 1;
+    }
+    return -1;
+}
+
+// \s?<command>
+inline qsizetype scanCmd(QStringView const text, qsizetype const pos) {
+    if (pos < text.size() && isSpace(text[pos])) {
+        if (auto const end = scanCmdWord(text, pos + 1); end >= 0) {
+            return end;
+        }
+    }
+    return scanCmdWord(text, pos);
+}
+
+// (?<=SNR)\s?[-+]?(?:3[01]|[0-2]?[0-9])
+inline qsizetype scanNum(QStringView const text, qsizetype pos) {
+    if (pos < 3 || !startsWith(text, pos - 3, "SNR")) {
+        return -1;
+    }
+    if (pos < text.size() && isSpace(text[pos])) {
+        ++pos;
+    }
+    if (at(text, pos, '-') || at(text, pos, '+')) {
+        ++pos;
+    }
+    if (pos + 1 < text.size() && isDigit(text[pos + 1]) &&
+        (at(text, pos, '3') ? text[pos + 1].unicode() <= '1'
+                            : text[pos].unicode() >= '0' &&
+                                  text[pos].unicode() <= '2')) {
+        return pos + 2;
+    }
+    if (pos < text.size() && isDigit(text[pos])) {
+        return pos + 1;
+    }
+    return -1;
+}
+
+inline QStringView capture(QStringView const text, qsizetype const begin,
+                    qsizetype const end) {
+    return end >= 0 ? text.sliced(begin, end - begin) : QStringView();
+}
+
+struct DirectedMatch {
+    QStringView callsign;
+    QStringView cmd;
+    QStringView num;
+    qsizetype length;
+};
+
+inline std::optional<DirectedMatch> matchDirected(QStringView const text) {
+    auto const callsign = scanCallsign(text, 0);
+    if (callsign < 0) {
+        return std::nullopt;
+    }
+
+    auto const cmd = scanCmd(text, callsign);
+    auto const numStart = cmd >= 0 ? cmd : callsign;
+    auto const num = scanNum(text, numStart);
+
+    return DirectedMatch{capture(text, 0, callsign),
+                         capture(text, callsign, cmd),
+                         capture(text, numStart, num),
+                         std::max({callsign, cmd, num})};
+}
+
+struct HeartbeatMatch {
+    QStringView type;
+    QStringView grid;
+    qsizetype length;
+};
+
+inline std::optional<HeartbeatMatch> matchHeartbeat(QStringView const text) {
+    auto pos = skipSpace(text, 0);
+
+    if (at(text, pos, '@')) {
+        auto const name = startsWith(text, pos + 1, "ALLCALL") ? 7
+                          : startsWith(text, pos + 1, "HB")    ? 2
+                                                               : 0;
+        auto const end = skipSpace(text, pos + 1 + name);
+        if (!name || end == pos + 1 + name) {
+            return std::nullopt;
+        }
+        pos = end;
+    }
+
+    for (auto const type : HB_TYPES) {
+        if (!startsWith(text, pos, type)) {
+            continue;
+        }
+        auto const end = pos + static_cast<qsizetype>(type.size());
+
+        // HEARTBEAT(?!\s+SNR)
+        if (type == "HEARTBEAT") {
+            auto const next = skipSpace(text, end);
+            if (next > end && startsWith(text, next, "SNR")) {
+                continue;
+            }
+        }
+
+        if (end < text.size() && isSpace(text[end])) {
+            if (auto const grid = scanGrid(text, end + 1);
+                grid >= 0 && atBoundary(text, grid)) {
+                return HeartbeatMatch{capture(text, pos, end),
+                                      capture(text, end + 1, grid), grid};
+            }
+        }
+        if (atBoundary(text, end)) {
+            return HeartbeatMatch{capture(text, pos, end), QStringView(), end};
+        }
+    }
+
+    return std::nullopt;
+}
+
+struct CompoundMatch {
+    QStringView callsign;
+    QStringView grid;
+    QStringView cmd;
+    QStringView num;
+    qsizetype length;
+};
+
+inline std::optional<CompoundMatch> matchCompound(QStringView const text) {
+    auto const start = skipSpace(text, 0);
+    if (!at(text, start, '`')) {
+        return std::nullopt;
+    }
+
+    auto const callsign = scanCallsign(text, start + 1);
+    if (callsign < 0) {
+        return std::nullopt;
+    }
+
+    qsizetype grid = -1;
+    if (callsign < text.size() && isSpace(text[callsign])) {
+        grid = scanGrid(text, callsign + 1);
+    }
+    if (grid < 0) {
+        grid = scanGrid(text, callsign);
+    }
+
+    auto const cmdStart = grid >= 0 ? grid : callsign;
+    auto const cmd = scanCmd(text, cmdStart);
+    auto const numStart = cmd >= 0 ? cmd : cmdStart;
+    auto const num = scanNum(text, numStart);
+
+    return CompoundMatch{capture(text, start + 1, callsign),
+                         capture(text, callsign, grid),
+                         capture(text, cmdStart, cmd),
+                         capture(text, numStart, num),
+                         std::max({callsign, grid, cmd, num})};
+}
+} // namespace MessageScanner
+
+#endif
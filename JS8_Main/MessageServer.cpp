@@ -1,9 +1,48 @@
 #include "MessageServer.h"
+#include <QCborMap>
+#include <QCborValue>
 #include <QLoggingCategory>
+#include <QMetaObject>
+#include <QtEndian>
+#include <algorithm>
 #include <stdexcept>
 Q_DECLARE_LOGGING_CATEGORY(messageserver_js8)
 
-MessageServer::MessageServer(QObject *parent) : QTcpServer(parent) {}
+namespace {
+// Message as a line of JSON.
+
+QByteArray jsonFrame(Message const &message) {
+    auto frame = message.toJson();
+    frame.append('\n');
+    return frame;
+}
+
+// Message as a CBOR map, preceded by its length, big-endian.
+
+QByteArray cborFrame(Message const &message) {
+    auto const cbor =
+        QCborMap::fromJsonObject(message.toJsonObject()).toCborValue().toCbor();
+
+    QByteArray frame(sizeof(quint32), Qt::Uninitialized);
+    qToBigEndian<quint32>(cbor.size(), frame.data());
+    frame.append(cbor);
+    return frame;
+}
+
+QByteArray frameFor(Client const *client, Message const &message) {
+    return client->isCbor() ? cborFrame(message) : jsonFrame(message);
+}
+
+QStringList upper(QStringList list) {
+    for (auto &item : list) {
+        item = item.trimmed().toUpper();
+    }
+    return list;
+}
+} // namespace
+
+MessageServer::MessageServer(QObject *parent)
+    : QTcpServer(parent), m_paused{false}, m_port{0}, m_maxConnections{0} {}
 
 MessageServer::~MessageServer() { stop(); }
 
@@ -96,13 +135,45 @@ void MessageServer::pruneConnections() {
     }
 }
 
+// Messages are sent from the GUI thread, while the server and its clients
+// live on the network thread; the message, implicitly shared, is passed to
+// the network thread, and the clients' filters evaluated there, before
+// any serialisation, which is only done if some client wants it.
+
 void MessageServer::send(const Message &message) {
-    foreach (auto client, m_clients) {
-        if (!client->awaitingResponse(message.id())) {
+    QMetaObject::invokeMethod(this, [this, message]() { write(message); });
+}
+
+void MessageServer::write(Message const &message) {
+    auto const id = message.id();
+
+    QByteArray json;
+    QByteArray cbor;
+
+    for (auto client : m_clients) {
+        if (!client->awaitingResponse(id)) {
             continue;
         }
-        client->send(message);
+        if (id <= 0 && !client->wants(message)) {
+            continue;
+        }
+
+        auto &frame = client->isCbor() ? cbor : json;
+        if (frame.isEmpty()) {
+            frame = frameFor(client, message);
+        }
+        client->write(id, frame);
     }
+
+    // Clients that have gone, or that we've dropped, go too.
+
+    m_clients.removeIf([](Client *const client) {
+        if (client->isConnected()) {
+            return false;
+        }
+        client->deleteLater();
+        return true;
+    });
 }
 
 void MessageServer::incomingConnection(qintptr handle) {
@@ -131,7 +202,7 @@ void MessageServer::incomingConnection(qintptr handle) {
 }
 
 Client::Client(MessageServer *server, QObject *parent)
-    : QObject(parent), m_server{server} {
+    : QObject(parent), m_cbor{false}, m_server{server}, m_socket{nullptr} {
     setConnected(true);
 }
 
@@ -156,6 +227,47 @@ void Client::close() {
 }
 
 void Client::send(const Message &message) {
+    write(message.id(), frameFor(this, message));
+}
+
+bool Client::wants(Message const &message) const {
+    if (!m_types.isEmpty()) {
+        auto const type = message.type();
+
+        if (!m_types.contains(type) &&
+            std::none_of(m_types.begin(), m_types.end(),
+                         [&type](QString const &prefix) {
+                             return prefix.endsWith('.') &&
+                                    type.startsWith(prefix);
+                         })) {
+            return false;
+        }
+    }
+
+    if (!m_calls.isEmpty()) {
+        auto const params = message.params();
+        bool hasCall = false;
+
+        for (auto const key : {"FROM", "TO", "CALL"}) {
+            if (auto const it = params.constFind(key); it != params.cend()) {
+                if (m_calls.contains(it->toString().toUpper())) {
+                    return true;
+                }
+                hasCall = true;
+            }
+        }
+
+        return !hasCall;
+    }
+
+    return true;
+}
+
+// The frame's queued, not flushed; the socket writes whatever's queued when
+// control returns to the event loop, so frames written together leave
+// together.
+
+void Client::write(qint64 const id, QByteArray const &line) {
     if (!isConnected()) {
         return;
     }
@@ -169,15 +281,21 @@ void Client::send(const Message &message) {
         return;
     }
 
-    qCDebug(messageserver_js8) << "client writing" << message.toJson();
-    m_socket->write(message.toJson());
-    m_socket->write("\n");
-    m_socket->flush();
+    if (m_socket->bytesToWrite() + line.size() > MaxQueuedBytes) {
+        qCWarning(messageserver_js8)
+            << "client not reading, dropping it with"
+            << m_socket->bytesToWrite() << "bytes queued";
+        m_socket->abort();
+        m_socket = nullptr;
+        setConnected(false);
+        return;
+    }
+
+    qCDebug(messageserver_js8) << "client writing" << line.trimmed();
+    m_socket->write(line);
 
     // remove if needed
-    if (m_requests.contains(message.id())) {
-        m_requests.remove(message.id());
-    }
+    m_requests.remove(id);
 }
 
 void Client::onDisconnected() {
@@ -199,6 +317,9 @@ void Client::readyRead() {
         try {
             auto m = Message::fromJson(msg);
             m_requests[m.ensureId()] = m;
+            if (subscribe(m)) {
+                continue;
+            }
             emit m_server->message(m);
         } catch (std::exception const &e) {
             send({"API.ERROR", e.what()});
@@ -207,4 +328,55 @@ void Client::readyRead() {
     }
 }
 
+// Handles the subscription commands; returns false if the message isn't one.
+
+bool Client::subscribe(Message const &message) {
+    auto const type = message.type();
+    auto const subscribing = type == "API.SUBSCRIBE";
+
+    if (!subscribing && type != "API.UNSUBSCRIBE") {
+        return false;
+    }
+
+    auto const params = message.params();
+    auto const types = upper(params.value("TYPES").toStringList());
+    auto const calls = upper(params.value("CALLS").toStringList());
+
+    if (subscribing) {
+        if (auto const it = params.constFind("FORMAT"); it != params.cend()) {
+            auto const format = it->toString().toUpper();
+
+            if (format != "JSON" && format != "CBOR") {
+                send(Message("API.ERROR",
+                             QString("Unknown FORMAT %1").arg(format),
+                             {{"_ID", message.id()}}));
+                return true;
+            }
+            m_cbor = format == "CBOR";
+        }
+
+        m_types.unite(QSet<QString>(types.begin(), types.end()));
+        m_calls.unite(QSet<QString>(calls.begin(), calls.end()));
+    } else if (types.isEmpty() && calls.isEmpty()) {
+        m_types.clear();
+        m_calls.clear();
+    } else {
+        m_types.subtract(QSet<QString>(types.begin(), types.end()));
+        m_calls.subtract(QSet<QString>(calls.begin(), calls.end()));
+    }
+
+    auto const sorted = [](QSet<QString> const &set) {
+        auto list = set.values();
+        list.sort();
+        return list;
+    };
+
+    send(Message("API.SUBSCRIPTION", "",
+                 {{"_ID", message.id()},
+                  {"TYPES", sorted(m_types)},
+                  {"CALLS", sorted(m_calls)},
+                  {"FORMAT", m_cbor ? "CBOR" : "JSON"}}));
+    return true;
+}
+
 Q_LOGGING_CATEGORY(messageserver_js8, "messageserver.js8", QtWarningMsg)
@@ -4,6 +4,9 @@
 #include <QAbstractSocket>
 #include <QList>
 #include <QScopedPointer>
+#include <QSet>
+#include <QString>
+#include <QStringList>
 #include <QTcpServer>
 #include <QTcpSocket>
 
@@ -11,6 +14,36 @@
 
 class Client;
 
+/**
+ * Serves the JSON API over TCP, one message per line.
+ *
+ * A message sent is handed to the server's thread, whichever thread sent
+ * it, and there checked against each client's subscription; it's then
+ * serialised once for each framing in use among the clients that want
+ * it, and the same frame handed to each. Frames are queued in each
+ * client's socket, and go out together as the socket's next write; a
+ * client that lets more than MaxQueuedBytes queue up, i.e., that isn't
+ * reading, is disconnected, rather than left to grow the heap.
+ *
+ * Clients manage their subscription with two commands, handled here
+ * rather than passed on:
+ *
+ *   - API.SUBSCRIBE adds the event types in its TYPES parameter, and the
+ *     callsigns in its CALLS parameter, to the client's filters; a type
+ *     ending in '.', e.g., "RX.", stands for every type it begins. Its
+ *     FORMAT parameter, if given, selects the framing of what's sent to
+ *     the client: "JSON", a line of JSON, the default, or "CBOR", a CBOR
+ *     map of the same content, preceded by its length, as four bytes,
+ *     most significant first.
+ *   - API.UNSUBSCRIBE removes the types and callsigns given from the
+ *     filters, or, given neither, clears both.
+ *
+ * Both are answered with API.SUBSCRIPTION, giving the filters and format
+ * then in effect. An empty filter passes everything; the callsign filter
+ * passes events whose FROM, TO, or CALL is among its callsigns, and events
+ * that carry none of them. Responses to a client's own requests aren't
+ * filtered. Requests are always lines of JSON, whatever the format.
+ **/
 class MessageServer : public QTcpServer {
     Q_OBJECT
   public:
@@ -18,6 +51,7 @@ class MessageServer : public QTcpServer {
     virtual ~MessageServer();
 
   protected:
+    void write(Message const &message);
     int activeConnections();
     void pruneConnections();
     void incomingConnection(qintptr handle);
@@ -48,15 +82,20 @@ class MessageServer : public QTcpServer {
 class Client : public QObject {
     Q_OBJECT
   public:
+    static constexpr qint64 MaxQueuedBytes = 4 * 1024 * 1024;
+
     explicit Client(MessageServer *server, QObject *parent = 0);
 
     bool isConnected() const { return m_connected; }
     void setSocket(qintptr handle);
     void send(const Message &message);
+    void write(qint64 id, QByteArray const &line);
     void close();
     bool awaitingResponse(qint64 id) {
         return id <= 0 || m_requests.contains(id);
     }
+    bool wants(Message const &message) const;
+    bool isCbor() const { return m_cbor; }
   signals:
 
   public slots:
@@ -65,7 +104,12 @@ class Client : public QObject {
     void readyRead();
 
   private:
+    bool subscribe(Message const &message);
+
     QMap<qint64, Message> m_requests;
+    QSet<QString> m_types;
+    QSet<QString> m_calls;
+    bool m_cbor;
     MessageServer *m_server;
     QTcpSocket *m_socket;
     bool m_connected;
@@ -0,0 +1,147 @@
+#include "TableRows.h"
+#include <QSet>
+
+/******************************************************************************/
+// Local Routines
+/******************************************************************************/
+
+namespace {
+// Roles an activity table's items carry; fonts are set by the caller, on
+// the items in the table, so aren't among them.
+
+constexpr int ROLES[] = {Qt::DisplayRole,       Qt::ToolTipRole,
+                         Qt::TextAlignmentRole, Qt::BackgroundRole,
+                         Qt::ForegroundRole,    Qt::UserRole};
+} // namespace
+
+/******************************************************************************/
+// Public Implementation
+/******************************************************************************/
+
+TableRows::TableRows(QTableWidget *table)
+    : m_table(table), m_staged(table->columnCount()) {}
+
+TableRows::~TableRows() {
+    if (!m_finished) {
+        finish();
+    }
+}
+
+int TableRows::add() {
+    commit();
+
+    m_staged.resize(m_table->columnCount());
+    m_spanColumn = -1;
+    m_spanColumns = 1;
+
+    return m_count++;
+}
+
+void TableRows::setItem(int const column, QTableWidgetItem *const item) {
+    m_staged[column].reset(item);
+}
+
+QTableWidgetItem *TableRows::item(int const column) {
+    auto &staged = m_staged[column];
+    if (!staged) {
+        staged = std::make_unique<QTableWidgetItem>();
+    }
+    return staged.get();
+}
+
+void TableRows::setSpan(int const column, int const columns) {
+    m_spanColumn = column;
+    m_spanColumns = columns;
+}
+
+void TableRows::select() { m_selected = m_count - 1; }
+
+void TableRows::finish() {
+    commit();
+    m_finished = true;
+
+    if (m_table->rowCount() > m_count) {
+        m_table->setRowCount(m_count);
+    }
+
+    // Leave the selection be if it's already what it should be; clearing
+    // and selecting again would signal a change that isn't one.
+
+    QSet<int> selectedRows;
+    for (auto const item : m_table->selectedItems()) {
+        selectedRows.insert(item->row());
+    }
+
+    if (m_selected < 0 ? selectedRows.isEmpty()
+                       : selectedRows == QSet<int>{m_selected}) {
+        return;
+    }
+
+    m_table->clearSelection();
+
+    if (m_selected >= 0) {
+        for (int column = 0; column < m_table->columnCount(); ++column) {
+            if (auto const item = m_table->item(m_selected, column)) {
+                item->setSelected(true);
+            }
+        }
+    }
+}
+
+/******************************************************************************/
+// Private Implementation
+/******************************************************************************/
+
+// Takes the row staged to the table. A cell staged where the table has no
+// item takes the staged item itself; a cell staged where it does has the
+// staged data copied over, role by role, where it differs, and a cell not
+// staged where the table has an item has the item removed.
+
+void TableRows::commit() {
+    if (m_count == 0) {
+        return;
+    }
+
+    int const row = m_count - 1;
+    int const columns = m_table->columnCount();
+
+    if (row >= m_table->rowCount()) {
+        m_table->insertRow(row);
+    }
+
+    for (int column = 0; column < columns; ++column) {
+        auto &staged = m_staged[column];
+        auto const current = m_table->item(row, column);
+
+        if (!staged) {
+            if (current) {
+                delete m_table->takeItem(row, column);
+            }
+        } else if (!current) {
+            m_table->setItem(row, column, staged.release());
+        } else {
+            for (auto const role : ROLES) {
+                if (auto const value = staged->data(role);
+                    current->data(role) != value) {
+                    current->setData(role, value);
+                }
+            }
+            staged.reset();
+        }
+    }
+
+    // Spans are anchored at their first column; clearing one from left to
+    // right reaches its anchor before any of the cells it covers.
+
+    for (int column = 0; column < columns; ++column) {
+        if (column == m_spanColumn) {
+            if (m_table->columnSpan(row, column) != m_spanColumns) {
+                m_table->setSpan(row, column, 1, m_spanColumns);
+            }
+            break;
+        }
+        if (m_table->columnSpan(row, column) != 1) {
+            m_table->setSpan(row, column, 1, 1);
+        }
+    }
+}
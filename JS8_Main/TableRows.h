@@ -0,0 +1,82 @@
+#ifndef TABLEROWS_H
+#define TABLEROWS_H
+
+#include <QTableWidget>
+#include <QTableWidgetItem>
+#include <memory>
+#include <vector>
+
+/**
+ * Brings the rows of a table widget into line with those computed afresh
+ * on each refresh, changing only what differs.
+ *
+ * The activity tables were formerly emptied with setRowCount(0) and every
+ * item built again on each refresh; on a busy band, that's hundreds of
+ * rows removed and inserted, each a full relayout of the view, most of
+ * them to show what was already shown. Rows are instead staged here, one
+ * at a time, as free-standing items, and committed to the table row by
+ * row; an item already in the table at that position takes on the staged
+ * item's data, which the item compares and signals only if it changed,
+ * and rows are inserted or removed only at the end of the table, as its
+ * length changes.
+ *
+ * Fonts are left to the caller, which sets them on the table's items once
+ * all rows are committed; the selection is reapplied only if the row to
+ * be selected isn't already the one that is.
+ *
+ * Usage: call add() to start each row, item() or setItem() to stage its
+ * cells, and finish() once the last row is staged; if it's not called,
+ * destruction does so.
+ **/
+class TableRows {
+  public:
+    explicit TableRows(QTableWidget *table);
+    ~TableRows();
+
+    // Commits the row being staged, if any, and starts the next; returns
+    // its index in the table.
+
+    int add();
+
+    // Stages the item as the cell at the column of the current row, and
+    // takes ownership of it.
+
+    void setItem(int column, QTableWidgetItem *item);
+
+    // Staged item at the column of the current row, created if not yet
+    // staged.
+
+    QTableWidgetItem *item(int column);
+
+    // The current row spans the columns given, from the column given.
+
+    void setSpan(int column, int columns);
+
+    // The current row is to be the table's selected row.
+
+    void select();
+
+    QTableWidget *table() const { return m_table; }
+
+    // Number of rows added so far.
+
+    int count() const { return m_count; }
+
+    // Commits the last row, removes any rows beyond it, and applies the
+    // selection.
+
+    void finish();
+
+  private:
+    void commit();
+
+    QTableWidget *m_table;
+    std::vector<std::unique_ptr<QTableWidgetItem>> m_staged;
+    int m_count = 0;
+    int m_spanColumn = -1;
+    int m_spanColumns = 1;
+    int m_selected = -1;
+    bool m_finished = false;
+};
+
+#endif // TABLEROWS_H
@@ -127,10 +127,36 @@ QSize CPlotter::minimumSizeHint() const { return QSize(50, 50); }
 QSize CPlotter::sizeHint() const { return QSize(180, 180); }
 
 void CPlotter::paintEvent(QPaintEvent *) {
+    // If spectrum data has changed since we last painted, render it now;
+    // multiple rows of data arriving between paints cost a single render.
+
+    if (m_spectrumDirty)
+        drawSpectrum();
+
     QPainter p(this);
 
     p.drawPixmap(0, 0, m_ScalePixmap);
-    p.drawPixmap(0, 30, m_WaterfallPixmap);
+
+    // The waterfall image is circular; the most recent row lives at the
+    // top index, so draw from there to the end of the image, and then
+    // from the start of the image up to the top index, beneath it.
+
+    if (!m_WaterfallImage.isNull()) {
+        auto const dpr = m_WaterfallImage.devicePixelRatio();
+        auto const width = m_WaterfallImage.width();
+        auto const height = m_WaterfallImage.height();
+        auto const split = height - m_waterfallTop;
+
+        p.drawImage(QRectF(0, 30, width / dpr, split / dpr), m_WaterfallImage,
+                    QRectF(0, m_waterfallTop, width, split));
+
+        if (m_waterfallTop > 0) {
+            p.drawImage(
+                QRectF(0, 30 + split / dpr, width / dpr, m_waterfallTop / dpr),
+                m_WaterfallImage, QRectF(0, 0, width, m_waterfallTop));
+        }
+    }
+
     p.drawPixmap(0, m_h1, m_SpectrumPixmap);
 
     p.drawPixmap(xFromFreq(m_freq), 30, m_DialPixmap[0]);
@@ -148,43 +174,111 @@ void CPlotter::paintEvent(QPaintEvent *) {
 
 void CPlotter::resizeEvent(QResizeEvent *) { m_resizeTimer->start(); }
 
-void CPlotter::drawLine(QString const &text) {
-    m_WaterfallPixmap.scroll(0, 1, m_WaterfallPixmap.rect());
+// Paint into the waterfall image using logical coordinates relative to the
+// most recent row, i.e., as if the image were not circular. We accomplish
+// that by painting twice, once translated to the top index, and once more
+// translated a full image height above it; in each pass, whatever falls
+// outside of the image is clipped, so between them the two passes cover
+// any painting that straddles the wrap point.
+
+template <typename Paint> void CPlotter::paintWaterfall(Paint &&paint) {
+    if (m_WaterfallImage.isNull())
+        return;
+
+    QPainter p(&m_WaterfallImage);
+
+    auto const dpr = m_WaterfallImage.devicePixelRatio();
+    auto const top = m_waterfallTop / dpr;
+
+    p.save();
+    p.translate(0, top);
+    paint(p);
+    p.restore();
+
+    if (m_waterfallTop > 0) {
+        p.translate(0, top - m_WaterfallImage.height() / dpr);
+        paint(p);
+    }
+}
+
+// Move the top of the circular waterfall image back by one device pixel
+// row, wrapping if required, and return the index of the row, which is
+// now the most recent one.
 
-    QPainter p(&m_WaterfallPixmap);
+int CPlotter::nextRow() {
+    if (--m_waterfallTop < 0)
+        m_waterfallTop = m_WaterfallImage.height() - 1;
+
+    return m_waterfallTop;
+}
+
+// Rasterize a row of waterfall data directly into a scanline of the
+// waterfall image. We do this in two simple passes that the compiler
+// is able to vectorize; the first maps dB values to palette indices,
+// the second maps indices to colors, expanding to device pixels in
+// the event that we're on a high-DPI display. Anything to the right
+// of the data is painted black.
+
+void CPlotter::drawRow(int const row, WF::SWide const &data) {
+    auto const width = m_WaterfallImage.width();
+    auto const count =
+        std::min(m_w, static_cast<int>(std::min(data.size(), m_indices.size())));
+    auto const line = reinterpret_cast<QRgb *>(m_WaterfallImage.scanLine(row));
+    auto const black = qRgb(0, 0, 0);
+
+    std::transform(data.begin(), data.begin() + count, m_indices.begin(),
+                   [&scaler = std::as_const(m_scaler1D)](float const value) {
+                       return static_cast<std::uint8_t>(scaler(value));
+                   });
+
+    if (width == m_w) {
+        std::transform(m_indices.begin(), m_indices.begin() + count, line,
+                       [&palette = std::as_const(m_palette)](auto const index) {
+                           return palette[index];
+                       });
+        std::fill(line + count, line + width, black);
+    } else {
+        for (auto x = 0; x < width; ++x) {
+            auto const index = static_cast<int>(qint64(x) * m_w / width);
+            line[x] = index < count ? m_palette[m_indices[index]] : black;
+        }
+    }
+}
+
+void CPlotter::drawLine(QString const &text) {
+    if (m_WaterfallImage.isNull())
+        return;
 
     // Draw a green line across the complete span.
 
-    p.setPen(Qt::green);
-    p.drawLine(0, 0, m_w, 0);
+    auto const line =
+        reinterpret_cast<QRgb *>(m_WaterfallImage.scanLine(nextRow()));
+
+    std::fill(line, line + m_WaterfallImage.width(), qRgb(0, 255, 0));
 
     // Compute the number of lines required before we need to draw the
     // text, and note the text to draw, saving it against a potential
     // replot request.
 
     m_text = text;
-    m_line = p.fontMetrics().height() * devicePixelRatio();
+    m_line = fontMetrics().height() * devicePixelRatio();
     m_replot.push_front(m_text);
 
     update();
 }
 
 void CPlotter::drawData(WF::SWide swide, WF::State const state) {
-    m_WaterfallPixmap.scroll(0, 1, m_WaterfallPixmap.rect());
+    if (m_WaterfallImage.isNull())
+        return;
 
     // Flattening, we just process the visible width; tends to be the best
     // approach in terms of what happens when resizing to a larger size.
 
-    m_flatten(swide.data(), m_w);
+    m_flatten(swide.data(), std::min(m_w, static_cast<int>(swide.size())));
 
     // Display the data in the waterfall, drawing only the displayed range.
 
-    QPainter p(&m_WaterfallPixmap);
-
-    for (auto x = 0; x < m_w; ++x) {
-        p.setPen(m_colors[m_scaler1D(swide[x])]);
-        p.drawPoint(x, 0);
-    }
+    drawRow(nextRow(), swide);
 
     // See if we've reached the point where we should draw previously computed
     // line text.
@@ -192,20 +286,18 @@ void CPlotter::drawData(WF::SWide swide, WF::State const state) {
     if (--m_line == 0) {
         m_line = std::numeric_limits<int>::max();
 
-        p.setPen(Qt::white);
-        p.drawText(5, p.fontMetrics().ascent(), m_text);
+        paintWaterfall([this](QPainter &p) {
+            p.setPen(Qt::white);
+            p.drawText(5, p.fontMetrics().ascent(), m_text);
+        });
     }
 
-    // A number of factors determine whether or not we should draw the spectrum.
+    // A number of factors determine whether or not we should draw the
+    // spectrum. If we should, compute the points of the spectrum line
+    // now, but defer drawing them until we're painted; the spectrum is
+    // redrawn only when it's changed, and at most once per paint.
 
     if (shouldDrawSpectrum(state)) {
-        // We draw the spectrum by copying the overlay prototype and drawing our
-        // points into it.
-
-        m_SpectrumPixmap = m_OverlayPixmap.copy();
-
-        QPainter p(&m_SpectrumPixmap);
-
         // Add a point to the polyline.
 
         auto const addPoint = [this](int const x, float const y) {
@@ -248,7 +340,7 @@ void CPlotter::drawData(WF::SWide swide, WF::State const state) {
             // the delta above that value.
 
         case Spectrum::Current: {
-            p.setPen(Qt::green);
+            m_spectrumPen = QPen(Qt::green);
 
             auto const min =
                 *std::min_element(swide.begin(), swide.begin() + m_w);
@@ -261,7 +353,7 @@ void CPlotter::drawData(WF::SWide swide, WF::State const state) {
             // data, which is power scaled and must be converted to dB scale.
 
         case Spectrum::Cumulative: {
-            p.setPen(Qt::cyan);
+            m_spectrumPen = QPen(Qt::cyan);
             addPoints(std::begin(specData.savg), [](auto const value) {
                 return 30.0f + 10.0f * std::log10(value);
             });
@@ -271,26 +363,17 @@ void CPlotter::drawData(WF::SWide swide, WF::State const state) {
             // the precomputed linear average data.
 
         case Spectrum::LinearAvg: {
-            p.setPen(Qt::yellow);
+            m_spectrumPen = QPen(Qt::yellow);
             addPoints(std::begin(specData.slin),
                       [](auto const value) { return value; });
         } break;
         }
 
-        // Draw the spectrum line, reducing the resulting points prior to
-        // drawing them, but keeping the collection capacity. We also work
-        // around what seems to be a performance bug in all versions of Qt
-        // up to and including 6.8, when drawing large polylines; this was
-        // culled from the Qwt library's workaround for the issue. Doubles
-        // overall program performance, pretty much.
+        // Reduce the resulting points prior to drawing them, but keep the
+        // collection capacity.
 
         m_points.erase(m_rdp(m_points), m_points.end());
-        p.setRenderHint(QPainter::Antialiasing);
-
-        for (qsizetype i = 0; i < m_points.size(); i += POLYLINE_SIZE) {
-            p.drawPolyline(m_points.data() + i,
-                           qMin(POLYLINE_SIZE + 1, m_points.size() - i));
-        }
+        m_spectrumDirty = true;
     }
 
     // Save the data against a potential replot requirement.
@@ -300,24 +383,49 @@ void CPlotter::drawData(WF::SWide swide, WF::State const state) {
     update();
 }
 
+// Draw the spectrum line, by blitting the overlay prototype into the
+// spectrum pixmap and drawing our points on top of it. We work around
+// what seems to be a performance bug in all versions of Qt up to and
+// including 6.8, when drawing large polylines; this was culled from the
+// Qwt library's workaround for the issue. Doubles overall program
+// performance, pretty much.
+
+void CPlotter::drawSpectrum() {
+    m_spectrumDirty = false;
+
+    if (m_SpectrumPixmap.isNull() || m_OverlayPixmap.isNull())
+        return;
+
+    QPainter p(&m_SpectrumPixmap);
+
+    p.drawPixmap(0, 0, m_OverlayPixmap);
+    p.setPen(m_spectrumPen);
+    p.setRenderHint(QPainter::Antialiasing);
+
+    for (qsizetype i = 0; i < m_points.size(); i += POLYLINE_SIZE) {
+        p.drawPolyline(m_points.data() + i,
+                       qMin(POLYLINE_SIZE + 1, m_points.size() - i));
+    }
+}
+
 void CPlotter::drawDecodeLine(QColor const &color, int const ia, int const ib) {
     auto const x1 = xFromFreq(ia);
     auto const x2 = xFromFreq(ib);
 
-    QPainter p(&m_WaterfallPixmap);
-
-    p.setPen(color);
-    p.drawLine(qMin(x1, x2), 4, qMax(x1, x2), 4);
-    p.drawLine(qMin(x1, x2), 0, qMin(x1, x2), 9);
-    p.drawLine(qMax(x1, x2), 0, qMax(x1, x2), 9);
+    paintWaterfall([&color, x1, x2](QPainter &p) {
+        p.setPen(color);
+        p.drawLine(qMin(x1, x2), 4, qMax(x1, x2), 4);
+        p.drawLine(qMin(x1, x2), 0, qMin(x1, x2), 9);
+        p.drawLine(qMax(x1, x2), 0, qMax(x1, x2), 9);
+    });
 }
 
 void CPlotter::drawHorizontalLine(QColor const &color, int const x,
                                   int const width) {
-    QPainter p(&m_WaterfallPixmap);
-
-    p.setPen(color);
-    p.drawLine(x, 0, width <= 0 ? m_w : x + width, 0);
+    paintWaterfall([this, &color, x, width](QPainter &p) {
+        p.setPen(color);
+        p.drawLine(x, 0, width <= 0 ? m_w : x + width, 0);
+    });
 }
 
 void CPlotter::drawMetrics() {
@@ -450,6 +558,11 @@ void CPlotter::drawMetrics() {
             auto const y = static_cast<int>(i * ppdH);
             p.drawLine(0, y, m_w, y);
         }
+
+        // The spectrum is drawn on top of the overlay, so it must be
+        // redrawn the next time we're painted.
+
+        m_spectrumDirty = true;
     }
 }
 
@@ -531,75 +644,67 @@ void CPlotter::drawDials() {
 // buffer, if any.
 
 void CPlotter::replot() {
-    if (m_WaterfallPixmap.isNull())
+    if (m_WaterfallImage.isNull())
         return;
 
-    // Whack anything currently in the waterfall pixmap; we must do this
-    // before attaching a painter.
+    // Whack anything currently in the waterfall image, and reset the top
+    // of the circular image to the first row; the replot buffer has the
+    // most recent entry first, so the rows will be in their natural order.
 
-    m_WaterfallPixmap.fill(Qt::black);
-
-    // We need to consider that entries have been added to the replot
-    // buffer at a rate proportional to the display pixel ratio, i.e.,
-    // it deals in device pixels, not logical pixels, so we must deal
-    // with scaling in the y dimension for this to work out.
-
-    QPainter p(&m_WaterfallPixmap);
-
-    p.scale(1, 1 / m_WaterfallPixmap.devicePixelRatio());
+    m_WaterfallImage.fill(Qt::black);
+    m_waterfallTop = 0;
 
     // Our draw routine pushed entries to the front of the buffer, so we
     // can iterate in forward order here, the Qt coordinate system having
-    // (0, 0) as the upper-left point.
+    // (0, 0) as the upper-left point. The replot buffer deals in device
+    // pixel rows, as does the image, so we can rasterize the waterfall
+    // data directly, noting any lines we'll need to paint afterward.
 
+    auto const height = m_WaterfallImage.height();
+    auto const green = qRgb(0, 255, 0);
     auto y = 0;
 
+    QVector<std::pair<int, QString const *>> lines;
+
     for (auto &&v : m_replot) {
-        std::visit(
-            [ratio = m_WaterfallPixmap.devicePixelRatio(),
-             width = m_WaterfallPixmap.size().width(),
-             extra = p.fontMetrics().descent(), &y = std::as_const(y),
-             &colors = std::as_const(m_colors),
-             &scaler = std::as_const(m_scaler1D), &p](auto const &v) {
-                // Note that a monostate is constructed as the default when we
-                // resize but have no backing data. There is nothing to in that
-                // case; just data that we didn't have when we were resized.
-
-                using T = std::decay_t<decltype(v)>;
-
-                // Line drawing; draw the usual green line across the width of
-                // the pixmap, annotated by the text provided.
-
-                if constexpr (std::is_same_v<T, QString>) {
-                    p.setPen(Qt::white);
-                    p.save();
-                    p.scale(1, ratio);
-                    p.drawText(5, y / ratio - extra, v);
-                    p.restore();
-                    p.setPen(Qt::green);
-                    p.drawLine(0, y, width, y);
-                }
+        if (y >= height)
+            break;
+
+        // Note that a monostate is constructed as the default when we resize
+        // but have no backing data. There is nothing to in that case; just
+        // data that we didn't have when we were resized.
+
+        if (auto const data = std::get_if<WF::SWide>(&v)) {
+            drawRow(y, *data);
+        } else if (auto const text = std::get_if<QString>(&v)) {
+            auto const line =
+                reinterpret_cast<QRgb *>(m_WaterfallImage.scanLine(y));
+            std::fill(line, line + m_WaterfallImage.width(), green);
+            lines.emplace_back(y, text);
+        }
 
-                // Standard waterfall data display; run through the vector of
-                // data and color each corresponding point in the pixmap
-                // appropriately.
+        y++;
+    }
 
-                else if constexpr (std::is_same_v<T, WF::SWide>) {
-                    auto const end =
-                        std::min(width, static_cast<int>(v.size()));
+    // Annotate the lines with their text. We need to consider that entries
+    // have been added to the replot buffer at a rate proportional to the
+    // display pixel ratio, i.e., it deals in device pixels, not logical
+    // pixels, so we must deal with scaling in the y dimension.
 
-                    for (auto x = 0; x < end; ++x) {
-                        p.setPen(colors[scaler(v[x])]);
-                        p.drawPoint(x, y);
-                    }
-                }
-            },
-            v);
+    if (!lines.isEmpty()) {
+        QPainter p(&m_WaterfallImage);
 
-        y++;
+        auto const ratio = m_WaterfallImage.devicePixelRatio();
+        auto const extra = p.fontMetrics().descent();
+
+        p.setPen(Qt::white);
+
+        for (auto const &[y, text] : lines) {
+            p.drawText(5, y / ratio - extra, *text);
+        }
     }
 
-    // The waterfall pixmap should now look as it did before, but with the
+    // The waterfall image should now look as it did before, but with the
     // current zero, gain, and color palette applied; schedule a repaint.
 
     update();
@@ -631,16 +736,29 @@ void CPlotter::resize() {
         // pixelated.
 
         m_ScalePixmap = makePixmap({m_w, 30}, Qt::white);
-        m_WaterfallPixmap = makePixmap({m_w, m_h1}, Qt::black);
         m_OverlayPixmap = makePixmap({m_w, m_h2}, Qt::black);
 
+        // The waterfall image is rasterized directly, one row of device
+        // pixels at a time, in a format that's cheap to blit.
+
+        if (auto const size = QSize(m_w, m_h1) * devicePixelRatio();
+            size.isEmpty()) {
+            m_WaterfallImage = QImage();
+        } else {
+            m_WaterfallImage = QImage(size, QImage::Format_RGB32);
+            m_WaterfallImage.setDevicePixelRatio(devicePixelRatio());
+            m_WaterfallImage.fill(Qt::black);
+        }
+
+        m_waterfallTop = 0;
+
         // The replot circular buffer should have capacity to hold the full
-        // height of the waterfall pixmap, in device, not logical, pixels.
+        // height of the waterfall image, in device, not logical, pixels.
         // Since our variant lists std::monostate as the first alternative,
         // if we get larger here, the added items will be constructed using
         // std::monostate as the alternative.
 
-        m_replot.resize(m_WaterfallPixmap.size().height());
+        m_replot.resize(m_WaterfallImage.height());
 
         // Ensure the 2D scaler is working with the current spectrum height.
 
@@ -654,10 +772,11 @@ void CPlotter::resize() {
         drawMetrics();
 
         // The overlay pixmap acts as a prototype for the spectrum pixmap;
-        // each time we draw the spectrum, we do so by first making a copy
-        // of the overlay, then drawing the spectrum line into it.
+        // each time we draw the spectrum, we do so by first blitting the
+        // overlay into it, then drawing the spectrum line on top.
 
         m_SpectrumPixmap = m_OverlayPixmap.copy();
+        m_spectrumDirty = !m_points.isEmpty();
 
         replot();
     }
@@ -739,6 +858,12 @@ void CPlotter::setBinsPerPixel(int const binsPerPixel) {
 void CPlotter::setColors(Colors const &colors) {
     if (m_colors != colors) {
         m_colors = colors;
+        m_palette.fill(qRgb(0, 0, 0));
+        std::transform(m_colors.begin(),
+                       m_colors.begin() + std::min(m_colors.size(),
+                                                   qsizetype(m_palette.size())),
+                       m_palette.begin(),
+                       [](QColor const &color) { return color.rgb(); });
         replot();
     }
 }
@@ -12,6 +12,8 @@
 #include "RDP.h"
 #include "WF.h"
 #include <QColor>
+#include <QImage>
+#include <QPen>
 #include <QPixmap>
 #include <QPolygonF>
 #include <QSize>
@@ -23,6 +25,7 @@
 #include <array>
 #include <boost/circular_buffer.hpp>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 #include <variant>
 
@@ -193,9 +196,14 @@ class CPlotter final : public QWidget {
     void drawMetrics();
     void drawFilter();
     void drawDials();
+    void drawRow(int, WF::SWide const &);
+    void drawSpectrum();
+    int nextRow();
     void replot();
     void resize();
 
+    template <typename Paint> void paintWaterfall(Paint &&);
+
     // Data members ** ORDER DEPENDENCY **
 
     float m_dialFreq = 0.0f;
@@ -222,13 +230,25 @@ class CPlotter final : public QWidget {
     Colors m_colors;
     Replot m_replot;
     QPolygonF m_points;
+    QPen m_spectrumPen;
+    bool m_spectrumDirty = false;
     Flatten m_flatten;
     Spectrum m_spectrum = Spectrum::Current;
     QTimer *m_replotTimer;
     QTimer *m_resizeTimer;
 
+    // The waterfall is a circular image; rather than scrolling memory
+    // each time a row arrives, we move the top row index backwards and
+    // write the new row there, drawing the image in two pieces around
+    // the wrap point. The palette is the color table in QRgb form, and
+    // the index buffer holds the scaled palette indices for a row.
+
+    QImage m_WaterfallImage;
+    int m_waterfallTop = 0;
+    std::array<QRgb, 256> m_palette = {};
+    std::array<std::uint8_t, WF::MaxScreenWidth> m_indices = {};
+
     QPixmap m_ScalePixmap;
-    QPixmap m_WaterfallPixmap;
     QPixmap m_OverlayPixmap;
     QPixmap m_SpectrumPixmap;
 
@@ -18,7 +18,12 @@
  *
  **/
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
 #include <stdexcept>
+#include <string_view>
 
 #include <boost/format.hpp>
 
@@ -31,6 +36,8 @@
 #include <vendor/CRCpp/CRC.h>
 
 #include "JS8_Mode/DecodedText.h"
+#include "JS8_Main/Huffman.h"
+#include "JS8_Main/MessageScanner.h"
 #include "JS8_jsc/jsc.h"
 #include "varicode.h"
 
@@ -149,79 +156,6 @@ QSet<int> snr_cmds = {25, 29};
 QMap<int, int> checksum_cmds = {{5, 16},  {9, 16},  {10, 16}, {11, 16},
                                 {12, 16}, {13, 16}, {15, 0},  {24, 16}};
 
-QString callsign_pattern = QString("(?<callsign>[@]?[A-Z0-9/]+)");
-QString optional_cmd_pattern =
-    QString("(?<cmd>\\s?(?:AGN[?]|QSL[?]|HW CPY[?]|MSG "
-            "TO[:]|SNR[?]|INFO[?]|GRID[?]|STATUS[?]|QUERY "
-            "MSGS[?]|HEARING[?]|(?:(?:STATUS|HEARING|QUERY CALL|QUERY "
-            "MSGS|QUERY|CMD|MSG|NACK|ACK|73|YES|NO|HEARTBEAT "
-            "SNR|SNR|QSL|RR|SK|FB|INFO|GRID|DIT DIT)(?=[ ]|$))|[?> ]))?");
-QString optional_grid_pattern = QString("(?<grid>\\s?[A-R]{2}[0-9]{2})?");
-QString optional_extended_grid_pattern =
-    QString("^(?<grid>\\s?(?:[A-R]{2}[0-9]{2}(?:[A-X]{2}(?:[0-9]{2})?)*))?");
-QString optional_num_pattern =
-    QString("(?<num>(?<=SNR)\\s?[-+]?(?:3[01]|[0-2]?[0-9]))?");
-
-QRegularExpression directed_re("^" + callsign_pattern + optional_cmd_pattern +
-                               optional_num_pattern);
-
-QRegularExpression heartbeat_re(
-    R"(^\s*(?<callsign>[@](?:ALLCALL|HB)\s+)?(?<type>CQ CQ CQ|CQ DX|CQ QRP|CQ CONTEST|CQ FIELD|CQ FD|CQ CQ|CQ|HB|HEARTBEAT(?!\s+SNR))(?:\s(?<grid>[A-R]{2}[0-9]{2}))?\b)");
-
-QRegularExpression
-    compound_re("^\\s*[`]" + callsign_pattern + "(?<extra>" +
-                optional_grid_pattern + // there's a reason this is first (see:
-                                        // buildMessageFrames)
-                optional_cmd_pattern + optional_num_pattern + ")");
-
-QMap<QString, QString> hufftable = {
-    // char   code                 weight
-    {" ", "01"},       // 1.0
-    {"E", "100"},      // 0.5
-    {"T", "1101"},     // 0.333333333333
-    {"A", "0011"},     // 0.25
-    {"O", "11111"},    // 0.2
-    {"I", "11100"},    // 0.166666666667
-    {"N", "10111"},    // 0.142857142857
-    {"S", "10100"},    // 0.125
-    {"H", "00011"},    // 0.111111111111
-    {"R", "00000"},    // 0.1
-    {"D", "111011"},   // 0.0909090909091
-    {"L", "110011"},   // 0.0833333333333
-    {"C", "110001"},   // 0.0769230769231
-    {"U", "101101"},   // 0.0714285714286
-    {"M", "101011"},   // 0.0666666666667
-    {"W", "001011"},   // 0.0625
-    {"F", "001001"},   // 0.0588235294118
-    {"G", "000101"},   // 0.0555555555556
-    {"Y", "000011"},   // 0.0526315789474
-    {"P", "1111011"},  // 0.05
-    {"B", "1111001"},  // 0.047619047619
-    {".", "1110100"},  // 0.0434782608696
-    {"V", "1100101"},  // 0.0416666666667
-    {"K", "1100100"},  // 0.04
-    {"-", "1100001"},  // 0.0384615384615
-    {"+", "1100000"},  // 0.037037037037
-    {"?", "1011001"},  // 0.0344827586207
-    {"!", "1011000"},  // 0.0333333333333
-    {"\"", "1010101"}, // 0.0322580645161
-    {"X", "1010100"},  // 0.03125
-    {"0", "0010101"},  // 0.030303030303
-    {"J", "0010100"},  // 0.0294117647059
-    {"1", "0010001"},  // 0.0285714285714
-    {"Q", "0010000"},  // 0.0277777777778
-    {"2", "0001001"},  // 0.027027027027
-    {"Z", "0001000"},  // 0.0263157894737
-    {"3", "0000101"},  // 0.025641025641
-    {"5", "0000100"},  // 0.025
-    {"4", "11110101"}, // 0.0243902439024
-    {"9", "11110100"}, // 0.0238095238095
-    {"8", "11110001"}, // 0.0232558139535
-    {"6", "11110000"}, // 0.0227272727273
-    {"7", "11101011"}, // 0.0222222222222
-    {"/", "11101010"}, // 0.0217391304348
-};
-
 QChar ESC = '\\';   // Escape char
 QChar EOT = '\x04'; // EOT char
 
@@ -410,10 +344,10 @@ QString Varicode::unescape(const QString &text) {
     QString unescaped(text);
 #if JS8_USE_ESCAPE_SUB_CHAR
     static const int size = 5;
-    QRegularExpression r("([\\x1A][0-9a-fA-F]{4})");
+    static QRegularExpression const r("([\\x1A][0-9a-fA-F]{4})");
 #else
     static const int size = 6;
-    QRegularExpression r("(([uU][+]|\\\\[uU])[0-9a-fA-F]{4})");
+    static QRegularExpression const r("(([uU][+]|\\\\[uU])[0-9a-fA-F]{4})");
 #endif
     qsizetype pos = 0;
     QRegularExpressionMatch match;
@@ -450,8 +384,6 @@ QString Varicode::lstrip(const QString &str) {
 /*
  * VARICODE
  */
-QMap<QString, QString> Varicode::defaultHuffTable() { return hufftable; }
-
 QString Varicode::cqString(int number) {
     if (!cqs.contains(number)) {
         return QString{};
@@ -532,7 +464,8 @@ bool Varicode::checksum32Valid(QString const &checksum, QString const &input) {
 
 QStringList Varicode::parseCallsigns(QString const &input) {
     QStringList callsigns;
-    QRegularExpression re(compound_callsign_pattern);
+    static QRegularExpression const re(compound_callsign_pattern);
+    static QRegularExpression const m(grid_pattern);
     QRegularExpressionMatchIterator iter = re.globalMatch(input);
     while (iter.hasNext()) {
         QRegularExpressionMatch match = iter.next();
@@ -543,7 +476,6 @@ QStringList Varicode::parseCallsigns(QString const &input) {
         if (!Varicode::isValidCallsign(callsign, nullptr)) {
             continue;
         }
-        QRegularExpression m(grid_pattern);
         if (m.match(callsign).hasMatch()) {
             continue;
         }
@@ -554,7 +486,7 @@ QStringList Varicode::parseCallsigns(QString const &input) {
 
 QStringList Varicode::parseGrids(const QString &input) {
     QStringList grids;
-    QRegularExpression re(grid_pattern);
+    static QRegularExpression const re(grid_pattern);
     QRegularExpressionMatchIterator iter = re.globalMatch(input);
     while (iter.hasNext()) {
         QRegularExpressionMatch match = iter.next();
@@ -570,148 +502,29 @@ QStringList Varicode::parseGrids(const QString &input) {
     return grids;
 }
 
-QList<QPair<int, QVector<bool>>>
-Varicode::huffEncode(const QMap<QString, QString> &huff, QString const &text) {
-    QList<QPair<int, QVector<bool>>> out;
-
-    int i = 0;
-
-    auto keys = huff.keys();
-    std::sort(keys.begin(), keys.end(), [](QString const &a, QString const &b) {
-        auto alen = a.length();
-        auto blen = b.length();
-        if (blen < alen) {
-            return true;
-        }
-        if (alen < blen) {
-            return false;
-        }
-
-        return b < a;
+bool Varicode::huffEncodable(QString const &text) {
+    return std::all_of(text.begin(), text.end(), [](QChar const ch) {
+        return Huffman::code(ch.toUpper().unicode()).length != 0;
     });
+}
 
-    while (i < text.length()) {
-        bool found = false;
-        foreach (auto ch, keys) {
-            if (QStringView(text.begin() + i, text.end()).startsWith(ch)) {
-                out.append({ch.length(), Varicode::strToBits(huff[ch])});
-                i += ch.length();
-                found = true;
-                break;
-            }
-        }
-
-        if (!found) {
-            i++;
-        }
-    }
-
-    return out;
+int Varicode::huffEncode(QString const &text, BitBuffer &bits,
+                         int const limit) {
+    return Huffman::encode({QStringView(text).utf16(),
+                            static_cast<std::size_t>(text.size())},
+                           bits, limit);
 }
 
-QString Varicode::huffDecode(QMap<QString, QString> const &huff,
-                             QVector<bool> const &bitvec) {
+QString Varicode::huffDecode(BitBuffer const &bits) {
     QString text;
 
-    QString bits = Varicode::bitsToStr(bitvec);
-
-    // TODO: jsherer - this is naive...
-    while (bits.length() > 0) {
-        bool found = false;
-        foreach (auto key, huff.keys()) {
-            if (bits.startsWith(huff[key])) {
-                if (key == EOT) {
-                    text.append(" ");
-                    found = false;
-                    break;
-                }
-                text.append(key);
-                bits = bits.mid(huff[key].length());
-                found = true;
-            }
-        }
-        if (!found) {
-            break;
-        }
-    }
+    Huffman::decode(bits, [&text](char const ch) {
+        text.append(QLatin1Char(ch));
+    });
 
     return text;
 }
 
-QSet<QString> Varicode::huffValidChars(const QMap<QString, QString> &huff) {
-    auto const keys = huff.keys();
-    return QSet<QString>(keys.begin(), keys.end());
-}
-
-// convert char* array of 0 bytes and 1 bytes to bool vector
-QVector<bool> Varicode::bytesToBits(char *bitvec, int n) {
-    QVector<bool> bits;
-    for (int i = 0; i < n; i++) {
-        bits.append(bitvec[i] == 0x01);
-    }
-    return bits;
-}
-
-// convert string of 0s and 1s to bool vector
-QVector<bool> Varicode::strToBits(QString const &bitvec) {
-    QVector<bool> bits;
-    foreach (auto ch, bitvec) {
-        bits.append(ch == '1');
-    }
-    return bits;
-}
-
-QString Varicode::bitsToStr(QVector<bool> const &bitvec) {
-    QString bits;
-    foreach (auto bit, bitvec) {
-        bits.append(bit ? "1" : "0");
-    }
-    return bits;
-}
-
-QVector<bool> Varicode::intToBits(quint64 value, int expected) {
-    QVector<bool> bits;
-
-    while (value) {
-        bits.prepend((bool)(value & 1));
-        value = value >> 1;
-    }
-
-    if (expected) {
-        while (bits.count() < expected) {
-            bits.prepend((bool)0);
-        }
-    }
-
-    return bits;
-}
-
-quint64 Varicode::bitsToInt(QVector<bool> const value) {
-    quint64 v = 0;
-    foreach (bool bit, value) {
-        v = (v << 1) + (int)(bit);
-    }
-    return v;
-}
-
-quint64 Varicode::bitsToInt(QVector<bool>::ConstIterator start, int n) {
-    quint64 v = 0;
-    for (int i = 0; i < n; i++) {
-        int bit = (int)(*start);
-        v = (v << 1) + (int)(bit);
-        start++;
-    }
-    return v;
-}
-
-QVector<bool> Varicode::bitsListToBits(QList<QVector<bool>> &list) {
-    QVector<bool> out;
-    foreach (auto vec, list) {
-        out += vec;
-    }
-    return out;
-}
-
 quint8 Varicode::unpack5bits(QString const &value) {
     return alphabet.indexOf(value.at(0));
 }
@@ -828,8 +641,8 @@ QString Varicode::pack72bits(quint64 value, quint8 rem) {
 // 21 bits for the data + 1 bit for a flag indicator
 // giving us a total of 5.5 bits per character
 quint32 Varicode::packAlphaNumeric22(QString const &value, bool isFlag) {
-    QString word =
-        QString(value).replace(QRegularExpression("[^A-Z0-9/ ]"), "");
+    static QRegularExpression const invalid("[^A-Z0-9/ ]");
+    QString word = QString(value).replace(invalid, "");
     if (word.length() < 4) {
         word = word + QString(" ").repeated(4 - word.length());
     }
@@ -881,8 +694,8 @@ QString Varicode::unpackAlphaNumeric22(quint32 packed, bool *isFlag) {
 //
 // giving us a total of 4.5-5.55 bits per character
 quint64 Varicode::packAlphaNumeric50(QString const &value) {
-    QString word =
-        QString(value).replace(QRegularExpression("[^A-Z0-9 /@]"), "");
+    static QRegularExpression const invalid("[^A-Z0-9 /@]");
+    QString word = QString(value).replace(invalid, "");
     if (word.length() > 3 && word.at(3) != '/') {
         word.insert(3, ' ');
     }
@@ -1025,7 +838,7 @@ quint32 Varicode::packCallsign(QString const &value, bool *pPortable) {
     }
 
     QString matched;
-    QRegularExpression m(pack_callsign_pattern);
+    static QRegularExpression const m(pack_callsign_pattern);
     foreach (auto permutation, permutations) {
         auto match = m.match(permutation);
         if (match.hasMatch()) {
@@ -1293,7 +1106,9 @@ bool isValidCompoundCallsign(QStringView callsign) {
         return true;
     }
 
-    if (callsign.length() > 2 && QRegularExpression("[0-9][A-Z]|[A-Z][0-9]")
+    static QRegularExpression const alphanumeric("[0-9][A-Z]|[A-Z][0-9]");
+
+    if (callsign.length() > 2 && alphanumeric
 #if (QT_VERSION < QT_VERSION_CHECK(6, 5, 0))
                                      .match(callsign)
 #else
@@ -1313,17 +1128,18 @@ bool Varicode::isValidCallsign(const QString &callsign, bool *pIsCompound) {
         return true;
     }
 
-    auto match = QRegularExpression(base_callsign_pattern).match(callsign);
+    static QRegularExpression const base(base_callsign_pattern);
+    static QRegularExpression const compound("^" + compound_callsign_pattern);
+    static QRegularExpression const alphanumeric("[0-9][A-Z]|[A-Z][0-9]");
+
+    auto match = base.match(callsign);
     if (match.hasMatch() && (match.capturedLength() == callsign.length())) {
         if (pIsCompound)
             *pIsCompound = false;
-        return callsign.length() > 2 &&
-               QRegularExpression("[0-9][A-Z]|[A-Z][0-9]")
-                   .match(callsign)
-                   .hasMatch();
+        return callsign.length() > 2 && alphanumeric.match(callsign).hasMatch();
     }
 
-    match = QRegularExpression("^" + compound_callsign_pattern).match(callsign);
+    match = compound.match(callsign);
 
     if (match.hasMatch() && (match.capturedLength() == callsign.length())) {
         bool isValid = isValidCompoundCallsign(match.capturedView(0));
@@ -1343,12 +1159,15 @@ bool Varicode::isCompoundCallsign(const QString &callsign) {
         return false;
     }
 
-    auto match = QRegularExpression(base_callsign_pattern).match(callsign);
+    static QRegularExpression const base(base_callsign_pattern);
+    static QRegularExpression const compound("^" + compound_callsign_pattern);
+
+    auto match = base.match(callsign);
     if (match.hasMatch() && (match.capturedLength() == callsign.length())) {
         return false;
     }
 
-    match = QRegularExpression("^" + compound_callsign_pattern).match(callsign);
+    match = compound.match(callsign);
     if (!match.hasMatch() || (match.capturedLength() != callsign.length())) {
         return false;
     }
@@ -1377,21 +1196,21 @@ QString Varicode::packHeartbeatMessage(QString const &text,
                                        const QString &callsign, int *n) {
     QString frame;
 
-    auto parsedText = heartbeat_re.match(text);
-    if (!parsedText.hasMatch()) {
+    auto const parsedText = MessageScanner::matchHeartbeat(text);
+    if (!parsedText) {
         if (n)
             *n = 0;
         return frame;
     }
 
-    auto extra = parsedText.captured("grid");
+    auto extra = parsedText->grid.toString();
 
     // Heartbeat Alt Type
     // ---------------
     // 1      0   HB
     // 1      1   CQ
 
-    auto type = parsedText.captured("type");
+    auto type = parsedText->type.toString();
     auto isAlt = type.startsWith("CQ");
 
     if (callsign.isEmpty()) {
@@ -1401,8 +1220,7 @@ QString Varicode::packHeartbeatMessage(QString const &text,
     }
 
     quint16 packed_extra = nmaxgrid; // which will display an empty string
-    if (extra.length() == 4 &&
-        QRegularExpression(grid_pattern).match(extra).hasMatch()) {
+    if (extra.length() == 4) {
         packed_extra = Varicode::packGrid(extra);
     }
 
@@ -1422,7 +1240,7 @@ QString Varicode::packHeartbeatMessage(QString const &text,
     }
 
     if (n)
-        *n = parsedText.captured(0).length();
+        *n = parsedText->length;
     return frame;
 }
 
@@ -1456,20 +1274,20 @@ QString Varicode::packCompoundMessage(QString const &text, int *n) {
     QString frame;
 
     qCDebug(varicode_js8) << "trying to pack compound message" << text;
-    auto parsedText = compound_re.match(text);
-    if (!parsedText.hasMatch()) {
+    auto const parsedText = MessageScanner::matchCompound(text);
+    if (!parsedText) {
         qCDebug(varicode_js8) << "no match for compound message" << text;
         if (n)
             *n = 0;
         return frame;
     }
 
-    qCDebug(varicode_js8) << parsedText.capturedTexts();
+    QString callsign = parsedText->callsign.toString();
+    QString grid = parsedText->grid.toString();
+    QString cmd = parsedText->cmd.toString();
+    QString num = parsedText->num.trimmed().toString();
 
-    QString callsign = parsedText.captured("callsign");
-    QString grid = parsedText.captured("grid");
-    QString cmd = parsedText.captured("cmd");
-    QString num = parsedText.captured("num").trimmed();
+    qCDebug(varicode_js8) << callsign << grid << cmd << num;
 
     if (callsign.isEmpty()) {
         if (n)
@@ -1499,7 +1317,7 @@ QString Varicode::packCompoundMessage(QString const &text, int *n) {
     frame = Varicode::packCompoundFrame(callsign, type, extra, 0);
 
     if (n)
-        *n = parsedText.captured(0).length();
+        *n = parsedText->length;
     return frame;
 }
 
@@ -1562,11 +1380,12 @@ QString Varicode::packCompoundFrame(const QString &callsign, quint8 type,
     quint8 packed_8 = (packed_5 << 3) | bits3;
 
     // [3][50][11],[5][3] = 72
-    auto bits = (Varicode::intToBits(packed_flag, 3) +
-                 Varicode::intToBits(packed_callsign, 50) +
-                 Varicode::intToBits(packed_11, 11));
+    BitBuffer bits;
+    bits.append(packed_flag, 3);
+    bits.append(packed_callsign, 50);
+    bits.append(packed_11, 11);
 
-    return Varicode::pack72bits(Varicode::bitsToInt(bits), packed_8);
+    return Varicode::pack72bits(bits.field(0, 64), packed_8);
 }
 
 QStringList Varicode::unpackCompoundFrame(const QString &text, quint8 *pType,
@@ -1579,13 +1398,13 @@ QStringList Varicode::unpackCompoundFrame(const QString &text, quint8 *pType,
 
     // [3][50][11],[5][3] = 72
     quint8 packed_8 = 0;
-    auto bits =
-        Varicode::intToBits(Varicode::unpack72bits(text, &packed_8), 64);
+    BitBuffer bits;
+    bits.append(Varicode::unpack72bits(text, &packed_8), 64);
 
     quint8 packed_5 = packed_8 >> 3;
     quint8 packed_3 = packed_8 & ((1 << 3) - 1);
 
-    quint8 packed_flag = Varicode::bitsToInt(bits.mid(0, 3));
+    quint8 packed_flag = bits.field(0, 3);
 
     // needs to be a ping type...
     if (packed_flag == Varicode::FrameData ||
@@ -1593,8 +1412,8 @@ QStringList Varicode::unpackCompoundFrame(const QString &text, quint8 *pType,
         return unpacked;
     }
 
-    quint64 packed_callsign = Varicode::bitsToInt(bits.mid(3, 50));
-    quint16 packed_11 = Varicode::bitsToInt(bits.mid(53, 11));
+    quint64 packed_callsign = bits.field(3, 50);
+    quint16 packed_11 = bits.field(53, 11);
 
     QString callsign = Varicode::unpackAlphaNumeric50(packed_callsign);
 
@@ -1623,8 +1442,8 @@ QString Varicode::packDirectedMessage(const QString &text,
                                       QString *pNum, int *n) {
     QString frame;
 
-    auto match = directed_re.match(text);
-    if (!match.hasMatch()) {
+    auto const match = MessageScanner::matchDirected(text);
+    if (!match) {
         if (n)
             *n = 0;
         return frame;
@@ -1635,9 +1454,9 @@ QString Varicode::packDirectedMessage(const QString &text,
     if (isFromCompound) {
         from = "<....>";
     }
-    QString to = match.captured("callsign");
-    QString cmd = match.captured("cmd");
-    QString num = match.captured("num");
+    QString to = match->callsign.toString();
+    QString cmd = match->cmd.toString();
+    QString num = match->num.toString();
 
     // ensure we have a directed command
     if (cmd.isEmpty()) {
@@ -1716,16 +1535,17 @@ QString Varicode::packDirectedMessage(const QString &text,
         ((((int)portable_from) << 7) + (((int)portable_to) << 6) + inum);
 
     // [3][28][28][5],[2][6] = 72
-    auto bits = (Varicode::intToBits(packed_flag, 3) +
-                 Varicode::intToBits(packed_from, 28) +
-                 Varicode::intToBits(packed_to, 28) +
-                 Varicode::intToBits(packed_cmd % 32, 5));
+    BitBuffer bits;
+    bits.append(packed_flag, 3);
+    bits.append(packed_from, 28);
+    bits.append(packed_to, 28);
+    bits.append(packed_cmd % 32, 5);
 
     if (pCmd)
         *pCmd = cmdOut;
     if (n)
-        *n = match.captured(0).length();
-    return Varicode::pack72bits(Varicode::bitsToInt(bits), packed_extra);
+        *n = match->length;
+    return Varicode::pack72bits(bits.field(0, 64), packed_extra);
 }
 
 QStringList Varicode::unpackDirectedMessage(const QString &text,
@@ -1738,16 +1558,17 @@ QStringList Varicode::unpackDirectedMessage(const QString &text,
 
     // [3][28][22][11],[2][6] = 72
     quint8 extra = 0;
-    auto bits = Varicode::intToBits(Varicode::unpack72bits(text, &extra), 64);
+    BitBuffer bits;
+    bits.append(Varicode::unpack72bits(text, &extra), 64);
 
-    quint8 packed_flag = Varicode::bitsToInt(bits.mid(0, 3));
+    quint8 packed_flag = bits.field(0, 3);
     if (packed_flag != Varicode::FrameDirected) {
         return unpacked;
     }
 
-    quint32 packed_from = Varicode::bitsToInt(bits.mid(3, 28));
-    quint32 packed_to = Varicode::bitsToInt(bits.mid(31, 28));
-    quint8 packed_cmd = Varicode::bitsToInt(bits.mid(59, 5));
+    quint32 packed_from = bits.field(3, 28);
+    quint32 packed_to = bits.field(31, 28);
+    quint8 packed_cmd = bits.field(59, 5);
 
     bool portable_from = ((extra >> 7) & 1) == 1;
     bool portable_to = ((extra >> 6) & 1) == 1;
@@ -1774,7 +1595,7 @@ QStringList Varicode::unpackDirectedMessage(const QString &text,
     return unpacked;
 }
 
-QString packHuffMessage(const QString &input, const QVector<bool> prefix,
+QString packHuffMessage(const QString &input, BitBuffer const &prefix,
                         int *n) {
     static const int frameSize = 72;
 
@@ -1786,54 +1607,34 @@ QString packHuffMessage(const QString &input, const QVector<bool> prefix,
     // we can drop the two zeros and use them for encoding the first two bits of
     // the actuall data sent. boom! The second bit is a flag that indicates this
     // is not compressed frame (huffman coding)
-    QVector<bool> frameBits;
-    if (!prefix.isEmpty()) {
-        frameBits << prefix;
-    }
-
-    int i = 0;
+    BitBuffer frameBits = prefix;
 
     // only pack huff messages that only contain valid chars
-    QString::const_iterator it;
-    QSet<QString> validChars =
-        Varicode::huffValidChars(Varicode::defaultHuffTable());
-    for (it = input.constBegin(); it != input.constEnd(); it++) {
-        auto ch = (*it).toUpper();
-        if (!validChars.contains(ch)) {
-            if (n)
-                *n = 0;
-            return frame;
-        }
+    if (!Varicode::huffEncodable(input)) {
+        if (n)
+            *n = 0;
+        return frame;
     }
 
-    // pack using the default huff table
-    foreach (auto pair,
-             Varicode::huffEncode(Varicode::defaultHuffTable(), input)) {
-        auto charN = pair.first;
-        auto charBits = pair.second;
-        if (frameBits.length() + charBits.length() < frameSize) {
-            frameBits += charBits;
-            i += charN;
-            continue;
-        }
-        break;
-    }
+    // pack using the default huff table, leaving at least one bit for
+    // the padding marker
+    int const i = Varicode::huffEncode(input, frameBits, frameSize);
 
-    qCDebug(varicode_js8) << "Huff bits" << frameBits.length() << "chars" << i;
+    qCDebug(varicode_js8) << "Huff bits" << frameBits.size() << "chars" << i;
 
-    int pad = frameSize - frameBits.length();
+    int pad = frameSize - frameBits.size();
     if (pad) {
         // the way we will pad is this...
         // set the bit after the frame to 0 and every bit after that a 1
         // to unpad, seek from the end of the bits until you hit a zero... the
         // rest is the actual frame.
         for (int i = 0; i < pad; i++) {
-            frameBits.append(i == 0 ? (bool)0 : (bool)1);
+            frameBits.append(i != 0);
         }
     }
 
-    quint64 value = Varicode::bitsToInt(frameBits.constBegin(), 64);
-    quint8 rem = (quint8)Varicode::bitsToInt(frameBits.constBegin() + 64, 8);
+    quint64 value = frameBits.field(0, 64);
+    quint8 rem = frameBits.field(64, 8);
     frame = Varicode::pack72bits(value, rem);
 
     if (n)
@@ -1842,7 +1643,7 @@ QString packHuffMessage(const QString &input, const QVector<bool> prefix,
     return frame;
 }
 
-QString packCompressedMessage(const QString &input, QVector<bool> prefix,
+QString packCompressedMessage(const QString &input, BitBuffer const &prefix,
                               int *n) {
     static const int frameSize = 72;
 
@@ -1855,17 +1656,14 @@ QString packCompressedMessage(const QString &input, QVector<bool> prefix,
     // the actuall data sent. boom! The second bit is a flag that indicates this
     // is a compressed frame (dense coding) For fast modes, we don't use the
     // prefix since it is indicated by the JS8CallData flag.
-    QVector<bool> frameBits;
-    if (!prefix.isEmpty()) {
-        frameBits << prefix;
-    }
+    BitBuffer frameBits = prefix;
 
     int i = 0;
     foreach (auto pair, JSC::compress(input)) {
         auto bits = pair.first;
         auto chars = pair.second;
 
-        if (frameBits.length() + bits.length() < frameSize) {
+        if (frameBits.size() + bits.size() < frameSize) {
             frameBits.append(bits);
             i += chars;
             continue;
@@ -1874,22 +1672,22 @@ QString packCompressedMessage(const QString &input, QVector<bool> prefix,
         break;
     }
 
-    qCDebug(varicode_js8) << "Compressed bits" << frameBits.length() << "chars"
+    qCDebug(varicode_js8) << "Compressed bits" << frameBits.size() << "chars"
                           << i;
 
-    int pad = frameSize - frameBits.length();
+    int pad = frameSize - frameBits.size();
     if (pad) {
         // the way we will pad is this...
         // set the bit after the frame to 0 and every bit after that a 1
         // to unpad, seek from the end of the bits until you hit a zero... the
         // rest is the actual frame.
         for (int i = 0; i < pad; i++) {
-            frameBits.append(i == 0 ? (bool)0 : (bool)1);
+            frameBits.append(i != 0);
         }
     }
 
-    quint64 value = Varicode::bitsToInt(frameBits.constBegin(), 64);
-    quint8 rem = (quint8)Varicode::bitsToInt(frameBits.constBegin() + 64, 8);
+    quint64 value = frameBits.field(0, 64);
+    quint8 rem = frameBits.field(64, 8);
     frame = Varicode::pack72bits(value, rem);
 
     if (n)
@@ -1933,7 +1731,9 @@ QString Varicode::unpackDataMessage(const QString &text) {
 
     quint8 rem = 0;
     quint64 value = Varicode::unpack72bits(text, &rem);
-    auto bits = Varicode::intToBits(value, 64) + Varicode::intToBits(rem, 8);
+    BitBuffer bits;
+    bits.append(value, 64);
+    bits.append(rem, 8);
 
     bool isData = bits.at(0);
     if (!isData) {
@@ -1953,7 +1753,7 @@ QString Varicode::unpackDataMessage(const QString &text) {
         unpacked = JSC::decompress(bits);
     } else {
         // huff decode the bits (without escapes)
-        unpacked = Varicode::huffDecode(Varicode::defaultHuffTable(), bits);
+        unpacked = Varicode::huffDecode(bits);
     }
 
     return unpacked;
@@ -2004,7 +1804,9 @@ QString Varicode::unpackFastDataMessage(const QString &text) {
 
     quint8 rem = 0;
     quint64 value = Varicode::unpack72bits(text, &rem);
-    auto bits = Varicode::intToBits(value, 64) + Varicode::intToBits(rem, 8);
+    BitBuffer bits;
+    bits.append(value, 64);
+    bits.append(rem, 8);
 
 #if JS8_FAST_DATA_CAN_USE_HUFF
     bool compressed = bits.at(0);
@@ -2018,7 +1820,7 @@ QString Varicode::unpackFastDataMessage(const QString &text) {
         unpacked = JSC::decompress(bits);
     } else {
         // huff decode the bits (without escapes)
-        unpacked = Varicode::huffDecode(Varicode::defaultHuffTable(), bits);
+        unpacked = Varicode::huffDecode(bits);
     }
 #else
     int n = bits.lastIndexOf(0);
@@ -5,6 +5,7 @@
  * (C) 2018 Jordan Sherer <kn4crd@gmail.com> - All Rights Reserved
  **/
 
+#include "JS8_Main/BitBuffer.h"
 #include <QBitArray>
 #include <QRegularExpression>
 #include <QString>
@@ -85,7 +86,6 @@ class Varicode {
     static QString rstrip(const QString &str);
     static QString lstrip(const QString &str);
 
-    static QMap<QString, QString> defaultHuffTable();
     static QString cqString(int number);
     static QString hbString(int number);
     static bool startsWithCQ(QString text);
@@ -102,20 +102,9 @@ class Varicode {
     static QStringList parseCallsigns(QString const &input);
     static QStringList parseGrids(QString const &input);
 
-    static QList<QPair<int, QVector<bool>>>
-    huffEncode(const QMap<QString, QString> &huff, QString const &text);
-    static QString huffDecode(const QMap<QString, QString> &huff,
-                              QVector<bool> const &bitvec);
-    static QSet<QString> huffValidChars(const QMap<QString, QString> &huff);
-
-    static QVector<bool> bytesToBits(char *bitvec, int n);
-    static QVector<bool> strToBits(QString const &bitvec);
-    static QString bitsToStr(QVector<bool> const &bitvec);
-
-    static QVector<bool> intToBits(quint64 value, int expected = 0);
-    static quint64 bitsToInt(QVector<bool> const value);
-    static quint64 bitsToInt(QVector<bool>::ConstIterator start, int n);
-    static QVector<bool> bitsListToBits(QList<QVector<bool>> &list);
+    static bool huffEncodable(QString const &text);
+    static int huffEncode(QString const &text, BitBuffer &bits, int limit);
+    static QString huffDecode(BitBuffer const &bits);
 
     static quint8 unpack5bits(QString const &value);
     static QString pack5bits(quint8 packed);
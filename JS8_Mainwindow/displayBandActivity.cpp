@@ -30,8 +30,8 @@ void MainWindow::displayBandActivity() {
         auto const currentScrollPos =
             ui->tableWidgetRXAll->verticalScrollBar()->value();
 
-        // Clear the table
-        ui->tableWidgetRXAll->setRowCount(0);
+        // Rows are staged, and committed over those already in the table
+        TableRows rows(ui->tableWidgetRXAll);
 
         // Sort!
         auto const sort = getSortByReverse("bandActivity", "offset");
@@ -152,7 +152,8 @@ void MainWindow::displayBandActivity() {
 
                     // hide aged items
                     if (!isOffsetSelected && activityAging &&
-                        item.utcTimestamp.secsTo(now) / 60 >= activityAging) {
+                        utcDateTime(item.utcTimestamp).secsTo(now) / 60 >=
+                            activityAging) {
                         shouldDisplay = false;
                     }
 
@@ -211,7 +212,7 @@ void MainWindow::displayBandActivity() {
                     text.append(item.text);
                     snr = item.snr;
                     age = since(item.utcTimestamp);
-                    timestamp = item.utcTimestamp;
+                    timestamp = utcDateTime(item.utcTimestamp);
                     tdrift = item.tdrift;
                     submode = item.submode;
                 }
@@ -221,21 +222,19 @@ void MainWindow::displayBandActivity() {
                     continue;
                 }
 
-                ui->tableWidgetRXAll->insertRow(
-                    ui->tableWidgetRXAll->rowCount());
-                int row = ui->tableWidgetRXAll->rowCount() - 1;
+                rows.add();
                 int col = 0;
 
                 auto offsetItem = new QTableWidgetItem(
                     QString(columnLabel("%1 Hz")).arg(offset));
                 offsetItem->setData(Qt::UserRole, QVariant(offset));
                 offsetItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-                ui->tableWidgetRXAll->setItem(row, col++, offsetItem);
+                rows.setItem(col++, offsetItem);
 
                 auto ageItem = new QTableWidgetItem(age);
                 ageItem->setTextAlignment(Qt::AlignCenter);
                 ageItem->setToolTip(timestamp.toString());
-                ui->tableWidgetRXAll->setItem(row, col++, ageItem);
+                rows.setItem(col++, ageItem);
 
                 auto snrText = Varicode::formatSNR(snr);
                 auto snrItem = new QTableWidgetItem(
@@ -243,13 +242,13 @@ void MainWindow::displayBandActivity() {
                         ? ""
                         : QString(columnLabel("%1 dB")).arg(snrText));
                 snrItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-                ui->tableWidgetRXAll->setItem(row, col++, snrItem);
+                rows.setItem(col++, snrItem);
 
                 auto tdriftItem = new QTableWidgetItem(
                     QString(columnLabel("%1 ms")).arg((int)(1000 * tdrift)));
                 tdriftItem->setData(Qt::UserRole, QVariant(tdrift));
                 tdriftItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-                ui->tableWidgetRXAll->setItem(row, col++, tdriftItem);
+                rows.setItem(col++, tdriftItem);
 
                 auto name = JS8::Submode::name(submode);
                 auto submodeItem =
@@ -257,7 +256,7 @@ void MainWindow::displayBandActivity() {
                 submodeItem->setToolTip(name);
                 submodeItem->setData(Qt::UserRole, QVariant(name));
                 submodeItem->setTextAlignment(Qt::AlignCenter);
-                ui->tableWidgetRXAll->setItem(row, col++, submodeItem);
+                rows.setItem(col++, submodeItem);
 
                 // align right if eliding...
                 int colWidth = ui->tableWidgetRXAll->columnWidth(3);
@@ -278,13 +277,10 @@ void MainWindow::displayBandActivity() {
                 }
                 textItem->setTextAlignment(flag);
 
-                ui->tableWidgetRXAll->setItem(row, col++, textItem);
+                rows.setItem(col++, textItem);
 
                 if (isOffsetSelected) {
-                    for (int i = 0; i < ui->tableWidgetRXAll->columnCount();
-                         i++) {
-                        ui->tableWidgetRXAll->item(row, i)->setSelected(true);
-                    }
+                    rows.select();
                 }
 
                 bool isDirectedAllCall = false;
@@ -293,7 +289,7 @@ void MainWindow::displayBandActivity() {
                     isMyCallIncluded(text.last())) {
                     for (int i = 0; i < ui->tableWidgetRXAll->columnCount();
                          i++) {
-                        ui->tableWidgetRXAll->item(row, i)->setBackground(
+                        rows.item(i)->setBackground(
                             QBrush(m_config.color_MyCall()));
                     }
                 }
@@ -306,7 +302,7 @@ void MainWindow::displayBandActivity() {
                     if (words.contains("CQ")) {
                         for (int i = 0; i < ui->tableWidgetRXAll->columnCount();
                              i++) {
-                            ui->tableWidgetRXAll->item(row, i)->setBackground(
+                            rows.item(i)->setBackground(
                                 QBrush(m_config.color_CQ()));
                         }
                     }
@@ -316,7 +312,7 @@ void MainWindow::displayBandActivity() {
                     if (!matchingSecondaryWords.isEmpty()) {
                         for (int i = 0; i < ui->tableWidgetRXAll->columnCount();
                              i++) {
-                            ui->tableWidgetRXAll->item(row, i)->setBackground(
+                            rows.item(i)->setBackground(
                                 QBrush(m_config.color_secondary_highlight()));
                         }
                     }
@@ -326,7 +322,7 @@ void MainWindow::displayBandActivity() {
                     if (!matchingPrimaryWords.isEmpty()) {
                         for (int i = 0; i < ui->tableWidgetRXAll->columnCount();
                              i++) {
-                            ui->tableWidgetRXAll->item(row, i)->setBackground(
+                            rows.item(i)->setBackground(
                                 QBrush(m_config.color_primary_highlight()));
                         }
                     }
@@ -334,6 +330,8 @@ void MainWindow::displayBandActivity() {
             }
         }
 
+        rows.finish();
+
         // Set table color
         auto style = QString(
             "QTableWidget { background:%1; selection-background-color:%2; "
@@ -342,7 +340,10 @@ void MainWindow::displayBandActivity() {
         style = style.arg(m_config.color_table_background().name());
         style = style.arg(m_config.color_table_highlight().name());
         style = style.arg(m_config.color_table_foreground().name());
-        ui->tableWidgetRXAll->setStyleSheet(style);
+        // Setting a style sheet repolishes the table, even if unchanged
+        if (ui->tableWidgetRXAll->styleSheet() != style) {
+            ui->tableWidgetRXAll->setStyleSheet(style);
+        }
 
         // Set the table palette for inactive selected row
         auto p = ui->tableWidgetRXAll->palette();
@@ -25,14 +25,14 @@ void MainWindow::displayCallActivity() {
 
     ui->tableWidgetCalls->setUpdatesEnabled(false);
     {
-        // Clear the table
-        ui->tableWidgetCalls->setRowCount(0);
+        // Rows are staged, and committed over those already in the table
+        TableRows rows(ui->tableWidgetCalls);
         ui->tableWidgetCalls->horizontalHeaderItem(8)->setText(
             m_config.miles() ? "mi" : "km");
 
         bool showIconColumn = false;
         createGroupCallsignTableRows(
-            ui->tableWidgetCalls, selectedCall,
+            rows, selectedCall,
             showIconColumn); // isAllCallIncluded(selectedCall)); // ||
         // isGroupCallIncluded(selectedCall));
 
@@ -202,19 +202,19 @@ void MainWindow::displayCallActivity() {
             bool hasMessage = m_rxInboxCountCache.value(d.call, 0) > 0;
 
             // display telephone icon if called cq in the past 5 minutes
-            bool hasCQ =
-                d.cqTimestamp.isValid() && d.cqTimestamp.secsTo(now) / 60 < 5;
+            bool hasCQ = d.cqTimestamp != 0 &&
+                         utcDateTime(d.cqTimestamp).secsTo(now) / 60 < 5;
 
             // display star if they've acked a message from us
-            bool hasACK = d.ackTimestamp.isValid();
+            bool hasACK = d.ackTimestamp != 0;
 
             if (!isCallSelected && !hasMessage && callsignAging &&
-                d.utcTimestamp.secsTo(now) / 60 >= callsignAging) {
+                utcDateTime(d.utcTimestamp).secsTo(now) / 60 >=
+                    callsignAging) {
                 continue;
             }
 
-            ui->tableWidgetCalls->insertRow(ui->tableWidgetCalls->rowCount());
-            int row = ui->tableWidgetCalls->rowCount() - 1;
+            rows.add();
             int col = 0;
 
 #if SHOW_THROUGH_CALLS
@@ -242,7 +242,7 @@ void MainWindow::displayCallActivity() {
                     ? QString("Heard Through Relay (%1)").arg(d.through)
                     : "");
             iconItem->setTextAlignment(Qt::AlignCenter);
-            ui->tableWidgetCalls->setItem(row, col++, iconItem);
+            rows.setItem(col++, iconItem);
             if (hasMessage || hasACK || hasCQ || hasThrough) {
                 showIconColumn = true;
             }
@@ -250,17 +250,17 @@ void MainWindow::displayCallActivity() {
             auto displayItem = new QTableWidgetItem(displayCall);
             displayItem->setData(Qt::UserRole, QVariant(d.call));
             displayItem->setToolTip(generateCallDetail(displayCall));
-            ui->tableWidgetCalls->setItem(row, col++, displayItem);
+            rows.setItem(col++, displayItem);
 
 #if ONLY_SHOW_HEARD_CALLSIGNS
-            if (d.utcTimestamp.isValid()) {
+            if (d.utcTimestamp != 0) {
 #else
             if (true) {
 #endif
                 auto ageItem = new QTableWidgetItem(since(d.utcTimestamp));
                 ageItem->setTextAlignment(Qt::AlignCenter);
-                ageItem->setToolTip(d.utcTimestamp.toString());
-                ui->tableWidgetCalls->setItem(row, col++, ageItem);
+                ageItem->setToolTip(utcDateTime(d.utcTimestamp).toString());
+                rows.setItem(col++, ageItem);
 
                 auto snrText = Varicode::formatSNR(d.snr);
                 auto snrItem = new QTableWidgetItem(
@@ -268,18 +268,18 @@ void MainWindow::displayCallActivity() {
                         ? ""
                         : QString(columnLabel("%1 dB")).arg(snrText));
                 snrItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-                ui->tableWidgetCalls->setItem(row, col++, snrItem);
+                rows.setItem(col++, snrItem);
 
                 auto offsetItem = new QTableWidgetItem(
                     QString(columnLabel("%1 Hz")).arg(d.offset));
                 offsetItem->setData(Qt::UserRole, QVariant(d.offset));
                 offsetItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-                ui->tableWidgetCalls->setItem(row, col++, offsetItem);
+                rows.setItem(col++, offsetItem);
 
                 auto tdriftItem = new QTableWidgetItem(
                     QString(columnLabel("%1 ms")).arg((int)(1000 * d.tdrift)));
                 tdriftItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-                ui->tableWidgetCalls->setItem(row, col++, tdriftItem);
+                rows.setItem(col++, tdriftItem);
 
                 auto name = JS8::Submode::name(d.submode);
                 auto modeItem =
@@ -287,12 +287,12 @@ void MainWindow::displayCallActivity() {
                 modeItem->setToolTip(name);
                 modeItem->setData(Qt::UserRole, QVariant(name));
                 modeItem->setTextAlignment(Qt::AlignCenter);
-                ui->tableWidgetCalls->setItem(row, col++, modeItem);
+                rows.setItem(col++, modeItem);
 
                 auto gridItem = new QTableWidgetItem(
                     QString("%1").arg(d.grid.trimmed().left(4)));
                 gridItem->setToolTip(d.grid.trimmed());
-                ui->tableWidgetCalls->setItem(row, col++, gridItem);
+                rows.setItem(col++, gridItem);
 
                 auto const vector =
                     Geodesic::vector(m_config.my_grid(), d.grid);
@@ -302,7 +302,7 @@ void MainWindow::displayCallActivity() {
                     vector.distance().toString(m_config.miles(), units));
                 distanceItem->setTextAlignment(Qt::AlignRight |
                                                Qt::AlignVCenter);
-                ui->tableWidgetCalls->setItem(row, col++, distanceItem);
+                rows.setItem(col++, distanceItem);
 
                 auto azimuthItem =
                     new QTableWidgetItem(vector.azimuth().toString(units));
@@ -310,7 +310,7 @@ void MainWindow::displayCallActivity() {
                     azimuthItem->setToolTip(azimuth.compass().toString());
                 azimuthItem->setTextAlignment(Qt::AlignRight |
                                               Qt::AlignVCenter);
-                ui->tableWidgetCalls->setItem(row, col++, azimuthItem);
+                rows.setItem(col++, azimuthItem);
 
                 QString flag;
                 if (m_logBook.hasWorkedBefore(d.call, "")) {
@@ -319,7 +319,7 @@ void MainWindow::displayCallActivity() {
                 }
                 auto workedBeforeItem = new QTableWidgetItem(flag);
                 workedBeforeItem->setTextAlignment(Qt::AlignCenter);
-                ui->tableWidgetCalls->setItem(row, col++, workedBeforeItem);
+                rows.setItem(col++, workedBeforeItem);
 
                 QString logDetailGrid;
                 QString logDetailDate;
@@ -367,66 +367,54 @@ void MainWindow::displayCallActivity() {
                 auto logNameItem = new QTableWidgetItem(logDetailName);
                 logNameItem->setTextAlignment(Qt::AlignCenter);
                 logNameItem->setToolTip(logDetailName);
-                ui->tableWidgetCalls->setItem(row, col++, logNameItem);
+                rows.setItem(col++, logNameItem);
 
                 auto logCommentItem = new QTableWidgetItem(logDetailComment);
                 logCommentItem->setTextAlignment(Qt::AlignCenter);
                 logCommentItem->setToolTip(logDetailComment);
-                ui->tableWidgetCalls->setItem(row, col++, logCommentItem);
+                rows.setItem(col++, logCommentItem);
 
             } else {
-                ui->tableWidgetCalls->setItem(row, col++,
-                                              new QTableWidgetItem("")); // age
-                ui->tableWidgetCalls->setItem(row, col++,
-                                              new QTableWidgetItem("")); // snr
-                ui->tableWidgetCalls->setItem(row, col++,
-                                              new QTableWidgetItem("")); // freq
-                ui->tableWidgetCalls->setItem(
-                    row, col++, new QTableWidgetItem("")); // tdrift
-                ui->tableWidgetCalls->setItem(row, col++,
-                                              new QTableWidgetItem("")); // mode
-                ui->tableWidgetCalls->setItem(row, col++,
-                                              new QTableWidgetItem("")); // grid
-                ui->tableWidgetCalls->setItem(
-                    row, col++, new QTableWidgetItem("")); // distance
-                ui->tableWidgetCalls->setItem(
-                    row, col++, new QTableWidgetItem("")); // azimuth
-                ui->tableWidgetCalls->setItem(
-                    row, col++, new QTableWidgetItem("")); // worked before
-                ui->tableWidgetCalls->setItem(
-                    row, col++, new QTableWidgetItem("")); // log name
-                ui->tableWidgetCalls->setItem(
-                    row, col++, new QTableWidgetItem("")); // log comment
+                rows.setItem(col++, new QTableWidgetItem("")); // age
+                rows.setItem(col++, new QTableWidgetItem("")); // snr
+                rows.setItem(col++, new QTableWidgetItem("")); // freq
+                rows.setItem(col++, new QTableWidgetItem("")); // tdrift
+                rows.setItem(col++, new QTableWidgetItem("")); // mode
+                rows.setItem(col++, new QTableWidgetItem("")); // grid
+                rows.setItem(col++, new QTableWidgetItem("")); // distance
+                rows.setItem(col++, new QTableWidgetItem("")); // azimuth
+                rows.setItem(col++, new QTableWidgetItem("")); // worked before
+                rows.setItem(col++, new QTableWidgetItem("")); // log name
+                rows.setItem(col++, new QTableWidgetItem("")); // log comment
             }
 
             if (isCallSelected) {
-                for (int i = 0; i < ui->tableWidgetCalls->columnCount(); i++) {
-                    ui->tableWidgetCalls->item(row, i)->setSelected(true);
-                }
+                rows.select();
             }
 
             if (hasCQ) {
                 for (int i = 0; i < ui->tableWidgetCalls->columnCount(); i++) {
-                    ui->tableWidgetCalls->item(row, i)->setBackground(
-                        QBrush(m_config.color_CQ()));
+                    rows.item(i)->setBackground(QBrush(m_config.color_CQ()));
                 }
             }
 
             if (m_config.secondary_highlight_words().contains(call)) {
                 for (int i = 0; i < ui->tableWidgetCalls->columnCount(); i++) {
-                    ui->tableWidgetCalls->item(row, i)->setBackground(
+                    rows.item(i)->setBackground(
                         QBrush(m_config.color_secondary_highlight()));
                 }
             }
 
             if (m_config.primary_highlight_words().contains(call)) {
                 for (int i = 0; i < ui->tableWidgetCalls->columnCount(); i++) {
-                    ui->tableWidgetCalls->item(row, i)->setBackground(
+                    rows.item(i)->setBackground(
                         QBrush(m_config.color_primary_highlight()));
                 }
             }
         }
 
+        rows.finish();
+
         // Set table color
         auto style = QString(
             "QTableWidget { background:%1; selection-background-color:%2; "
@@ -435,7 +423,10 @@ void MainWindow::displayCallActivity() {
         style = style.arg(m_config.color_table_background().name());
         style = style.arg(m_config.color_table_highlight().name());
         style = style.arg(m_config.color_table_foreground().name());
-        ui->tableWidgetCalls->setStyleSheet(style);
+        // Setting a style sheet repolishes the table, even if unchanged
+        if (ui->tableWidgetCalls->styleSheet() != style) {
+            ui->tableWidgetCalls->setStyleSheet(style);
+        }
 
         // Set the table palette for inactive selected row
         auto p = ui->tableWidgetCalls->palette();
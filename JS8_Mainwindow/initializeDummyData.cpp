@@ -205,8 +205,8 @@ void MainWindow::initializeDummyData() {
         cd.dial = 7078000;
         cd.offset = 500 + 100 * i;
         cd.snr = i == 3 ? -100 : i;
-        cd.ackTimestamp = i == 1 ? dt.addSecs(-900) : QDateTime{};
-        cd.utcTimestamp = dt;
+        cd.ackTimestamp = i == 1 ? dt.addSecs(-900).toMSecsSinceEpoch() : 0;
+        cd.utcTimestamp = dt.toMSecsSinceEpoch();
         cd.grid = i == 5 ? "J042" : i == 6 ? " FN42FN42FN" : "";
         cd.tdrift = 0.1 * i;
         cd.submode = i % 3;
@@ -220,7 +220,7 @@ void MainWindow::initializeDummyData() {
         ad.text = QString("%1: %2 TEST MESSAGE")
                       .arg(call)
                       .arg(m_config.my_callsign());
-        ad.utcTimestamp = dt;
+        ad.utcTimestamp = dt.toMSecsSinceEpoch();
         ad.submode = cd.submode;
         m_bandActivity[500 + 100 * i] = {ad};
 
@@ -235,7 +235,7 @@ void MainWindow::initializeDummyData() {
     adHB1.dial = 7078000;
     adHB1.offset = 750;
     adHB1.text = QString("KN4CRD: HB AUTO EM73");
-    adHB1.utcTimestamp = DriftingDateTime::currentDateTimeUtc();
+    adHB1.utcTimestamp = DriftingDateTime::currentMSecsSinceEpoch();
     adHB1.submode = Varicode::JS8CallNormal;
     m_bandActivity[750].append(adHB1);
 
@@ -245,7 +245,7 @@ void MainWindow::initializeDummyData() {
     adHB2.dial = 7078000;
     adHB2.offset = 750;
     adHB2.text = QString(" MSG ID 1");
-    adHB2.utcTimestamp = DriftingDateTime::currentDateTimeUtc();
+    adHB2.utcTimestamp = DriftingDateTime::currentMSecsSinceEpoch();
     adHB2.submode = Varicode::JS8CallNormal;
     m_bandActivity[750].append(adHB2);
 
@@ -255,7 +255,7 @@ void MainWindow::initializeDummyData() {
     cmd.from = "N0JDS";
     cmd.relayPath = "N0JDS>OH8STN";
     cmd.text = "HELLO BRAVE SOUL";
-    cmd.utcTimestamp = dt;
+    cmd.utcTimestamp = dt.toMSecsSinceEpoch();
     cmd.submode = Varicode::JS8CallNormal;
     addCommandToMyInbox(cmd);
 
@@ -20,7 +20,7 @@ void MainWindow::initializeGroupMessage() {
     cmd.cmd = " MSG TO:";
     cmd.from = "KN4CRD";
     cmd.to = "@GROUP42";
-    cmd.utcTimestamp = dt;
+    cmd.utcTimestamp = dt.toMSecsSinceEpoch();
     cmd.submode = Varicode::JS8CallNormal;
     cmd.text = "@GROUP42 TEST MESSAGE TO GROUP";
 
@@ -34,7 +34,7 @@ void MainWindow::initializeGroupMessage() {
     cmd1.cmd = " MSG TO:";
     cmd1.from = "KN4CRD";
     cmd1.to = "@GROUP42";
-    cmd1.utcTimestamp = dt;
+    cmd1.utcTimestamp = dt.toMSecsSinceEpoch();
     cmd1.submode = Varicode::JS8CallNormal;
     cmd1.text = "@GROUP42 ANOTHER TEST MESSAGE TO GROUP";
 
@@ -46,7 +46,7 @@ void MainWindow::initializeGroupMessage() {
     cmd2.cmd = " QUERY MSGS";
     cmd2.from = "W1AW";
     cmd2.to = "@GROUP42";
-    cmd2.utcTimestamp = DriftingDateTime::currentDateTimeUtc();
+    cmd2.utcTimestamp = DriftingDateTime::currentMSecsSinceEpoch();
     cmd2.submode = Varicode::JS8CallNormal;
 
     m_rxCommandQueue.append(cmd2);
@@ -67,7 +67,7 @@ void MainWindow::initializeGroupMessage() {
     cmd3.cmd = " QUERY";
     cmd3.from = "W1AW";
     cmd3.to = "@GROUP42";
-    cmd3.utcTimestamp = DriftingDateTime::currentDateTimeUtc();
+    cmd3.utcTimestamp = DriftingDateTime::currentMSecsSinceEpoch();
     cmd3.submode = Varicode::JS8CallNormal;
     cmd3.text = textString.c_str();
 
@@ -81,7 +81,7 @@ void MainWindow::initializeGroupMessage() {
     cmd4.cmd = " MSG TO:";
     cmd4.from = "KN4CRD";
     cmd4.to = "K4RWR";
-    cmd4.utcTimestamp = dt;
+    cmd4.utcTimestamp = dt.toMSecsSinceEpoch();
     cmd4.submode = Varicode::JS8CallNormal;
     cmd4.text = "W1AW TEST MESSAGE TO STATION";
 
@@ -95,7 +95,7 @@ void MainWindow::initializeGroupMessage() {
     cmd5.cmd = " MSG TO:";
     cmd5.from = "KN4CRD";
     cmd5.to = "K4RWR";
-    cmd5.utcTimestamp = dt;
+    cmd5.utcTimestamp = dt.toMSecsSinceEpoch();
     cmd5.submode = Varicode::JS8CallNormal;
     cmd5.text = "W1AW ANOTHER TEST MESSAGE TO STATION";
 
@@ -107,7 +107,7 @@ void MainWindow::initializeGroupMessage() {
     cmd6.cmd = " QUERY MSGS";
     cmd6.from = "W1AW";
     cmd6.to = "K4RWR";
-    cmd6.utcTimestamp = DriftingDateTime::currentDateTimeUtc();
+    cmd6.utcTimestamp = DriftingDateTime::currentMSecsSinceEpoch();
     cmd6.submode = Varicode::JS8CallNormal;
 
     m_rxCommandQueue.append(cmd6);
@@ -128,7 +128,7 @@ void MainWindow::initializeGroupMessage() {
     cmd7.cmd = " QUERY";
     cmd7.from = "W1AW";
     cmd7.to = "K4RWR";
-    cmd7.utcTimestamp = DriftingDateTime::currentDateTimeUtc();
+    cmd7.utcTimestamp = DriftingDateTime::currentMSecsSinceEpoch();
     cmd7.submode = Varicode::JS8CallNormal;
     cmd7.text = textString.c_str();
 
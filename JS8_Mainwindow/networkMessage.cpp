@@ -207,13 +207,14 @@ void MainWindow::networkMessage(Message const &message) {
 
         foreach (auto cd, m_callActivity.values()) {
             if (callsignAging &&
-                cd.utcTimestamp.secsTo(now) / 60 >= callsignAging) {
+                utcDateTime(cd.utcTimestamp).secsTo(now) / 60 >=
+                    callsignAging) {
                 continue;
             }
             QVariantMap detail;
             detail["SNR"] = QVariant(cd.snr);
             detail["GRID"] = QVariant(cd.grid);
-            detail["UTC"] = QVariant(cd.utcTimestamp.toMSecsSinceEpoch());
+            detail["UTC"] = QVariant(cd.utcTimestamp);
             calls[cd.call] = QVariant(detail);
         }
 
@@ -248,7 +249,7 @@ void MainWindow::networkMessage(Message const &message) {
                 {"OFFSET", QVariant(d.offset)},
                 {"TEXT", QVariant(d.text)},
                 {"SNR", QVariant(d.snr)},
-                {"UTC", QVariant(d.utcTimestamp.toMSecsSinceEpoch())}});
+                {"UTC", QVariant(d.utcTimestamp)}});
         }
 
         sendNetworkMessage("RX.BAND_ACTIVITY", "", offsets);
@@ -262,6 +263,43 @@ void MainWindow::networkMessage(Message const &message) {
                            });
         return;
     }
+    /**
+     * @brief RX.REPLAY: Replays a decode from the decode journal, as sent by
+     * js8journal --replay. The decode is shown as a notice, and passed on to
+     * API clients as RX.ACTIVITY, flagged REPLAY; it plays no part in band
+     * or call activity, nor in automatic replies, and isn't journaled again.
+     */
+    if (type == "RX.REPLAY") {
+        auto const record =
+            DecodeJournal::Record::fromVariantMap(message.params());
+        DecodedText const decodedtext(record.decoded());
+        auto const utc =
+            QDateTime::fromMSecsSinceEpoch(record.utc, QTimeZone::utc());
+        auto const offset = decodedtext.frequencyOffset();
+
+        writeNoticeTextToUI(
+            utc, QString("Replay %1 %2 %3 dB: %4")
+                     .arg(Radio::frequency_MHz_string(record.dial))
+                     .arg(offset)
+                     .arg(Varicode::formatSNR(decodedtext.snr()))
+                     .arg(decodedtext.message()));
+
+        if (canSendNetworkMessage()) {
+            sendNetworkMessage(
+                "RX.ACTIVITY", decodedtext.message(),
+                {{"_ID", QVariant(-1)},
+                 {"REPLAY", QVariant(true)},
+                 {"RECEIVER", QVariant(record.receiver)},
+                 {"FREQ", QVariant(record.dial + offset)},
+                 {"DIAL", QVariant(record.dial)},
+                 {"OFFSET", QVariant(offset)},
+                 {"SNR", QVariant(decodedtext.snr())},
+                 {"SPEED", QVariant(decodedtext.submode())},
+                 {"TDRIFT", QVariant(decodedtext.dt())},
+                 {"UTC", QVariant(record.utc)}});
+        }
+        return;
+    }
     /** @} */ // End RX Commands
 
     // TX.GET_TEXT
@@ -357,38 +395,41 @@ void MainWindow::networkMessage(Message const &message) {
             selectedCall = "%";
         }
 
-        Inbox inbox(inboxPath());
-        if (!inbox.open()) {
-            return;
-        }
-
-        QList<QPair<int, Message>> msgs;
-        msgs.append(
-            inbox.values("STORE", "$.params.TO", selectedCall, 0, 1000));
-        msgs.append(
-            inbox.values("READ", "$.params.FROM", selectedCall, 0, 1000));
-        foreach (auto pair, inbox.values("UNREAD", "$.params.FROM",
-                                         selectedCall, 0, 1000)) {
-            msgs.append(pair);
-        }
-        std::stable_sort(
-            msgs.begin(), msgs.end(),
-            [](QPair<int, Message> const &a, QPair<int, Message> const &b) {
-                return QVariant::compare(a.second.params().value("UTC"),
-                                         b.second.params().value("UTC")) ==
-                       QPartialOrdering::Greater;
+        // Queried on the inbox's thread; the reply's sent when it's done.
+
+        m_inboxService->post(
+            this,
+            [selectedCall](Inbox &inbox) {
+                QList<QPair<int, Message>> msgs;
+                msgs.append(inbox.values("STORE", "$.params.TO", selectedCall,
+                                         0, 1000));
+                msgs.append(inbox.values("READ", "$.params.FROM",
+                                         selectedCall, 0, 1000));
+                msgs.append(inbox.values("UNREAD", "$.params.FROM",
+                                         selectedCall, 0, 1000));
+                std::stable_sort(msgs.begin(), msgs.end(),
+                                 [](QPair<int, Message> const &a,
+                                    QPair<int, Message> const &b) {
+                                     return QVariant::compare(
+                                                a.second.params().value("UTC"),
+                                                b.second.params().value(
+                                                    "UTC")) ==
+                                            QPartialOrdering::Greater;
+                                 });
+
+                QVariantList l;
+                for (auto const &pair : std::as_const(msgs)) {
+                    l << pair.second.toVariantMap();
+                }
+                return l;
+            },
+            [this, id](QVariantList l) {
+                sendNetworkMessage("INBOX.MESSAGES", "",
+                                   {
+                                       {"_ID", id},
+                                       {"MESSAGES", l},
+                                   });
             });
-
-        QVariantList l;
-        foreach (auto pair, msgs) {
-            l << pair.second.toVariantMap();
-        }
-
-        sendNetworkMessage("INBOX.MESSAGES", "",
-                           {
-                               {"_ID", id},
-                               {"MESSAGES", l},
-                           });
         return;
     }
     /** @brief INBOX.STORE_MESSAGE: Stores a message in the inbox for a callsign. */
@@ -410,7 +451,7 @@ void MainWindow::networkMessage(Message const &message) {
         d.from = m_config.my_callsign();
         d.relayPath = d.from;
         d.text = text;
-        d.utcTimestamp = DriftingDateTime::currentDateTimeUtc();
+        d.utcTimestamp = DriftingDateTime::currentMSecsSinceEpoch();
         d.submode = m_nSubMode;
 
         auto mid = addCommandToStorage("STORE", d);
@@ -59,7 +59,7 @@ void MainWindow::processCommandActivity() {
         cd.offset = d.offset;
         cd.bits = d.bits;
         cd.ackTimestamp =
-            d.text.contains(": ACK") || toMe ? d.utcTimestamp : QDateTime{};
+            d.text.contains(": ACK") || toMe ? d.utcTimestamp : 0;
         cd.utcTimestamp = d.utcTimestamp;
         cd.tdrift = d.tdrift;
         cd.submode = d.submode;
@@ -163,7 +163,7 @@ void MainWindow::processCommandActivity() {
                  {"SNR", QVariant(d.snr)},
                  {"SPEED", QVariant(d.submode)},
                  {"TDRIFT", QVariant(d.tdrift)},
-                 {"UTC", QVariant(d.utcTimestamp.toMSecsSinceEpoch())}});
+                 {"UTC", QVariant(d.utcTimestamp)}});
         }
 
         // we're only responding to allcalls if we are participating in the
@@ -212,8 +212,9 @@ void MainWindow::processCommandActivity() {
                  !d.cmd.contains(" SNR")); /* && isRecentOffset(d.freq);*/
 
             if (shouldOverwrite &&
-                ui->textEditRX->find(d.utcTimestamp.time().toString(),
-                                     QTextDocument::FindBackward)) {
+                ui->textEditRX->find(
+                    utcDateTime(d.utcTimestamp).time().toString(),
+                    QTextDocument::FindBackward)) {
                 // ... maybe we could delete the last line that had this message
                 // on this frequency...
                 c = ui->textEditRX->textCursor();
@@ -233,8 +234,8 @@ void MainWindow::processCommandActivity() {
             }
 
             // log it to the display!
-            displayTextForFreq(ad.text, ad.offset, ad.utcTimestamp, false, true,
-                               false);
+            displayTextForFreq(ad.text, ad.offset, utcDateTime(ad.utcTimestamp),
+                               false, true, false);
 
             /*
             // and send it to the network in case we want to interact with it
@@ -253,7 +254,7 @@ void MainWindow::processCommandActivity() {
                     {"SNR", QVariant(ad.snr)},
                     {"SPEED", QVariant(ad.submode)},
                     {"TDRIFT", QVariant(ad.tdrift)},
-                    {"UTC", QVariant(ad.utcTimestamp.toMSecsSinceEpoch())}
+                    {"UTC", QVariant(ad.utcTimestamp)}
                 });
             }
             */
@@ -401,7 +402,8 @@ void MainWindow::processCommandActivity() {
                 auto const &cd = m_callActivity[call];
 
                 if (callsignAging &&
-                    cd.utcTimestamp.secsTo(now) / 60 >= callsignAging) {
+                    utcDateTime(cd.utcTimestamp).secsTo(now) / 60 >=
+                        callsignAging) {
                     continue;
                 }
 
@@ -451,7 +453,8 @@ void MainWindow::processCommandActivity() {
                     cd.dial = d.dial;
                     cd.offset = d.offset;
                     cd.through = d.from;
-                    cd.utcTimestamp = DriftingDateTime::currentDateTimeUtc();
+                    cd.utcTimestamp =
+                        DriftingDateTime::currentMSecsSinceEpoch();
                     cd.tdrift = d.tdrift;
                     cd.submode = d.submode;
                     logCallActivity(cd, false);
@@ -793,7 +796,7 @@ void MainWindow::processCommandActivity() {
             SelfDestructMessageBox *m = new SelfDestructMessageBox(
                 300, "New Message Received",
                 QString("A new message was received at %1 UTC from %2")
-                    .arg(d.utcTimestamp.time().toString())
+                    .arg(utcDateTime(d.utcTimestamp).time().toString())
                     .arg(d.from),
                 QMessageBox::Information, QMessageBox::Ok, QMessageBox::Ok,
                 false, this);
@@ -842,18 +845,14 @@ void MainWindow::processCommandActivity() {
             segs.removeFirst();
 
             if (cmd == "MSG" && !segs.isEmpty()) {
-                auto inbox = Inbox(inboxPath());
-                if (!inbox.open()) {
-                    continue;
-                }
-
                 bool ok = false;
                 int mid = QString(segs.first()).toInt(&ok);
                 if (!ok) {
                     continue;
                 }
 
-                auto msg = inbox.value(mid);
+                auto msg = m_inboxService->call(
+                    [mid](Inbox &inbox) { return inbox.value(mid); });
                 auto params = msg.params();
                 if (params.isEmpty()) {
                     continue;
@@ -985,7 +984,8 @@ void MainWindow::processCommandActivity() {
             auto baseCall = callsigns.first();
             foreach (auto cd, m_callActivity.values()) {
                 if (callsignAging &&
-                    cd.utcTimestamp.secsTo(now) / 60 >= callsignAging) {
+                    utcDateTime(cd.utcTimestamp).secsTo(now) / 60 >=
+                        callsignAging) {
                     continue;
                 }
 
@@ -9,6 +9,24 @@ void MainWindow::processDecodeEvent(JS8::Event::Variant const &event) {
     static QList<qint32> driftQueue;
     static qint32 syncStart = -1;
 
+    // Events from additional receivers are handled separately; only
+    // decodes are of interest there, and none of the drift tracking,
+    // waterfall annotation or decoder state below applies to them.
+
+    if (auto const id = std::visit([](auto const &e) { return e.receiver; },
+                                   event);
+        id != 0) {
+        if (auto const decoded = std::get_if<JS8::Event::Decoded>(&event)) {
+            if (auto const it = std::find_if(
+                    m_receivers.begin(), m_receivers.end(),
+                    [id](auto const &receiver) { return receiver->id() == id; });
+                it != m_receivers.end()) {
+                processReceiverDecode(**it, *decoded);
+            }
+        }
+        return;
+    }
+
     std::visit(
         [this](auto &&e) {
             using T = std::decay_t<decltype(e)>;
@@ -242,6 +260,11 @@ void MainWindow::processDecodeEvent(JS8::Event::Variant const &event) {
                 writeAllTxt(date + " " + decodedtext.string() + " " +
                             decodedtext.message());
 
+                if (m_config.write_logs()) {
+                    m_decodeJournal->append(DecodeJournal::Record::from(
+                        e, DriftingDateTime::currentDateTimeUtc(), freq));
+                }
+
                 /**
                  * @brief Send decode to WSJT-X protocol
                  *
@@ -303,7 +326,8 @@ void MainWindow::processDecodeEvent(JS8::Event::Variant const &event) {
                     d.dial = freq;
                     d.offset = offset;
                     d.text = decodedtext.message();
-                    d.utcTimestamp = DriftingDateTime::currentDateTimeUtc();
+                    d.utcTimestamp =
+                        DriftingDateTime::currentMSecsSinceEpoch();
                     d.snr = decodedtext.snr();
                     d.isBuffered = false;
                     d.submode = decodedtext.submode();
@@ -356,13 +380,14 @@ void MainWindow::processDecodeEvent(JS8::Event::Variant const &event) {
                 bool shouldProcessCompound = true;
                 if (shouldProcessCompound && decodedtext.isCompound() &&
                     !decodedtext.isDirectedMessage()) {
-                    cd.call = decodedtext.compoundCall();
+                    cd.call = Intern::string(decodedtext.compoundCall());
                     cd.grid = decodedtext.extra(); // compound calls via pings
                                                    // may contain grid...
                     cd.snr = decodedtext.snr();
                     cd.dial = freq;
                     cd.offset = decodedtext.frequencyOffset();
-                    cd.utcTimestamp = DriftingDateTime::currentDateTimeUtc();
+                    cd.utcTimestamp =
+                        DriftingDateTime::currentMSecsSinceEpoch();
                     cd.bits = decodedtext.bits();
                     cd.submode = decodedtext.submode();
                     cd.tdrift = m_wideGraph->shouldAutoSyncSubmode(d.submode)
@@ -376,7 +401,7 @@ void MainWindow::processDecodeEvent(JS8::Event::Variant const &event) {
                             // this is a cq with a standard or compound call,
                             // ala "KN4CRD/P: @ALLCALL CQ CQ CQ"
                             cd.cqTimestamp =
-                                DriftingDateTime::currentDateTimeUtc();
+                                DriftingDateTime::currentMSecsSinceEpoch();
 
                             // convert CQ to a directed command and process...
                             cmd.from = cd.call;
@@ -446,13 +471,14 @@ void MainWindow::processDecodeEvent(JS8::Event::Variant const &event) {
                 if (shouldProcessDirected && decodedtext.isDirectedMessage()) {
                     auto parts = decodedtext.directedMessage();
 
-                    cmd.from = parts.at(0);
-                    cmd.to = parts.at(1);
+                    cmd.from = Intern::string(parts.at(0));
+                    cmd.to = Intern::string(parts.at(1));
                     cmd.cmd = parts.at(2);
                     cmd.dial = freq;
                     cmd.offset = decodedtext.frequencyOffset();
                     cmd.snr = decodedtext.snr();
-                    cmd.utcTimestamp = DriftingDateTime::currentDateTimeUtc();
+                    cmd.utcTimestamp =
+                        DriftingDateTime::currentMSecsSinceEpoch();
                     cmd.bits = decodedtext.bits();
                     cmd.extra =
                         parts.length() > 2 ? parts.mid(3).join(" ") : "";
@@ -484,7 +510,7 @@ void MainWindow::processDecodeEvent(JS8::Event::Variant const &event) {
                             cmdcd.ackTimestamp =
                                 cmd.to == m_config.my_callsign()
                                     ? cmd.utcTimestamp
-                                    : QDateTime{};
+                                    : 0;
                             cmdcd.tdrift = cmd.tdrift;
                             cmdcd.submode = cmd.submode;
                             logCallActivity(cmdcd, false);
@@ -538,3 +564,62 @@ void MainWindow::processDecodeEvent(JS8::Event::Variant const &event) {
         },
         event);
 }
+
+/**
+ * @brief member function of the MainWindow class
+ *  process text decoded from an additional receiver
+ *
+ * Additional receivers are monitor-only; their frames are deduplicated
+ * per receiver, logged to ALL.TXT tagged with the receiver, and sent to
+ * API clients as RX.ACTIVITY with the receiver dial frequency. They play
+ * no part in band or call activity, nor in automatic replies.
+ */
+
+void MainWindow::processReceiverDecode(Receiver const &receiver,
+                                       JS8::Event::Decoded const &event) {
+    DecodedText decodedtext(event);
+    FrameCacheKey dedupeKey(decodedtext.submode(), decodedtext.frame(),
+                            receiver.id());
+
+    if (auto const it = m_messageDupeCache.find(dedupeKey);
+        it != m_messageDupeCache.end()) {
+        if (it->second.secsTo(QDateTime::currentDateTimeUtc()) <
+            0.5 * JS8::Submode::period(decodedtext.submode())) {
+            return;
+        }
+    }
+
+    m_messageDupeCache.insert_or_assign(dedupeKey,
+                                        QDateTime::currentDateTimeUtc());
+
+    auto const dial = static_cast<int>(receiver.dialFrequency());
+    auto const date =
+        DriftingDateTime::currentDateTimeUtc().toString("yyyy-MM-dd");
+
+    writeAllTxt(date + " " + decodedtext.string() + " " +
+                decodedtext.message() +
+                QString(" [RX%1 %2]").arg(receiver.id()).arg(dial));
+
+    if (m_config.write_logs()) {
+        m_decodeJournal->append(DecodeJournal::Record::from(
+            event, DriftingDateTime::currentDateTimeUtc(),
+            receiver.dialFrequency()));
+    }
+
+    if (canSendNetworkMessage()) {
+        auto const offset = decodedtext.frequencyOffset();
+
+        sendNetworkMessage(
+            "RX.ACTIVITY", decodedtext.message(),
+            {{"_ID", QVariant(-1)},
+             {"RECEIVER", QVariant(receiver.id())},
+             {"FREQ", QVariant(dial + offset)},
+             {"DIAL", QVariant(dial)},
+             {"OFFSET", QVariant(offset)},
+             {"SNR", QVariant(decodedtext.snr())},
+             {"SPEED", QVariant(decodedtext.submode())},
+             {"TDRIFT", QVariant(decodedtext.dt())},
+             {"UTC", QVariant(DriftingDateTime::currentDateTimeUtc()
+                                  .toMSecsSinceEpoch())}});
+    }
+}
@@ -22,13 +22,14 @@ void MainWindow::processRxActivity() {
             sendNetworkMessage(
                 "RX.ACTIVITY", d.text,
                 {{"_ID", QVariant(-1)},
+                 {"RECEIVER", QVariant(0)},
                  {"FREQ", QVariant(d.dial + d.offset)},
                  {"DIAL", QVariant(d.dial)},
                  {"OFFSET", QVariant(d.offset)},
                  {"SNR", QVariant(d.snr)},
                  {"SPEED", QVariant(d.submode)},
                  {"TDRIFT", QVariant(d.tdrift)},
-                 {"UTC", QVariant(d.utcTimestamp.toMSecsSinceEpoch())}});
+                 {"UTC", QVariant(d.utcTimestamp)}});
         }
 
         // use the actual frequency and check its delta from our current
@@ -86,7 +87,7 @@ void MainWindow::processRxActivity() {
                 if (d.text.startsWith(theirCall) &&
                     d.text.mid(theirCall.length(), 1) == ":") {
                     CallDetail cd = {};
-                    cd.call = theirCall;
+                    cd.call = Intern::string(theirCall);
                     cd.dial = d.dial;
                     cd.offset = d.offset;
                     cd.snr = d.snr;
@@ -121,8 +122,8 @@ void MainWindow::processRxActivity() {
         }
 
         // log it to the display!
-        displayTextForFreq(d.text, d.offset, d.utcTimestamp, false, isFirst,
-                           isLast);
+        displayTextForFreq(d.text, d.offset, utcDateTime(d.utcTimestamp), false,
+                           isFirst, isLast);
 
         // If we've received a message to be displayed, we should no longer call
         // CQ.
@@ -162,13 +163,13 @@ void MainWindow::processRxActivity() {
         }
 
         auto now = DriftingDateTime::currentDateTimeUtc();
-        if(last.utcTimestamp.secsTo(now) < m_TRperiod){
+        if(utcDateTime(last.utcTimestamp).secsTo(now) < m_TRperiod){
             continue;
         }
 
         ActivityDetail d = {};
         d.text = " . . . ";
-        d.utcTimestamp = now;
+        d.utcTimestamp = now.toMSecsSinceEpoch();
         d.snr = -99;
 
         m_bandActivity[offset].append(d);
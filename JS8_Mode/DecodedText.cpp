@@ -5,6 +5,9 @@
 #include "DecodedText.h"
 #include "JS8_Include/commons.h"
 #include <JS8_Main/varicode.h>
+#include <QCache>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QStringBuilder>
 
 /******************************************************************************/
@@ -17,6 +20,11 @@ namespace {
 // denote it as being sketchy.
 
 constexpr auto QUALITY_THRESHOLD = 0.17f;
+
+// Number of unpacked frames to cache; a period's worth of decodes, and
+// then some.
+
+constexpr auto CACHE_SIZE = 256;
 } // namespace
 
 /******************************************************************************/
@@ -54,16 +62,29 @@ QString buildCompound(QStringList const &parts) {
     subset.removeAll("");
     return subset.join('/');
 }
+
+// Key for the cache of unpacked frames.
+
+struct CacheKey {
+    QString frame;
+    int bits;
+
+    bool operator==(CacheKey const &) const = default;
+};
+
+size_t qHash(CacheKey const &key, size_t const seed = 0) {
+    return qHashMulti(seed, key.frame, key.bits);
+}
 } // namespace
 
 /******************************************************************************/
 // Private Implementation
 /******************************************************************************/
 
-// Core constructor, called by the two public constructors.
-// Attempts to unpack, using the unpack strategies defined
-// in the order of the unpack strategies array, until one
-// of them works or all of them have failed.
+// Core constructor, called by the two public constructors. Unpacking
+// depends only on the frame and its bits, so the result is taken from
+// the cache if we've seen the frame recently; autosync will decode the
+// same signal several times a period, and the dupe check comes later.
 
 /**
  * @private
@@ -81,38 +102,77 @@ QString buildCompound(QStringList const &parts) {
 DecodedText::DecodedText(QString const &frame, int bits, int submode,
                          bool isLowConfidence, int time, int frequencyOffset,
                          float snr, float dt)
-    : frameType_(Varicode::FrameUnknown), frame_(frame), isAlt_(false),
-      isHeartbeat_(false), isLowConfidence_(isLowConfidence), message_(frame_),
-      bits_(bits), submode_(submode), time_(time),
-      frequencyOffset_(frequencyOffset), snr_(snr), dt_(dt) {
-    auto const m = message().trimmed();
+    : frame_(frame), isLowConfidence_(isLowConfidence), bits_(bits),
+      submode_(submode), time_(time), frequencyOffset_(frequencyOffset),
+      snr_(snr), dt_(dt) {
+    static QMutex mutex;
+    static QCache<CacheKey, Unpacked> cache(CACHE_SIZE);
 
-    if (m.length() < 12 || m.contains(' '))
+    CacheKey const key{frame_, bits_};
+    QMutexLocker lock(&mutex);
+
+    if (auto const cached = cache.object(key)) {
+        unpacked_ = *cached;
         return;
+    }
+
+    lock.unlock();
+    unpacked_ = unpack(frame_, bits_);
+    lock.relock();
+
+    cache.insert(key, new Unpacked(unpacked_));
+}
+
+// Attempts to unpack, using the unpack strategies defined in the order
+// of the unpack strategies array, until one of them works or all of them
+// have failed, in which case the message is the frame itself.
+
+/**
+ * @private
+ * @brief Unpack a frame (private)
+ *
+ * @param frame
+ * @param bits
+ * @return Unpacked
+ */
+DecodedText::Unpacked DecodedText::unpack(QString const &frame,
+                                          int const bits) {
+    Unpacked unpacked{Varicode::FrameUnknown};
+    unpacked.message = frame;
+
+    auto const m = frame.trimmed();
+
+    if (m.length() < 12 || m.contains(' '))
+        return unpacked;
 
     for (auto unpack : unpackStrategies) {
-        if ((this->*unpack)(m))
+        if (unpack(unpacked, m, bits))
             break;
     }
+
+    return unpacked;
 }
 
 /**
  * @private
  * @brief Try to unpack fast data message (private)
  *
+ * @param u
  * @param m
+ * @param bits
  * @return true
  * @return false
  */
-bool DecodedText::tryUnpackFastData(QString const &m) {
-    if ((bits_ & Varicode::JS8CallData) != Varicode::JS8CallData)
+bool DecodedText::tryUnpackFastData(Unpacked &u, QString const &m,
+                                    int const bits) {
+    if ((bits & Varicode::JS8CallData) != Varicode::JS8CallData)
         return false;
 
     if (auto const data = Varicode::unpackFastDataMessage(m); data.isEmpty()) {
         return false;
     } else {
-        message_ = data;
-        frameType_ = Varicode::FrameData;
+        u.message = data;
+        u.frameType = Varicode::FrameData;
 
         return true;
     }
@@ -122,19 +182,22 @@ bool DecodedText::tryUnpackFastData(QString const &m) {
  * @private
  * @brief Try to unpack data message (private)
  *
+ * @param u
  * @param m
+ * @param bits
  * @return true
  * @return false
  */
-bool DecodedText::tryUnpackData(QString const &m) {
-    if ((bits_ & Varicode::JS8CallData) == Varicode::JS8CallData)
+bool DecodedText::tryUnpackData(Unpacked &u, QString const &m,
+                                int const bits) {
+    if ((bits & Varicode::JS8CallData) == Varicode::JS8CallData)
         return false;
 
     if (auto const data = Varicode::unpackDataMessage(m); data.isEmpty()) {
         return false;
     } else {
-        message_ = data;
-        frameType_ = Varicode::FrameData;
+        u.message = data;
+        u.frameType = Varicode::FrameData;
 
         return true;
     }
@@ -144,12 +207,15 @@ bool DecodedText::tryUnpackData(QString const &m) {
  * @private
  * @brief Try to unpack heartbeat message (private)
  *
+ * @param u
  * @param m
+ * @param bits
  * @return true
  * @return false
  */
-bool DecodedText::tryUnpackHeartbeat(QString const &m) {
-    if ((bits_ & Varicode::JS8CallData) == Varicode::JS8CallData)
+bool DecodedText::tryUnpackHeartbeat(Unpacked &u, QString const &m,
+                                     int const bits) {
+    if ((bits & Varicode::JS8CallData) == Varicode::JS8CallData)
         return false;
 
     bool isAlt = false;
@@ -166,21 +232,21 @@ bool DecodedText::tryUnpackHeartbeat(QString const &m) {
     // 1         0   HB
     // 1         1   CQ
 
-    frameType_ = type;
-    isHeartbeat_ = true;
-    isAlt_ = isAlt;
-    extra_ = parts.value(2, QString());
-    compound_ = buildCompound(parts);
-    message_ = compound_ % ": ";
+    u.frameType = type;
+    u.isHeartbeat = true;
+    u.isAlt = isAlt;
+    u.extra = parts.value(2, QString());
+    u.compound = buildCompound(parts);
+    u.message = u.compound % ": ";
 
     if (isAlt) {
-        message_ += "@ALLCALL " % Varicode::cqString(bits3);
+        u.message += "@ALLCALL " % Varicode::cqString(bits3);
     } else {
         auto const sbits3 = Varicode::hbString(bits3);
-        message_ += "@HB " % (sbits3 == "HB" ? "HEARTBEAT" : sbits3);
+        u.message += "@HB " % (sbits3 == "HB" ? "HEARTBEAT" : sbits3);
     }
 
-    message_ += ' ' % extra_ % ' ';
+    u.message += ' ' % u.extra % ' ';
 
     return true;
 }
@@ -189,31 +255,34 @@ bool DecodedText::tryUnpackHeartbeat(QString const &m) {
  * @private
  * @brief Try to unpack compound message (private)
  *
+ * @param u
  * @param m
+ * @param bits
  * @return true
  * @return false
  */
-bool DecodedText::tryUnpackCompound(QString const &m) {
+bool DecodedText::tryUnpackCompound(Unpacked &u, QString const &m,
+                                    int const bits) {
     quint8 type = Varicode::FrameUnknown;
     quint8 bits3 = 0;
     auto const parts = Varicode::unpackCompoundMessage(m, &type, &bits3);
 
     if (parts.length() < 2 ||
-        (bits_ & Varicode::JS8CallData) == Varicode::JS8CallData)
+        (bits & Varicode::JS8CallData) == Varicode::JS8CallData)
         return false;
 
-    frameType_ = type;
-    extra_ = parts.mid(2).join(' ');
-    compound_ = buildCompound(parts);
+    u.frameType = type;
+    u.extra = parts.mid(2).join(' ');
+    u.compound = buildCompound(parts);
 
     if (type == Varicode::FrameCompound) {
-        message_ = compound_ % ": ";
+        u.message = u.compound % ": ";
     } else if (type == Varicode::FrameCompoundDirected) {
-        message_ = compound_ % extra_ % ' ';
+        u.message = u.compound % u.extra % ' ';
 
-        directed_.reserve(parts.size() - 2 + 2);
-        directed_ = {"<....>", compound_};
-        directed_ += parts.mid(2);
+        u.directed.reserve(parts.size() - 2 + 2);
+        u.directed = {"<....>", u.compound};
+        u.directed += parts.mid(2);
     }
 
     return true;
@@ -223,12 +292,15 @@ bool DecodedText::tryUnpackCompound(QString const &m) {
  * @private
  * @brief Try to unpack directed message (private)
  *
+ * @param u
  * @param m
+ * @param bits
  * @return true
  * @return false
  */
-bool DecodedText::tryUnpackDirected(QString const &m) {
-    if ((bits_ & Varicode::JS8CallData) == Varicode::JS8CallData)
+bool DecodedText::tryUnpackDirected(Unpacked &u, QString const &m,
+                                    int const bits) {
+    if ((bits & Varicode::JS8CallData) == Varicode::JS8CallData)
         return false;
 
     quint8 type = Varicode::FrameUnknown;
@@ -240,16 +312,16 @@ bool DecodedText::tryUnpackDirected(QString const &m) {
     switch (parts.length()) {
     case 3: // Directed message         => "0: 12 "
     case 4: // Directed numeric message => "0: 12 3 "
-        message_ =
+        u.message =
             parts.at(0) % ": " % parts.at(1) % parts.mid(2).join(' ') % ' ';
         break;
     default: // Free text message
-        message_ = parts.join("");
+        u.message = parts.join("");
         break;
     }
 
-    directed_ = parts;
-    frameType_ = type;
+    u.directed = parts;
+    u.frameType = type;
 
     return true;
 }
@@ -303,9 +375,9 @@ DecodedText::DecodedText(QString const &frame, int const bits,
 QStringList DecodedText::messageWords() const {
     QStringList words;
 
-    words.reserve(message_.count(' ') + 2);
-    words.append(message_);
-    words.append(message_.split(' ', Qt::SkipEmptyParts));
+    words.reserve(unpacked_.message.count(' ') + 2);
+    words.append(unpacked_.message);
+    words.append(unpacked_.message.split(' ', Qt::SkipEmptyParts));
 
     return words;
 }
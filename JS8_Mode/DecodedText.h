@@ -22,19 +22,19 @@ class DecodedText {
     // Inline accessors
 
     int bits() const { return bits_; }
-    QString compoundCall() const { return compound_; }
-    QStringList directedMessage() const { return directed_; }
+    QString compoundCall() const { return unpacked_.compound; }
+    QStringList directedMessage() const { return unpacked_.directed; }
     float dt() const { return dt_; }
-    QString extra() const { return extra_; }
+    QString extra() const { return unpacked_.extra; }
     QString frame() const { return frame_; }
-    quint8 frameType() const { return frameType_; }
+    quint8 frameType() const { return unpacked_.frameType; }
     int frequencyOffset() const { return frequencyOffset_; }
-    bool isAlt() const { return isAlt_; }
-    bool isCompound() const { return !compound_.isEmpty(); }
-    bool isDirectedMessage() const { return directed_.length() > 2; }
-    bool isHeartbeat() const { return isHeartbeat_; }
+    bool isAlt() const { return unpacked_.isAlt; }
+    bool isCompound() const { return !unpacked_.compound.isEmpty(); }
+    bool isDirectedMessage() const { return unpacked_.directed.length() > 2; }
+    bool isHeartbeat() const { return unpacked_.isHeartbeat; }
     bool isLowConfidence() const { return isLowConfidence_; }
-    QString message() const { return message_; }
+    QString message() const { return unpacked_.message; }
     int snr() const { return snr_; }
     int submode() const { return submode_; }
     // You can use decode_time() from commons.h to split up this integer:
@@ -46,14 +46,30 @@ class DecodedText {
     QString string() const;
 
   private:
+    // Results of unpacking a frame. These depend only on the frame and
+    // its bits, and are implicitly shared, so that repeated frames are
+    // unpacked once, then copied from a cache.
+
+    struct Unpacked {
+        quint8 frameType;
+        bool isAlt = false;
+        bool isHeartbeat = false;
+        QString compound;
+        QStringList directed;
+        QString extra;
+        QString message;
+    };
+
+    static Unpacked unpack(QString const &frame, int bits);
+
     // Unpacking strategies, attempted in order until one of them
     // works or all of them have failed.
 
-    bool tryUnpackFastData(QString const &);
-    bool tryUnpackData(QString const &);
-    bool tryUnpackHeartbeat(QString const &);
-    bool tryUnpackCompound(QString const &);
-    bool tryUnpackDirected(QString const &);
+    static bool tryUnpackFastData(Unpacked &, QString const &, int bits);
+    static bool tryUnpackData(Unpacked &, QString const &, int bits);
+    static bool tryUnpackHeartbeat(Unpacked &, QString const &, int bits);
+    static bool tryUnpackCompound(Unpacked &, QString const &, int bits);
+    static bool tryUnpackDirected(Unpacked &, QString const &, int bits);
 
     static constexpr std::array unpackStrategies = {
         &DecodedText::tryUnpackFastData, &DecodedText::tryUnpackData,
@@ -69,21 +85,15 @@ class DecodedText {
 
     // Data members ** ORDER DEPENDENCY **
 
-    quint8 frameType_;
     QString frame_;
-    bool isAlt_;
-    bool isHeartbeat_;
     bool isLowConfidence_;
-    QString compound_;
-    QStringList directed_;
-    QString extra_;
-    QString message_;
     int bits_;
     int submode_;
     int time_;
     int frequencyOffset_;
     int snr_;
     float dt_;
+    Unpacked unpacked_;
 };
 
 #endif // DECODEDTEXT_H
@@ -60,7 +60,19 @@ Q_DECLARE_LOGGING_CATEGORY(detector_js8)
  */
 Detector::Detector(unsigned frameRate, unsigned periodLengthInSeconds,
                    QObject *parent)
-    : AudioDevice(parent), m_frameRate(frameRate),
+    : Detector(frameRate, periodLengthInSeconds, dec_data, parent) {}
+
+/**
+ * @brief Construct a new Detector object writing into specific decode data
+ * 
+ * @param frameRate 
+ * @param periodLengthInSeconds 
+ * @param data 
+ * @param parent 
+ */
+Detector::Detector(unsigned frameRate, unsigned periodLengthInSeconds,
+                   struct dec_data &data, QObject *parent)
+    : AudioDevice(parent), m_data(data), m_frameRate(frameRate),
       m_period(periodLengthInSeconds), m_filter(LOWPASS) {
     clear();
 }
@@ -94,13 +106,13 @@ void Detector::clear() {
     resetBufferPosition();
     resetBufferContent();
 #else
-    dec_data.params.kin = 0;
+    m_data.params.kin = 0;
     m_bufferPos = 0;
 #endif
 
     // fill buffer with zeros (G4WJS commented out because it might cause
-    // decoder hangs) qFill (dec_data.d2, dec_data.d2 + sizeof (dec_data.d2) /
-    // sizeof (dec_data.d2[0]), 0);
+    // decoder hangs) qFill (m_data.d2, m_data.d2 + sizeof (m_data.d2) /
+    // sizeof (m_data.d2[0]), 0);
 }
 
 /**
@@ -113,27 +125,27 @@ void Detector::resetBufferPosition() {
     // set index to roughly where we are in time (1ms resolution)
     qint64 const now = DriftingDateTime::currentMSecsSinceEpoch();
     unsigned const msInPeriod = (now % 86400000LL) % (m_period * 1000);
-    int const prevKin = dec_data.params.kin;
+    int const prevKin = m_data.params.kin;
 
-    dec_data.params.kin = qMin(
+    m_data.params.kin = qMin(
         (msInPeriod * m_frameRate) / 1000,
-        static_cast<unsigned>(sizeof(dec_data.d2) / sizeof(dec_data.d2[0])));
+        static_cast<unsigned>(sizeof(m_data.d2) / sizeof(m_data.d2[0])));
     m_bufferPos = 0;
     m_ns = secondInPeriod();
 
-    int const delta = dec_data.params.kin - prevKin;
+    int const delta = m_data.params.kin - prevKin;
 
     qCDebug(detector_js8) << "advancing detector buffer from" << prevKin << "to"
-                          << dec_data.params.kin << "delta" << delta;
+                          << m_data.params.kin << "delta" << delta;
 
     // rotate buffer moving the contents that were at prevKin to the new kin
     // position
     if (delta < 0) {
-        std::rotate(std::begin(dec_data.d2), std::begin(dec_data.d2) - delta,
-                    std::end(dec_data.d2));
+        std::rotate(std::begin(m_data.d2), std::begin(m_data.d2) - delta,
+                    std::end(m_data.d2));
     } else {
-        std::rotate(std::rbegin(dec_data.d2), std::rbegin(dec_data.d2) + delta,
-                    std::rend(dec_data.d2));
+        std::rotate(std::rbegin(m_data.d2), std::rbegin(m_data.d2) + delta,
+                    std::rend(m_data.d2));
     }
 }
 
@@ -144,7 +156,7 @@ void Detector::resetBufferPosition() {
 void Detector::resetBufferContent() {
     QMutexLocker mutex(&m_lock);
 
-    std::fill(std::begin(dec_data.d2), std::end(dec_data.d2), 0);
+    std::fill(std::begin(m_data.d2), std::end(m_data.d2), 0);
     qCDebug(detector_js8) << "clearing detector buffer content";
 }
 
@@ -162,7 +174,7 @@ qint64 Detector::writeData(char const *const data, qint64 const maxSize) {
 
     int const ns = secondInPeriod();
     if (ns < m_ns) {
-        dec_data.params.kin = 0;
+        m_data.params.kin = 0;
         m_bufferPos = 0;
     }
     m_ns = ns;
@@ -174,7 +186,7 @@ qint64 Detector::writeData(char const *const data, qint64 const maxSize) {
     // These are in terms of input frames (not down sampled).
 
     size_t const framesAcceptable =
-        (sizeof(dec_data.d2) / sizeof(dec_data.d2[0]) - dec_data.params.kin) *
+        (sizeof(m_data.d2) / sizeof(m_data.d2[0]) - m_data.params.kin) *
         Filter::NDOWN;
     size_t const framesAccepted =
         qMin(static_cast<size_t>(maxSize / bytesPerFrame()), framesAcceptable);
@@ -182,7 +194,7 @@ qint64 Detector::writeData(char const *const data, qint64 const maxSize) {
     if (framesAccepted < static_cast<size_t>(maxSize / bytesPerFrame())) {
         qCDebug(detector_js8)
             << "dropped " << maxSize / bytesPerFrame() - framesAccepted
-            << " frames of data on the floor!" << dec_data.params.kin << ns;
+            << " frames of data on the floor!" << m_data.params.kin << ns;
     }
 
     for (auto remaining = framesAccepted; remaining;) {
@@ -195,15 +207,15 @@ qint64 Detector::writeData(char const *const data, qint64 const maxSize) {
         m_bufferPos += numFramesProcessed;
 
         if (m_bufferPos == m_samplesPerFFT * Filter::NDOWN) {
-            if (dec_data.params.kin >= 0 &&
-                dec_data.params.kin <
+            if (m_data.params.kin >= 0 &&
+                m_data.params.kin <
                     static_cast<int>(JS8_NTMAX * 12000 - m_samplesPerFFT)) {
                 for (std::size_t i = 0; i < m_samplesPerFFT; ++i) {
-                    dec_data.d2[dec_data.params.kin++] =
+                    m_data.d2[m_data.params.kin++] =
                         m_filter.downSample(&m_buffer[i * Filter::NDOWN]);
                 }
             }
-            Q_EMIT framesWritten(dec_data.params.kin);
+            Q_EMIT framesWritten(m_data.params.kin);
             m_bufferPos = 0;
         }
         remaining -= numFramesProcessed;
@@ -5,6 +5,8 @@
 #include <array>
 #include <vendor/Eigen/Dense>
 
+struct dec_data;
+
 // Output device that distributes data in predefined chunks via a signal;
 // underlying device for this abstraction is just the buffer that stores
 // samples throughout a receiving period.
@@ -68,10 +70,13 @@ class Detector : public AudioDevice {
     using Buffer = std::array<short, MaxBufferSize * Filter::NDOWN>;
 
   public:
-    // Constructor
+    // Constructor; the detector writes into the supplied decode data,
+    // which by default is the global decode data of the primary receiver.
 
     Detector(unsigned frameRate, unsigned periodLengthInSeconds,
              QObject *parent = nullptr);
+    Detector(unsigned frameRate, unsigned periodLengthInSeconds,
+             struct dec_data &data, QObject *parent = nullptr);
 
     // Inline accessors
 
@@ -107,6 +112,7 @@ class Detector : public AudioDevice {
   private:
     // Data members
 
+    struct dec_data &m_data;
     unsigned m_frameRate;
     unsigned m_period;
     QMutex m_lock;
@@ -12,6 +12,7 @@
 #include "JS8_Mode/whitening_processor.h"
 #include "ldpc_feedback.h"
 #include "soft_combiner.h"
+#include "sync_search.h"
 #include <QDebug>
 #include <QLoggingCategory>
 #include <QtGlobal>
@@ -30,9 +31,11 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <deque>
 #include <fftw3.h>
 #include <initializer_list>
 #include <limits>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <numbers>
@@ -380,6 +383,20 @@ constexpr auto BASELINE_SAMPLE = 10;
 constexpr auto BASELINE_MIN = 500;
 constexpr auto BASELINE_MAX = 2500;
 
+// Define the closed range in Hz of the traditional audio passband, to
+// which the candidate search is limited by default. In wideband mode,
+// useful when fed a wide SDR audio slice, the search instead covers as
+// much as the symbol spectra of each submode are able to represent.
+
+constexpr auto SEARCH_MIN = 100;
+constexpr auto SEARCH_MAX = 4910;
+
+inline bool widebandEnabled() {
+    bool ok = false;
+    int value = qEnvironmentVariableIntValue("JS8_WIDEBAND", &ok);
+    return ok && value != 0;
+}
+
 // We're going to do a pairwise Estrin's evaluation of the polynomial
 // coefficients, so it's critical that the degree of the polynomial is
 // odd, resulting in an even number of coefficients.
@@ -1073,9 +1090,9 @@ template <typename Mode> class DecodeMode {
     alignas(64) std::array<std::complex<float>, Mode::NFFT1 / 2 + 1> sd;
     alignas(64) std::array<std::complex<float>, NP> cd0;
     std::array<float, Mode::NMAX> dd;
-    std::array<std::array<float, Mode::NHSYM>, Mode::NSPS> s;
+    std::array<std::array<float, Mode::NSPS>, Mode::NHSYM> s;
     std::array<float, Mode::NSPS> savg;
-    FFTWPlanManager plans;
+    std::shared_ptr<FFTWPlanManager> plans;
     SyncIndex sync;
     js8::SoftCombiner<N> m_softCombiner;
     bool m_enableFreqTracking = true;
@@ -1083,9 +1100,32 @@ template <typename Mode> class DecodeMode {
     float m_llrErasureThreshold = js8::llrErasureThreshold();
     bool m_enableLdpcFeedback = js8::ldpcFeedbackEnabled();
     int m_maxLdpcPasses = js8::ldpcFeedbackMaxPasses();
+    bool m_wideband = widebandEnabled();
 
     using Plan = FFTWPlanManager::Type;
 
+    // FFT plans depend only on the mode, not on the arrays they're
+    // executed on, so every decoder of a mode, one per receiver, shares
+    // a single set of them, executing them on its own arrays. The plans
+    // are created by the first decoder of the mode, and destroyed along
+    // with the last; access is under the FFTW mutex.
+
+    inline static std::weak_ptr<FFTWPlanManager> sharedPlans;
+
+    // Execute shared plans on our arrays; complex to complex, and real to
+    // complex, all of them in place, and all of our arrays having the
+    // same alignment as those the plans were created with.
+
+    void execute(Plan const type, std::complex<float> *const data) {
+        auto const cx = reinterpret_cast<fftwf_complex *>(data);
+        fftwf_execute_dft((*plans)[type], cx, cx);
+    }
+
+    void execute_r2c(Plan const type, std::complex<float> *const data) {
+        fftwf_execute_dft_r2c((*plans)[type], reinterpret_cast<float *>(data),
+                              reinterpret_cast<fftwf_complex *>(data));
+    }
+
     static constexpr auto Costas = JS8::Costas::array(Mode::NCOSTAS);
 
     // Fore and aft tapers to reduce spectral leakage during the
@@ -1344,7 +1384,7 @@ template <typename Mode> class DecodeMode {
                 }
             }
 
-            fftwf_execute(plans[Plan::CS]);
+            execute(Plan::CS, csymb.data());
 
             // Normalize and take the magnitude of the first 8 points.
 
@@ -1794,7 +1834,7 @@ template <typename Mode> class DecodeMode {
         std::copy(dd.begin(), dd.end(), fftw_real);
         std::fill(fftw_real + dd.size(), fftw_real + Mode::NDFFT1, 0.0f);
 
-        fftwf_execute(plans[Plan::BB]);
+        execute_r2c(Plan::BB, ds_cx.data());
     }
 
     // This function extracts a narrow frequency band around the target
@@ -1852,7 +1892,7 @@ template <typename Mode> class DecodeMode {
         // downsampled, time-domain signal focused on the extracted narrow
         // frequency band.
 
-        fftwf_execute(plans[Plan::DS]);
+        execute(Plan::DS, cd0.data());
 
         // The resulting time-domain samples are normalized by a factor derived
         // from the input and output FFT sizes (Mode::NDFFT1 and Mode::NDFFT2),
@@ -1886,7 +1926,9 @@ template <typename Mode> class DecodeMode {
     //
     //     - Adjusts the frequency bounds (nfa and nfb) to ensure the analysis
     //     remains
-    //       within valid and meaningful regions of the signal.
+    //       within valid and meaningful regions of the signal; the audio
+    //       passband by default, or in wideband mode, the full extent of
+    //       the symbol spectra.
     //
     // 3.  Baseline Computation:
     //
@@ -1952,29 +1994,37 @@ template <typename Mode> class DecodeMode {
                            reinterpret_cast<float *>(sd.data()),
                            std::multiplies<float>{});
 
-            fftwf_execute(plans[Plan::SD]);
+            execute_r2c(Plan::SD, sd.data());
 
             // Compute power spectrum
 
             for (int i = 0; i < Mode::NSPS; ++i) {
                 auto const power = std::norm(sd[i]);
-                s[i][j] = power;
+                s[j][i] = power;
                 savg[i] += power;
             }
         }
 
-        // Filter edge sanity measures
+        // Filter edge sanity measures; in wideband mode, the highest
+        // frequency searched is that at which the top tone of a signal
+        // is still within the symbol spectra.
+
+        auto const [fmin, fmax] =
+            m_wideband ? std::pair{0, static_cast<int>(
+                                          (Mode::NSPS - 1 - NFOS * 7) *
+                                          Mode::DF)}
+                       : std::pair{SEARCH_MIN, SEARCH_MAX};
 
         int const nwin = nfb - nfa;
 
-        if (nfa < 100) {
-            nfa = 100;
+        if (nfa < fmin) {
+            nfa = fmin;
             if (nwin < 100)
                 nfb = nfa + nwin;
         }
 
-        if (nfb > 4910) {
-            nfb = 4910;
+        if (nfb > fmax) {
+            nfb = fmax;
             if (nwin < 100)
                 nfa = nfb - nwin;
         }
@@ -1992,64 +2042,13 @@ template <typename Mode> class DecodeMode {
 
         sync.clear();
 
-        for (int i = ia; i <= ib; ++i) {
-            float max_value = -std::numeric_limits<float>::infinity();
-            int max_index = -Mode::JZ;
-
-            for (int j = -Mode::JZ; j <= Mode::JZ; ++j) {
-                std::array<std::array<float, 3>, 2> t{};
-
-                for (int p = 0; p < 3; ++p) {
-                    for (int n = 0; n < 7; ++n) {
-                        int const offset =
-                            j + Mode::JSTRT + NSSY * n + p * 36 * NSSY;
-
-                        if (offset >= 0 && offset < Mode::NHSYM) {
-                            // Accumulate Costas pattern contributions.
-
-                            t[0][p] += s[i + NFOS * Costas[p][n]][offset];
-
-                            // Accumulate sum over all frequencies for this
-                            // block.
-
-                            for (int freq = 0; freq < 7; ++freq) {
-                                t[1][p] += s[i + NFOS * freq][offset];
-                            }
-                        }
-                    }
-                }
-
-                // Compute sync metric over the index range. We are at the
-                // moment maintaining the Fortran summation methodology for
-                // compatibility testing; there are more efficient ways to do
-                // this, but IEEE 754 addition is a touchy thing, so we'll need
-                // to ensure that any changes don't negatively affect result
-                // precision.
-
-                auto const compute_sync = [&t](int start, int end) {
-                    float tx = 0.0f;
-                    float t0 = 0.0f;
-
-                    for (int i = start; i <= end; ++i) {
-                        tx += t[0][i];
-                        t0 += t[1][i];
-                    }
-
-                    return tx / ((t0 - tx) / 6.0f);
-                };
-
-                if (auto const sync_value =
-                        std::max({compute_sync(0, 2), compute_sync(0, 1),
-                                  compute_sync(1, 2)});
-                    sync_value > max_value) {
-                    max_value = sync_value;
-                    max_index = j;
-                }
-            }
-
-            sync.emplace(Mode::DF * i, Mode::TSTEP * (max_index + 0.5f),
-                         max_value);
-        }
+        js8::syncSearch<Mode::NHSYM, Mode::NSPS, NFOS, NSSY, Mode::JZ,
+                        Mode::JSTRT>(
+            s, Costas, ia, ib,
+            [this](int const i, float const max_value, int const max_index) {
+                sync.emplace(Mode::DF * i, Mode::TSTEP * (max_index + 0.5f),
+                             max_value);
+            });
 
         // If we found nothing, we're done here.
 
@@ -2235,7 +2234,7 @@ template <typename Mode> class DecodeMode {
 
         // FFT to the frequency domain.
 
-        fftwf_execute(plans[Plan::CF]);
+        execute(Plan::CF, cfilt.data());
 
         // Apply the filter in the frequency domain.
 
@@ -2244,7 +2243,7 @@ template <typename Mode> class DecodeMode {
 
         // Inverse FFT to return to the time domain.
 
-        fftwf_execute(plans[Plan::CB]);
+        execute(Plan::CB, cfilt.data());
 
         // Subtract the reconstructed signal.
 
@@ -2384,45 +2383,58 @@ template <typename Mode> class DecodeMode {
                            return value * factor;
                        });
 
-        // The rest of our FFT plans are always the same size and operate on the
-        // same data, so we can reuse them as long as we're alive.
+        // The rest of our FFT plans are always the same size, so we can
+        // reuse them as long as we're alive; if another decoder of this
+        // mode is alive, we share its plans. Any we create are declared
+        // ahead of the lock, so that if we throw, they're destroyed with
+        // it released, as the plan manager takes it.
 
+        std::shared_ptr<FFTWPlanManager> created;
         std::lock_guard<std::mutex> lock(fftw_mutex);
 
-        plans[Plan::DS] = fftwf_plan_dft_1d(
+        if (plans = sharedPlans.lock(); plans)
+            return;
+
+        created = std::make_shared<FFTWPlanManager>();
+
+        auto &plan = *created;
+
+        plan[Plan::DS] = fftwf_plan_dft_1d(
             Mode::NDFFT2, reinterpret_cast<fftwf_complex *>(cd0.data()),
             reinterpret_cast<fftwf_complex *>(cd0.data()), FFTW_BACKWARD,
             FFTW_ESTIMATE_PATIENT);
 
-        plans[Plan::BB] = fftwf_plan_dft_r2c_1d(
+        plan[Plan::BB] = fftwf_plan_dft_r2c_1d(
             Mode::NDFFT1, reinterpret_cast<float *>(ds_cx.data()),
             reinterpret_cast<fftwf_complex *>(ds_cx.data()),
             FFTW_ESTIMATE_PATIENT);
 
-        plans[Plan::CF] = fftwf_plan_dft_1d(
+        plan[Plan::CF] = fftwf_plan_dft_1d(
             Mode::NMAX, reinterpret_cast<fftwf_complex *>(cfilt.data()),
             reinterpret_cast<fftwf_complex *>(cfilt.data()), FFTW_FORWARD,
             FFTW_ESTIMATE_PATIENT);
 
-        plans[Plan::CB] = fftwf_plan_dft_1d(
+        plan[Plan::CB] = fftwf_plan_dft_1d(
             Mode::NMAX, reinterpret_cast<fftwf_complex *>(cfilt.data()),
             reinterpret_cast<fftwf_complex *>(cfilt.data()), FFTW_BACKWARD,
             FFTW_ESTIMATE_PATIENT);
 
-        plans[Plan::SD] = fftwf_plan_dft_r2c_1d(
+        plan[Plan::SD] = fftwf_plan_dft_r2c_1d(
             Mode::NFFT1, reinterpret_cast<float *>(sd.data()),
             reinterpret_cast<fftwf_complex *>(sd.data()),
             FFTW_ESTIMATE_PATIENT);
 
-        plans[Plan::CS] = fftwf_plan_dft_1d(
+        plan[Plan::CS] = fftwf_plan_dft_1d(
             Mode::NDOWNSPS, reinterpret_cast<fftwf_complex *>(csymb.data()),
             reinterpret_cast<fftwf_complex *>(csymb.data()), FFTW_FORWARD,
             FFTW_ESTIMATE_PATIENT);
 
-        for (auto plan : plans) {
-            if (!plan)
+        for (auto p : plan) {
+            if (!p)
                 throw std::runtime_error("Failed to create FFT plan");
         }
+
+        sharedPlans = plans = std::move(created);
     }
 
     // Decode entry point.
@@ -2576,12 +2588,10 @@ class Worker : public QObject {
     // to avoid initializing them on the main thread.
 
     class Impl {
-        // To avoid data races, decode data is referenced here but is
-        // actually located in the Worker that instantiates us, as it
-        // must be possible to copy data for us before we're ready to
-        // process it.
+        // Decode data isn't held here, but supplied for each pass; the
+        // entries below refer to their positions and sizes within it.
 
-        struct dec_data &m_data;
+        using Params = decltype(dec_data::params);
 
         // Mode-specific decode strategy; we'll instantiate one of
         // these for each of the 5 modes; this class is an aggregate
@@ -2593,12 +2603,12 @@ class Worker : public QObject {
                          DecodeMode<ModeI>>
                 decode;
             int mode;
-            int &kpos;
-            int &ksz;
+            int Params::*kpos;
+            int Params::*ksz;
 
             template <typename DecodeModeType>
             DecodeEntry(std::in_place_type_t<DecodeModeType>, int mode,
-                        int &kpos, int &ksz)
+                        int Params::*kpos, int Params::*ksz)
                 : decode(std::in_place_type<DecodeModeType>), mode(mode),
                   kpos(kpos), ksz(ksz) {}
         };
@@ -2611,33 +2621,30 @@ class Worker : public QObject {
         // version here in terms of faster modes first.
 
         template <typename ModeType>
-        DecodeEntry makeDecodeEntry(int shift, int &kpos, int &ksz) {
+        DecodeEntry makeDecodeEntry(int shift, int Params::*kpos,
+                                    int Params::*ksz) {
             return DecodeEntry(std::in_place_type<DecodeMode<ModeType>>,
                                1 << shift, kpos, ksz);
         }
 
         std::array<DecodeEntry, 5> m_decodes = {
-            {makeDecodeEntry<ModeI>(4, m_data.params.kposI, m_data.params.kszI),
-             makeDecodeEntry<ModeE>(3, m_data.params.kposE, m_data.params.kszE),
-             makeDecodeEntry<ModeC>(2, m_data.params.kposC, m_data.params.kszC),
-             makeDecodeEntry<ModeB>(1, m_data.params.kposB, m_data.params.kszB),
-             makeDecodeEntry<ModeA>(0, m_data.params.kposA,
-                                    m_data.params.kszA)}};
+            {makeDecodeEntry<ModeI>(4, &Params::kposI, &Params::kszI),
+             makeDecodeEntry<ModeE>(3, &Params::kposE, &Params::kszE),
+             makeDecodeEntry<ModeC>(2, &Params::kposC, &Params::kszC),
+             makeDecodeEntry<ModeB>(1, &Params::kposB, &Params::kszB),
+             makeDecodeEntry<ModeA>(0, &Params::kposA, &Params::kszA)}};
 
       public:
-        // Constructor
-
-        explicit Impl(struct dec_data &data) : m_data(data) {}
+        // Execute a decoding pass over the supplied data, using the
+        // supplied event emitter to emit events as they occur.
 
-        // Execute a decoding pass, using the supplied event emitter to
-        // emit events as they occur.
-
-        void operator()(::JS8::Event::Emitter emitEvent) {
+        void operator()(struct dec_data const &data,
+                        ::JS8::Event::Emitter emitEvent) {
             // The multi-decoder can provide data for multiple modes at
             // the same time; specific decodes to be performed for this
             // pass are in the `nsubmodes` bitset.
 
-            auto const set = m_data.params.nsubmodes;
+            auto const set = data.params.nsubmodes;
             std::size_t sum = 0;
 
             // Let any interested parties know that we've started a run
@@ -2653,8 +2660,8 @@ class Worker : public QObject {
                 if ((set & entry.mode) == entry.mode) {
                     std::visit(
                         [&](auto &&decode) {
-                            sum += decode(m_data, entry.kpos, entry.ksz,
-                                          emitEvent);
+                            sum += decode(data, data.params.*entry.kpos,
+                                          data.params.*entry.ksz, emitEvent);
                         },
                         entry.decode);
                 }
@@ -2667,11 +2674,44 @@ class Worker : public QObject {
         }
     };
 
+    // A pending decoding pass; the receiver that supplied the data, and
+    // a copy of the data, made at the time the pass was requested. The
+    // pass decodes the copy in place. Data copies are large, and the same
+    // number of them are in play every period, so they're drawn from and
+    // returned to a pool.
+
+    struct Job {
+        int receiver;
+        std::unique_ptr<struct dec_data> data;
+    };
+
     // Data members
 
     QSemaphore *m_semaphore;
     std::atomic<bool> m_quit = false;
-    struct dec_data m_data;
+    std::mutex m_mutex;
+    std::deque<Job> m_jobs;
+    std::vector<std::unique_ptr<struct dec_data>> m_pool;
+
+    // Take the next pending job, if any; once taken, its data is ours
+    // alone until we return it to the pool.
+
+    std::optional<Job> next() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_jobs.empty())
+            return std::nullopt;
+
+        auto job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+
+        return job;
+    }
+
+    void recycle(std::unique_ptr<struct dec_data> data) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pool.push_back(std::move(data));
+    }
 
   public:
     // Constructor
@@ -2685,10 +2725,34 @@ class Worker : public QObject {
 
     void stop() { m_quit = true; }
 
-    // Called by the owning Decoder to refresh the copy of the
-    // decode data that the Worker implementation references.
+    // Called by the owning Decoder to queue a copy of the decode data
+    // supplied by a receiver for a decoding pass. Each receiver has at
+    // most one pass pending; if one is, its data is refreshed in place.
+
+    void copy(int const receiver, struct dec_data const &data) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (auto const it = std::find_if(
+                m_jobs.begin(), m_jobs.end(),
+                [receiver](auto const &job) { return job.receiver == receiver; });
+            it != m_jobs.end()) {
+            *it->data = data;
+            return;
+        }
 
-    void copy() { m_data = dec_data; };
+        std::unique_ptr<struct dec_data> copy;
+
+        if (m_pool.empty()) {
+            copy = std::make_unique<struct dec_data>(data);
+        } else {
+            copy = std::move(m_pool.back());
+            m_pool.pop_back();
+            *copy = data;
+        }
+
+        m_jobs.push_back({receiver, std::move(copy)});
+        m_semaphore->release();
+    }
 
   signals:
 
@@ -2711,7 +2775,16 @@ class Worker : public QObject {
         // can take a while. We only need the implementation while
         // we're running.
 
-        std::unique_ptr<Impl> impl = std::make_unique<Impl>(m_data);
+        //
+        // Each receiver gets an implementation of its own, created the
+        // first time the receiver supplies data; decoders carry state
+        // from one pass to the next, soft combining in particular, and
+        // that must never mix data from different radios. All of them
+        // share this thread, and the FFT plans of each mode.
+
+        std::map<int, std::unique_ptr<Impl>> impls;
+
+        impls.emplace(0, std::make_unique<Impl>());
 
         // Wait until there's something that requires our attention,
         // which is going to either be needing to quit or needing to
@@ -2723,9 +2796,39 @@ class Worker : public QObject {
             if (m_quit)
                 break;
 
-            (*impl)([this](::JS8::Event::Variant const &event) {
-                emit decodeEvent(event);
+            auto job = next();
+
+            if (!job)
+                continue;
+
+            auto &impl = impls[job->receiver];
+
+            if (!impl)
+                impl = std::make_unique<Impl>();
+
+            // Events from the primary receiver go out as is; those from
+            // any other are tagged with the receiver identifier.
+
+            (*impl)(*job->data, [this, receiver = job->receiver](
+                                    ::JS8::Event::Variant const &event) {
+                if (receiver == 0) {
+                    emit decodeEvent(event);
+                } else {
+                    auto tagged = event;
+
+                    std::visit(
+                        [receiver](auto &e) {
+                            if constexpr (requires { e.receiver; }) {
+                                e.receiver = receiver;
+                            }
+                        },
+                        tagged);
+
+                    emit decodeEvent(tagged);
+                }
             });
+
+            recycle(std::move(job->data));
         }
     }
 };
@@ -2757,9 +2860,10 @@ void JS8::Decoder::quit() {
     m_thread.wait();
 }
 
-void JS8::Decoder::decode() {
-    m_worker->copy();
-    m_semaphore.release();
+void JS8::Decoder::decode() { decode(0, dec_data); }
+
+void JS8::Decoder::decode(int const receiver, struct dec_data const &data) {
+    m_worker->copy(receiver, data);
 }
 
 /******************************************************************************/
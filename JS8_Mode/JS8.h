@@ -9,6 +9,8 @@
 #include <string>
 #include <variant>
 
+struct dec_data;
+
 namespace JS8 {
 Q_NAMESPACE
 
@@ -40,13 +42,18 @@ void encode(int type, Costas::Array const &costas, const char *message,
             int *tones);
 
 namespace Event {
+// Events carry the identifier of the receiver that supplied the data
+// decoded; the primary receiver is always zero.
+
 struct DecodeStarted {
     int submodes;
+    int receiver = 0;
 };
 
 struct SyncStart {
     int position;
     int size;
+    int receiver = 0;
 };
 
 struct SyncState {
@@ -58,6 +65,7 @@ struct SyncState {
         int candidate;
         float decoded;
     } sync;
+    int receiver = 0;
 };
 
 struct Decoded {
@@ -69,10 +77,12 @@ struct Decoded {
     int type;
     float quality;
     int mode;
+    int receiver = 0;
 };
 
 struct DecodeFinished {
     std::size_t decoded;
+    int receiver = 0;
 };
 
 using Variant =
@@ -102,6 +112,7 @@ class Decoder : public QObject {
     void start(QThread::Priority priority);
     void quit();
     void decode();
+    void decode(int receiver, struct dec_data const &data);
 };
 } // namespace JS8
 
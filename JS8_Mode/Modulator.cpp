@@ -11,17 +11,40 @@
 #include <QDateTime>
 #include <QLoggingCategory>
 #include <QtMath>
-#include <limits>
+#include <algorithm>
+#include <cmath>
 #include <numbers>
+#include <tuple>
+#include <utility>
 
 #include "moc_Modulator.cpp"
 
 Q_DECLARE_LOGGING_CATEGORY(modulator_js8)
 
 namespace {
-constexpr double TAU = 2 * std::numbers::pi;
 constexpr auto FRAME_RATE = 48000;
 constexpr auto MS_PER_SEC = 1000;
+
+/**
+ * @brief Compute the fade out bounds of a transmission
+ *
+ * Returns the frame at which the fade out starts, and the frame at which
+ * the transmission ends; there's no fade out during tuning.
+ *
+ * @param tuning
+ * @param framesPerSymbol
+ * @return std::pair<unsigned, unsigned>
+ */
+std::pair<unsigned, unsigned> fadeBounds(bool const tuning,
+                                         unsigned const framesPerSymbol) {
+    if (tuning) {
+        auto const end = static_cast<unsigned>(9999.0 / 4.0 * framesPerSymbol);
+        return {end, end};
+    }
+
+    return {static_cast<unsigned>((JS8_NUM_SYMBOLS - 0.017) * framesPerSymbol),
+            JS8_NUM_SYMBOLS * framesPerSymbol};
+}
 } // namespace
 
 /**
@@ -52,15 +75,43 @@ void Modulator::start(double const frequency, int const submode,
 
     m_quickClose = false;
     m_audioFrequency = frequency;
-    m_nsps = JS8::Submode::samplesForOneSymbol(submode);
+    m_framesPerSymbol = JS8::Submode::samplesForOneSymbol(submode) *
+                        (FRAME_RATE / JS8_RX_SAMPLE_RATE);
     m_toneSpacing = JS8::Submode::toneSpacing(submode);
-    m_isym0 = std::numeric_limits<unsigned>::max();
-    m_amp = std::numeric_limits<qint16>::max();
-    m_audioFrequency0 = 0.0;
-    m_phi = 0.0;
     m_silentFrames = 0;
     m_ic = 0;
 
+    // If we're tuning, audio is generated on demand, since we've no idea
+    // how long we'll be doing so. Otherwise, the frame is rendered as it's
+    // played; if it's the one we've been rendering ahead of time, much or
+    // all of it will already have been.
+
+    if (m_tuning) {
+        m_tuneOscillator = ToneOscillator{};
+        m_tuneOscillator.prepare(frequency, m_toneSpacing, FRAME_RATE);
+    } else {
+        QVector<int> tones(JS8_NUM_SYMBOLS);
+        std::copy(std::begin(itone), std::end(itone), tones.begin());
+
+        if (m_next.tones == tones && m_next.audioFrequency == frequency &&
+            m_next.submode == submode) {
+            qCDebug(modulator_js8)
+                << "Using pre-rendered frame," << m_next.rendered << "of"
+                << m_next.pcm.size() << "frames rendered.";
+
+            // The pre-rendered frame is now on the air; the buffers of the
+            // previous frame are available for the next pre-render.
+
+            std::swap(m_frame, m_next);
+            m_next.tones.clear();
+        } else {
+            m_frame.tones = std::move(tones);
+            m_frame.audioFrequency = frequency;
+            m_frame.submode = submode;
+            prepare(m_frame);
+        }
+    }
+
     // If we're not tuning, then we'll need to figure out exactly when we
     // should start transmitting; this will depend on the submode in play.
 
@@ -102,6 +153,17 @@ void Modulator::start(double const frequency, int const submode,
                 << "Starting" << periodOffsetMS
                 << "ms late into transmission, cutting away initial symbol(s).";
             m_ic = (periodOffsetMS - startDelayMS) * FRAME_RATE / MS_PER_SEC;
+
+            // There's no need to render what we'll never play; pick up
+            // from the block in which we start.
+
+            if (auto const from = std::min<std::size_t>(
+                    m_ic / BLOCK_FRAMES * BLOCK_FRAMES, m_frame.pcm.size());
+                m_frame.rendered < from) {
+                m_frame.rendered = from;
+                m_frame.oscillator.re = 1.0;
+                m_frame.oscillator.im = 0.0;
+            }
         }
     } else {
         qCDebug(modulator_js8) << "Modulator finds it is tuning.";
@@ -166,6 +228,177 @@ void Modulator::close() {
     AudioDevice::close();
 }
 
+/**
+ * @brief Set the audio frequency
+ *
+ * Whatever hasn't yet been played of the frame on the air is rendered
+ * again, starting at the next block boundary, where the phasor was
+ * recorded, so the change is phase continuous; any pre-rendered frame
+ * is rendered again from the start. Rendering itself is left to the
+ * audio callback, a little at a time.
+ *
+ * @param audioFrequency
+ */
+void Modulator::setAudioFrequency(double const audioFrequency) {
+    m_audioFrequency = audioFrequency;
+
+    if (m_tuning)
+        return;
+
+    if (m_state.load() != State::Idle &&
+        m_frame.audioFrequency != audioFrequency) {
+        m_frame.audioFrequency = audioFrequency;
+        rewind(m_frame,
+               (m_ic + BLOCK_FRAMES - 1) / BLOCK_FRAMES * BLOCK_FRAMES);
+    }
+
+    if (!m_next.tones.isEmpty() && m_next.audioFrequency != audioFrequency) {
+        m_next.audioFrequency = audioFrequency;
+        rewind(m_next, 0);
+    }
+}
+
+/**
+ * @brief Render a frame ahead of time
+ *
+ * The frame is rendered by the audio callback, alongside the frame on
+ * the air, so that it's ready by the time that one ends.
+ *
+ * @param tones
+ * @param audioFrequency
+ * @param submode
+ */
+void Modulator::prerender(QVector<int> tones, double const audioFrequency,
+                          int const submode) {
+    if (tones.size() != JS8_NUM_SYMBOLS)
+        return;
+
+    if (m_next.tones == tones && m_next.audioFrequency == audioFrequency &&
+        m_next.submode == submode)
+        return;
+
+    m_next.tones = std::move(tones);
+    m_next.audioFrequency = audioFrequency;
+    m_next.submode = submode;
+
+    prepare(m_next);
+}
+
+/**
+ * @brief Prepare a frame to be rendered from the start
+ *
+ * Sizes the buffers, which keep their capacity from frame to frame, and
+ * resets the oscillator; no audio is rendered until it's needed.
+ *
+ * @param frame
+ */
+void Modulator::prepare(Frame &frame) {
+    std::size_t const framesPerSymbol =
+        JS8::Submode::samplesForOneSymbol(frame.submode) *
+        (FRAME_RATE / JS8_RX_SAMPLE_RATE);
+    auto const i1 = fadeBounds(false, framesPerSymbol).second;
+
+    frame.pcm.resize(i1);
+    frame.phasors.resize((i1 + BLOCK_FRAMES - 1) / BLOCK_FRAMES);
+    frame.oscillator.prepare(frame.audioFrequency,
+                             JS8::Submode::toneSpacing(frame.submode),
+                             FRAME_RATE);
+    frame.oscillator.re = 1.0;
+    frame.oscillator.im = 0.0;
+    frame.rendered = 0;
+}
+
+/**
+ * @brief Arrange for a frame to be rendered again from a block boundary
+ *
+ * Restores the phasor recorded at the boundary, if the frame has been
+ * rendered that far; if not, there's nothing to do.
+ *
+ * @param frame
+ * @param from
+ */
+void Modulator::rewind(Frame &frame, std::size_t const from) {
+    Q_ASSERT(!(from % BLOCK_FRAMES));
+
+    if (from >= frame.rendered)
+        return;
+
+    if (from) {
+        std::tie(frame.oscillator.re, frame.oscillator.im) =
+            frame.phasors[from / BLOCK_FRAMES];
+    } else {
+        frame.oscillator.re = 1.0;
+        frame.oscillator.im = 0.0;
+    }
+
+    frame.rendered = from;
+}
+
+/**
+ * @brief Render a frame, up to the provided frame offset
+ *
+ * Renders onward from as far as the frame has been rendered, in whole
+ * blocks, through to the block holding the provided offset, or to the
+ * end of the frame, including the fade out. Runs never cross a block
+ * boundary, a symbol boundary, or the start of the fade out; symbol
+ * lookup is per run, not per sample.
+ *
+ * @param frame
+ * @param until
+ */
+void Modulator::render(Frame &frame, std::size_t const until) {
+    auto const end = std::min(
+        (until + BLOCK_FRAMES - 1) / BLOCK_FRAMES * BLOCK_FRAMES,
+        frame.pcm.size());
+
+    if (frame.rendered >= end)
+        return;
+
+    std::size_t const framesPerSymbol =
+        JS8::Submode::samplesForOneSymbol(frame.submode) *
+        (FRAME_RATE / JS8_RX_SAMPLE_RATE);
+    auto const [i0, i1] = fadeBounds(false, framesPerSymbol);
+
+    // Precompute the fade out ramp, a raised cosine running from full
+    // amplitude down to zero over the fade out period; it depends only
+    // on the length of that period.
+
+    if (auto const size = i1 - i0; m_ramp.size() != size) {
+        m_ramp.resize(size);
+
+        for (unsigned i = 0; i < size; ++i) {
+            m_ramp[i] =
+                0.5 * (1.0 + std::cos(std::numbers::pi * (i + 1) / size));
+        }
+    }
+
+    auto &oscillator = frame.oscillator;
+
+    if (oscillator.audioFrequency != frame.audioFrequency) {
+        oscillator.prepare(frame.audioFrequency,
+                           JS8::Submode::toneSpacing(frame.submode),
+                           FRAME_RATE);
+    }
+
+    for (auto ic = frame.rendered; ic < end;) {
+        if (!(ic % BLOCK_FRAMES)) {
+            frame.phasors[ic / BLOCK_FRAMES] = {oscillator.re, oscillator.im};
+        }
+
+        auto const frames = std::min({BLOCK_FRAMES - ic % BLOCK_FRAMES,
+                                      framesPerSymbol - ic % framesPerSymbol,
+                                      (ic < i0 ? i0 : i1) - ic});
+
+        oscillator.render(frame.pcm.data() + ic, frames,
+                          frame.tones[ic / framesPerSymbol],
+                          ic < i0 ? nullptr : m_ramp.data() + (ic - i0));
+
+        ic += frames;
+    }
+
+    frame.rendered = end;
+}
+
 /**
  * @brief Read data from the modulator
  * 
@@ -205,47 +438,51 @@ qint64 Modulator::readData(char *const data, qint64 const maxSize) {
         [[fallthrough]];
 
     case State::Active: {
-        // Fade out parameters; no fade out during tuning.
+        if (m_tuning) {
+            // Tuning; generate the first tone on demand, until we're told
+            // to stop, or until we hit the end of the tuning period.
+
+            auto const end = fadeBounds(true, m_framesPerSymbol).second;
+
+            while (samples != samplesEnd && m_ic < end) {
+                if (m_tuneOscillator.audioFrequency != m_audioFrequency)
+                    m_tuneOscillator.prepare(m_audioFrequency, m_toneSpacing,
+                                            FRAME_RATE);
 
-        unsigned int const i0 =
-            (m_tuning ? 9999 : (JS8_NUM_SYMBOLS - 0.017) * 4.0) * m_nsps;
-        unsigned int const i1 =
-            (m_tuning ? 9999 : JS8_NUM_SYMBOLS * 4.0) * m_nsps;
+                auto const frames = static_cast<std::size_t>(
+                    std::min<qint64>({maxFrames - framesGenerated,
+                                      BLOCK_FRAMES, end - m_ic}));
 
-        while (samples != samplesEnd && m_ic < i1) {
-            unsigned int const isym = m_tuning ? 0 : m_ic / (4.0 * m_nsps);
+                m_tuneOscillator.render(m_block.data(), frames, itone[0],
+                                        nullptr);
 
-            if (isym != m_isym0 || m_audioFrequency != m_audioFrequency0) {
-                double const toneFrequency =
-                    m_audioFrequency + itone[isym] * m_toneSpacing;
+                samples = load(m_block.data(), frames, samples);
 
-                m_dphi = TAU * toneFrequency / FRAME_RATE;
-                m_isym0 = isym;
-                m_audioFrequency0 = m_audioFrequency;
+                framesGenerated += frames;
+                m_ic += frames;
             }
+        } else if (m_ic < m_frame.pcm.size()) {
+            // Transmitting a frame; render as much of it as we're about
+            // to play, if it hasn't been already, and copy it out
+            // according to the channel layout.
 
-            m_phi += m_dphi;
+            auto const frames = static_cast<std::size_t>(std::min<qint64>(
+                maxFrames - framesGenerated, m_frame.pcm.size() - m_ic));
 
-            if (m_phi > TAU)
-                m_phi -= TAU;
-            if (m_ic > i0)
-                m_amp = 0.98 * m_amp;
-            if (m_ic > i1)
-                m_amp = 0.0;
+            render(m_frame, m_ic + frames);
 
-            samples = load(qRound(m_amp * qSin(m_phi)), samples);
+            samples = load(m_frame.pcm.data() + m_ic, frames, samples);
 
-            ++framesGenerated;
-            ++m_ic;
-        }
+            framesGenerated += frames;
+            m_ic += frames;
 
-        if (m_amp == 0.0) {
-            m_state.store(State::Idle);
-            return framesGenerated * bytesPerFrame();
-            m_phi = 0.0;
-        }
+            // Render twice as much again of the next frame, if there is
+            // one; it'll be ready well before this one ends, and no call
+            // renders more than a few blocks.
 
-        m_audioFrequency0 = m_audioFrequency;
+            if (!m_next.tones.isEmpty())
+                render(m_next, m_next.rendered + 2 * frames);
+        }
 
         // Done for this chunk; continue on the next call. Pad the
         // block with silence.
@@ -2,8 +2,14 @@
 #define MODULATOR_HPP__
 
 #include "JS8_Audio/AudioDevice.h"
+#include "ToneOscillator.h"
 #include <QAudio>
 #include <QPointer>
+#include <QVector>
+#include <array>
+#include <atomic>
+#include <utility>
+#include <vector>
 
 class SoundOutput;
 
@@ -42,12 +48,26 @@ class Modulator final : public AudioDevice {
     /**
      * Sets the audio frequency.
      *
+     * If a frame is on the air, the portion of it not yet played is
+     * rendered again at the new frequency, as is any pre-rendered frame.
+     *
      * This is **not** by itself thread-safe, but ok if fed
      * via the Qt signalling mechanism.
      */
-    Q_SLOT void setAudioFrequency(double const audioFrequency) {
-        m_audioFrequency = audioFrequency;
-    }
+    Q_SLOT void setAudioFrequency(double audioFrequency);
+
+    /**
+     * Renders a frame ahead of time, typically the next frame in the
+     * transmit queue while the current one is on the air; it's rendered
+     * a little at a time, alongside the current one. If the tones,
+     * frequency, and submode match when start() is next called, the
+     * pre-rendered audio is used as is.
+     *
+     * This is **not** by itself thread-safe, but ok if fed
+     * via the Qt signalling mechanism.
+     */
+    Q_SLOT void prerender(QVector<int> tones, double audioFrequency,
+                          int submode);
 
     // Slots
 
@@ -75,6 +95,34 @@ class Modulator final : public AudioDevice {
     qint64 bytesAvailable() const override { return 8000; }
 
   private:
+    // Number of frames in a render block; frames are rendered in blocks,
+    // with the oscillator phasor recorded at the start of each, so that
+    // a frame can be re-rendered from any block boundary onward.
+
+    static constexpr std::size_t BLOCK_FRAMES = 1024;
+
+    // A frame of audio, rendered from its tones in whole blocks as it's
+    // needed, by the audio callback, so that no call does more than a
+    // few blocks' work; `rendered` is how far it's got. The buffers are
+    // pooled, in that frames are swapped rather than copied, retaining
+    // their capacity for reuse.
+
+    struct Frame {
+        QVector<int> tones;
+        double audioFrequency = 0.0;
+        int submode = -1;
+        ToneOscillator oscillator;
+        std::vector<qint16> pcm;
+        std::vector<std::pair<double, double>> phasors;
+        std::size_t rendered = 0;
+    };
+
+    // Manipulators
+
+    void prepare(Frame &);
+    void rewind(Frame &, std::size_t);
+    void render(Frame &, std::size_t);
+
     // Data members
 
     QPointer<SoundOutput> m_stream;
@@ -82,15 +130,15 @@ class Modulator final : public AudioDevice {
     bool m_quickClose = false;
     bool m_tuning = false;
     double m_audioFrequency;
-    double m_audioFrequency0;
     double m_toneSpacing;
-    double m_phi;
-    double m_dphi;
-    double m_amp;
-    double m_nsps;
     qint64 m_silentFrames;
+    unsigned m_framesPerSymbol;
     unsigned m_ic;
-    unsigned m_isym0;
+    Frame m_frame;
+    Frame m_next;
+    ToneOscillator m_tuneOscillator;
+    std::vector<double> m_ramp;
+    std::array<qint16, BLOCK_FRAMES> m_block;
 };
 
 #endif
@@ -0,0 +1,69 @@
+/**
+ * @file Receiver.cpp
+ * @brief Implementation of Receiver class
+ */
+#include "Receiver.h"
+#include "Detector.h"
+#include "JS8_Audio/soundin.h"
+#include <QLoggingCategory>
+#include <QThread>
+
+#include "moc_Receiver.cpp"
+
+Q_DECLARE_LOGGING_CATEGORY(receiver_js8)
+
+/**
+ * @brief Construct a new Receiver object
+ *
+ * @param id
+ * @param device
+ * @param channel
+ * @param dialFrequency
+ * @param thread
+ * @param parent
+ */
+Receiver::Receiver(int const id, QAudioDevice const &device,
+                   AudioDevice::Channel const channel,
+                   quint64 const dialFrequency, QThread *const thread,
+                   QObject *parent)
+    : QObject(parent), m_id(id), m_device(device), m_channel(channel),
+      m_dialFrequency(dialFrequency),
+      m_data(std::make_unique<struct dec_data>()),
+      m_soundInput(new SoundInput),
+      m_detector(new Detector(JS8_RX_SAMPLE_RATE, JS8_NTMAX, *m_data)) {
+    m_soundInput->moveToThread(thread);
+    m_detector->moveToThread(thread);
+
+    connect(this, &Receiver::startAudioInputStream, m_soundInput,
+            &SoundInput::start);
+    connect(this, &Receiver::stopAudioInputStream, m_soundInput,
+            &SoundInput::stop);
+    connect(m_soundInput, &SoundInput::error, this,
+            [this](QString const &message) { Q_EMIT error(m_id, message); });
+    connect(thread, &QThread::finished, m_soundInput, &QObject::deleteLater);
+    connect(thread, &QThread::finished, m_detector, &QObject::deleteLater);
+}
+
+/**
+ * @brief Destroy the Receiver object
+ *
+ */
+Receiver::~Receiver() = default;
+
+/**
+ * @brief Start receiving audio
+ *
+ * @param framesPerBuffer
+ */
+void Receiver::start(int const framesPerBuffer) {
+    qCDebug(receiver_js8) << "starting receiver" << m_id << "on"
+                          << m_device.description() << "dial"
+                          << m_dialFrequency;
+
+    Q_EMIT startAudioInputStream(m_device, framesPerBuffer, m_detector,
+                                 m_channel);
+}
+
+/******************************************************************************/
+
+Q_LOGGING_CATEGORY(receiver_js8, "receiver.js8", QtWarningMsg)
@@ -0,0 +1,76 @@
+#ifndef RECEIVER_HPP__
+#define RECEIVER_HPP__
+
+#include "JS8_Audio/AudioDevice.h"
+#include "JS8_Include/commons.h"
+#include <QAudioDevice>
+#include <QObject>
+#include <QtGlobal>
+#include <memory>
+
+class Detector;
+class QThread;
+class SoundInput;
+
+// An additional receiver; an audio input feeding a detector, which writes
+// into decode data owned by the receiver, rather than into the global
+// decode data of the primary receiver. Any number of these may share the
+// single decoder, each decode being tagged with the receiver identifier.
+//
+// The primary receiver is always identifier zero, so additional receivers
+// are numbered from one. We have no control of the radios to which these
+// are connected, so the dial frequency is as configured.
+//
+// The audio input and detector live on the supplied audio thread, and
+// are disposed of when it finishes; the receiver itself must outlive
+// the thread, as it owns the decode data the detector writes into.
+
+class Receiver final : public QObject {
+    Q_OBJECT
+
+  public:
+    // Constructor
+
+    Receiver(int id, QAudioDevice const &device, AudioDevice::Channel channel,
+             quint64 dialFrequency, QThread *thread,
+             QObject *parent = nullptr);
+
+    // Destructor
+
+    ~Receiver();
+
+    // Inline accessors
+
+    int id() const { return m_id; }
+    quint64 dialFrequency() const { return m_dialFrequency; }
+    Detector *detector() const { return m_detector; }
+
+    // Inline manipulators
+
+    struct dec_data &data() { return *m_data; }
+
+    // Manipulators
+
+    void start(int framesPerBuffer);
+
+    // Signals
+
+    Q_SIGNAL void startAudioInputStream(QAudioDevice const &, int,
+                                        AudioDevice *,
+                                        AudioDevice::Channel) const;
+    Q_SIGNAL void stopAudioInputStream() const;
+    Q_SIGNAL void error(int id, QString message) const;
+
+  private:
+    // Data members
+
+    int m_id;
+    QAudioDevice m_device;
+    AudioDevice::Channel m_channel;
+    quint64 m_dialFrequency;
+    std::unique_ptr<struct dec_data> m_data;
+    SoundInput *m_soundInput;
+    Detector *m_detector;
+};
+
+#endif
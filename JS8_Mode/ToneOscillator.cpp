@@ -0,0 +1,116 @@
+/**
+ * @file ToneOscillator.cpp
+ * @brief Implementation of ToneOscillator class
+ */
+#include "ToneOscillator.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace {
+constexpr double TAU = 2 * std::numbers::pi;
+constexpr double AMPLITUDE = std::numeric_limits<qint16>::max();
+} // namespace
+
+/**
+ * @brief Precompute the rotations for each tone
+ *
+ * Called whenever the audio frequency changes; everything the oscillator
+ * needs per sample is derived from these, so there's no trigonometry in
+ * the render path.
+ *
+ * @param frequency
+ * @param spacing
+ * @param frameRate
+ */
+void ToneOscillator::prepare(double const frequency, double const spacing,
+                             int const frameRate) {
+    for (std::size_t t = 0; t < TONES; ++t) {
+        auto &tone = m_tones[t];
+        double const dphi = TAU * (frequency + t * spacing) / frameRate;
+
+        for (std::size_t k = 0; k < LANES; ++k) {
+            tone.re[k] = std::cos((k + 1) * dphi);
+            tone.im[k] = std::sin((k + 1) * dphi);
+        }
+
+        tone.stepRe = std::cos(LANES * dphi);
+        tone.stepIm = std::sin(LANES * dphi);
+    }
+
+    audioFrequency = frequency;
+}
+
+/**
+ * @brief Render mono samples of a tone
+ *
+ * Results are identical from run to run, since there's no dependency on
+ * anything but the tone sequence, frequency, and frame count.
+ *
+ * @param out    Destination for the samples
+ * @param count  Number of samples to render
+ * @param index  Tone to render
+ * @param ramp   Fade out gain for each sample, or nullptr if none
+ */
+void ToneOscillator::render(qint16 *const out, std::size_t const count,
+                            int const index, double const *const ramp) {
+    auto const &tone =
+        m_tones[std::min<std::size_t>(static_cast<unsigned>(index),
+                                      TONES - 1)];
+
+    // Renormalize the phasor to keep the recursion on the unit circle.
+
+    if (auto const norm = std::hypot(re, im); norm > 0.0) {
+        re /= norm;
+        im /= norm;
+    }
+
+    std::array<double, LANES> laneRe;
+    std::array<double, LANES> laneIm;
+    std::array<double, LANES> sample;
+
+    for (std::size_t k = 0; k < LANES; ++k) {
+        laneRe[k] = re * tone.re[k] - im * tone.im[k];
+        laneIm[k] = re * tone.im[k] + im * tone.re[k];
+    }
+
+    std::size_t i = 0;
+
+    for (; i + LANES <= count; i += LANES) {
+        for (std::size_t k = 0; k < LANES; ++k) {
+            sample[k] = AMPLITUDE * laneIm[k];
+        }
+
+        if (ramp) {
+            for (std::size_t k = 0; k < LANES; ++k) {
+                sample[k] *= ramp[i + k];
+            }
+        }
+
+        for (std::size_t k = 0; k < LANES; ++k) {
+            out[i + k] = qRound(sample[k]);
+        }
+
+        re = laneRe[LANES - 1];
+        im = laneIm[LANES - 1];
+
+        for (std::size_t k = 0; k < LANES; ++k) {
+            auto const r = laneRe[k] * tone.stepRe - laneIm[k] * tone.stepIm;
+            laneIm[k] = laneRe[k] * tone.stepIm + laneIm[k] * tone.stepRe;
+            laneRe[k] = r;
+        }
+    }
+
+    // Partial block, if any, at the end of the count.
+
+    if (auto const rest = count - i) {
+        for (std::size_t k = 0; k < rest; ++k) {
+            out[i + k] =
+                qRound(AMPLITUDE * laneIm[k] * (ramp ? ramp[i + k] : 1.0));
+        }
+
+        re = laneRe[rest - 1];
+        im = laneIm[rest - 1];
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef TONE_OSCILLATOR_HPP__
+#define TONE_OSCILLATOR_HPP__
+
+#include <QtGlobal>
+#include <array>
+#include <cstddef>
+
+/**
+ * Phase continuous oscillator for the 8 tones of the JS8 alphabet; a
+ * phasor, rotated once per sample by precomputed rotations for the
+ * current tone.
+ *
+ * We run LANES copies of it, each offset by one sample, so that each
+ * step of the inner loops is independent work, which the compiler can
+ * map onto vector registers on any platform. There's no trigonometry
+ * in the render path, and output depends on nothing but the tones,
+ * frequency, and the counts rendered, so it's identical from run to run.
+ */
+class ToneOscillator {
+  public:
+    // Number of oscillator lanes rendered in parallel.
+
+    static constexpr std::size_t LANES = 8;
+
+    // Number of tones in the JS8 alphabet.
+
+    static constexpr std::size_t TONES = 8;
+
+    // Manipulators
+
+    void prepare(double audioFrequency, double toneSpacing, int frameRate);
+    void render(qint16 *, std::size_t, int, double const *);
+
+    // Frequency of tone zero at last prepare(), and the phasor of the
+    // last sample rendered; a render can be resumed from a recorded
+    // phasor by restoring these.
+
+    double audioFrequency = 0.0;
+    double re = 1.0;
+    double im = 0.0;
+
+  private:
+    // Per-lane rotations taking the phasor of the last sample rendered
+    // to each of the next LANES samples, and the rotation advancing
+    // every lane by LANES samples.
+
+    struct Tone {
+        std::array<double, LANES> re;
+        std::array<double, LANES> im;
+        double stepRe;
+        double stepIm;
+    };
+
+    std::array<Tone, TONES> m_tones;
+};
+
+#endif
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace js8 {
+/**
+ * @brief The sync search of syncjs8(): for each frequency bin in [ia, ib],
+ * the symbol offset at which the Costas arrays best match the symbol
+ * spectra, and the sync metric there.
+ *
+ * The symbol spectra are held by time, then frequency, so that adjacent
+ * bins are adjacent in memory. Bins are searched a block at a time, each
+ * bin's sums added in just the order they would be were it searched on its
+ * own, as the Fortran did; IEEE 754 addition being a touchy thing, that's
+ * what keeps the results bit-identical. The loads are contiguous, though,
+ * rather than a whole spectrum apart, and the compiler is free to vectorise
+ * across the block.
+ *
+ * Calls found(bin, sync, offset) for each bin, in order.
+ */
+template <int NHSYM, int NSPS, int NFOS, int NSSY, int JZ, int JSTRT,
+          typename Found>
+void syncSearch(std::array<std::array<float, NSPS>, NHSYM> const &s,
+                std::array<std::array<int, 7>, 3> const &costas, int const ia,
+                int const ib, Found &&found) {
+    constexpr int BLOCK = 16;
+
+    for (int i0 = ia; i0 <= ib; i0 += BLOCK) {
+        int const width = std::min(BLOCK, ib + 1 - i0);
+
+        std::array<float, BLOCK> max_value;
+        std::array<int, BLOCK> max_index;
+
+        max_value.fill(-std::numeric_limits<float>::infinity());
+        max_index.fill(-JZ);
+
+        for (int j = -JZ; j <= JZ; ++j) {
+            // Costas pattern contributions, and sums over all frequencies,
+            // by block, by bin.
+
+            std::array<std::array<std::array<float, BLOCK>, 3>, 2> t{};
+
+            for (int p = 0; p < 3; ++p) {
+                for (int n = 0; n < 7; ++n) {
+                    int const offset = j + JSTRT + NSSY * n + p * 36 * NSSY;
+
+                    if (offset < 0 || offset >= NHSYM)
+                        continue;
+
+                    float const *const row = s[offset].data() + i0;
+                    float const *const tone = row + NFOS * costas[p][n];
+
+                    for (int b = 0; b < width; ++b) {
+                        t[0][p][b] += tone[b];
+                    }
+                    for (int freq = 0; freq < 7; ++freq) {
+                        for (int b = 0; b < width; ++b) {
+                            t[1][p][b] += row[NFOS * freq + b];
+                        }
+                    }
+                }
+            }
+
+            for (int b = 0; b < width; ++b) {
+                auto const compute_sync = [&t, b](int start, int end) {
+                    float tx = 0.0f;
+                    float t0 = 0.0f;
+
+                    for (int p = start; p <= end; ++p) {
+                        tx += t[0][p][b];
+                        t0 += t[1][p][b];
+                    }
+
+                    return tx / ((t0 - tx) / 6.0f);
+                };
+
+                if (auto const sync_value =
+                        std::max({compute_sync(0, 2), compute_sync(0, 1),
+                                  compute_sync(1, 2)});
+                    sync_value > max_value[b]) {
+                    max_value[b] = sync_value;
+                    max_index[b] = j;
+                }
+            }
+        }
+
+        for (int b = 0; b < width; ++b) {
+            found(i0 + b, max_value[b], max_index[b]);
+        }
+    }
+}
+} // namespace js8
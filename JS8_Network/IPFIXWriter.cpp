@@ -0,0 +1,269 @@
+#include "IPFIXWriter.h"
+#include "JS8_Main/DriftingDateTime.h"
+#include <QtEndian>
+#include <cstddef>
+#include <utility>
+
+/******************************************************************************/
+// Constants
+/******************************************************************************/
+
+namespace {
+constexpr quint16 VERSION = 10;              // IPFIX
+constexpr quint16 TEMPLATE_SET = 2;          // Template Set ID
+constexpr quint16 OPTIONS_SET = 3;           // Options Template Set ID
+constexpr quint16 RECEIVER_SET = 0x50e2;     // Receiver information Link ID
+constexpr quint16 SENDER_SET = 0x50e3;       // Sender information Link ID
+constexpr quint32 ENTERPRISE = 30351;        // PSK Reporter
+constexpr quint16 VARIABLE = 0xffff;         // Field length, variable
+constexpr qsizetype HEADER_LENGTH = 16;      // Message header
+constexpr qsizetype MAX_STRING_LENGTH = 254; // PSK reporter spec
+constexpr qsizetype MIN_PAYLOAD_LENGTH = 508;
+constexpr qsizetype MAX_PAYLOAD_LENGTH = 10000;
+} // namespace
+
+/******************************************************************************/
+// Local Routines
+/******************************************************************************/
+
+namespace {
+// The string in UTF-8, as PSK Reporter takes it.
+//
+// From https://pskreporter.info/pskdev.html
+//
+//   The data that follows is encoded as three (or four — the number
+//   depends on the number of fields in the record format descriptor)
+//   fields of byte length code followed by UTF-8 (use ASCII if you
+//   don't know what UTF-8 is) data. The length code is the number of
+//   bytes of data and does not include the length code itself. Each
+//   field is limited to a length code of no more than 254 bytes.
+//   Finally, the record is null padded to a multiple of 4 bytes.
+//
+// From https://datatracker.ietf.org/doc/rfc7011/
+//
+// 6.1.6.  string and octetArray
+//
+//    The "string" data type represents a finite-length string of valid
+//    characters of the Unicode character encoding set.  The string data
+//    type MUST be encoded in UTF-8 [RFC3629] format.  The string is sent
+//    as an array of zero or more octets using an Information Element of
+//    fixed or variable length.  IPFIX Exporting Processes MUST NOT send
+//    IPFIX Messages containing ill-formed UTF-8 string values for
+//    Information Elements of the string data type; Collecting Processes
+//    SHOULD detect and ignore such values.  See [UTF8-EXPLOIT] for
+//    background on this issue.
+
+QByteArray utf8(QString const &s) {
+    auto utf = s.toUtf8();
+
+    // Blindly truncating the string to 254 bytes might land us in the
+    // middle of a code point, thus violating 6.1.6. Therefore, if we must
+    // truncate, we need to do so at a point where we stay legal.
+
+    if (utf.size() > MAX_STRING_LENGTH) {
+        // Walk back through the UTF-8 data and see where we can truncate.
+        // Continuation bytes in UTF-8 sequences are in the range 0x80-0xBF.
+        // Going backward from the limit, attempt to find the first starting
+        // byte at which the string can be truncated safely. Since UTF-8 byte
+        // sequences aren't longer than 4 bytes, this should not take more
+        // than 4 loop iterations to find the correct position. Worst case,
+        // we're going to emit a zero-length string.
+
+        auto const truncatePosition = [&utf]() -> qsizetype {
+            for (auto i = MAX_STRING_LENGTH; i > 0; i--) {
+                if (auto const byte = static_cast<std::byte>(utf.at(i));
+                    (byte & std::byte{0xC0}) != std::byte{0x80}) {
+                    return i;
+                }
+            }
+            return 0;
+        };
+
+        // Truncate at the position found. This will truncate at a codepoint
+        // boundary, but it may change the characters in the string, rather
+        // than just cutting them off; e.g. it might result in "résumé" being
+        // turned into "résume". Never promised you a perfect solution here,
+        // just a legal one.
+
+        utf.truncate(truncatePosition());
+    }
+
+    return utf;
+}
+
+// Appends the value, big-endian.
+
+template <typename T> void put(QByteArray &buffer, T const value) {
+    auto const at = buffer.size();
+    buffer.resize(at + sizeof(T));
+    qToBigEndian<T>(value, buffer.data() + at);
+}
+
+// Appends the string, preceded by a size byte.
+
+void putString(QByteArray &buffer, QString const &string) {
+    auto const utf = utf8(string);
+    put<quint8>(buffer, utf.size());
+    buffer.append(utf);
+}
+
+// Appends an enterprise-specific field specifier to a template.
+
+void putField(QByteArray &buffer, quint16 const element, quint16 const length) {
+    put<quint16>(buffer, 0x8000 + element);
+    put<quint16>(buffer, length);
+    put<quint32>(buffer, ENTERPRISE);
+}
+
+// As mentioned above, from the PSK reporter spec, records must be null
+// padded to a multiple of 4 bytes. Given a value representing a buffer
+// length, return the number of additional bytes required to make it an
+// even multiple of 4.
+
+qsizetype padding(qsizetype const n) { return ((n + 3) & ~0x3) - n; }
+
+// Pads what's been appended to the buffer since the offset given, a set
+// or a message, to 4-byte alignment with NUL bytes, and punches in its
+// length, which is always after an initial 16-bit field, i.e. after a
+// message header version field or a set ID field.
+
+void seal(QByteArray &buffer, qsizetype const at) {
+    buffer.append(padding(buffer.size() - at), '\0');
+    qToBigEndian<quint16>(buffer.size() - at, buffer.data() + at + 2);
+}
+} // namespace
+
+/******************************************************************************/
+// Public Implementation
+/******************************************************************************/
+
+IPFIXWriter::IPFIXWriter(quint32 const observationDomain, Sender send)
+    : m_send(std::move(send)), m_domain(observationDomain) {
+    // Sender Information Descriptor
+
+    put<quint16>(m_templates, TEMPLATE_SET);
+    put<quint16>(m_templates, 0); // Length (place-holder)
+    put<quint16>(m_templates, SENDER_SET);
+    put<quint16>(m_templates, 7);        // Field Count
+    putField(m_templates, 1, VARIABLE);  // senderCallsign
+    putField(m_templates, 5, 5);         // frequency
+    putField(m_templates, 6, 1);         // sNR
+    putField(m_templates, 10, VARIABLE); // mode
+    putField(m_templates, 3, VARIABLE);  // senderLocator
+    putField(m_templates, 11, 1);        // informationSource
+    put<quint16>(m_templates, 150);      // dateTimeSeconds, IANA
+    put<quint16>(m_templates, 4);
+    seal(m_templates, 0);
+
+    // Receiver Information Descriptor
+
+    auto const at = m_templates.size();
+    put<quint16>(m_templates, OPTIONS_SET);
+    put<quint16>(m_templates, 0); // Length (place-holder)
+    put<quint16>(m_templates, RECEIVER_SET);
+    put<quint16>(m_templates, 4);       // Field Count
+    put<quint16>(m_templates, 0);       // Scope Field Count
+    putField(m_templates, 2, VARIABLE); // receiverCallsign
+    putField(m_templates, 4, VARIABLE); // receiverLocator
+    putField(m_templates, 8, VARIABLE); // decodingSoftware
+    putField(m_templates, 9, VARIABLE); // antennaInformation
+    seal(m_templates, at);
+
+    setReceiver({}, {}, {}, {});
+
+    m_records.reserve(MAX_PAYLOAD_LENGTH);
+    m_message.reserve(MAX_PAYLOAD_LENGTH);
+}
+
+void IPFIXWriter::setReceiver(QString const &call, QString const &grid,
+                              QString const &software,
+                              QString const &antenna) {
+    m_receiver.clear();
+    put<quint16>(m_receiver, RECEIVER_SET);
+    put<quint16>(m_receiver, 0); // Length (place-holder)
+    putString(m_receiver, call);
+    putString(m_receiver, grid);
+    putString(m_receiver, software);
+    putString(m_receiver, antenna);
+    seal(m_receiver, 0);
+}
+
+void IPFIXWriter::add(QString const &call, QString const &grid,
+                      Radio::Frequency const freq, QString const &mode,
+                      int const snr, QDateTime const &time) {
+    auto const mark = m_records.size();
+
+    putString(m_records, call);
+    put<quint8>(m_records, freq >> 32); // 40 bits, big-endian
+    put<quint32>(m_records, freq);
+    put<qint8>(m_records, snr);
+    putString(m_records, mode);
+    putString(m_records, grid);
+    put<quint8>(m_records, 1); // REPORTER_SOURCE_AUTOMATIC
+    put<quint32>(m_records, time.toSecsSinceEpoch());
+
+    // A spot that overflows the message under way is held over to the
+    // next, which finish() then leaves to wait for more, as the reporter
+    // always has, however large it may be.
+
+    m_due = !(mark && length(m_records.size()) > MAX_PAYLOAD_LENGTH);
+
+    if (!m_due) {
+        send(mark);
+    }
+}
+
+void IPFIXWriter::finish(bool const flush) {
+    if (flush || (m_due && length(m_records.size()) > MIN_PAYLOAD_LENGTH)) {
+        send(m_records.size());
+    }
+    m_due = false;
+}
+
+/******************************************************************************/
+// Private Implementation
+/******************************************************************************/
+
+// Length of the message that would carry the given number of bytes of spot
+// records; every set in it is padded, so it needs none of its own.
+
+qsizetype IPFIXWriter::length(qsizetype const records) const {
+    return HEADER_LENGTH + (m_descriptors ? m_templates.size() : 0) +
+           m_receiver.size() +
+           (records ? 4 + records + padding(records) : 0);
+}
+
+// Assembles a message of the header, the descriptors if they're due, the
+// receiver information, and the given number of bytes of spot records,
+// sends it, and drops those records. Note that while the descriptors go in
+// the order of sender, receiver, the order is documented not to matter to
+// PSK Reporter.
+
+void IPFIXWriter::send(qsizetype const records) {
+    m_message.resize(0);
+
+    put<quint16>(m_message, VERSION);
+    put<quint16>(m_message, 0); // Length (place-holder)
+    put<quint32>(m_message, DriftingDateTime::currentSecsSinceEpoch());
+    put<quint32>(m_message, ++m_sequence);
+    put<quint32>(m_message, m_domain);
+
+    if (m_descriptors) {
+        --m_descriptors;
+        m_message.append(m_templates);
+    }
+
+    m_message.append(m_receiver);
+
+    if (records) {
+        auto const at = m_message.size();
+        put<quint16>(m_message, SENDER_SET);
+        put<quint16>(m_message, 0); // Length (place-holder)
+        m_message.append(m_records.constData(), records);
+        seal(m_message, at);
+    }
+
+    seal(m_message, 0);
+    m_send(m_message);
+    m_records.remove(0, records);
+}
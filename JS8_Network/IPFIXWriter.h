@@ -0,0 +1,74 @@
+#ifndef IPFIXWRITER_H
+#define IPFIXWRITER_H
+
+#include "JS8_Main/Radio.h"
+#include <QByteArray>
+#include <QDateTime>
+#include <QString>
+#include <functional>
+
+/**
+ * Encodes spots as the IPFIX messages PSK Reporter takes in.
+ *
+ * Each message carries a header, the record format descriptors when they're
+ * due, the receiver information record, and a data set of spot records.
+ * The descriptors never change, and the receiver information only when the
+ * local station does, so both are encoded once, and copied into each message
+ * as it's assembled; spot records are encoded as they're added, big-endian,
+ * straight into a buffer whose capacity is reserved once, at the largest a
+ * message may be, and reused from message to message. Nothing goes through
+ * a QDataStream, and nothing is encoded twice.
+ *
+ * A message is handed to the sender once the next spot record wouldn't fit
+ * in it, and, by finish(), once there are records enough to be worth
+ * sending, or if asked to flush what there is, even if there are none.
+ * Messages are split just where the QDataStream encoder this replaced split
+ * them, but for a flush, which it forgot once it had sent a message.
+ **/
+class IPFIXWriter {
+  public:
+    using Sender = std::function<void(QByteArray const &)>;
+
+    IPFIXWriter(quint32 observationDomain, Sender send);
+
+    // Local station, as reported in the receiver information record.
+
+    void setReceiver(QString const &call, QString const &grid,
+                     QString const &software, QString const &antenna);
+
+    // The record format descriptors are to go in the next so many messages.
+
+    void sendDescriptors(unsigned messages) { m_descriptors = messages; }
+
+    // Encodes the spot; if it doesn't fit in the message under way, sends
+    // that first, and starts the next with it.
+
+    void add(QString const &call, QString const &grid, Radio::Frequency freq,
+             QString const &mode, int snr, QDateTime const &time);
+
+    // Sends the spots added since the last message was sent, if they're
+    // enough to fill a minimal datagram, and the last added since the last
+    // call didn't overflow the message before it, or if flushing.
+
+    void finish(bool flush);
+
+    // Spot record bytes encoded, but not yet sent.
+
+    qsizetype pending() const { return m_records.size(); }
+
+  private:
+    qsizetype length(qsizetype records) const;
+    void send(qsizetype records);
+
+    Sender m_send;
+    quint32 m_domain;
+    quint32 m_sequence = 0;
+    unsigned m_descriptors = 0;
+    bool m_due = false;
+    QByteArray m_templates;
+    QByteArray m_receiver;
+    QByteArray m_records;
+    QByteArray m_message;
+};
+
+#endif // IPFIXWRITER_H
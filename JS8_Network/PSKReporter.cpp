@@ -13,12 +13,13 @@
 // Reports will be sent in batch mode every 5 minutes.
 
 #include <QByteArray>
-#include <QDataStream>
 #include <QDateTime>
 #include <QDir>
 #include <QFile>
 #include <QHash>
+#include <QList>
 #include <QLoggingCategory>
+#include <QMap>
 #include <QObject>
 #include <QQueue>
 #include <QRandomGenerator>
@@ -28,12 +29,12 @@
 #include <QTimer>
 #include <QUdpSocket>
 #include <algorithm>
-#include <cstddef>
 #include <ctime>
+#include <utility>
 
 #include "JS8_Include/pimpl_impl.h"
 #include "JS8_Main/Bands.h"
-#include "JS8_Main/DriftingDateTime.h"
+#include "JS8_Network/IPFIXWriter.h"
 #include "JS8_UI/Configuration.h"
 
 #include "moc_PSKReporter.cpp"
@@ -52,216 +53,8 @@ constexpr quint16 PORT = 4739;               // 14739 for test
 constexpr int MIN_SEND_INTERVAL = 600;       // in seconds
 constexpr int JITTER_MAX = 5;                // in seconds
 constexpr int FLUSH_INTERVAL = 125;          // in send intervals
-constexpr qsizetype MAX_STRING_LENGTH = 254; // PSK reporter spec
 constexpr std::time_t CACHE_TIMEOUT = 3600;  // in seconds
-constexpr int MIN_PAYLOAD_LENGTH = 508;
-constexpr int MAX_PAYLOAD_LENGTH = 10000;
-} // namespace
-
-/******************************************************************************/
-// Utility Functions
-/******************************************************************************/
-
-namespace {
-// Write the string to the data stream in UTF-8 format, preceded by
-// a size byte.
-//
-// From https://pskreporter.info/pskdev.html
-//
-//   The data that follows is encoded as three (or four — the number
-//   depends on the number of fields in the record format descriptor)
-//   fields of byte length code followed by UTF-8 (use ASCII if you
-//   don't know what UTF-8 is) data. The length code is the number of
-//   bytes of data and does not include the length code itself. Each
-//   field is limited to a length code of no more than 254 bytes.
-//   Finally, the record is null padded to a multiple of 4 bytes.
-//
-// From https://datatracker.ietf.org/doc/rfc7011/
-//
-// 6.1.6.  string and octetArray
-//
-//    The "string" data type represents a finite-length string of valid
-//    characters of the Unicode character encoding set.  The string data
-//    type MUST be encoded in UTF-8 [RFC3629] format.  The string is sent
-//    as an array of zero or more octets using an Information Element of
-//    fixed or variable length.  IPFIX Exporting Processes MUST NOT send
-//    IPFIX Messages containing ill-formed UTF-8 string values for
-//    Information Elements of the string data type; Collecting Processes
-//    SHOULD detect and ignore such values.  See [UTF8-EXPLOIT] for
-//    background on this issue.
-
-/**
- * @brief Writes a UTF-8 string to the given data stream.
- * 
- * @param out 
- * @param s 
- */
-void writeUtfString(QDataStream &out, QString const &s) {
-    auto utf = s.toUtf8();
-
-    // The original code would just truncate the string to a maximum length
-    // of 254 bytes blindly here, but that might land us in the middle of
-    // a code point, thus violating 6.1.6. Therefore, if we must truncate,
-    // we need to do so at a point where we stay legal.
-
-    if (utf.size() > MAX_STRING_LENGTH) {
-        // Walk back through the UTF-8 data and see where we can truncate.
-        // Continuation bytes in UTF-8 sequences are in the range 0x80-0xBF.
-        // Going backward from the limit, attempt to find the first starting
-        // byte at which the string can be truncated safely. Since UTF-8 byte
-        // sequences aren't longer than 4 bytes, this should not take more
-        // than 4 loop iterations to find the correct position. Worst case,
-        // we're going to emit a zero-length string.
-
-        auto const truncatePosition = [&utf]() -> qsizetype {
-            for (auto i = MAX_STRING_LENGTH; i > 0; i--) {
-                if (auto const byte = static_cast<std::byte>(utf.at(i));
-                    (byte & std::byte{0xC0}) != std::byte{0x80}) {
-                    return i;
-                }
-            }
-            return 0;
-        };
-
-        // Truncate at the position found. This will truncate at a codepoint
-        // boundary, but it may change the characters in the string, rather
-        // than just cutting them off; e.g. it might result in "résumé" being
-        // turned into "résume". Never promised you a perfect solution here,
-        // just a legal one.
-
-        utf.truncate(truncatePosition());
-    }
-
-    out << quint8(utf.size());
-    out.writeRawData(utf, utf.size());
-}
-
-// As mentioned above, from the PSK reporter spec, records must be null
-// padded to a multiple of 4 bytes. Given a value representing a buffer
-// length, return the number of additional bytes required to make it an
-// even multiple of 4.
-
-/**
- * @brief Calculates the number of padding bytes needed for 4-byte alignment.
- * 
- * @param n 
- * @return qsizetype 
- */
-qsizetype num_pad_bytes(qsizetype const n) { return ((n + 3) & ~0x3) - n; }
-
-// If the buffer isn't landing on a 4-byte boundary, pad with nulls.
-// Rewind the data stream to 2 bytes in, punch in the length of the
-// buffer, and reposition to after the buffer, plus any alignment.
-
-/**
- * @brief Sets the length of the data in the stream, adding padding if necessary.
- * 
- * @param out 
- * @param b 
- */
-void set_length(QDataStream &out, QByteArray const &b) {
-    // Pad out to 4-byte alignment with NUL bytes, if necessary.
-
-    if (auto const padSize = num_pad_bytes(b.size()); padSize != 0) {
-        out.writeRawData(QByteArray(padSize, '\0'), padSize);
-    }
-
-    // Remember where we are, then position to punch in the length,
-    // which is always after an initial 16-bit field, i.e. after a
-    // message header version field or a template set ID field.
-
-    auto const pos = out.device()->pos();
-    out.device()->seek(sizeof(quint16));
-
-    // Insert the length, not including any nulls that we might have
-    // added, and move back to where we were.
-
-    out << static_cast<quint16>(b.size());
-    out.device()->seek(pos);
-}
-
-// Append a Sender Information Descriptor to the provided message.
-
-/**
- * @brief Appends a Sender Information Descriptor to the given message.
- * 
- * @param message 
- */
-void appendSIDTo(QDataStream &message) {
-    QByteArray buffer;
-    QDataStream stream{&buffer, QIODevice::WriteOnly};
-
-    stream << quint16(2u)     // Template Set ID
-           << quint16(0u)     // Length (place-holder)
-           << quint16(0x50e3) // Link ID
-           << quint16(7u)     // Field Count
-           << quint16(0x8000 +
-                      1u) // Option 1 Information Element ID (senderCallsign)
-           << quint16(0xffff) // Option 1 Field Length (variable)
-           << quint32(30351u) // Option 1 Enterprise Number
-           << quint16(0x8000 +
-                      5u)     // Option 2 Information Element ID (frequency)
-           << quint16(5u)     // Option 2 Field Length
-           << quint32(30351u) // Option 2 Enterprise Number
-           << quint16(0x8000 + 6u)  // Option 3 Information Element ID (sNR)
-           << quint16(1u)           // Option 3 Field Length
-           << quint32(30351u)       // Option 3 Enterprise Number
-           << quint16(0x8000 + 10u) // Option 4 Information Element ID (mode)
-           << quint16(0xffff)       // Option 4 Field Length (variable)
-           << quint32(30351u)       // Option 4 Enterprise Number
-           << quint16(0x8000 +
-                      3u)     // Option 5 Information Element ID (senderLocator)
-           << quint16(0xffff) // Option 5 Field Length (variable)
-           << quint32(30351u) // Option 5 Enterprise Number
-           << quint16(
-                  0x8000 +
-                  11u)    // Option 6 Information Element ID (informationSource)
-           << quint16(1u) // Option 6 Field Length
-           << quint32(30351u) // Option 6 Enterprise Number
-           << quint16(150u) // Option 7 Information Element ID (dateTimeSeconds)
-           << quint16(4u);  // Option 7 Field Length
-
-    set_length(stream, buffer);
-    message.writeRawData(buffer, buffer.size());
-}
-
-// Append a Receiver Information Descriptor to the provided message.
-
-/**
- * @brief Appends a Receiver Information Descriptor to the given message.
- * 
- * @param message 
- */
-void appendRIDTo(QDataStream &message) {
-    QByteArray buffer;
-    QDataStream stream{&buffer, QIODevice::WriteOnly};
-
-    stream << quint16(3u)     // Options Template Set ID
-           << quint16(0u)     // Length (place-holder)
-           << quint16(0x50e2) // Link ID
-           << quint16(4u)     // Field Count
-           << quint16(0u)     // Scope Field Count
-           << quint16(0x8000 +
-                      2u) // Option 1 Information Element ID (receiverCallsign)
-           << quint16(0xffff) // Option 1 Field Length (variable)
-           << quint32(30351u) // Option 1 Enterprise Number
-           << quint16(0x8000 +
-                      4u) // Option 2 Information Element ID (receiverLocator)
-           << quint16(0xffff) // Option 2 Field Length (variable)
-           << quint32(30351u) // Option 2 Enterprise Number
-           << quint16(0x8000 +
-                      8u) // Option 3 Information Element ID (decodingSoftware)
-           << quint16(0xffff) // Option 3 Field Length (variable)
-           << quint32(30351u) // Option 3 Enterprise Number
-           << quint16(
-                  0x8000 +
-                  9u) // Option 4 Information Element ID (antennaInformation)
-           << quint16(0xffff)  // Option 4 Field Length (variable)
-           << quint32(30351u); // Option 4 Enterprise Number
-
-    set_length(stream, buffer);
-    message.writeRawData(buffer, buffer.size());
-}
+constexpr std::time_t CACHE_BUCKET = 300;    // in seconds
 } // namespace
 
 /******************************************************************************/
@@ -277,9 +70,18 @@ class PSKReporter::impl final : public QObject {
     Q_OBJECT
 
   public:
-    // POD describing a spot; we queue these for later delivery.
+    // Key of a call and band in the cache: the callsign and the name of
+    // the frequency band, so we can spot cached calls if they switch bands.
+    // Entries hold their own copies of both, so the cache needs nothing
+    // from elsewhere to stay valid, and expiry frees them.
+
+    using Key = std::pair<QString, QString>;
+
+    // POD describing a spot; we queue these for later delivery. The key
+    // is that of its call and band in the cache.
 
     struct Spot {
+        Key key_;
         QString call_;
         QString grid_;
         int snr_;
@@ -300,14 +102,13 @@ class PSKReporter::impl final : public QObject {
     QString rx_call_;
     QString rx_grid_;
     QString rx_ant_;
-    QByteArray tx_data_;
-    QByteArray tx_residue_;
-    QByteArray payload_;
-    QQueue<Spot> spots_;
-    QHash<QString, std::time_t> calls_;
     quint32 observation_id_ = QRandomGenerator::global()->generate();
-    quint32 sequence_number_ = 0u;
-    unsigned send_descriptors_ = 0u;
+    IPFIXWriter writer_;
+    QQueue<Spot> spots_;
+    qsizetype dequeued_ = 0;
+    QHash<Key, qsizetype> queued_;
+    QHash<Key, std::time_t> calls_;
+    QMap<std::time_t, QList<Key>> expiry_;
     unsigned flush_counter_ = 0u;
     bool once_ = false;
 
@@ -316,7 +117,13 @@ class PSKReporter::impl final : public QObject {
     impl(PSKReporter *self, Configuration const *config,
          QString const &program_info)
         : QObject{self}, self_{self}, config_{config}, prog_id_{program_info},
-          report_timer_{this}, descriptor_timer_{this} {
+          report_timer_{this}, descriptor_timer_{this},
+          writer_{observation_id_, [this](QByteArray const &message) {
+                      socket_->write(message); // TODO: handle errors
+                      qCDebug(pskreporter_js8) << "[PSK]sent spots";
+                  }} {
+        writer_.setReceiver(rx_call_, rx_grid_, prog_id_, rx_ant_);
+
         // Attempt to load up the eclipse dates. Not a big deal if this fails;
         // just means that we won't bypass the spot cache during eclipse
         // periods.
@@ -351,8 +158,8 @@ class PSKReporter::impl final : public QObject {
         connect(&descriptor_timer_, &QTimer::timeout, [this]() {
             if (socket_ &&
                 QAbstractSocket::UdpSocket == socket_->socketType()) {
-                send_descriptors_ =
-                    3; // Send format descriptors again, 3 times.
+                // Send format descriptors again, 3 times.
+                writer_.sendDescriptors(3);
             }
         });
     }
@@ -397,7 +204,7 @@ class PSKReporter::impl final : public QObject {
             break;
 
         default:
-            spots_.clear();
+            clear_spots();
             Q_EMIT self_->errorOccurred(socket_->errorString());
             break;
         }
@@ -409,10 +216,10 @@ class PSKReporter::impl final : public QObject {
 
         if (config_->psk_reporter_tcpip()) {
             socket_.reset(new QTcpSocket, &QObject::deleteLater);
-            send_descriptors_ = 1;
+            writer_.sendDescriptors(1);
         } else {
             socket_.reset(new QUdpSocket, &QObject::deleteLater);
-            send_descriptors_ = 3;
+            writer_.sendDescriptors(3);
         }
 
         connect(socket_.get(), &QAbstractSocket::errorOccurred, this,
@@ -449,154 +256,85 @@ class PSKReporter::impl final : public QObject {
         report_timer_.stop();
     }
 
-    void build_preamble(QDataStream &message) {
-        // Message Header
-        message << quint16(10u) // Version Number
-                << quint16(0u)  // Length (place-holder filled in later)
-                << quint32(0u)  // Export Time (place-holder filled in later)
-                << ++sequence_number_ // Sequence Number
-                << observation_id_;   // Observation Domain ID
-
-        // We send the record format descriptors every so often; if we're due to
-        // send them again, then append them to the message. Note that while we
-        // add these to the message in the order of sender, recipient, the order
-        // is documented not to matter to PSKReporter.
-
-        if (send_descriptors_) {
-            --send_descriptors_;
-            appendSIDTo(message);
-            appendRIDTo(message);
-            qCDebug(pskreporter_js8) << "[PSK]sent descriptors";
-        }
-
-        // As opposed to the record format descriptors, which can be omitted
-        // once they have been transmitted a few times (to ensure that the
-        // server has cached them), the receiver information record must be sent
-        // every time.
-
-        QByteArray record;
-        QDataStream stream{&record, QIODevice::WriteOnly};
-
-        // Set up the header; we'll fill in the length below, later.
-
-        stream << quint16(0x50e2) // Template ID
-               << quint16(0u);    // Length (place-holder)
-
-        // Stream the data into the record as UTF-8 strings, each one up to 254
-        // bytes in length.
-
-        writeUtfString(stream, rx_call_);
-        writeUtfString(stream, rx_grid_);
-        writeUtfString(stream, prog_id_);
-        writeUtfString(stream, rx_ant_);
-
-        // Run back to the length field and update it, if necessary padding out
-        // the record to 4-byte alignment with NUL bytes, and append it to the
-        // message.
-
-        set_length(stream, record);
-        message.writeRawData(record, record.size());
-    }
+    // Encodes the queued spots, sending messages as they fill, and sends
+    // what's left over if there's enough of it, or if flushing; what's not
+    // sent is held by the writer until the next report.
 
     void send_report(bool const send_residue = false) {
         if (QAbstractSocket::ConnectedState != socket_->state())
             return;
 
-        QDataStream message{&payload_,
-                            QIODevice::WriteOnly | QIODevice::Append};
-        QDataStream tx_out{&tx_data_, QIODevice::WriteOnly | QIODevice::Append};
+        auto const flush = flushing() || send_residue;
 
-        if (!payload_.size()) {
-            // Build header, optional descriptors, and receiver information
-            build_preamble(message);
+        qCDebug(pskreporter_js8) << "[PSK]pending spots:" << spots_.size();
+        while (!spots_.isEmpty()) {
+            auto const spot = dequeue();
+            writer_.add(spot.call_, spot.grid_, spot.freq_, spot.mode_,
+                        spot.snr_, spot.time_);
         }
 
-        auto flush = flushing() || send_residue;
-        while (spots_.size() || flush) {
-            if (!payload_.size()) {
-                // Build header, optional descriptors, and receiver information
-                build_preamble(message);
-            }
+        writer_.finish(flush);
+        qCDebug(pskreporter_js8)
+            << "[PSK]unsent spot data:" << writer_.pending() << "bytes";
+    }
 
-            if (!tx_data_.size() && (spots_.size() || tx_residue_.size())) {
-                // Set Header
-                tx_out << quint16(0x50e3) // Template ID
-                       << quint16(0u);    // Length (place-holder)
+    // The queue is indexed by the cache key of each spot in it; the index
+    // holds a spot's position in the sequence of all spots ever queued,
+    // from which the number dequeued gives its place in the queue. Entries
+    // are checked against the spot they point to, so an entry whose spot
+    // has gone needs no removal; the index is cleared whenever the queue
+    // is empty.
+
+    Spot *queued(Key const &key) {
+        if (auto const it = queued_.constFind(key); it != queued_.constEnd()) {
+            if (auto const slot = *it - dequeued_;
+                slot >= 0 && slot < spots_.size() && spots_[slot].key_ == key) {
+                return &spots_[slot];
             }
+        }
+        return nullptr;
+    }
 
-            // insert any residue
-            if (tx_residue_.size()) {
-                tx_out.writeRawData(tx_residue_, tx_residue_.size());
-                tx_residue_.clear();
-            }
+    void enqueue(Spot spot) {
+        queued_.insert(spot.key_, dequeued_ + spots_.size());
+        spots_.enqueue(std::move(spot));
+    }
 
-            qCDebug(pskreporter_js8) << "[PSK]pending spots:" << spots_.size();
-            while (spots_.size() || flush) {
-                auto tx_data_size = tx_data_.size();
-                if (spots_.size()) {
-                    auto const &spot = spots_.dequeue();
-
-                    // Sender information
-                    writeUtfString(tx_out, spot.call_);
-                    tx_out // BigEndian
-                        << static_cast<quint8>(spot.freq_ >> 32)
-                        << static_cast<quint8>(spot.freq_ >> 24)
-                        << static_cast<quint8>(spot.freq_ >> 16)
-                        << static_cast<quint8>(spot.freq_ >> 8)
-                        << static_cast<quint8>(spot.freq_)
-                        << static_cast<qint8>(spot.snr_);
-                    writeUtfString(tx_out, spot.mode_);
-                    writeUtfString(tx_out, spot.grid_);
-                    tx_out << quint8(1u) // REPORTER_SOURCE_AUTOMATIC
-                           << static_cast<quint32>(
-                                  spot.time_.toSecsSinceEpoch());
-                }
+    Spot dequeue() {
+        ++dequeued_;
+        auto spot = spots_.dequeue();
+        if (spots_.isEmpty()) {
+            queued_.clear();
+        }
+        return spot;
+    }
+
+    void clear_spots() {
+        dequeued_ += spots_.size();
+        spots_.clear();
+        queued_.clear();
+    }
 
-                auto len = payload_.size() + tx_data_.size();
-                len += num_pad_bytes(tx_data_.size());
-                len += num_pad_bytes(len);
-
-                if (len > MAX_PAYLOAD_LENGTH // our upper datagram size limit
-                    || (!spots_.size() &&
-                        len > MIN_PAYLOAD_LENGTH) // spots drained and above
-                                                  // lower datagram size limit
-                    || (flush &&
-                        !spots_.size())) // send what we have, possibly no spots
-                {
-                    if (tx_data_.size()) {
-                        if (len <= MAX_PAYLOAD_LENGTH) {
-                            tx_data_size = tx_data_.size();
-                        }
-                        QByteArray tx{tx_data_.left(tx_data_size)};
-                        QDataStream out{&tx, QIODevice::WriteOnly |
-                                                 QIODevice::Append};
-                        // insert Length
-                        set_length(out, tx);
-                        message.writeRawData(tx, tx.size());
-                    }
-
-                    // insert Length and Export Time
-                    set_length(message, payload_);
-                    message.device()->seek(2 * sizeof(quint16));
-                    message << static_cast<quint32>(
-                        DriftingDateTime::currentSecsSinceEpoch());
-
-                    // Send data to PSK Reporter site
-                    socket_->write(payload_); // TODO: handle errors
-                    qCDebug(pskreporter_js8) << "[PSK]sent spots";
-                    flush = false; // break loop
-                    message.device()->seek(0u);
-                    payload_.clear(); // Fresh message
-                    // Save unsent spots
-                    tx_residue_ =
-                        tx_data_.right(tx_data_.size() - tx_data_size);
-                    tx_out.device()->seek(0u);
-                    tx_data_.clear();
-                    break;
+    // Cache entries are filed, by the time they were last updated, into
+    // buckets of CACHE_BUCKET seconds; expiry drops whole buckets, rather
+    // than examining every entry in the cache, and only those entries in
+    // them that haven't since been updated, and so filed again, later.
+
+    void cache(Key const &key, std::time_t const now) {
+        calls_.insert(key, now);
+        expiry_[now - now % CACHE_BUCKET].append(key);
+    }
+
+    void expire(std::time_t const now) {
+        while (!expiry_.isEmpty() &&
+               expiry_.firstKey() + CACHE_BUCKET <= now - CACHE_TIMEOUT * 2) {
+            auto const bucket = expiry_.firstKey();
+            for (auto const &key : expiry_.take(bucket)) {
+                if (auto const it = calls_.find(key);
+                    it != calls_.end() && *it < bucket + CACHE_BUCKET) {
+                    calls_.erase(it);
                 }
             }
-            qCDebug(pskreporter_js8)
-                << "[PSK]remaining spots:" << spots_.size();
         }
     }
 
@@ -666,6 +404,7 @@ void PSKReporter::setLocalStation(QString const &call, QString const &grid,
         m_->rx_call_ = call;
         m_->rx_grid_ = grid;
         m_->rx_ant_ = ant;
+        m_->writer_.setReceiver(call, grid, m_->prog_id_, ant);
     }
 }
 
@@ -697,10 +436,7 @@ void PSKReporter::addRemoteStation(QString const &call, QString const &grid,
         // either by adding a new cache entry or updating an existing one with
         // an updated time value.
 
-        // Get the frequency band name and concatenate it with the callsign to
-        // create the cache key so we can spot cached calls if they switch bands
-        auto const band = m_->config_->bands()->find(freq);
-        auto const cache_key = call + "_" + band;
+        auto const key = impl::Key{call, m_->config_->bands()->find(freq)};
 
         const std::time_t now = std::time(nullptr);
 
@@ -708,39 +444,29 @@ void PSKReporter::addRemoteStation(QString const &call, QString const &grid,
         // current time
         const std::time_t cache_expiration_time = now - CACHE_TIMEOUT;
 
-        auto const it = m_->calls_.find(cache_key);
+        auto const it = m_->calls_.constFind(key);
 
-        bool notFound = (it == m_->calls_.end());
+        bool notFound = (it == m_->calls_.constEnd());
         bool expired = (!notFound && it.value() < cache_expiration_time);
         bool eclipse = m_->eclipse_active(utcTimestamp);
 
         if (notFound || expired || eclipse) {
-            m_->spots_.enqueue({call, grid, snr, freq, mode, utcTimestamp});
-            m_->calls_.insert(cache_key, now);
+            m_->enqueue({key, call, grid, snr, freq, mode, utcTimestamp});
+            m_->cache(key, now);
         } else // cache exists AND not expired AND no eclipse active
         {
-            // Iterate through the queued spots from last to first, if we find
-            // one with a matching call and band (we should), replace it with a
-            // new spot with updated details and bump the cache time
-            for (qsizetype i = m_->spots_.size(); i-- > 0;) {
-                auto const &cachedSpot = m_->spots_[i];
-                auto const cachedSpotBand =
-                    m_->config_->bands()->find(cachedSpot.freq_);
-
-                if (cachedSpot.call_ == call && cachedSpotBand == band) {
-                    m_->spots_[i] = {call, grid, snr, freq, mode, utcTimestamp};
-                    m_->calls_.insert(cache_key, now);
-                    break;
-                }
+            // If the spot for this call and band is still queued, replace it
+            // with a new spot with updated details and bump the cache time.
+            if (auto const spot = m_->queued(key)) {
+                *spot = {key, call, grid, snr, freq, mode, utcTimestamp};
+                m_->cache(key, now);
             }
         }
 
         // Perform cache cleanup; anything that's been around for more than
         // twice the cache timeout period can go.
 
-        m_->calls_.removeIf([now](auto const it) {
-            return now - it.value() > (CACHE_TIMEOUT * 2);
-        });
+        m_->expire(now);
     }
 }
 
@@ -0,0 +1,239 @@
+#include "CATScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include <QLoggingCategory>
+#include <QMetaObject>
+
+Q_DECLARE_LOGGING_CATEGORY(catscheduler_js8)
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+enum Kind { PTT, RX_frequency, TX_frequency, rig_mode, other, kinds };
+
+char const *const kind_names[kinds] = {"PTT", "RX frequency", "TX frequency",
+                                       "mode", "other"};
+
+// The kind of change the request makes to the state, in order of
+// priority where it makes more than one.
+Kind kind_of(Transceiver::TransceiverState const &from,
+             Transceiver::TransceiverState const &to) {
+    if (from.ptt() != to.ptt())
+        return PTT;
+    if (from.frequency() != to.frequency())
+        return RX_frequency;
+    if (from.tx_frequency() != to.tx_frequency() || from.split() != to.split())
+        return TX_frequency;
+    if (from.mode() != to.mode())
+        return rig_mode;
+    return other;
+}
+
+double ms(Clock::duration const d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+struct stats {
+    unsigned requests{0};
+    unsigned superseded{0};
+    Clock::duration waited{};
+    Clock::duration waited_max{};
+    Clock::duration took{};
+    Clock::duration took_max{};
+};
+} // namespace
+
+// State shared between the scheduler and the requests it has posted; it
+// outlives the scheduler until the last of them has been acted on.
+struct CATScheduler::queue {
+    struct request {
+        enum Action { start, set, stop } action;
+        Transceiver::TransceiverState state;
+        unsigned sequence_number{0};
+        unsigned superseded{0};
+        Clock::time_point submitted;
+    };
+
+    // the Transceiver the scheduler was made for, which requests are made
+    // of, as opposed to one it wraps
+    Transceiver *transceiver{nullptr};
+
+    std::mutex mutex;
+
+    // guarded by the mutex
+    std::deque<request> pending;
+    stats totals[kinds];
+
+    // touched only on the Transceiver's thread
+    Transceiver::TransceiverState last;
+
+    // acts on the first pending request; false if there were none
+    bool dispatch();
+};
+
+// The queues of the schedulers that exist, by Transceiver.
+struct CATScheduler::registry {
+    std::mutex mutex;
+    std::unordered_map<Transceiver const *, std::weak_ptr<queue>> queues;
+
+    static registry &instance() {
+        static registry r;
+        return r;
+    }
+
+    static std::shared_ptr<queue> find(Transceiver const *transceiver) {
+        auto &r = instance();
+        std::lock_guard<std::mutex> lock{r.mutex};
+        if (auto const it = r.queues.find(transceiver); it != r.queues.end()) {
+            return it->second.lock();
+        }
+        return {};
+    }
+};
+
+CATScheduler::CATScheduler(Transceiver *transceiver)
+    : transceiver_{transceiver}, queue_{std::make_shared<queue>()} {
+    queue_->transceiver = transceiver_;
+
+    auto &r = registry::instance();
+    std::lock_guard<std::mutex> lock{r.mutex};
+    for (auto t = transceiver_; t; t = t->wrapped()) {
+        r.queues[t] = queue_;
+    }
+}
+
+CATScheduler::~CATScheduler() {
+    {
+        auto &r = registry::instance();
+        std::lock_guard<std::mutex> lock{r.mutex};
+        for (auto t = transceiver_; t; t = t->wrapped()) {
+            r.queues.erase(t);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock{queue_->mutex};
+    for (int k = 0; k < kinds; ++k) {
+        auto const &s = queue_->totals[k];
+        if (s.requests) {
+            qCDebug(catscheduler_js8).nospace()
+                << "[CAT]" << kind_names[k] << ": " << s.requests
+                << " requests, " << s.superseded << " superseded; waited "
+                << ms(s.waited) / s.requests << " ms on average, "
+                << ms(s.waited_max) << " ms at most; took "
+                << ms(s.took) / s.requests << " ms on average, "
+                << ms(s.took_max) << " ms at most";
+        }
+    }
+}
+
+void CATScheduler::start(unsigned sequence_number) {
+    {
+        std::lock_guard<std::mutex> lock{queue_->mutex};
+        queue_->pending.push_back({queue::request::start, {}, sequence_number,
+                                   0, Clock::now()});
+    }
+    post();
+}
+
+void CATScheduler::set(Transceiver::TransceiverState const &state,
+                       unsigned sequence_number) {
+    {
+        std::lock_guard<std::mutex> lock{queue_->mutex};
+        auto &pending = queue_->pending;
+
+        // if the last request yet to be acted on is a state change, this
+        // one rides along with it
+        if (!pending.empty() && pending.back().action == queue::request::set) {
+            pending.back().state = state;
+            pending.back().sequence_number = sequence_number;
+            ++pending.back().superseded;
+            return;
+        }
+
+        pending.push_back({queue::request::set, state, sequence_number, 0,
+                           Clock::now()});
+    }
+    post();
+}
+
+void CATScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock{queue_->mutex};
+        queue_->pending.push_back(
+            {queue::request::stop, {}, 0, 0, Clock::now()});
+    }
+    post();
+}
+
+// Each request is posted on its own; the posted call acts on whichever
+// request is first in the queue, if dispatch_pending() hasn't already.
+void CATScheduler::post() {
+    QMetaObject::invokeMethod(
+        transceiver_, [q = queue_]() { q->dispatch(); }, Qt::QueuedConnection);
+}
+
+void CATScheduler::dispatch_pending(Transceiver *transceiver) {
+    if (auto const q = registry::find(transceiver)) {
+        while (q->dispatch()) {
+        }
+    }
+}
+
+bool CATScheduler::pending(Transceiver const *transceiver) {
+    if (auto const q = registry::find(transceiver)) {
+        std::lock_guard<std::mutex> lock{q->mutex};
+        return !q->pending.empty();
+    }
+    return false;
+}
+
+bool CATScheduler::queue::dispatch() {
+    std::unique_lock<std::mutex> lock{mutex};
+    if (pending.empty()) {
+        return false;
+    }
+    auto const r = pending.front();
+    pending.pop_front();
+    lock.unlock();
+
+    switch (r.action) {
+    case request::start:
+        transceiver->start(r.sequence_number);
+        return true;
+    case request::stop:
+        transceiver->stop();
+        return true;
+    case request::set:
+        break;
+    }
+
+    auto const waited = Clock::now() - r.submitted;
+    auto const start = Clock::now();
+    transceiver->set(r.state, r.sequence_number);
+    auto const took = Clock::now() - start;
+
+    auto const kind = kind_of(last, r.state);
+    last = r.state;
+
+    qCDebug(catscheduler_js8).nospace()
+        << "[CAT]" << kind_names[kind] << " #" << r.sequence_number
+        << ": waited " << ms(waited) << " ms, took " << ms(took) << " ms, "
+        << r.superseded << " superseded";
+
+    lock.lock();
+    auto &s = totals[kind];
+    ++s.requests;
+    s.superseded += r.superseded;
+    s.waited += waited;
+    s.waited_max = std::max(s.waited_max, waited);
+    s.took += took;
+    s.took_max = std::max(s.took_max, took);
+    return true;
+}
+
+Q_LOGGING_CATEGORY(catscheduler_js8, "catscheduler.js8", QtWarningMsg)
@@ -0,0 +1,78 @@
+#ifndef CAT_SCHEDULER_HPP__
+#define CAT_SCHEDULER_HPP__
+
+#include <memory>
+
+#include "Transceiver.h"
+
+//
+// CAT Scheduler
+//
+//  Helper class that passes requests to a Transceiver instance on the
+//  thread it runs on, in the order they were made, coalescing  state
+//  changes the Transceiver has yet to act on.
+//
+// Collaborations
+//
+//  Stands in  for queued connections to Transceiver::start(), set() and
+//  stop(). Each state change carries the whole of the requested state,
+//  so one the Transceiver hasn't yet started on is superseded by a state
+//  change that directly follows it; a burst of frequency changes, e.g.
+//  while the dial is dragged, costs the rig a single QSY, to the last
+//  frequency requested, once it's done with what it's doing. A state
+//  change is never coalesced across a start or a stop.
+//
+//  Requests are posted to the  Transceiver's thread, and may also be
+//  acted on ahead of a poll, see PollingTransceiver, which calls
+//  dispatch_pending() before each, and cuts a poll short, between one
+//  query of the rig and the next, for a request that's pending(). The
+//  Transceiver a scheduler is made for is looked up by any it wraps, so
+//  that one  wrapped, e.g. by EmulateSplitTransceiver,  can find it.
+//  Within a request the  Transceiver
+//  orders its commands as it always has: PTT off first, then frequencies
+//  and mode, then PTT on, so that the rig never keys up on the frequency
+//  it's leaving.
+//
+// Responsibilities
+//
+//  Keeps per-command timing  statistics: the time a request waited to
+//  be acted on, the time it took, and the number of requests it super-
+//  seded, by the kind of change it made; PTT, RX frequency, TX frequency,
+//  mode, or other. Each request is logged as it's acted on, and totals
+//  on destruction, to the catscheduler.js8 logging category.
+//
+class CATScheduler final {
+  public:
+    // the Transceiver must outlive any requests made of it
+    explicit CATScheduler(Transceiver *transceiver);
+    ~CATScheduler();
+
+    CATScheduler(CATScheduler const &) = delete;
+    CATScheduler &operator=(CATScheduler const &) = delete;
+
+    // Start the Transceiver, request a state, or stop it; may be called
+    // from any thread.
+    void start(unsigned sequence_number);
+    void set(Transceiver::TransceiverState const &, unsigned sequence_number);
+    void stop();
+
+    // Acts now, in order, on the requests made of the Transceiver through
+    // its scheduler that it has yet to act on; does nothing if it has no
+    // scheduler. Call only on the Transceiver's thread.
+    static void dispatch_pending(Transceiver *transceiver);
+
+    // Whether requests made of the Transceiver through its scheduler are
+    // yet to be acted on; may be called from any thread.
+    static bool pending(Transceiver const *transceiver);
+
+  private:
+    struct queue;
+    struct registry;
+
+    void post();
+
+    Transceiver *transceiver_;
+    std::shared_ptr<queue> queue_;
+};
+
+#endif
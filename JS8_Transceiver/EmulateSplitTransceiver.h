@@ -38,6 +38,7 @@ class EmulateSplitTransceiver final : public Transceiver {
         wrapped_->start(sequence_number);
     }
     void stop() noexcept override { wrapped_->stop(); }
+    Transceiver *wrapped() const override { return wrapped_.get(); }
 
   private:
     void handle_update(TransceiverState const &, unsigned seqeunce_number);
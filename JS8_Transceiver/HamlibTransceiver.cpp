@@ -122,19 +122,6 @@ int unregister_callback(rig_model_t rig_model, void *) {
     return 1; // keep them coming
 }
 
-// int frequency_change_callback (RIG * /* rig */, vfo_t vfo, freq_t f,
-// rig_ptr_t arg)
-// {
-//   (void)vfo;			// unused in release build
-
-//   Q_ASSERT (vfo == RIG_VFO_CURR); // G4WJS: at the time of writing only
-//   current VFO is signalled by hamlib
-
-//   HamlibTransceiver * transceiver (reinterpret_cast<HamlibTransceiver *>
-//   (arg)); Q_EMIT transceiver->frequency_change (f, Transceiver::A); return
-//   RIG_OK;
-// }
-
 class hamlib_tx_vfo_fixup final {
   public:
     hamlib_tx_vfo_fixup(RIG *rig, vfo_t tx_vfo) : rig_{rig} {
@@ -187,7 +174,7 @@ HamlibTransceiver::HamlibTransceiver(TransceiverFactory::PTTMethod ptt_type,
       back_ptt_port_{false}, one_VFO_{false}, is_dummy_{true}, reversed_{false},
       freq_query_works_{true}, mode_query_works_{true},
       split_query_works_{true}, tickle_hamlib_{false}, get_vfo_works_{true},
-      set_vfo_works_{true} {
+      set_vfo_works_{true}, transceive_{false}, transceiving_{false} {
     if (!rig_) {
         throw error{tr("Hamlib initialisation error")};
     }
@@ -231,7 +218,8 @@ HamlibTransceiver::HamlibTransceiver(
       reversed_{false}, freq_query_works_{rig_ && rig_->caps->get_freq},
       mode_query_works_{rig_ && rig_->caps->get_mode},
       split_query_works_{rig_ && rig_->caps->get_split_vfo},
-      tickle_hamlib_{false}, get_vfo_works_{true}, set_vfo_works_{true} {
+      tickle_hamlib_{false}, get_vfo_works_{true}, set_vfo_works_{true},
+      transceive_{false}, transceiving_{false} {
     if (!rig_) {
         throw error{tr("Hamlib initialisation error")};
     }
@@ -292,6 +280,11 @@ HamlibTransceiver::HamlibTransceiver(
                                      .constData());
                     }
                 }
+
+                //
+                // rig reports its own changes, see do_start()
+                //
+                transceive_ = settings["transceive"].toBool();
             }
         }
 
@@ -388,10 +381,26 @@ HamlibTransceiver::HamlibTransceiver(
 
     // Make Icom CAT split commands less glitchy
     set_conf("no_xchg", "1");
+}
+
+// Hamlib calls these back, from its event handling, which may be a signal
+// handler, when a rig in transceive mode reports a change; they note only
+// that there was one, and the next tick of the polling timer polls for it.
+
+int HamlibTransceiver::changed(RIG *, vfo_t, freq_t, rig_ptr_t arg) {
+    static_cast<HamlibTransceiver *>(arg)->changed_asynchronously();
+    return RIG_OK;
+}
+
+int HamlibTransceiver::changed(RIG *, vfo_t, rmode_t, pbwidth_t,
+                               rig_ptr_t arg) {
+    static_cast<HamlibTransceiver *>(arg)->changed_asynchronously();
+    return RIG_OK;
+}
 
-    // would be nice to get events but not supported on Windows and also not on
-    // a lot of rigs rig_set_freq_callback (rig_.data (),
-    // &frequency_change_callback, this);
+int HamlibTransceiver::changed(RIG *, vfo_t, ptt_t, rig_ptr_t arg) {
+    static_cast<HamlibTransceiver *>(arg)->changed_asynchronously();
+    return RIG_OK;
 }
 
 void HamlibTransceiver::error_check(int ret_code, QString const &doing) const {
@@ -642,6 +651,29 @@ int HamlibTransceiver::do_start() {
         resolution = -1; // best guess
     }
 
+    // Rigs that report their own changes, e.g. by Kenwood auto information or
+    // Icom CI-V transceive, are asked to do so if the settings file says to;
+    // we're then called back on each change, and poll for it at once, rather
+    // than at the next polling interval, and between changes poll only every
+    // 30s, unless polling is set to be less often still. Only frequency, mode
+    // and PTT are reported; a change of split made at the rig may go unseen for
+    // as long. It's not supported on Windows, nor on a lot of rigs, and on some
+    // the reports get in the way of replies to commands, so it's to be asked
+    // for.
+    if (transceive_) {
+        rig_set_freq_callback(rig_.data(), &HamlibTransceiver::changed, this);
+        rig_set_mode_callback(rig_.data(), &HamlibTransceiver::changed, this);
+        rig_set_ptt_callback(rig_.data(), &HamlibTransceiver::changed, this);
+        transceiving_ = RIG_OK == rig_set_trn(rig_.data(), RIG_TRN_RIG);
+        reports_changes(transceiving_);
+        if (!transceiving_) {
+            rig_set_freq_callback(rig_.data(), nullptr, nullptr);
+            rig_set_mode_callback(rig_.data(), nullptr, nullptr);
+            rig_set_ptt_callback(rig_.data(), nullptr, nullptr);
+        }
+        TRACE_CAT("HamlibTransceiver", "transceive =" << transceiving_);
+    }
+
     poll();
 
     TRACE_CAT("HamlibTransceiver", "exit" << state()
@@ -660,6 +692,11 @@ void HamlibTransceiver::do_stop() {
         }
     }
     if (rig_) {
+        if (transceiving_) {
+            rig_set_trn(rig_.data(), RIG_TRN_OFF);
+            transceiving_ = false;
+            reports_changes(false);
+        }
         rig_close(rig_.data());
     }
 
@@ -989,8 +1026,12 @@ void HamlibTransceiver::poll() {
         reversed_ = RIG_VFO_B == v;
     }
 
-    if ((WSJT_RIG_NONE_CAN_SPLIT || !is_dummy_) && rig_->caps->get_split_vfo &&
-        split_query_works_) {
+    // Each query of the rig below gives way to a request waiting on it; a
+    // PTT change shouldn't wait on a slow rig's answers to the rest of the
+    // poll, just the one it's giving.
+
+    if (!give_way() && (WSJT_RIG_NONE_CAN_SPLIT || !is_dummy_) &&
+        rig_->caps->get_split_vfo && split_query_works_) {
         vfo_t v{RIG_VFO_NONE}; // so we can tell if it doesn't get updated :(
         auto rc = rig_get_split_vfo(rig_.data(), RIG_VFO_CURR, &s, &v);
         if (-RIG_OK == rc && RIG_SPLIT_ON == s) {
@@ -1018,7 +1059,7 @@ void HamlibTransceiver::poll() {
         }
     }
 
-    if (freq_query_works_) {
+    if (!give_way() && freq_query_works_) {
         // only read if possible and when receiving or simplex
         if (!state().ptt() || !state().split()) {
             error_check(rig_get_freq(rig_.data(), RIG_VFO_CURR, &f),
@@ -1029,7 +1070,8 @@ void HamlibTransceiver::poll() {
             update_rx_frequency(f);
         }
 
-        if ((WSJT_RIG_NONE_CAN_SPLIT || !is_dummy_) && state().split() &&
+        if (!give_way() && (WSJT_RIG_NONE_CAN_SPLIT || !is_dummy_) &&
+            state().split() &&
             (rig_->caps->targetable_vfo &
              (RIG_TARGETABLE_FREQ | RIG_TARGETABLE_PURE)) &&
             !one_VFO_) {
@@ -1057,7 +1099,8 @@ void HamlibTransceiver::poll() {
     }
 
     // only read when receiving or simplex if direct VFO addressing unavailable
-    if ((!state().ptt() || !state().split()) && mode_query_works_) {
+    if (!give_way() && (!state().ptt() || !state().split()) &&
+        mode_query_works_) {
         // We have to ignore errors here because Yaesu FTdx... rigs can
         // report the wrong mode when transmitting split with different
         // modes per VFO. This is unfortunate because that is exactly
@@ -1077,7 +1120,8 @@ void HamlibTransceiver::poll() {
         }
     }
 
-    if (RIG_PTT_NONE != rig_->state.pttport.type.ptt && rig_->caps->get_ptt) {
+    if (!give_way() && RIG_PTT_NONE != rig_->state.pttport.type.ptt &&
+        rig_->caps->get_ptt) {
         ptt_t p;
         auto rc = rig_get_ptt(rig_.data(), RIG_VFO_CURR, &p);
         if (-RIG_ENAVAIL != rc && -RIG_ENIMPL != rc) // may fail if
@@ -54,6 +54,10 @@ class HamlibTransceiver final : public PollingTransceiver {
 
     void poll() override;
 
+    static int changed(RIG *, vfo_t, freq_t, rig_ptr_t);
+    static int changed(RIG *, vfo_t, rmode_t, pbwidth_t, rig_ptr_t);
+    static int changed(RIG *, vfo_t, ptt_t, rig_ptr_t);
+
     void error_check(int ret_code, QString const &doing) const;
     void set_conf(char const *item, char const *value);
     QByteArray get_conf(char const *item);
@@ -85,6 +89,8 @@ class HamlibTransceiver final : public PollingTransceiver {
                          // establish the Tx VFO
     bool get_vfo_works_; // Net rigctl promises what it can't deliver
     bool set_vfo_works_; // More rigctl promises which it can't deliver
+    bool transceive_;    // asked to have the rig report its own changes
+    bool transceiving_;  // and it does
 };
 
 #endif
@@ -0,0 +1,61 @@
+#ifndef POLL_SCHEDULE_HPP__
+#define POLL_SCHEDULE_HPP__
+
+#include <algorithm>
+#include <cstdint>
+
+//
+// Poll Schedule
+//
+//  Decides when a rig is next to be polled; polls come quickly after a
+//  command is sent, or a change is seen, and back off, each interval
+//  double the last, to the longest interval while the state doesn't
+//  change.
+//
+// Collaborations
+//
+//  Used by  PollingTransceiver, which asks  whether a poll  is due at
+//  each tick of its timer. Times are in milliseconds, on any  clock
+//  that doesn't go backwards; there's  nothing here of Qt, so that the
+//  schedule may be run on a simulated clock, see tools/poll_schedule_
+//  check.cpp.
+//
+class PollSchedule final {
+  public:
+    using Time = std::int64_t;
+
+    // shortest polling interval, after a command or a change
+    static int constexpr fastest{250};
+
+    explicit PollSchedule(int longest = 0) : longest_{longest} {}
+
+    // The longest polling interval; takes effect at the next poll.
+    void longest(int interval) { longest_ = interval; }
+    int longest() const { return longest_; }
+
+    // Polls again shortly, counting from now, and backs off afresh from
+    // there.
+    void soon(Time now) {
+        interval_ = std::min(fastest, longest_);
+        last_ = now;
+    }
+
+    bool due(Time now) const { return now - last_ >= interval_; }
+
+    // Notes a poll made now, which found the state on the move, or yet
+    // to settle, or not.
+    void polled(Time now, bool moving) {
+        last_ = now;
+        interval_ = moving ? std::min(fastest, longest_)
+                           : std::min(interval_ * 2, longest_);
+    }
+
+    int interval() const { return interval_; }
+
+  private:
+    int longest_;
+    int interval_{0};
+    Time last_{0};
+};
+
+#endif
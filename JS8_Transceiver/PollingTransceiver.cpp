@@ -1,20 +1,36 @@
 #include "PollingTransceiver.h"
 
+#include <algorithm>
 #include <exception>
 
 #include <QObject>
 #include <QString>
 #include <QTimer>
 
+#include "CATScheduler.h"
+
 #include "moc_PollingTransceiver.cpp"
 
 namespace {
 unsigned const polls_to_stabilize{3};
-}
+
+// interval at which the timer ticks, checking whether a poll is due,
+// or a change has been reported, in milliseconds
+int const tick_interval{50};
+
+// longest polling interval, when the rig reports its own changes, unless
+// the configured one is longer, in milliseconds; polls are then needed
+// only to see that the rig is still there, and for the changes it
+// doesn't report
+int const reported_poll_interval{30000};
+} // namespace
 
 PollingTransceiver::PollingTransceiver(int poll_interval, QObject *parent)
     : TransceiverBase{parent}, interval_{poll_interval * 1000},
-      poll_timer_{nullptr}, retries_{0} {}
+      schedule_{interval_}, poll_timer_{nullptr}, changed_{false},
+      polling_{false}, retries_{0} {
+    clock_.start();
+}
 
 void PollingTransceiver::start_timer() {
     if (interval_) {
@@ -26,7 +42,8 @@ void PollingTransceiver::start_timer() {
             connect(poll_timer_, &QTimer::timeout, this,
                     &PollingTransceiver::handle_timeout);
         }
-        poll_timer_->start(interval_);
+        schedule_.soon(clock_.elapsed());
+        poll_timer_->start(std::min(tick_interval, interval_));
     } else {
         stop_timer();
     }
@@ -38,6 +55,19 @@ void PollingTransceiver::stop_timer() {
     }
 }
 
+// Polls again shortly, counting from now, and backs off afresh from
+// there; the rig has been asked to change, and will soon have, or be
+// part way through having, done so. Counting from the last poll would
+// poll at once, if that was a while ago, before the rig has had time
+// to act.
+
+void PollingTransceiver::poll_soon() { schedule_.soon(clock_.elapsed()); }
+
+void PollingTransceiver::reports_changes(bool reports) {
+    schedule_.longest(reports ? std::max(interval_, reported_poll_interval)
+                              : interval_);
+}
+
 void PollingTransceiver::do_post_start() {
     start_timer();
     if (!next_state_.online()) {
@@ -64,6 +94,7 @@ void PollingTransceiver::do_post_frequency(Frequency f, MODE m) {
             next_state_.mode(m);
         }
         retries_ = polls_to_stabilize;
+        poll_soon();
     }
 }
 
@@ -74,6 +105,7 @@ void PollingTransceiver::do_post_tx_frequency(Frequency f, MODE) {
         next_state_.tx_frequency(f);
         next_state_.split(f); // setting non-zero TX frequency means split
         retries_ = polls_to_stabilize;
+        poll_soon();
     }
 }
 
@@ -83,6 +115,7 @@ void PollingTransceiver::do_post_mode(MODE m) {
         // update expected state with new mode and set poll count
         next_state_.mode(m);
         retries_ = polls_to_stabilize;
+        poll_soon();
     }
 }
 
@@ -92,6 +125,7 @@ void PollingTransceiver::do_post_ptt(bool p) {
         next_state_.ptt(p);
         retries_ = polls_to_stabilize;
         // retries_ = 0;             // fast feedback on PTT
+        poll_soon();
     }
 }
 
@@ -103,10 +137,22 @@ bool PollingTransceiver::do_pre_update() {
     return true;
 }
 
+bool PollingTransceiver::give_way() const {
+    return polling_ && CATScheduler::pending(this);
+}
+
 void PollingTransceiver::do_sync(bool force_signal, bool no_poll) {
-    if (!no_poll)
+    if (!no_poll) {
         poll(); // tell sub-classes to update our state
 
+        // A poll cut short, or overtaken, by a request doesn't count
+        // towards the state settling; the request goes first, and it's
+        // polled again after.
+        if (!force_signal && give_way()) {
+            return;
+        }
+    }
+
     // Signal new state if it is directly requested or, what we expected
     // or, hasn't become what we expected after polls_to_stabilize
     // polls. Unsolicited changes will be signalled immediately unless
@@ -136,17 +182,39 @@ void PollingTransceiver::do_sync(bool force_signal, bool no_poll) {
 }
 
 void PollingTransceiver::handle_timeout() {
+    // poll if a change has been reported, or the interval has run
+    if (!changed_.exchange(false) && !schedule_.due(clock_.elapsed())) {
+        return;
+    }
+
+    // Requests waiting on the scheduler go ahead of the poll; a PTT change,
+    // or a QSY, shouldn't wait on a rig that's slow to answer. One of them
+    // may have stopped us.
+    CATScheduler::dispatch_pending(this);
+    if (!poll_timer_->isActive()) {
+        return;
+    }
+
     QString message;
 
     // we must catch all exceptions here since we are called by Qt and
     // inform our parent of the failure via the offline() message
     try {
+        auto const before = state();
+        auto const now = clock_.elapsed();
+        polling_ = true;
         do_sync();
+
+        // Poll quickly while the state is on the move, or is yet to
+        // settle to what's expected, or the poll gave way to a request;
+        // back off while it holds still.
+        schedule_.polled(now, retries_ || state() != before || give_way());
     } catch (std::exception const &e) {
         message = e.what();
     } catch (...) {
         message = tr("Unexpected rig error");
     }
+    polling_ = false;
     if (!message.isEmpty()) {
         offline(message);
     }
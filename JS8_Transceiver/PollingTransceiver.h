@@ -1,8 +1,11 @@
 #ifndef POLLING_TRANSCEIVER_HPP__
 #define POLLING_TRANSCEIVER_HPP__
 
+#include <QElapsedTimer>
 #include <QObject>
+#include <atomic>
 
+#include "PollSchedule.h"
 #include "TransceiverBase.h"
 
 class QTimer;
@@ -17,7 +20,27 @@ class QTimer;
 //
 //  Implements the TransceiverBase post  action interface and provides
 //  the abstract  poll() operation  for sub-classes to  implement. The
-//  poll operation is invoked every poll_interval seconds.
+//  poll operation is invoked every poll_interval  seconds,  and
+//  more often when the rig's state is on the move: polls come quickly
+//  after a command is  sent, or a change is seen,  and back off, each
+//  interval double the last, to poll_interval while the state doesn't
+//  change, so that a command is seen to have taken effect promptly, how-
+//  ever long the poll_interval. An  idle rig is polled as often as it
+//  was at a fixed poll_interval; it's the polls that follow  a command
+//  that are sooner. See PollSchedule.
+//
+//  Sub-classes whose rigs can  report their own changes  may call the
+//  changed_asynchronously() operation when one is reported; the state
+//  is then polled at the next  tick, without waiting for the interval
+//  to run. Those that have asked  the rig to report its changes, and
+//  been told it will, may call  reports_changes(); polls then back off
+//  further, to 30s  or poll_interval if longer,  as they're needed only
+//  to see that the rig is still there, and for what it doesn't report.
+//
+//  Requests made through a CATScheduler  are acted on ahead of each
+//  poll, so that they don't wait behind it, and sub-classes may cut a
+//  poll short, see give_way(), for one made while it's under way; then
+//  a request waits on the query in progress, not on the whole poll.
 //
 // Responsibilities
 //
@@ -44,6 +67,18 @@ class PollingTransceiver : public TransceiverBase {
     // in a non-intrusive manner.
     virtual void poll() = 0;
 
+    // Notes that the rig has reported a change of state; safe to call
+    // from any thread, and from a signal handler.
+    void changed_asynchronously() noexcept { changed_ = true; }
+
+    // Notes whether the rig reports its own changes.
+    void reports_changes(bool);
+
+    // Whether a poll under way should give way to a request made through
+    // a CATScheduler; sub-classes may check between one query of the rig
+    // and the next, and leave the rest of the state as it was if so.
+    bool give_way() const;
+
     void do_post_start() override final;
     void do_post_stop() override final;
     void do_post_frequency(Frequency, MODE) override final;
@@ -55,11 +90,16 @@ class PollingTransceiver : public TransceiverBase {
   private:
     void start_timer();
     void stop_timer();
+    void poll_soon();
 
     Q_SLOT void handle_timeout();
 
-    int interval_; // polling interval in milliseconds
+    int interval_; // configured polling interval in milliseconds
+    PollSchedule schedule_;
     QTimer *poll_timer_;
+    QElapsedTimer clock_;
+    std::atomic<bool> changed_;
+    bool polling_; // in a timed poll, which may give way
 
     // keep a record of the last state signalled so we can elide
     // duplicate updates
@@ -135,6 +135,9 @@ class Transceiver : public QObject {
     Q_SLOT virtual void start(unsigned sequence_number) noexcept = 0;
     Q_SLOT virtual void stop() noexcept = 0;
 
+    // The Transceiver this one decorates, if any.
+    virtual Transceiver *wrapped() const { return nullptr; }
+
     //
     // asynchronous status updates
     //
@@ -183,6 +183,7 @@
 #include "JS8_Main/StationList.h"
 #include "JS8_Main/qt_helpers.h"
 #include "JS8_Network/NetworkServerLookup.h"
+#include "JS8_Transceiver/CATScheduler.h"
 #include "JS8_Transceiver/Transceiver.h"
 #include "JS8_Transceiver/TransceiverFactory.h"
 #include "JS8_Widgets/LazyFillComboBox.h"
@@ -489,6 +490,7 @@ class Configuration::impl final : public QDialog {
 
     QThread *transceiver_thread_;
     TransceiverFactory transceiver_factory_;
+    std::unique_ptr<CATScheduler> cat_scheduler_;
     QList<QMetaObject::Connection> rig_connections_;
 
     QScopedPointer<Ui::configuration_dialog> ui_;
@@ -585,6 +587,8 @@ class Configuration::impl final : public QDialog {
     QString reply_;
     int callsign_aging_;
     int activity_aging_;
+    int rx_history_lines_;
+    int rx_history_age_;
     QColor color_primary_highlight_;
     QColor next_color_primary_highlight_;
     QColor color_secondary_highlight_;
@@ -1171,6 +1175,10 @@ int Configuration::callsign_aging() const { return m_->callsign_aging_; }
 
 int Configuration::activity_aging() const { return m_->activity_aging_; }
 
+int Configuration::rx_history_lines() const { return m_->rx_history_lines_; }
+
+int Configuration::rx_history_age() const { return m_->rx_history_age_; }
+
 void Configuration::set_dynamic_location(QString const &grid_descriptor) {
     m_->dynamic_grid_ = grid_descriptor.trimmed();
 }
@@ -1657,6 +1665,8 @@ void Configuration::impl::initialize_models() {
     ui_->grid_line_edit->setText(my_grid_.toUpper());
     ui_->callsign_aging_spin_box->setValue(callsign_aging_);
     ui_->activity_aging_spin_box->setValue(activity_aging_);
+    ui_->rx_history_lines_spin_box->setValue(rx_history_lines_);
+    ui_->rx_history_age_spin_box->setValue(rx_history_age_);
     ui_->groups_line_edit->setText(my_groups_.join(", "));
     ui_->auto_whitelist_line_edit->setText(auto_whitelist_.join(", "));
     ui_->auto_blacklist_line_edit->setText(auto_blacklist_.join(", "));
@@ -1980,6 +1990,8 @@ void Configuration::impl::read_settings() {
             .toStringList();
     callsign_aging_ = settings_->value("CallsignAging", 0).toInt();
     activity_aging_ = settings_->value("ActivityAging", 2).toInt();
+    rx_history_lines_ = settings_->value("RXHistoryLines", 5000).toInt();
+    rx_history_age_ = settings_->value("RXHistoryAge", 0).toInt();
     eot_ = settings_->value("EOTCharacter", QString{"\u2662"}).toString();
     mfi_ = settings_->value("MFICharacter", QString{"\u2026\u2026"}).toString();
     my_info_ = settings_->value("MyInfo", QString{}).toString();
@@ -2342,6 +2354,8 @@ void Configuration::impl::write_settings() {
     settings_->setValue("Reply", reply_);
     settings_->setValue("CallsignAging", callsign_aging_);
     settings_->setValue("ActivityAging", activity_aging_);
+    settings_->setValue("RXHistoryLines", rx_history_lines_);
+    settings_->setValue("RXHistoryAge", rx_history_age_);
     settings_->setValue("colorCQ", color_cq_);
     settings_->setValue("colorPrimary", color_primary_highlight_);
     settings_->setValue("colorSecondary", color_secondary_highlight_);
@@ -3025,6 +3039,8 @@ void Configuration::impl::accept() {
     my_status_ = ui_->status_message_line_edit->text().toUpper();
     callsign_aging_ = ui_->callsign_aging_spin_box->value();
     activity_aging_ = ui_->activity_aging_spin_box->value();
+    rx_history_lines_ = ui_->rx_history_lines_spin_box->value();
+    rx_history_age_ = ui_->rx_history_age_spin_box->value();
     spot_to_reporting_networks_ = ui_->psk_reporter_check_box->isChecked();
     spot_to_aprs_ = ui_->enable_aprs_spotting_check_box->isChecked();
     psk_reporter_tcpip_ = ui_->psk_reporter_tcpip_check_box->isChecked();
@@ -3937,10 +3953,16 @@ bool Configuration::impl::open_rig(bool force) {
             // hook up Configuration transceiver control signals to Transceiver
             // slots
             //
-            // these connections cross the thread boundary
-            rig_connections_
-                << connect(this, &Configuration::impl::set_transceiver,
-                           rig.get(), &Transceiver::set);
+            // these go by way of the scheduler, which crosses the thread
+            // boundary, in order, coalescing state changes the rig has yet
+            // to act on
+            cat_scheduler_ = std::make_unique<CATScheduler>(rig.get());
+            rig_connections_ << connect(
+                this, &Configuration::impl::set_transceiver, this,
+                [this](TransceiverState const &state,
+                       unsigned sequence_number) {
+                    cat_scheduler_->set(state, sequence_number);
+                });
 
             // hook up Transceiver signals to Configuration signals
             //
@@ -3956,12 +3978,14 @@ bool Configuration::impl::open_rig(bool force) {
                            &Configuration::impl::handle_transceiver_failure);
 
             // setup thread safe startup and close down semantics
+            rig_connections_ << connect(
+                this, &Configuration::impl::start_transceiver, this,
+                [this](unsigned sequence_number) {
+                    cat_scheduler_->start(sequence_number);
+                });
             rig_connections_
-                << connect(this, &Configuration::impl::start_transceiver,
-                           rig.get(), &Transceiver::start);
-            rig_connections_
-                << connect(this, &Configuration::impl::stop_transceiver,
-                           rig.get(), &Transceiver::stop);
+                << connect(this, &Configuration::impl::stop_transceiver, this,
+                           [this]() { cat_scheduler_->stop(); });
 
             auto p = rig.release(); // take ownership
 
@@ -4146,6 +4170,7 @@ void Configuration::impl::close_rig() {
             disconnect(connection);
         }
         rig_connections_.clear();
+        cat_scheduler_.reset();
         rig_active_ = false;
     }
 }
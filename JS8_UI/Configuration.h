@@ -111,6 +111,8 @@ class Configuration final : public QObject {
     QSet<QString> secondary_highlight_words() const;
     int activity_aging() const;
     int callsign_aging() const;
+    int rx_history_lines() const;
+    int rx_history_age() const;
     QString eot() const;
     QString mfi() const;
     QString my_info() const;
@@ -15,6 +15,9 @@ constexpr quint32 UI_POLL_INTERVAL_MS = 100;
 // How many milliseconds to wait before releasing PTT at end of transmission.
 constexpr int TX_SWITCHOFF_DELAY = 200;
 
+// Most calls kept in the call activity; see pruneActivity().
+constexpr qsizetype MAX_CALL_ACTIVITY = 5000;
+
 int volatile itone[JS8_NUM_SYMBOLS]; // Audio tones for all Tx symbols
 struct dec_data dec_data;            // for sharing with Fortran
 struct specData specData;            // Used by plotter
@@ -32,6 +35,24 @@ constexpr auto RX = 1;
 constexpr auto TX = 2;
 } // namespace State
 
+// Time of the most recent text written to a block of the RX history; the
+// history is trimmed to its age limit by it.
+
+struct RxBlockData : QTextBlockUserData {
+    explicit RxBlockData(QDateTime const &utc) : utc(utc) {}
+    QDateTime utc;
+};
+
+// Only RxBlockData is ever set as a block's user data.
+
+void stampBlock(QTextBlock block, QDateTime const &utc) {
+    if (auto const data = static_cast<RxBlockData *>(block.userData())) {
+        data->utc = utc;
+    } else {
+        block.setUserData(new RxBlockData(utc));
+    }
+}
+
 int ms_minute_error() {
     auto const now = DriftingDateTime::currentDateTimeLocal();
     auto const time = now.time();
@@ -162,7 +183,8 @@ MainWindow::MainWindow(QString const &program_info, QDir const &temp_directory,
       m_pskReporter{new PSKReporter{&m_config, program_info}}, // UR
       m_spotClient{new SpotClient{"spot.js8call.com", 50000, program_info}},
       m_aprsClient{new APRSISClient{"rotate.aprs2.net", 14580}},
-      m_aprsInboundRelay{nullptr},
+      m_aprsInboundRelay{nullptr}, m_logWriter{new LogWriter},
+      m_decodeJournal{nullptr}, m_inboxService{nullptr},
       m_manual{&m_network_manager} {
     ui->setupUi(this);
 
@@ -199,6 +221,31 @@ MainWindow::MainWindow(QString const &program_info, QDir const &temp_directory,
     m_pskReporter->moveToThread(&m_networkThread);
     m_spotClient->moveToThread(&m_networkThread);
 
+    // The text logs and the decode journal are written from a thread of
+    // their own, at a lower priority still; the GUI thread only ever queues
+    // lines and records to them.
+
+    m_decodeJournal = new DecodeJournal::Writer{
+        m_config.writeable_data_dir().absoluteFilePath("journal")};
+
+    m_logWriter->moveToThread(&m_logThread);
+    m_decodeJournal->moveToThread(&m_logThread);
+    connect(m_logWriter, &LogWriter::error, this, &MainWindow::logFileError);
+    connect(m_decodeJournal, &DecodeJournal::Writer::error, this,
+            &MainWindow::logFileError);
+    connect(&m_logThread, &QThread::finished, m_logWriter,
+            &QObject::deleteLater);
+    connect(&m_logThread, &QThread::finished, m_decodeJournal,
+            &QObject::deleteLater);
+
+    // The inbox is kept open, on a thread of its own, for the life of the
+    // window; queries of it are handed to that thread.
+
+    m_inboxService = new InboxService{inboxPath()};
+    m_inboxService->moveToThread(&m_inboxThread);
+    connect(&m_inboxThread, &QThread::finished, m_inboxService,
+            &QObject::deleteLater);
+
     // hook up the message server slots and signals and disposal
     connect(m_messageServer, &MessageServer::message, this,
             &MainWindow::tcpNetworkMessage);
@@ -228,7 +275,7 @@ MainWindow::MainWindow(QString const &program_info, QDir const &temp_directory,
                 return info;
             }
             info.heard = true;
-            info.lastHeardUtc = it->utcTimestamp;
+            info.lastHeardUtc = utcDateTime(it->utcTimestamp);
             return info;
         },
         [this](QDateTime const &utc, QString const &text) {
@@ -317,6 +364,8 @@ MainWindow::MainWindow(QString const &program_info, QDir const &temp_directory,
             &Modulator::stop);
     connect(this, &MainWindow::tune, m_modulator, &Modulator::tune);
     connect(this, &MainWindow::sendMessage, m_modulator, &Modulator::start);
+    connect(this, &MainWindow::prerenderMessage, m_modulator,
+            &Modulator::prerender);
     connect(&m_audioThread, &QThread::finished, m_modulator,
             &QObject::deleteLater);
 
@@ -485,9 +534,7 @@ MainWindow::MainWindow(QString const &program_info, QDir const &temp_directory,
         // rehighlight
         auto d = ui->textEditRX->document();
         if (d) {
-            for (int i = 0; i < d->lineCount(); i++) {
-                auto b = d->findBlockByLineNumber(i);
-
+            for (auto b = d->begin(); b != d->end(); b = b.next()) {
                 switch (b.userState()) {
                 case State::RX:
                     highlightBlock(b, m_config.rx_text_font(),
@@ -502,6 +549,9 @@ MainWindow::MainWindow(QString const &program_info, QDir const &temp_directory,
                 }
             }
         }
+
+        // the history's limits may have changed
+        trimRxHistory();
     });
 
     setWindowTitle(program_title());
@@ -597,6 +647,11 @@ MainWindow::MainWindow(QString const &program_info, QDir const &temp_directory,
     connect(&m_guiTimer, &QTimer::timeout, this, &MainWindow::guiUpdate);
     m_guiTimer.start(UI_POLL_INTERVAL_MS);
 
+    m_activityDisplayTimer.setSingleShot(true);
+    m_activityDisplayTimer.setInterval(UI_POLL_INTERVAL_MS);
+    connect(&m_activityDisplayTimer, &QTimer::timeout, this,
+            &MainWindow::refreshActivityDisplay);
+
     pttReleaseTimer.setTimerType(Qt::PreciseTimer);
     pttReleaseTimer.setSingleShot(true);
     connect(&pttReleaseTimer, &QTimer::timeout, this, &MainWindow::stopTx2);
@@ -698,11 +753,16 @@ MainWindow::MainWindow(QString const &program_info, QDir const &temp_directory,
     m_networkThread.start(m_networkThreadPriority);
     m_audioThread.start(m_audioThreadPriority);
     m_notificationAudioThread.start(m_notificationAudioThreadPriority);
+    m_logThread.start(QThread::LowPriority);
+    m_inboxThread.start(QThread::LowPriority);
     m_decoder.start(m_decoderThreadPriority);
 
     Q_EMIT startAudioInputStream(m_config.audio_input_device(),
                                  m_framesAudioInputBuffered, m_detector,
                                  m_config.audio_input_channel());
+    for (auto const &receiver : m_receivers) {
+        receiver->start(m_framesAudioInputBuffered);
+    }
     Q_EMIT initializeAudioOutputStream(
         m_config.audio_output_device(),
         AudioDevice::Mono == m_config.audio_output_channel() ? 1 : 2,
@@ -1179,60 +1239,61 @@ MainWindow::MainWindow(QString const &program_info, QDir const &temp_directory,
             selectedCall = "%";
         }
 
-        Inbox inbox(inboxPath());
-        if (!inbox.open()) {
-            return;
-        }
+        // Unread messages are marked read as they're fetched; the window's
+        // shown once they are.
 
-        QList<QPair<int, Message>> msgs;
+        m_inboxService->post(
+            this,
+            [selectedCall](Inbox &inbox) {
+                QList<QPair<int, Message>> msgs;
 
-        msgs.append(
-            inbox.values("STORE", "$.params.TO", selectedCall, 0, 1000));
+                msgs.append(inbox.values("STORE", "$.params.TO", selectedCall,
+                                         0, 1000));
 
-        msgs.append(
-            inbox.values("READ", "$.params.FROM", selectedCall, 0, 1000));
+                msgs.append(inbox.values("READ", "$.params.FROM",
+                                         selectedCall, 0, 1000));
 
-        foreach (auto pair, inbox.values("UNREAD", "$.params.FROM",
-                                         selectedCall, 0, 1000)) {
-            msgs.append(pair);
+                foreach (auto pair, inbox.values("UNREAD", "$.params.FROM",
+                                                 selectedCall, 0, 1000)) {
+                    msgs.append(pair);
 
-            // mark as read
-            auto msg = pair.second;
-            msg.setType("READ");
-            inbox.set(pair.first, msg);
-        }
+                    // mark as read
+                    auto msg = pair.second;
+                    msg.setType("READ");
+                    inbox.set(pair.first, msg);
+                }
 
-        std::stable_sort(
-            msgs.begin(), msgs.end(),
-            [](QPair<int, Message> const &a, QPair<int, Message> const &b) {
-                return QVariant::compare(a.second.params().value("UTC"),
-                                         b.second.params().value("UTC")) ==
-                       QPartialOrdering::Greater;
+                std::stable_sort(msgs.begin(), msgs.end(),
+                                 [](QPair<int, Message> const &a,
+                                    QPair<int, Message> const &b) {
+                                     return QVariant::compare(
+                                                a.second.params().value("UTC"),
+                                                b.second.params().value(
+                                                    "UTC")) ==
+                                            QPartialOrdering::Greater;
+                                 });
+
+                return msgs;
+            },
+            [this, selectedCall](QList<QPair<int, Message>> msgs) {
+                auto mw = new MessageWindow(this);
+                connect(mw, &MessageWindow::finished, this,
+                        [this](int) { refreshInboxCounts(); });
+                connect(mw, &MessageWindow::deleteMessage, this,
+                        [this](int id) {
+                            m_inboxService->post(
+                                [id](Inbox &inbox) { inbox.del(id); });
+                        });
+                connect(mw, &MessageWindow::replyMessage, this,
+                        [this, mw](const QString &text) {
+                            addMessageText(text, true, true);
+                            refreshInboxCounts();
+                            mw->close();
+                        });
+                mw->setCall(selectedCall);
+                mw->populateMessages(msgs);
+                mw->show();
             });
-
-        auto mw = new MessageWindow(this);
-        connect(mw, &MessageWindow::finished, this, [this](int) {
-            refreshInboxCounts();
-            displayCallActivity();
-        });
-        connect(mw, &MessageWindow::deleteMessage, this, [this](int id) {
-            Inbox inbox(inboxPath());
-            if (!inbox.open()) {
-                return;
-            }
-
-            inbox.del(id);
-        });
-        connect(mw, &MessageWindow::replyMessage, this,
-                [this, mw](const QString &text) {
-                    addMessageText(text, true, true);
-                    refreshInboxCounts();
-                    displayCallActivity();
-                    mw->close();
-                });
-        mw->setCall(selectedCall);
-        mw->populateMessages(msgs);
-        mw->show();
     });
 
     auto historyAction =
@@ -1262,7 +1323,7 @@ MainWindow::MainWindow(QString const &program_info, QDir const &temp_directory,
         d.from = m_config.my_callsign();
         d.relayPath = d.from;
         d.text = m->textValue();
-        d.utcTimestamp = DriftingDateTime::currentDateTimeUtc();
+        d.utcTimestamp = DriftingDateTime::currentMSecsSinceEpoch();
         d.submode = m_nSubMode;
 
         addCommandToStorage("STORE", d);
@@ -1557,6 +1618,8 @@ void MainWindow::on_the_minute() {
     } else {
         tx_watchdog(false);
     }
+
+    pruneActivity();
 }
 
 void MainWindow::tryBandHop() {
@@ -1711,6 +1774,12 @@ MainWindow::~MainWindow() {
     m_notificationAudioThread.quit();
     m_notificationAudioThread.wait();
 
+    m_logThread.quit();
+    m_logThread.wait();
+
+    m_inboxThread.quit();
+    m_inboxThread.wait();
+
     m_decoder.quit();
 
     remove_child_from_event_filter(this);
@@ -1781,7 +1850,7 @@ void MainWindow::writeSettings() {
             continue;
         }
         if (callsignAging &&
-            cd.utcTimestamp.secsTo(now) / 60 >= callsignAging) {
+            utcDateTime(cd.utcTimestamp).secsTo(now) / 60 >= callsignAging) {
             continue;
         }
         m_settings->setValue(
@@ -1794,12 +1863,14 @@ void MainWindow::writeSettings() {
                 {"tdrift", QVariant(cd.tdrift)},
 #if CACHE_CALL_DATETIME_AS_STRINGS
                 {"ackTimestamp",
-                 QVariant(cd.ackTimestamp.toString("yyyy-MM-dd hh:mm:ss"))},
+                 QVariant(utcDateTime(cd.ackTimestamp)
+                              .toString("yyyy-MM-dd hh:mm:ss"))},
                 {"utcTimestamp",
-                 QVariant(cd.utcTimestamp.toString("yyyy-MM-dd hh:mm:ss"))},
+                 QVariant(utcDateTime(cd.utcTimestamp)
+                              .toString("yyyy-MM-dd hh:mm:ss"))},
 #else
-                {"ackTimestamp", QVariant(cd.ackTimestamp)},
-                {"utcTimestamp", QVariant(cd.utcTimestamp)},
+                {"ackTimestamp", QVariant(utcDateTime(cd.ackTimestamp))},
+                {"utcTimestamp", QVariant(utcDateTime(cd.utcTimestamp))},
 #endif
                 {"submode", QVariant(cd.submode)},
             });
@@ -1856,6 +1927,7 @@ void MainWindow::readSettings() {
         m_config.reset_activity()
             ? ""
             : m_settings->value("RXActivity", "").toString());
+    stampRxHistory();
     ui->actionShow_Band_Heartbeats_and_ACKs->setChecked(
         m_settings->value("BandHBActivityVisible", true).toBool());
     m_settings->endGroup();
@@ -1946,6 +2018,45 @@ void MainWindow::readSettings() {
         m_settings->value("Network/NetworkThreadPriority", QThread::LowPriority)
             .toInt() %
         8);
+
+    // additional receivers; monitor-only audio inputs, each connected to
+    // a radio of its own, decoded along with the primary receiver and
+    // reported to API clients. the audio input is matched by description
+    auto const receivers = m_settings->beginReadArray("Receivers");
+    auto const inputs = QMediaDevices::audioInputs();
+    for (int i = 0; i < receivers; ++i) {
+        m_settings->setArrayIndex(i);
+
+        auto const description = m_settings->value("Device").toString();
+        auto const input = std::find_if(
+            inputs.begin(), inputs.end(), [&description](auto const &device) {
+                return device.description() == description;
+            });
+
+        if (input == inputs.end()) {
+            qCWarning(mainwindow_js8)
+                << "Ignoring receiver with unknown audio input" << description;
+            continue;
+        }
+
+        auto receiver = std::make_unique<Receiver>(
+            static_cast<int>(m_receivers.size()) + 1, *input,
+            AudioDevice::fromString(m_settings->value("Channel").toString()),
+            m_settings->value("Dial").toULongLong(), &m_audioThread);
+
+        connect(this, &MainWindow::FFTSize, receiver->detector(),
+                &Detector::setBlockSize);
+        connect(this, &MainWindow::finished, receiver.get(),
+                &Receiver::stopAudioInputStream);
+        connect(receiver.get(), &Receiver::error, this,
+                [](int const id, QString const &message) {
+                    qCWarning(mainwindow_js8)
+                        << "Receiver" << id << "audio input error:" << message;
+                });
+
+        m_receivers.push_back(std::move(receiver));
+    }
+    m_settings->endArray();
     m_settings->endGroup();
 
     if (m_config.reset_activity()) {
@@ -1986,8 +2097,8 @@ void MainWindow::readSettings() {
             cd.dial = dial;
             cd.offset = freq;
             cd.tdrift = tdrift;
-            cd.ackTimestamp = ackTimestamp;
-            cd.utcTimestamp = utcTimestamp;
+            cd.ackTimestamp = toTimestamp(ackTimestamp);
+            cd.utcTimestamp = toTimestamp(utcTimestamp);
             cd.submode = submode;
 
             logCallActivity(cd, false);
@@ -3333,7 +3444,8 @@ bool MainWindow::decodeProcessQueue(qint32 *pSubmode) {
     dec_data.params.nfa =
         m_wideGraph->filterEnabled() ? m_wideGraph->filterMinimum() : 0;
     dec_data.params.nfb =
-        m_wideGraph->filterEnabled() ? m_wideGraph->filterMaximum() : 5000;
+        m_wideGraph->filterEnabled() ? m_wideGraph->filterMaximum()
+                                     : JS8_RX_SAMPLE_RATE / 2;
 
     if (dec_data.params.nutc < m_nutc0)
         m_RxLog = 1; // Date and Time to ALL.TXT
@@ -3386,6 +3498,22 @@ void MainWindow::decodeStart() {
                          << QString("(%1)").arg(dec_data.params.kszI);
 
     m_decoder.decode();
+
+    // Additional receivers decode the same periods as the primary one;
+    // their detectors run in lockstep on the audio thread, so take our
+    // parameters, other than the amount of data each has collected.
+
+    for (auto const &receiver : m_receivers) {
+        QMutexLocker lock(receiver->detector()->getMutex());
+
+        auto &data = receiver->data();
+        auto const kin = data.params.kin;
+
+        data.params = dec_data.params;
+        data.params.kin = kin;
+
+        m_decoder.decode(receiver->id(), data);
+    }
 }
 
 /**
@@ -3449,7 +3577,7 @@ void processDecodeEvent(); // JS8_Mainwindow/processDecodeEvent.cpp
 bool MainWindow::hasExistingMessageBufferToMe(int *const pOffset) {
     for (auto const [offset, buffer] : m_messageBuffer.asKeyValueRange()) {
         // if this is a valid buffer and it's to me...
-        if (buffer.cmd.utcTimestamp.isValid() &&
+        if (buffer.cmd.utcTimestamp != 0 &&
             (buffer.cmd.to == m_config.my_callsign() ||
              buffer.cmd.to == Radio::base_callsign(m_config.my_callsign()))) {
             if (pOffset)
@@ -3532,10 +3660,10 @@ void MainWindow::logCallActivity(CallDetail d, bool spot) {
         if (d.grid.isEmpty() && !old.grid.isEmpty()) {
             d.grid = old.grid;
         }
-        if (!d.ackTimestamp.isValid() && old.ackTimestamp.isValid()) {
+        if (d.ackTimestamp == 0 && old.ackTimestamp != 0) {
             d.ackTimestamp = old.ackTimestamp;
         }
-        if (!d.cqTimestamp.isValid() && old.cqTimestamp.isValid()) {
+        if (d.cqTimestamp == 0 && old.cqTimestamp != 0) {
             d.cqTimestamp = old.cqTimestamp;
         }
         m_callActivity[d.call] = d;
@@ -3558,39 +3686,17 @@ void MainWindow::logCallActivity(CallDetail d, bool spot) {
 }
 
 void MainWindow::logHeardGraph(QString from, QString to) {
-    auto my_callsign = m_config.my_callsign();
+    auto const now = DriftingDateTime::currentSecsSinceEpoch();
 
-    // hearing
-    if (m_heardGraphOutgoing.contains(my_callsign)) {
-        m_heardGraphOutgoing[my_callsign].insert(from);
-    } else {
-        m_heardGraphOutgoing[my_callsign].insert(from);
-    }
-
-    // heard by
-    if (m_heardGraphIncoming.contains(from)) {
-        m_heardGraphIncoming[from].insert(my_callsign);
-    } else {
-        m_heardGraphIncoming[from] = {my_callsign};
-    }
+    // we're hearing them
+    m_heardGraph.add(m_config.my_callsign(), from, now);
 
     if (to == "@ALLCALL") {
         return;
     }
 
-    // hearing
-    if (m_heardGraphOutgoing.contains(from)) {
-        m_heardGraphOutgoing[from].insert(to);
-    } else {
-        m_heardGraphOutgoing[from] = {to};
-    }
-
-    // heard by
-    if (m_heardGraphIncoming.contains(to)) {
-        m_heardGraphIncoming[to].insert(from);
-    } else {
-        m_heardGraphIncoming[to] = {from};
-    }
+    // they're hearing who they're calling
+    m_heardGraph.add(from, to, now);
 }
 
 QString MainWindow::lookupCallInCompoundCache(QString const &call) {
@@ -3850,6 +3956,7 @@ void MainWindow::prepareSending(qint64 nowMS) {
             m_currentMessageBits = msgibits;
 
             emitTones();
+            prerenderNextMessageFrame();
         }
 
         if (m_tune) {
@@ -4169,34 +4276,33 @@ void MainWindow::stopTx2() {
 
 void MainWindow::TxAgain() { auto_tx_mode(true); }
 
+// The activity maps are implicitly shared, so caching them copies nothing.
+// On restore, they're taken from the cache rather than copied out of it,
+// so that they aren't shared, and so not copied on the first write either;
+// they'll be cached again when we leave the band.
+
 void MainWindow::cacheActivity(QString key) {
     m_callActivityBandCache[key] = m_callActivity;
     m_bandActivityBandCache[key] = m_bandActivity;
     m_rxTextBandCache[key] = ui->textEditRX->toHtml();
-    m_heardGraphIncomingBandCache[key] = m_heardGraphIncoming;
-    m_heardGraphOutgoingBandCache[key] = m_heardGraphOutgoing;
+    m_heardGraph.cacheBand(key);
 }
 
 void MainWindow::restoreActivity(QString key) {
     if (m_callActivityBandCache.contains(key)) {
-        m_callActivity = m_callActivityBandCache[key];
+        m_callActivity = m_callActivityBandCache.take(key);
     }
 
     if (m_bandActivityBandCache.contains(key)) {
-        m_bandActivity = m_bandActivityBandCache[key];
+        m_bandActivity = m_bandActivityBandCache.take(key);
     }
 
     if (m_rxTextBandCache.contains(key)) {
         ui->textEditRX->setHtml(m_rxTextBandCache[key]);
+        stampRxHistory();
     }
 
-    if (m_heardGraphIncomingBandCache.contains(key)) {
-        m_heardGraphIncoming = m_heardGraphIncomingBandCache[key];
-    }
-
-    if (m_heardGraphOutgoingBandCache.contains(key)) {
-        m_heardGraphOutgoing = m_heardGraphOutgoingBandCache[key];
-    }
+    m_heardGraph.restoreBand(key);
 
     displayActivity(true);
 }
@@ -4252,24 +4358,61 @@ void MainWindow::clearCallActivity() {
 
     m_callActivity.clear();
 
-    m_heardGraphIncoming.clear();
-    m_heardGraphOutgoing.clear();
+    m_heardGraph.clear();
 
     ui->tableWidgetCalls->setRowCount(0);
 
-    bool showIconColumn = false;
-    createGroupCallsignTableRows(ui->tableWidgetCalls, "", showIconColumn);
-
     resetTimeDeltaAverage();
     displayCallActivity();
 }
 
-void MainWindow::createGroupCallsignTableRows(QTableWidget *table,
+/**
+ * @brief Bounds the call and band activity.
+ *
+ * Called each minute. Aging is a display setting, applied as the tables
+ * are drawn, and can be changed, or turned off, at any time, so nothing
+ * is dropped here for its age; if more than MAX_CALL_ACTIVITY calls are
+ * held, the least recently heard are dropped. The selected call is kept,
+ * and so is any call with messages waiting. The band activity is bounded
+ * already, at ten entries for each offset in the passband; offsets left
+ * with none are dropped.
+ */
+void MainWindow::pruneActivity() {
+    if (m_callActivity.size() > MAX_CALL_ACTIVITY) {
+        auto const selectedCall = callsignSelected();
+
+        QList<std::pair<qint64, QString>> heard;
+        for (auto const [call, cd] : m_callActivity.asKeyValueRange()) {
+            if (call != selectedCall &&
+                m_rxInboxCountCache.value(call, 0) == 0) {
+                heard.append({cd.utcTimestamp, call});
+            }
+        }
+
+        auto const excess =
+            std::min(m_callActivity.size() - MAX_CALL_ACTIVITY, heard.size());
+        std::nth_element(heard.begin(), heard.begin() + excess, heard.end());
+        for (qsizetype i = 0; i < excess; ++i) {
+            m_callActivity.remove(heard.at(i).second);
+        }
+    }
+
+    for (auto it = m_bandActivity.begin(); it != m_bandActivity.end();) {
+        if (it->isEmpty()) {
+            it = m_bandActivity.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void MainWindow::createGroupCallsignTableRows(TableRows &rows,
                                               QString const &selectedCall,
                                               bool &showIconColumn) {
     int count = 0;
     auto now = DriftingDateTime::currentDateTimeUtc();
     int callsignAging = m_config.callsign_aging();
+    auto const table = rows.table();
 
     int startCol = 1;
 
@@ -4278,7 +4421,7 @@ void MainWindow::createGroupCallsignTableRows(QTableWidget *table,
             continue;
         }
         if (callsignAging &&
-            cd.utcTimestamp.secsTo(now) / 60 >= callsignAging) {
+            utcDateTime(cd.utcTimestamp).secsTo(now) / 60 >= callsignAging) {
             continue;
         }
         count++;
@@ -4289,21 +4432,19 @@ void MainWindow::createGroupCallsignTableRows(QTableWidget *table,
                    : QString(columnLabel("Callsigns (%1)")).arg(count));
 
     if (!m_config.avoid_allcall()) {
-        table->insertRow(table->rowCount());
+        rows.add();
 
         auto emptyItem = new QTableWidgetItem("");
         emptyItem->setData(Qt::UserRole, QVariant("@ALLCALL"));
-        table->setItem(table->rowCount() - 1, 0, emptyItem);
+        rows.setItem(0, emptyItem);
 
         auto item = new QTableWidgetItem(QString("@ALLCALL"));
         item->setData(Qt::UserRole, QVariant("@ALLCALL"));
 
-        table->setItem(table->rowCount() - 1, startCol, item);
-        table->setSpan(table->rowCount() - 1, startCol, 1,
-                       table->columnCount());
+        rows.setItem(startCol, item);
+        rows.setSpan(startCol, table->columnCount());
         if (selectedCall == "@ALLCALL") {
-            table->item(table->rowCount() - 1, 0)->setSelected(true);
-            table->item(table->rowCount() - 1, startCol)->setSelected(true);
+            rows.select();
         }
     }
 
@@ -4311,7 +4452,7 @@ void MainWindow::createGroupCallsignTableRows(QTableWidget *table,
     std::sort(groups.begin(), groups.end());
     foreach (auto group, groups) {
         int col = 0;
-        table->insertRow(table->rowCount());
+        rows.add();
 
         bool hasMessage = m_rxInboxCountCache.value(group, 0) > 0;
 
@@ -4319,7 +4460,7 @@ void MainWindow::createGroupCallsignTableRows(QTableWidget *table,
         iconItem->setData(Qt::UserRole, QVariant(group));
         iconItem->setToolTip(hasMessage ? "Message Available" : "");
         iconItem->setTextAlignment(Qt::AlignHCenter | Qt::AlignVCenter);
-        table->setItem(table->rowCount() - 1, col++, iconItem);
+        rows.setItem(col++, iconItem);
         if (hasMessage) {
             showIconColumn = true;
         }
@@ -4327,12 +4468,11 @@ void MainWindow::createGroupCallsignTableRows(QTableWidget *table,
         auto item = new QTableWidgetItem(group);
         item->setData(Qt::UserRole, QVariant(group));
         item->setToolTip(generateCallDetail(group));
-        table->setItem(table->rowCount() - 1, col, item);
-        table->setSpan(table->rowCount() - 1, col, 1, table->columnCount());
+        rows.setItem(col, item);
+        rows.setSpan(col, table->columnCount());
 
         if (selectedCall == group) {
-            table->item(table->rowCount() - 1, 0)->setSelected(true);
-            table->item(table->rowCount() - 1, col)->setSelected(true);
+            rows.select();
         }
     }
 }
@@ -4388,6 +4528,8 @@ void MainWindow::writeNoticeTextToUI(QDateTime date, QString text) {
     c.insertHtml(QString("<strong>%1 - %2</strong>")
                      .arg(date.time().toString())
                      .arg(text));
+    stampBlock(c.block(), date);
+    trimRxHistory();
 
     c.movePosition(QTextCursor::End);
 
@@ -4423,8 +4565,10 @@ int MainWindow::writeMessageTextToUI(QDateTime date, QString text, int freq,
         }
     }
 
-    // fixup duplicate acks
-    auto tc = c.document()->find(text);
+    // fixup duplicate acks; a duplicate is as recent as the time it carries,
+    // so look for it from the end
+    auto tc = c.document()->find(text, c.document()->characterCount() - 1,
+                                 QTextDocument::FindBackward);
     if (!tc.isNull() && tc.selectedText() == text &&
         (text.contains(" ACK ") || text.contains(" HEARTBEAT SNR "))) {
         tc.select(QTextCursor::BlockUnderCursor);
@@ -4460,6 +4604,10 @@ int MainWindow::writeMessageTextToUI(QDateTime date, QString text, int freq,
                        m_config.color_rx_foreground(), QColor(Qt::transparent));
     }
 
+    // the cursor follows its block as the history's trimmed above it
+    stampBlock(c.block(), date);
+    trimRxHistory();
+
     ui->textEditRX->ensureCursorVisible();
     ui->textEditRX->verticalScrollBar()->setValue(
         ui->textEditRX->verticalScrollBar()->maximum());
@@ -4467,6 +4615,83 @@ int MainWindow::writeMessageTextToUI(QDateTime date, QString text, int freq,
     return c.blockNumber();
 }
 
+// History restored as HTML carries no times; it's aged from when it was
+// restored.
+
+void MainWindow::stampRxHistory() {
+    auto const d = ui->textEditRX->document();
+    auto const now = DriftingDateTime::currentDateTimeUtc();
+
+    for (auto b = d->begin(); b != d->end(); b = b.next()) {
+        if (!b.userData()) {
+            stampBlock(b, now);
+        }
+    }
+}
+
+// The RX history is held to the configured number of lines and age; older
+// history remains in the logs on disk. Lines over the limit are trimmed a
+// tenth of the limit at a time, rather than one with each line written,
+// and the blocks that remain are renumbered by the trim, so the offset
+// cache is renumbered to match.
+
+void MainWindow::trimRxHistory() {
+    auto const d = ui->textEditRX->document();
+    auto const lines = m_config.rx_history_lines();
+    auto const hours = m_config.rx_history_age();
+
+    int remove = 0;
+
+    if (lines && d->blockCount() > lines + lines / 10) {
+        remove = d->blockCount() - lines;
+    }
+
+    if (hours) {
+        auto const cutoff =
+            DriftingDateTime::currentDateTimeUtc().addSecs(-3600 * hours);
+
+        for (auto b = d->findBlockByNumber(remove); b.isValid();
+             b = b.next()) {
+            auto const data = static_cast<RxBlockData *>(b.userData());
+            if (data && data->utc >= cutoff) {
+                break;
+            }
+            ++remove;
+        }
+    }
+
+    if (remove < 2) {
+        return;
+    }
+
+    // Removing up to the separator ahead of the first block kept, rather
+    // than through it, leaves that block as it is, with its state and data;
+    // what's left of the blocks removed is the document's first, emptied.
+
+    QTextCursor c(d);
+    if (auto const keep = d->findBlockByNumber(remove); keep.isValid()) {
+        c.setPosition(keep.position() - 1, QTextCursor::KeepAnchor);
+    } else {
+        c.movePosition(QTextCursor::End, QTextCursor::KeepAnchor);
+    }
+    c.removeSelectedText();
+
+    auto first = d->firstBlock();
+    first.setUserData(nullptr);
+    first.setUserState(-1);
+
+    auto const removed = remove - 1;
+    for (auto it = m_rxFrameBlockNumbers.begin();
+         it != m_rxFrameBlockNumbers.end();) {
+        if (it.value() < remove) {
+            it = m_rxFrameBlockNumbers.erase(it);
+        } else {
+            it.value() -= removed;
+            ++it;
+        }
+    }
+}
+
 bool MainWindow::isMessageQueuedForTransmit() {
     return m_transmitting || m_txFrameCount > 0;
 }
@@ -4908,6 +5133,44 @@ bool MainWindow::prepareNextMessageFrame() {
     return true;
 }
 
+/**
+ * @brief Renders the audio for the next frame in the queue ahead of time.
+ *
+ * Called once the current frame's tones have been computed; encodes the
+ * frame at the head of the transmit queue, with the same adjustments to
+ * its bits that prepareNextMessageFrame() will make, and hands the tones
+ * to the modulator to render while the current frame is on the air.
+ *
+ * If the queue changes in the meantime, e.g., via typeahead, the tones
+ * won't match when the modulator is next started, and it'll render the
+ * frame at that point instead, so this is purely an optimization.
+ */
+void MainWindow::prerenderNextMessageFrame() {
+    if (m_txFrameQueue.isEmpty()) {
+        return;
+    }
+
+    auto const &[frame, frameBits] = m_txFrameQueue.head();
+
+    // The next frame is never the first; it's the last if nothing
+    // follows it.
+
+    auto bits = frameBits & ~Varicode::JS8CallFirst;
+
+    if (m_txFrameQueue.size() == 1) {
+        bits |= Varicode::JS8CallLast;
+    }
+
+    char nextMessage[29];
+    copyMessage(frame, nextMessage);
+
+    QVector<int> tones(JS8_NUM_SYMBOLS);
+    JS8::encode(bits, JS8::Costas::array(JS8::Submode::costas(m_nSubMode)),
+                nextMessage, tones.data());
+
+    Q_EMIT prerenderMessage(tones, freq() + m_XIT, m_nSubMode);
+}
+
 bool MainWindow::isFreqOffsetFree(int const f, int const bw) {
     // if this frequency is our current frequency, or it's in our
     // directed cache, it's free.
@@ -4924,7 +5187,7 @@ bool MainWindow::isFreqOffsetFree(int const f, int const bw) {
 
     for (auto [offset, activity] : m_bandActivity.asKeyValueRange()) {
         if (activity.isEmpty() ||
-            activity.last().utcTimestamp.secsTo(now) >= 30)
+            utcDateTime(activity.last().utcTimestamp).secsTo(now) >= 30)
             continue;
 
         if (qAbs(offset - f) < bw)
@@ -5440,8 +5703,8 @@ void MainWindow::on_actionErase_ALL_TXT_triggered() // Erase ALL.TXT
         this, tr("Confirm Erase"),
         tr("Are you sure you want to erase file ALL.TXT?"));
     if (ret == JS8MessageBox::Yes) {
-        QFile f{m_config.writeable_data_dir().absoluteFilePath("ALL.TXT")};
-        f.remove();
+        m_logWriter->remove(
+            m_config.writeable_data_dir().absoluteFilePath("ALL.TXT"));
         m_RxLog = 1;
     }
 }
@@ -5817,7 +6080,8 @@ void MainWindow::on_snrMacroButton_clicked() {
     }
 
     auto cd = m_callActivity[call];
-    if (callsignAging && cd.utcTimestamp.secsTo(now) / 60 >= callsignAging) {
+    if (callsignAging &&
+        utcDateTime(cd.utcTimestamp).secsTo(now) / 60 >= callsignAging) {
         return;
     }
 
@@ -6020,7 +6284,7 @@ void MainWindow::buildRelayMenu(QMenu *menu) {
     int callsignAging = m_config.callsign_aging();
     foreach (auto cd, m_callActivity.values()) {
         if (callsignAging &&
-            cd.utcTimestamp.secsTo(now) / 60 >= callsignAging) {
+            utcDateTime(cd.utcTimestamp).secsTo(now) / 60 >= callsignAging) {
             continue;
         }
 
@@ -6261,11 +6525,12 @@ void MainWindow::on_tableWidgetRXAll_cellDoubleClicked(int row, int col) {
     QString activityText;
     bool isLast = false;
     foreach (auto d, m_bandActivity[offset]) {
-        if (activityAging && d.utcTimestamp.secsTo(now) / 60 >= activityAging) {
+        if (activityAging &&
+            utcDateTime(d.utcTimestamp).secsTo(now) / 60 >= activityAging) {
             continue;
         }
         if (activityText.isEmpty()) {
-            firstActivity = d.utcTimestamp;
+            firstActivity = utcDateTime(d.utcTimestamp);
         }
         activityText.append(d.text);
 
@@ -6288,10 +6553,8 @@ QString MainWindow::generateCallDetail(QString selectedCall) {
     }
 
     // heard detail
-    QString hearing =
-        m_heardGraphOutgoing.value(selectedCall).values().join(", ");
-    QString heardby =
-        m_heardGraphIncoming.value(selectedCall).values().join(", ");
+    QString hearing = m_heardGraph.hearing(selectedCall).join(", ");
+    QString heardby = m_heardGraph.heardBy(selectedCall).join(", ");
     QStringList detail = {
         QString("<h1>%1</h1>").arg(selectedCall.toHtmlEscaped()),
         hearing.isEmpty() ? ""
@@ -6356,9 +6619,10 @@ void MainWindow::on_tableWidgetCalls_cellDoubleClicked(int row, int col) {
             d.tdrift = params.value("TDRIFT").toFloat();
             d.text = params.value("TEXT").toString();
             d.to = params.value("TO").toString();
-            d.utcTimestamp = QDateTime::fromString(
-                params.value("UTC").toString(), "yyyy-MM-dd hh:mm:ss");
-            d.utcTimestamp.setUtcOffset(0);
+            auto utc = QDateTime::fromString(params.value("UTC").toString(),
+                                             "yyyy-MM-dd hh:mm:ss");
+            utc.setUtcOffset(0);
+            d.utcTimestamp = toTimestamp(utc);
 
             msg.setType("READ");
             i.set(id, msg);
@@ -6578,6 +6842,9 @@ void MainWindow::onDriftChanged(qint64 /*new_drift_ms*/) {
     // this makes the detected emit the correct k when drifting time
     qCDebug(mainwindow_js8) << "Processing drift change.";
     m_detector->resetBufferPosition();
+    for (auto const &receiver : m_receivers) {
+        receiver->detector()->resetBufferPosition();
+    }
 }
 
 void MainWindow::setFreqOffsetForRestore(int freq, bool shouldRestore) {
@@ -7334,7 +7601,7 @@ void MainWindow::processIdleActivity() {
             continue;
         if (last.text == m_config.mfi())
             continue;
-        if (last.utcTimestamp.secsTo(now) <
+        if (utcDateTime(last.utcTimestamp).secsTo(now) <
             JS8::Submode::period(last.submode) * 1.50)
             continue;
 
@@ -7467,8 +7734,9 @@ void MainWindow::processBufferedActivity() {
 
         // check to make sure we empty old buffers by getting the latest
         // timestamp and checking to see if it's older than one minute.
-        auto dt = DriftingDateTime::currentDateTimeUtc().addDays(-1);
-        if (buffer.cmd.utcTimestamp.isValid()) {
+        auto dt =
+            DriftingDateTime::currentMSecsSinceEpoch() - 24 * 60 * 60 * 1000;
+        if (buffer.cmd.utcTimestamp != 0) {
             dt = qMax(dt, buffer.cmd.utcTimestamp);
         }
         if (!buffer.compound.isEmpty()) {
@@ -7480,14 +7748,14 @@ void MainWindow::processBufferedActivity() {
 
         // if the buffer has messages older than 1 minute, and we still haven't
         // closed it, let's mark it as the last frame
-        if (dt.secsTo(DriftingDateTime::currentDateTimeUtc()) > 60 &&
+        if ((DriftingDateTime::currentMSecsSinceEpoch() - dt) / 1000 > 60 &&
             !buffer.msgs.isEmpty()) {
             buffer.msgs.last().bits |= Varicode::JS8CallLast;
         }
 
         // but, if the buffer is older than 1.5 minutes, and we still haven't
         // closed it, just remove it and skip
-        if (dt.secsTo(DriftingDateTime::currentDateTimeUtc()) > 90) {
+        if ((DriftingDateTime::currentMSecsSinceEpoch() - dt) / 1000 > 90) {
             m_messageBuffer.remove(freq);
             continue;
         }
@@ -7559,70 +7827,82 @@ QString MainWindow::inboxPath() {
         m_config.writeable_data_dir().absoluteFilePath("inbox.db3"));
 }
 
+// Counts are taken on the inbox's thread, and applied, and the call activity
+// redisplayed, once they're in hand.
+
 void MainWindow::refreshInboxCounts() {
-    auto inbox = Inbox(inboxPath());
-    if (inbox.open()) {
-        // reset inbox counts
-        m_rxInboxCountCache.clear();
-
-        // compute new counts from db
-        auto v = inbox.values("UNREAD", "$", "%", 0, 10000);
-        foreach (auto pair, v) {
-            auto params = pair.second.params();
-            auto to = params.value("TO").toString();
-            if (to.isEmpty() ||
-                (to != m_config.my_callsign() &&
-                 to != Radio::base_callsign(m_config.my_callsign()))) {
-                continue;
-            }
-            auto from = params.value("FROM").toString();
-            if (from.isEmpty()) {
-                continue;
-            }
+    using Counts = std::pair<QList<QPair<int, Message>>, QMap<QString, int>>;
 
-            m_rxInboxCountCache[from] = m_rxInboxCountCache.value(from, 0) + 1;
-
-            if (!m_callActivity.contains(from)) {
-                auto const utc = params.value("UTC").toString();
-                auto const snr = params.value("SNR").toInt();
-                auto const dial = params.value("DIAL").toInt();
-                auto const offset = params.value("OFFSET").toInt();
-                auto const tdrift = params.value("TDRIFT").toInt();
-                auto const submode = params.value("SUBMODE").toInt();
-
-                CallDetail cd;
-                cd.call = from;
-                cd.snr = snr;
-                cd.dial = dial;
-                cd.offset = offset;
-                cd.tdrift = tdrift;
-                cd.utcTimestamp =
-                    QDateTime::fromString(utc, "yyyy-MM-dd hh:mm:ss");
-                cd.utcTimestamp.setTimeZone(QTimeZone::utc());
-                cd.ackTimestamp = cd.utcTimestamp;
-                cd.submode = submode;
-                logCallActivity(cd, false);
-            }
+    m_inboxService->post(
+        this,
+        [](Inbox &inbox) {
+            return Counts{inbox.values("UNREAD", "$", "%", 0, 10000),
+                          inbox.getGroupMessageCounts()};
+        },
+        [this](Counts counts) {
+            applyInboxCounts(counts.first, counts.second);
+            displayCallActivity();
+        });
+}
+
+void MainWindow::applyInboxCounts(
+    QList<QPair<int, Message>> const &v,
+    QMap<QString, int> const &groupMessageCounts) {
+    // reset inbox counts
+    m_rxInboxCountCache.clear();
+
+    // compute new counts from db
+    foreach (auto pair, v) {
+        auto params = pair.second.params();
+        auto to = params.value("TO").toString();
+        if (to.isEmpty() ||
+            (to != m_config.my_callsign() &&
+             to != Radio::base_callsign(m_config.my_callsign()))) {
+            continue;
+        }
+        auto from = params.value("FROM").toString();
+        if (from.isEmpty()) {
+            continue;
         }
 
-        // Now handle group message counts
-        QMap<QString, int> groupMessageCounts = inbox.getGroupMessageCounts();
-        foreach (auto key, groupMessageCounts.keys()) {
-            m_rxInboxCountCache[key] = groupMessageCounts[key];
+        m_rxInboxCountCache[from] = m_rxInboxCountCache.value(from, 0) + 1;
+
+        if (!m_callActivity.contains(from)) {
+            auto const utc = params.value("UTC").toString();
+            auto const snr = params.value("SNR").toInt();
+            auto const dial = params.value("DIAL").toInt();
+            auto const offset = params.value("OFFSET").toInt();
+            auto const tdrift = params.value("TDRIFT").toInt();
+            auto const submode = params.value("SUBMODE").toInt();
+
+            CallDetail cd;
+            cd.call = from;
+            cd.snr = snr;
+            cd.dial = dial;
+            cd.offset = offset;
+            cd.tdrift = tdrift;
+            auto dateTime = QDateTime::fromString(utc, "yyyy-MM-dd hh:mm:ss");
+            dateTime.setTimeZone(QTimeZone::utc());
+            cd.utcTimestamp = toTimestamp(dateTime);
+            cd.ackTimestamp = cd.utcTimestamp;
+            cd.submode = submode;
+            logCallActivity(cd, false);
         }
     }
-}
 
-bool MainWindow::hasMessageHistory(QString call) {
-    auto inbox = Inbox(inboxPath());
-    if (!inbox.open()) {
-        return false;
+    // Now handle group message counts
+    foreach (auto key, groupMessageCounts.keys()) {
+        m_rxInboxCountCache[key] = groupMessageCounts[key];
     }
+}
 
-    int store = inbox.count("STORE", "$.params.TO", call);
-    int unread = inbox.count("UNREAD", "$.params.FROM", call);
-    int read = inbox.count("READ", "$.params.FROM", call);
-    return (store + unread + read) > 0;
+bool MainWindow::hasMessageHistory(QString call) {
+    return m_inboxService->call([&call](Inbox &inbox) {
+        int store = inbox.count("STORE", "$.params.TO", call);
+        int unread = inbox.count("UNREAD", "$.params.FROM", call);
+        int read = inbox.count("READ", "$.params.FROM", call);
+        return (store + unread + read) > 0;
+    });
 }
 
 int MainWindow::addCommandToMyInbox(CommandDetail d) {
@@ -7634,14 +7914,9 @@ int MainWindow::addCommandToMyInbox(CommandDetail d) {
 }
 
 int MainWindow::addCommandToStorage(QString type, CommandDetail d) {
-    // inbox:
-    auto inbox = Inbox(inboxPath());
-    if (!inbox.open()) {
-        return -1;
-    }
-
     QVariantMap v = {
-        {"UTC", QVariant(d.utcTimestamp.toString("yyyy-MM-dd hh:mm:ss"))},
+        {"UTC", QVariant(utcDateTime(d.utcTimestamp)
+                             .toString("yyyy-MM-dd hh:mm:ss"))},
         {"TO", QVariant(d.to)},
         {"FROM", QVariant(d.from)},
         {"PATH", QVariant(d.relayPath)},
@@ -7668,110 +7943,84 @@ int MainWindow::addCommandToStorage(QString type, CommandDetail d) {
 
     auto m = Message(type, "", v);
 
-    return inbox.append(m);
+    return m_inboxService->call([&m](Inbox &inbox) { return inbox.append(m); });
 }
 
 int MainWindow::getNextMessageIdForCallsign(QString callsign) {
-    auto inbox = Inbox(inboxPath());
-    if (!inbox.open()) {
-        return -1;
-    }
-
-    auto v1 = inbox.values("STORE", "$.params.TO", callsign, 0, 10);
-    foreach (auto pair, v1) {
-        auto params = pair.second.params();
-        auto text = params.value("TEXT").toString().trimmed();
-        if (!text.isEmpty()) {
-            return pair.first;
+    return m_inboxService->call([&callsign](Inbox &inbox) {
+        auto v1 = inbox.values("STORE", "$.params.TO", callsign, 0, 10);
+        foreach (auto pair, v1) {
+            auto params = pair.second.params();
+            auto text = params.value("TEXT").toString().trimmed();
+            if (!text.isEmpty()) {
+                return pair.first;
+            }
         }
-    }
 
-    auto v2 = inbox.values("STORE", "$.params.TO",
-                           Radio::base_callsign(callsign), 0, 10);
-    foreach (auto pair, v2) {
-        auto params = pair.second.params();
-        auto text = params.value("TEXT").toString().trimmed();
-        if (!text.isEmpty()) {
-            return pair.first;
+        auto v2 = inbox.values("STORE", "$.params.TO",
+                               Radio::base_callsign(callsign), 0, 10);
+        foreach (auto pair, v2) {
+            auto params = pair.second.params();
+            auto text = params.value("TEXT").toString().trimmed();
+            if (!text.isEmpty()) {
+                return pair.first;
+            }
         }
-    }
 
-    return -1;
+        return -1;
+    });
 }
 
 int MainWindow::getLookaheadMessageIdForCallsign(QString callsign, int msgId) {
-    auto inbox = Inbox(inboxPath());
-    if (!inbox.open()) {
-        return -1;
-    }
+    return m_inboxService->call([&callsign, msgId](Inbox &inbox) {
+        int mid = inbox.getLookaheadMessageIdForCallsign(callsign, msgId);
 
-    int mid = inbox.getLookaheadMessageIdForCallsign(callsign, msgId);
-
-    if (mid == -1) {
-        mid = inbox.getLookaheadMessageIdForCallsign(
-            Radio::base_callsign(callsign), msgId);
-    }
+        if (mid == -1) {
+            mid = inbox.getLookaheadMessageIdForCallsign(
+                Radio::base_callsign(callsign), msgId);
+        }
 
-    if (mid != -1) {
         return mid;
-    }
-
-    return -1;
+    });
 }
 
 // Facade for Inbox::getNextGroupMessageIdForCallsign
 int MainWindow::getNextGroupMessageIdForCallsign(QString group_name,
                                                  QString callsign) {
-    Inbox inbox(inboxPath());
-    if (!inbox.open()) {
-        return -1;
-    }
-
-    return inbox.getNextGroupMessageIdForCallsign(group_name, callsign);
+    return m_inboxService->call([&group_name, &callsign](Inbox &inbox) {
+        return inbox.getNextGroupMessageIdForCallsign(group_name, callsign);
+    });
 }
 
 // Facade for Inbox::getLookaheadGroupMessageIdForCallsign
 int MainWindow::getLookaheadGroupMessageIdForCallsign(QString group_name,
                                                       QString callsign,
                                                       int afterMsgId) {
-    Inbox inbox(inboxPath());
-    if (!inbox.open()) {
-        return -1;
-    }
-
-    int mid = inbox.getLookaheadGroupMessageIdForCallsign(group_name, callsign,
-                                                          afterMsgId);
-
-    if (mid == -1) {
-        mid = inbox.getLookaheadGroupMessageIdForCallsign(
-            group_name, Radio::base_callsign(callsign), afterMsgId);
-    }
-
-    if (mid != -1) {
-        return mid;
-    }
+    return m_inboxService->call(
+        [&group_name, &callsign, afterMsgId](Inbox &inbox) {
+            int mid = inbox.getLookaheadGroupMessageIdForCallsign(
+                group_name, callsign, afterMsgId);
+
+            if (mid == -1) {
+                mid = inbox.getLookaheadGroupMessageIdForCallsign(
+                    group_name, Radio::base_callsign(callsign), afterMsgId);
+            }
 
-    return -1;
+            return mid;
+        });
 }
 
 // Facade for Inbox::markGroupMsgDeliveredForCallsign
 bool MainWindow::markGroupMsgDeliveredForCallsign(int msgId, QString callsign) {
-    Inbox inbox(inboxPath());
-    if (!inbox.open()) {
-        return false;
-    }
-
-    return inbox.markGroupMsgDeliveredForCallsign(msgId, callsign);
+    return m_inboxService->call([msgId, &callsign](Inbox &inbox) {
+        return inbox.markGroupMsgDeliveredForCallsign(msgId, callsign);
+    });
 }
 
 bool MainWindow::markMsgDelivered(int mid, Message msg) {
-    Inbox inbox(inboxPath());
-    if (!inbox.open()) {
-        return false;
-    }
-
     msg.setType("DELIVERED");
-    return inbox.set(mid, msg);
+    return m_inboxService->call(
+        [mid, &msg](Inbox &inbox) { return inbox.set(mid, msg); });
 }
 
 QStringList MainWindow::parseRelayPathCallsigns(QString from, QString text) {
@@ -7821,7 +8070,7 @@ void MainWindow::processSpots() {
 
         spotReport(d.submode, d.dial, d.offset, d.snr, d.call, d.grid);
         pskLogReport("JS8", d.dial, d.offset, d.snr, d.call, d.grid,
-                     d.utcTimestamp);
+                     utcDateTime(d.utcTimestamp));
 
         if (canSendNetworkMessage()) {
             sendNetworkMessage("RX.SPOT", "",
@@ -7930,11 +8179,32 @@ void MainWindow::processTxQueue() {
     }
 }
 
+// Requests to display the activity arrive in bursts, e.g., one for each of
+// a period's decodes, and from each of the several things that follow
+// them; they're coalesced into a single refresh of the activity tables, at
+// most one per UI poll interval.
+
 void MainWindow::displayActivity(bool force) {
     if (!m_rxDisplayDirty && !force) {
         return;
     }
 
+    m_rxDisplayDirty = true;
+    ++m_activityDisplayRequests;
+
+    if (!m_activityDisplayTimer.isActive()) {
+        m_activityDisplayTimer.start();
+    }
+}
+
+void MainWindow::refreshActivityDisplay() {
+    if (!m_rxDisplayDirty) {
+        return;
+    }
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+
     // Band Activity
     displayBandActivity();
 
@@ -7942,6 +8212,10 @@ void MainWindow::displayActivity(bool force) {
     displayCallActivity();
 
     m_rxDisplayDirty = false;
+
+    qCDebug(mainwindow_js8)
+        << "activity displayed in" << elapsed.nsecsElapsed() / 1000 << "us,"
+        << std::exchange(m_activityDisplayRequests, 0) << "requests coalesced";
 }
 
 // updateBandActivity
@@ -8235,23 +8509,12 @@ void MainWindow::write_frequency_entry(QString const &file_name) {
     }
 
     // Write freq changes to ALL.TXT only below 30 MHz.
-    QFile f2{m_config.writeable_data_dir().absoluteFilePath(file_name)};
-    if (f2.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Append)) {
-        QTextStream out(&f2);
-        out << DriftingDateTime::currentDateTimeUtc().toString(
-                   "yyyy-MM-dd hh:mm:ss")
-            << "  " << qSetRealNumberPrecision(12) << (m_freqNominal / 1.e6)
-            << " MHz  "
-            << "JS8" << Qt::endl;
-        f2.close();
-    } else {
-        QTimer::singleShot(0, [this,
-                               message = tr("Cannot open \"%1\" for append: %2")
-                                             .arg(f2.fileName())
-                                             .arg(f2.errorString())] {
-            JS8MessageBox::warning_message(this, tr("Log File Error"), message);
-        });
-    }
+    m_logWriter->append(
+        m_config.writeable_data_dir().absoluteFilePath(file_name),
+        DriftingDateTime::currentDateTimeUtc().toString("yyyy-MM-dd hh:mm:ss") %
+            QStringLiteral("  ") %
+            QString::number(m_freqNominal / 1.e6, 'g', 12) %
+            QStringLiteral(" MHz  JS8"));
 }
 
 void MainWindow::write_transmit_entry(QString const &file_name) {
@@ -8259,26 +8522,26 @@ void MainWindow::write_transmit_entry(QString const &file_name) {
         return;
     }
 
-    QFile f{m_config.writeable_data_dir().absoluteFilePath(file_name)};
-    if (f.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Append)) {
-        QTextStream out(&f);
-        auto time = DriftingDateTime::currentDateTimeUtc();
-        time = time.addSecs(-(time.time().second() % m_TRperiod));
-        auto dt =
-            DecodedText(m_currentMessage, m_currentMessageBits, m_nSubMode);
-        out << time.toString("yyyy-MM-dd hh:mm:ss") << "  Transmitting "
-            << qSetRealNumberPrecision(12) << (m_freqNominal / 1.e6) << " MHz  "
-            << "JS8"
-            << ":  " << dt.message() << Qt::endl;
-        f.close();
-    } else {
-        QTimer::singleShot(0, [this,
-                               message = tr("Cannot open \"%1\" for append: %2")
-                                             .arg(f.fileName())
-                                             .arg(f.errorString())] {
-            JS8MessageBox::warning_message(this, tr("Log File Error"), message);
-        });
-    }
+    auto time = DriftingDateTime::currentDateTimeUtc();
+    time = time.addSecs(-(time.time().second() % m_TRperiod));
+    auto dt = DecodedText(m_currentMessage, m_currentMessageBits, m_nSubMode);
+
+    m_logWriter->append(
+        m_config.writeable_data_dir().absoluteFilePath(file_name),
+        time.toString("yyyy-MM-dd hh:mm:ss") %
+            QStringLiteral("  Transmitting ") %
+            QString::number(m_freqNominal / 1.e6, 'g', 12) %
+            QStringLiteral(" MHz  JS8:  ") % dt.message());
+}
+
+// Failures are reported by the log writer as they happen, from its thread,
+// rather than by the callers above, which only queue lines to it.
+
+void MainWindow::logFileError(QString const &path, QString const &message) {
+    JS8MessageBox::warning_message(
+        this, tr("Log File Error"),
+        tr("Cannot write \"%1\": %2")
+            .arg(QDir::toNativeSeparators(path), message));
 }
 
 void MainWindow::writeAllTxt(QStringView message) {
@@ -8287,29 +8550,14 @@ void MainWindow::writeAllTxt(QStringView message) {
 
     // Write decoded text to file "ALL.TXT".
 
-    QFile f{m_config.writeable_data_dir().absoluteFilePath("ALL.TXT")};
-
-    if (f.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Append)) {
-        QTextStream out(&f);
-
-        if (m_RxLog == 1) {
-            out << DriftingDateTime::currentDateTimeUtc().toString(
-                       "yyyy-MM-dd hh:mm:ss")
-                << "  " << qSetRealNumberPrecision(12) << (m_freqNominal / 1.e6)
-                << " MHz  JS8" << Qt::endl;
-
-            m_RxLog = 0;
-        }
-
-        out << message << Qt::endl;
-
-        f.close();
-    } else {
-        JS8MessageBox::warning_message(this, tr("File Open Error"),
-                                       tr("Cannot open \"%1\" for append: %2")
-                                           .arg(f.fileName())
-                                           .arg(f.errorString()));
+    if (m_RxLog == 1) {
+        write_frequency_entry("ALL.TXT");
+        m_RxLog = 0;
     }
+
+    m_logWriter->append(
+        m_config.writeable_data_dir().absoluteFilePath("ALL.TXT"),
+        message.toString());
 }
 
 void MainWindow::writeMsgTxt(QStringView message, int snr, int offset) {
@@ -8318,25 +8566,12 @@ void MainWindow::writeMsgTxt(QStringView message, int snr, int offset) {
 
     // Write decoded text to file "DIRECTED.TXT".
 
-    QFile f{m_config.writeable_data_dir().absoluteFilePath("DIRECTED.TXT")};
-
-    if (f.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Append)) {
-        QTextStream out(&f);
-        QString output = DriftingDateTime::currentDateTimeUtc().toString(
-                             "yyyy-MM-dd hh:mm:ss") %
-                         "\t" % Radio::frequency_MHz_string(m_freqNominal) %
-                         "\t" % QString::number(offset) % "\t" %
-                         Varicode::formatSNR(snr) % "\t" % message;
-
-        out << output << Qt::endl;
-
-        f.close();
-    } else {
-        JS8MessageBox::warning_message(this, tr("File Open Error"),
-                                       tr("Cannot open \"%1\" for append: %2")
-                                           .arg(f.fileName())
-                                           .arg(f.errorString()));
-    }
+    m_logWriter->append(
+        m_config.writeable_data_dir().absoluteFilePath("DIRECTED.TXT"),
+        DriftingDateTime::currentDateTimeUtc().toString("yyyy-MM-dd hh:mm:ss") %
+            "\t" % Radio::frequency_MHz_string(m_freqNominal) % "\t" %
+            QString::number(offset) % "\t" % Varicode::formatSNR(snr) % "\t" %
+            message);
 }
 
 QByteArray MainWindow::wisdomFileName() const {
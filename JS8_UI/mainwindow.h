@@ -24,6 +24,7 @@
 #include <QLoggingCategory>
 #include <QMainWindow>
 #include <QMdiSubWindow>
+#include <QMediaDevices>
 #include <QMutex>
 #include <QMutexLocker>
 #include <QNetworkAccessManager>
@@ -65,9 +66,11 @@
 #include <fftw3.h>
 #include <functional>
 #include <iterator>
+#include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "JS8_Audio/AudioDevice.h"
@@ -82,12 +85,17 @@
 #include "JS8_Main/APRSISClient.h"
 #include "JS8_Main/AprsInboundRelay.h"
 #include "JS8_Main/Bands.h"
+#include "JS8_Main/DecodeJournal.h"
 #include "JS8_Main/DriftingDateTime.h"
 #include "JS8_Main/FrequencyList.h"
 #include "JS8_Main/Geodesic.h"
+#include "JS8_Main/HeardGraph.h"
 #include "JS8_Main/HelpTextWindow.h"
 #include "JS8_Main/Inbox.h"
+#include "JS8_Main/InboxService.h"
+#include "JS8_Main/Intern.h"
 #include "JS8_Main/JS8MessageBox.h"
+#include "JS8_Main/LogWriter.h"
 #include "JS8_Main/MessageClient.h"
 #include "JS8_Main/MessageServer.h"
 #include "JS8_Main/Modes.h"
@@ -97,6 +105,7 @@
 #include "JS8_Main/SelfDestructMessageBox.h"
 #include "JS8_Main/SignalMeter.h"
 #include "JS8_Main/StationList.h"
+#include "JS8_Main/TableRows.h"
 #include "JS8_Main/TxLoop.h"
 #include "JS8_Main/qt_helpers.h"
 #include "JS8_Main/revision_utils.h"
@@ -107,6 +116,7 @@
 #include "JS8_Mode/JS8.h"
 #include "JS8_Mode/JS8Submode.h"
 #include "JS8_Mode/Modulator.h"
+#include "JS8_Mode/Receiver.h"
 #include "JS8_Network/NetworkAccessManager.h"
 #include "JS8_Network/PSKReporter.h"
 #include "JS8_Network/SpotClient.h"
@@ -228,12 +238,15 @@ class MainWindow : public QMainWindow {
     void clearBandActivity();
     void clearRXActivity();
     void clearCallActivity();
-    void createGroupCallsignTableRows(QTableWidget *table,
+    void pruneActivity();
+    void createGroupCallsignTableRows(TableRows &rows,
                                       const QString &selectedCall,
                                       bool &showIconColumn);
     void displayTextForFreq(QString text, int freq, QDateTime date, bool isTx,
                             bool isNewLine, bool isLast);
     void writeNoticeTextToUI(QDateTime date, QString text);
+    void stampRxHistory();
+    void trimRxHistory();
     int writeMessageTextToUI(QDateTime date, QString text, int freq, bool isTx,
                              int block = -1);
     bool isMessageQueuedForTransmit();
@@ -263,6 +276,7 @@ class MainWindow : public QMainWindow {
     QPair<QString, int> popMessageFrame();
     void tryNotify(const QString &key);
     void processDecodeEvent(JS8::Event::Variant const &);
+    void processReceiverDecode(Receiver const &, JS8::Event::Decoded const &);
 
     void updateCQButtonDisplay();
     void updateHBButtonDisplay();
@@ -396,6 +410,7 @@ class MainWindow : public QMainWindow {
                                                   bool isData,
                                                   bool *pDisableTypeahead);
     bool prepareNextMessageFrame();
+    void prerenderNextMessageFrame();
     bool isFreqOffsetFree(int f, int bw);
     int findFreeFreqOffset(int fmin, int fmax, int bw);
     void setDrift(int n);
@@ -492,6 +507,8 @@ class MainWindow : public QMainWindow {
     Q_SIGNAL void tune(bool = true) const;
     Q_SIGNAL void sendMessage(double frequency, int submode, double txDelay,
                               SoundOutput *, AudioDevice::Channel) const;
+    Q_SIGNAL void prerenderMessage(QVector<int> tones, double frequency,
+                                   int submode) const;
     Q_SIGNAL void outAttenuationChanged(qreal) const;
     Q_SIGNAL void toggleShorthand() const;
     Q_SIGNAL void submodeChanged(Varicode::SubmodeType) const;
@@ -563,7 +580,10 @@ class MainWindow : public QMainWindow {
     QThread m_networkThread;
     QThread m_audioThread;
     QThread m_notificationAudioThread;
+    QThread m_logThread;
+    QThread m_inboxThread;
     JS8::Decoder m_decoder;
+    std::vector<std::unique_ptr<Receiver>> m_receivers;
 
     qint64 m_secBandChanged;
 
@@ -644,15 +664,18 @@ class MainWindow : public QMainWindow {
     QString m_msgSent0;
     QString m_opCall;
 
+    // Timestamps in the records below are UTC milliseconds since the
+    // epoch, 0 if none; see utcDateTime() for the date and time.
+
     struct CallDetail {
         QString call;
         QString through;
         QString grid;
         int dial;
         int offset;
-        QDateTime cqTimestamp;
-        QDateTime ackTimestamp;
-        QDateTime utcTimestamp;
+        qint64 cqTimestamp = 0;
+        qint64 ackTimestamp = 0;
+        qint64 utcTimestamp = 0;
         int snr;
         int bits;
         float tdrift;
@@ -667,7 +690,7 @@ class MainWindow : public QMainWindow {
         QString cmd;
         int dial;
         int offset;
-        QDateTime utcTimestamp;
+        qint64 utcTimestamp = 0;
         int snr;
         int bits;
         QString grid;
@@ -687,7 +710,7 @@ class MainWindow : public QMainWindow {
         int dial;
         int offset;
         QString text;
-        QDateTime utcTimestamp;
+        qint64 utcTimestamp = 0;
         int snr;
         bool shouldDisplay;
         float tdrift;
@@ -707,7 +730,9 @@ class MainWindow : public QMainWindow {
     int m_waterfallHeight;
     bool m_bandActivityWasVisible;
     bool m_rxDirty;
-    bool m_rxDisplayDirty;
+    bool m_rxDisplayDirty = false;
+    QTimer m_activityDisplayTimer;
+    int m_activityDisplayRequests = 0;
     int m_txFrameCountEstimate;
     int m_txFrameCount;
     int m_txFrameCountSent;
@@ -718,6 +743,22 @@ class MainWindow : public QMainWindow {
     QString m_lastTxMessage;
     QString m_totalTxMessage;
 
+    // Date and time of a record timestamp; invalid if there's none.
+    static QDateTime utcDateTime(qint64 const timestamp) {
+        return timestamp
+                   ? QDateTime::fromMSecsSinceEpoch(timestamp, QTimeZone::utc())
+                   : QDateTime{};
+    }
+
+    // Record timestamp of a date and time; 0 if it's invalid.
+    static qint64 toTimestamp(QDateTime const &dateTime) {
+        return dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : 0;
+    }
+
+    QString since(qint64 const timestamp) {
+        return since(utcDateTime(timestamp));
+    }
+
     // moved from mainwindow.cpp, is used in multiple functions
     QString since(QDateTime const &time) {
         auto const delta = time.secsTo(DriftingDateTime::currentDateTimeUtc());
@@ -748,8 +789,23 @@ class MainWindow : public QMainWindow {
             output = output.replace(key, value.toUpper());
         }
 
-        return prune ? output.replace(QRegularExpression("[<](?:[^>]+)[>]"), "")
-                     : output;
+        // prune any macros left unreplaced, i.e., anything matching <[^>]+>
+        if (prune) {
+            for (auto start = output.indexOf('<'); start != -1;
+                 start = output.indexOf('<', start)) {
+                auto const end = output.indexOf('>', start + 1);
+                if (end == -1) {
+                    break;
+                }
+                if (end > start + 1) {
+                    output.remove(start, end - start + 1);
+                } else {
+                    ++start;
+                }
+            }
+        }
+
+        return output;
     }
 
     QList<int> generateOffsets(int minOffset, int maxOffset) {
@@ -799,15 +855,17 @@ class MainWindow : public QMainWindow {
     struct FrameCacheKey {
         int submode;
         QString frame;
+        int receiver;
 
-        FrameCacheKey(int submode, QString frame)
-            : submode(submode), frame(std::move(frame)) {}
+        FrameCacheKey(int submode, QString frame, int receiver = 0)
+            : submode(submode), frame(std::move(frame)), receiver(receiver) {}
 
         bool operator==(FrameCacheKey const &) const noexcept = default;
 
         struct Hash {
             std::size_t operator()(FrameCacheKey const &key) const noexcept {
-                std::size_t const h1 = std::hash<int>{}(key.submode);
+                std::size_t const h1 =
+                    std::hash<int>{}(key.submode | (key.receiver << 8));
                 std::size_t const h2 = qHash(key.frame);
                 return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
             }
@@ -847,12 +905,7 @@ class MainWindow : public QMainWindow {
     QMap<int, QString> m_origCallActivityHeaderLabelMap; // colIndex, label
     QMap<QString, QString> m_columnLabelMap;             // full, minimal
 
-    QMap<QString, QSet<QString>>
-        m_heardGraphOutgoing; // callsign -> [stations who've this callsign has
-                              // heard]
-    QMap<QString, QSet<QString>>
-        m_heardGraphIncoming; // callsign -> [stations who've heard this
-                              // callsign]
+    HeardGraph m_heardGraph; // who's hearing whom, per band
 
     QMap<QString, int> m_rxInboxCountCache; // call -> count
 
@@ -861,10 +914,6 @@ class MainWindow : public QMainWindow {
     QMap<QString, QMap<int, QList<ActivityDetail>>>
         m_bandActivityBandCache;              // band -> band activity
     QMap<QString, QString> m_rxTextBandCache; // band -> rx text
-    QMap<QString, QMap<QString, QSet<QString>>>
-        m_heardGraphOutgoingBandCache; // band -> heard in
-    QMap<QString, QMap<QString, QSet<QString>>>
-        m_heardGraphIncomingBandCache; // band -> heard out
 
     QMap<QString, QDateTime>
         m_callSelectedTime; // call -> timestamp when callsign was last selected
@@ -915,6 +964,9 @@ class MainWindow : public QMainWindow {
     SpotClient *m_spotClient;
     APRSISClient *m_aprsClient;
     AprsInboundRelay *m_aprsInboundRelay;
+    LogWriter *m_logWriter;
+    DecodeJournal::Writer *m_decodeJournal;
+    InboxService *m_inboxService;
     DisplayManual m_manual;
     QVariantHash m_pwrBandTxMemory; // Remembers power level by band
     QVariantHash
@@ -972,6 +1024,8 @@ class MainWindow : public QMainWindow {
     void processCommandActivity();
     QString inboxPath();
     void refreshInboxCounts();
+    void applyInboxCounts(QList<QPair<int, Message>> const &unread,
+                          QMap<QString, int> const &groupMessageCounts);
     bool hasMessageHistory(QString call);
     int addCommandToMyInbox(CommandDetail d);
     int addCommandToStorage(QString type, CommandDetail d);
@@ -986,6 +1040,7 @@ class MainWindow : public QMainWindow {
     void processSpots();
     void processTxQueue();
     void displayActivity(bool force = false);
+    void refreshActivityDisplay();
     void displayBandActivity();
     void displayCallActivity();
     void enable_DXCC_entity(bool on);
@@ -1004,6 +1059,7 @@ class MainWindow : public QMainWindow {
     void tx_watchdog(bool triggered);
     void write_frequency_entry(QString const &file_name);
     void write_transmit_entry(QString const &file_name);
+    void logFileError(QString const &path, QString const &message);
 };
 
 #endif // MAINWINDOW_H
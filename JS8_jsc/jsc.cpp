@@ -23,14 +23,209 @@
  **/
 
 #include "jsc.h"
-#include "JS8_Main/varicode.h"
+#include "jsc_blob.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <ranges>
+#include <string_view>
 
 #include <QDebug>
-#include <QCache>
+#include <QResource>
+#include <QSet>
+#include <QtEndian>
+
+namespace {
+    /**
+     * @brief The packed dictionary, as written by jsc_pack.
+     *
+     * Used in place, from the uncompressed resource compiled into the
+     * binary; nothing is copied, and nothing needs relocation. Values
+     * are read little endian, and needn't be aligned.
+     */
+    class Blob {
+    public:
+        static Blob const & instance(){
+            static Blob const blob;
+            return blob;
+        }
+
+        Tuple entry(int section, quint32 i) const {
+            auto const p = m_sections[section] + i * sizeof(JSCBlob::Entry);
+            return { m_sections[JSCBlob::Pool] + read(p + offsetof(JSCBlob::Entry, offset)),
+                     static_cast<int>(read(p + offsetof(JSCBlob::Entry, size))),
+                     static_cast<int>(read(p + offsetof(JSCBlob::Entry, index))) };
+        }
+
+        quint32 sorted(quint32 i) const {
+            return read(m_sections[JSCBlob::Sorted] + i * sizeof(quint32));
+        }
+
+        quint32 sortedSize() const {
+            return m_count[JSCBlob::Sorted];
+        }
+
+    private:
+        Blob(){
+            QResource resource(":/jsc.bin");
+            if(!resource.isValid() || resource.compressionAlgorithm() != QResource::NoCompression || resource.size() < qint64(sizeof(JSCBlob::Header))){
+                qFatal("JSC dictionary resource is missing or compressed");
+            }
+
+            auto p = reinterpret_cast<char const *>(resource.data());
+            if(read(p) != JSCBlob::Magic){
+                qFatal("JSC dictionary resource is not a packed dictionary");
+            }
+            p += sizeof(quint32);
+
+            static constexpr std::array<quint32, JSCBlob::Sections> width = {
+                sizeof(JSCBlob::Entry), sizeof(JSCBlob::Entry), sizeof(JSCBlob::Entry), sizeof(quint32), 1
+            };
+
+            qint64 total = sizeof(JSCBlob::Header);
+            for(int i = 0; i < JSCBlob::Sections; i++){
+                m_count[i] = read(p + i * sizeof(quint32));
+                total += qint64(m_count[i]) * width[i];
+            }
+            p += JSCBlob::Sections * sizeof(quint32);
+
+            if(total != resource.size() || m_count[JSCBlob::Map] != JSC::size || m_count[JSCBlob::List] != JSC::size || m_count[JSCBlob::Prefix] != JSC::prefixSize){
+                qFatal("JSC dictionary resource does not match the tables");
+            }
+
+            for(int i = 0; i < JSCBlob::Sections; i++){
+                m_sections[i] = p;
+                p += m_count[i] * width[i];
+            }
+        }
+
+        static quint32 read(char const *p){
+            return qFromLittleEndian<quint32>(p);
+        }
+
+        std::array<quint32, JSCBlob::Sections> m_count;
+        std::array<char const *, JSCBlob::Sections> m_sections;
+    };
+
+    /**
+     * @brief Sorted index of the compression list, used as an implicit trie.
+     *
+     * The positions of list entries, ordered by word, are packed into the
+     * dictionary at build time. Words sharing a prefix are contiguous, so
+     * a trie node is no more than a range of the index and the length of
+     * the prefix, and descending to a child is a binary search on the
+     * character at that depth.
+     *
+     * Only the first prefix group of each leading character is indexed,
+     * as that's the only one the lookup has ever searched.
+     */
+    class Index {
+    public:
+        struct Node {
+            quint32 lo;
+            quint32 hi;
+            quint32 depth;
+
+            bool isEmpty() const { return lo == hi; }
+        };
+
+        static Index const & instance(){
+            static Index const index;
+            return index;
+        }
+
+        // prefix table entry for the leading character, or -1 if none
+        int group(char ch) const {
+            return m_groups[static_cast<unsigned char>(ch)];
+        }
+
+        Node root() const {
+            return { 0, m_blob.sortedSize(), 0 };
+        }
+
+        // node for the prefix extended by the character; empty if no word
+        // has that prefix
+        Node child(Node const node, char const ch) const {
+            auto const first = node.lo + terminals(node);
+            auto const depth = node.depth;
+            auto const key = static_cast<unsigned char>(ch);
+            auto const range = std::views::iota(first, node.hi);
+
+            auto const at = [this, depth](quint32 i){
+                return static_cast<unsigned char>(m_blob.entry(JSCBlob::List, m_blob.sorted(i)).str[depth]);
+            };
+
+            auto const lo = std::ranges::partition_point(range, [&](quint32 i){ return at(i) < key; });
+            auto const hi = std::ranges::partition_point(lo, range.end(), [&](quint32 i){ return at(i) <= key; });
+
+            return { first + static_cast<quint32>(lo - range.begin()),
+                     first + static_cast<quint32>(hi - range.begin()),
+                     depth + 1 };
+        }
+
+        // node for the prefix extended by the characters
+        Node walk(Node node, char const *str, qsizetype size) const {
+            for(qsizetype i = 0; i < size && !node.isEmpty(); i++){
+                node = child(node, str[i]);
+            }
+            return node;
+        }
+
+        // list position of the first, in list order, of the words that end
+        // at the node, or -1 if none do
+        qint64 word(Node const node) const {
+            qint64 first = -1;
+            for(auto i = node.lo; i < node.lo + terminals(node); i++){
+                auto const position = m_blob.sorted(i);
+                if(first < 0 || position < first){
+                    first = position;
+                }
+            }
+            return first;
+        }
+
+    private:
+        Index() : m_blob(Blob::instance()) {
+            m_groups.fill(-1);
+
+            for(quint32 i = 0; i < JSC::prefixSize; i++){
+                auto &group = m_groups[static_cast<unsigned char>(JSC::prefix[i].str[0])];
+                if(group < 0){
+                    group = i;
+                }
+            }
+        }
+
+        // number of words, sorted to the front of the node, that end there
+        quint32 terminals(Node const node) const {
+            quint32 n = 0;
+            while(node.lo + n < node.hi && static_cast<quint32>(m_blob.entry(JSCBlob::List, m_blob.sorted(node.lo + n)).size) == node.depth){
+                n++;
+            }
+            return n;
+        }
+
+        Blob const & m_blob;
+        std::array<int, 256> m_groups;
+    };
+}
 
-QMap<QString, quint32> LOOKUP_CACHE;
+const JSC::Table JSC::map(JSCBlob::Map);
+const JSC::Table JSC::list(JSCBlob::List);
+const JSC::Table JSC::prefix(JSCBlob::Prefix);
+
+/**
+ * @brief Entry of a table of the packed dictionary.
+ *
+ * @param i
+ * @return Tuple
+ */
+Tuple JSC::Table::operator[](quint32 i) const {
+    return Blob::instance().entry(m_section, i);
+}
 
 /**
  * @brief Generates a codeword for the given index and parameters.
@@ -43,23 +238,26 @@ QMap<QString, quint32> LOOKUP_CACHE;
  * @return Codeword 
  */
 Codeword JSC::codeword(quint32 index, bool separate, quint32 bytesize, quint32 s, quint32 c){
-    QList<Codeword> out;
-
-    quint32 v = ((index % s) << 1) + (quint32)separate;
-    out.prepend(Varicode::intToBits(v, bytesize + 1));
+    // continuation bytes are generated last to first; hold them until
+    // we've got them all, then emit them ahead of the terminal byte
+    quint32 bytes[32];
+    int count = 0;
 
     quint32 x = index / s;
     while(x > 0){
         x -= 1;
-        out.prepend(Varicode::intToBits((x % c) + s, bytesize));
+        bytes[count++] = (x % c) + s;
         x /= c;
     }
 
     Codeword word;
-    foreach(auto w, out){
-        word.append(w);
+    while(count > 0){
+        word.append(bytes[--count], bytesize);
     }
 
+    quint32 v = ((index % s) << 1) + (quint32)separate;
+    word.append(v, bytesize + 1);
+
     return word;
 }
 
@@ -141,13 +339,12 @@ QString JSC::decompress(Codeword const& bitvec){
     QList<quint32> separators;
 
     int i = 0;
-    int count = bitvec.count();
+    int count = bitvec.size();
     while(i < count){
-        auto b = bitvec.mid(i, 4);
-        if(b.length() != 4){
+        if(count - i < 4){
             break;
         }
-        quint64 byte = Varicode::bitsToInt(b);
+        quint64 byte = bitvec.field(i, 4);
         bytes.append(byte);
         i += 4;
 
@@ -219,68 +416,110 @@ bool JSC::exists(QString w, quint32 *pIndex){
  * @return quint32 
  */
 quint32 JSC::lookup(QString w, bool * ok){
-    if(LOOKUP_CACHE.contains(w)){
-        if(ok) *ok = true;
-        return LOOKUP_CACHE[w];
-    }
-
-    bool found = false;
-    quint32 result = lookup(w.toLatin1().data(), &found);
-    if(found){
-        LOOKUP_CACHE[w] = result;
-    }
-
-    if(ok) *ok = found;
-    return result;
+    return lookup(w.toLatin1().constData(), ok);
 }
 
 /**
  * @brief Looks up the index of the given C-style string in the compression map.
+ *
+ * Finds the first word, in list order, of the prefix group for the leading
+ * character that is a prefix of the string; the longest, as the list is
+ * ordered.
  * 
  * @param b 
  * @param ok 
  * @return quint32 
  */
 quint32 JSC::lookup(char const* b, bool *ok){
-    quint32 index = 0;
-    quint32 count = 0;
-    bool found = false;
+    auto const &index = Index::instance();
 
-    // first find prefix match to jump into the list faster
-    for(quint32 i = 0; i < JSC::prefixSize; i++){
-        // skip obvious non-prefixes...
-        if(b[0] != JSC::prefix[i].str[0]){
-            continue;
-        }
+    // no prefix found... no lookup
+    int const group = index.group(b[0]);
+    if(group < 0){
+        if(ok) *ok = false;
+        return 0;
+    }
 
-        // ok, we found one... let's end early for single char strings.
-        if(JSC::prefix[i].size == 1){
-            if(ok) *ok = true;
-            return JSC::list[JSC::prefix[i].index].index;
-        }
+    // ok, we found one... let's end early for single char strings.
+    if(JSC::prefix[group].size == 1){
+        if(ok) *ok = true;
+        return JSC::list[JSC::prefix[group].index].index;
+    }
+
+    // descend the index along the string, keeping the first word in list
+    // order of those passed on the way down
+    qint64 first = -1;
+    auto node = index.root();
+    for(auto p = b; *p && !node.isEmpty(); p++){
+        node = index.child(node, *p);
 
-        // otherwise, keep track of the first index in the list and the number of elements
-        index = JSC::prefix[i].index;
-        count = JSC::prefix[i].size;
-        found = true;
-        break;
+        auto const word = index.word(node);
+        if(word >= 0 && (first < 0 || word < first)){
+            first = word;
+        }
     }
 
-    // no prefix found... no lookup
-    if(!found){
+    if(first < 0){
         if(ok) *ok = false;
         return 0;
     }
 
-    // now that we have the first index in the list, let's just iterate through the list, comparing words along the way
-    for(quint32 i = index; i < index + count; i++){
-        quint32 len = JSC::list[i].size;
-        if(strncmp(b, JSC::list[i].str, len) == 0){
-            if(ok) *ok = true;
-            return JSC::list[i].index;
+    if(ok) *ok = true;
+    return JSC::list[first].index;
+}
+
+/**
+ * @brief Finds the words of the compression map within one edit of the given word.
+ *
+ * An edit is the substitution of a letter for any character, the deletion
+ * of any character, or the addition of a letter at either end; the index
+ * is searched once per edit position, rather than checking every variant.
+ *
+ * @param w
+ * @return QStringList
+ */
+QStringList JSC::nearby(QString const &w){
+    static char const letters[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    auto const &index = Index::instance();
+    auto const word = w.toLatin1();
+    auto const size = word.size();
+    auto const data = word.constData();
+
+    QSet<QString> out;
+
+    auto const found = [&](Index::Node node, QByteArray const &candidate){
+        if(index.word(node) >= 0){
+            out.insert(QString::fromLatin1(candidate));
         }
+    };
+
+    for(auto const ch : std::string_view(letters)){
+        // letter added at the start
+        found(index.walk(index.child(index.root(), ch), data, size), ch + word);
+
+        // letter added at the end
+        found(index.child(index.walk(index.root(), data, size), ch), word + ch);
+    }
+
+    auto prefix = index.root();
+    for(qsizetype j = 0; j < size && !prefix.isEmpty(); j++){
+        auto const rest = data + j + 1;
+        auto const restSize = size - j - 1;
+
+        // letter substituted at j
+        for(auto const ch : std::string_view(letters)){
+            auto const node = index.child(prefix, ch);
+            if(!node.isEmpty()){
+                found(index.walk(node, rest, restSize), word.left(j) + ch + word.mid(j + 1));
+            }
+        }
+
+        // character deleted at j
+        found(index.walk(prefix, rest, restSize), word.left(j) + word.mid(j + 1));
+
+        prefix = index.child(prefix, data[j]);
     }
 
-    if(ok) *ok = false;
-    return 0;
+    return out.values();
 }
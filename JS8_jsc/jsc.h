@@ -12,8 +12,10 @@
 #include <QPair>
 #include <QVector>
 
-typedef QPair<QVector<bool>, quint32> CodewordPair;        // Tuple(Codeword, N) where N = number of characters
-typedef QVector<bool> Codeword;                        // Codeword bit vector
+#include "JS8_Main/BitBuffer.h"
+
+typedef BitBuffer Codeword;                            // Codeword bit vector
+typedef QPair<Codeword, quint32> CodewordPair;         // Tuple(Codeword, N) where N = number of characters
 
 typedef struct Tuple{
     char const * str;
@@ -35,13 +37,33 @@ public:
     static bool exists(QString w, quint32 *pIndex);
     static quint32 lookup(QString w, bool *ok);
     static quint32 lookup(char const* b, bool *ok);
+    static QStringList nearby(QString const &w);
 
     static const quint32 size = 262144;
+    static const quint32 prefixSize = 103;
+
+#ifdef JSC_TABLE_SOURCES
+    // The generated tables, compiled only into jsc_pack, which packs them
+    // into the blob that the tables below read from.
     static const Tuple map[262144];
     static const Tuple list[262144];
-
-    static const quint32 prefixSize = 103;
     static const Tuple prefix[103];
+#else
+    // View of a table in the packed dictionary; entries are made on
+    // access, with the string pointing into the blob's pool.
+    class Table {
+    public:
+        constexpr explicit Table(int section) : m_section(section) {}
+        Tuple operator[](quint32 i) const;
+
+    private:
+        int m_section;
+    };
+
+    static const Table map;
+    static const Table list;
+    static const Table prefix;
+#endif
 };
 
 #endif // JSC_H
@@ -0,0 +1,53 @@
+#ifndef JSC_BLOB_H
+#define JSC_BLOB_H
+
+/**
+ * @file jsc_blob.h
+ * @brief Layout of the packed JSC dictionary
+ *
+ * The dictionary tables are packed at build time, by jsc_pack, into a
+ * single blob that holds no pointers, so that it can be carried as a
+ * resource and used in place, needing neither relocation nor a copy.
+ *
+ * All values are 32-bit little endian. The blob is a header, followed,
+ * in order, by the map, list, and prefix entries, the sorted index, and
+ * the string pool:
+ *
+ *   Header           magic, then the count of each of the sections
+ *   Entry[map]       word, by offset into the pool, size, and index
+ *   Entry[list]
+ *   Entry[prefix]
+ *   quint32[sorted]  list positions of the indexed words, ordered by word
+ *   char[pool]       words, each terminated by a NUL
+ *
+ * The sorted index is of the first prefix group of each leading character,
+ * which is the only part of the list that the lookup ever searches.
+ **/
+
+#include <QtGlobal>
+
+namespace JSCBlob {
+    constexpr quint32 Magic = 0x3143534a; // "JSC1"
+
+    enum Section {
+        Map,
+        List,
+        Prefix,
+        Sorted,
+        Pool,
+        Sections
+    };
+
+    struct Header {
+        quint32 magic;
+        quint32 count[Sections];
+    };
+
+    struct Entry {
+        quint32 offset;
+        quint32 size;
+        quint32 index;
+    };
+}
+
+#endif // JSC_BLOB_H
@@ -37,7 +37,6 @@
 Q_DECLARE_LOGGING_CATEGORY(jsc_checker_js8)
 
 const int CORRECT = QTextFormat::UserProperty + 10;
-const QString ALPHABET = { "ABCDEFGHIJKLMNOPQRSTUVWXYZ" };
 
 /**
  * @brief Construct a new JSCChecker::JSCChecker object
@@ -194,67 +193,16 @@ void JSCChecker::checkRange(QTextEdit* edit, int start, int end)
 }
 
 /**
- * @brief Generate all candidate words that are one edit distance away
+ * @brief Generate candidate words that are one edit distance away
  * 
  * @param word 
- * @param includeAdditions 
- * @param includeDeletions 
- * @return QSet<QString> 
- */
-QSet<QString> oneEdit(QString word, bool includeAdditions, bool includeDeletions){
-    QSet<QString> all;
-
-    // 1-edit distance words (i.e., prefixed/suffixed/edited characters)
-    for(int i = 0; i < 26; i++){
-        if(includeAdditions){
-            auto prefixed = ALPHABET.mid(i, 1) + word;
-            all.insert(prefixed);
-
-            auto suffixed = word + ALPHABET.mid(i, 1);
-            all.insert(suffixed);
-        }
-
-        for(int j = 0; j < word.length(); j++){
-            auto edited = word.mid(0, j) + ALPHABET.mid(i, 1) + word.mid(j + 1, word.length() - j);
-            all.insert(edited);
-        }
-    }
-
-    // 1-edit distance words (i.e., removed characters)
-    if(includeDeletions){
-        for(int j = 0; j < word.length(); j++){
-            auto deleted = word.mid(0, j) + word.mid(j + 1, word.length() - j);
-            all.insert(deleted);
-        }
-    }
-
-    return all;
-}
-
-/**
- * @brief Generate candidate words that are one or two edit distances away
- * 
- * @param word 
- * @param includeTwoEdits 
  * @return QMultiMap<quint32, QString> 
  */
-QMultiMap<quint32, QString> candidates(QString word, bool includeTwoEdits){
-    // one edit
-    QSet<QString> one = oneEdit(word, true, true);
-
-    // two edits
-    QSet<QString> two;
-    if(includeTwoEdits){
-        foreach(auto w, one){
-            two |= oneEdit(w, false, false);
-        }
-    }
-
-    // existence check
+QMultiMap<quint32, QString> candidates(QString word){
     QMultiMap<quint32, QString> m;
 
     quint32 index;
-    foreach(auto w, one | two){
+    foreach(auto w, JSC::nearby(word)){
         if(JSC::exists(w, &index)){
             m.insert(index, w);
         }
@@ -290,7 +238,7 @@ QStringList JSCChecker::suggestions(QString word, int n, bool *pFound){
     }
 
     // compute suggestion candidates
-    m.unite(candidates(word, false));
+    m.unite(candidates(word));
 
     // return in order of probability (i.e., index rank)
     int i = 0;
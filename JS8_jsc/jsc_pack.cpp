@@ -0,0 +1,162 @@
+/**
+ * @file jsc_pack.cpp
+ * @brief Build tool that packs the JSC dictionary tables into a blob
+ */
+/**
+ * This file is part of JS8Call.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * Compiled, along with the generated table sources, into a host tool,
+ * run by the build to write the blob described in jsc_blob.h; usage is
+ *
+ *   jsc_pack <output>
+ *
+ * Identical words share a single copy in the string pool, so that the
+ * map and the list, which hold the same words, cost the pool only once.
+ **/
+
+#include "jsc.h"
+#include "jsc_blob.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <QtEndian>
+
+namespace {
+    class Packer {
+    public:
+        void add(JSCBlob::Section section, Tuple const *tuples, quint32 count){
+            for(quint32 i = 0; i < count; i++){
+                auto const &t = tuples[i];
+                put(m_entries[section], intern(std::string_view(t.str, t.size)));
+                put(m_entries[section], t.size);
+                put(m_entries[section], t.index);
+            }
+            m_count[section] = count;
+        }
+
+        void sorted(std::vector<quint32> const &positions){
+            for(auto position : positions){
+                put(m_sorted, position);
+            }
+            m_count[JSCBlob::Sorted] = positions.size();
+        }
+
+        bool write(char const *path){
+            m_count[JSCBlob::Pool] = m_pool.size();
+
+            std::string header;
+            put(header, JSCBlob::Magic);
+            for(auto count : m_count){
+                put(header, count);
+            }
+
+            auto file = std::fopen(path, "wb");
+            if(!file){
+                return false;
+            }
+
+            bool ok = true;
+            for(auto const &part : { header, m_entries[JSCBlob::Map], m_entries[JSCBlob::List], m_entries[JSCBlob::Prefix], m_sorted, m_pool }){
+                ok = ok && std::fwrite(part.data(), 1, part.size(), file) == part.size();
+            }
+
+            return std::fclose(file) == 0 && ok;
+        }
+
+    private:
+        static void put(std::string &out, quint32 value){
+            char bytes[sizeof(value)];
+            qToLittleEndian(value, bytes);
+            out.append(bytes, sizeof(bytes));
+        }
+
+        quint32 intern(std::string_view word){
+            auto it = m_offsets.find(std::string(word));
+            if(it != m_offsets.end()){
+                return it->second;
+            }
+
+            quint32 offset = m_pool.size();
+            m_pool.append(word);
+            m_pool.push_back('\0');
+            m_offsets.emplace(word, offset);
+            return offset;
+        }
+
+        std::array<quint32, JSCBlob::Sections> m_count = {};
+        std::array<std::string, JSCBlob::Prefix + 1> m_entries;
+        std::string m_sorted;
+        std::string m_pool;
+        std::unordered_map<std::string, quint32> m_offsets;
+    };
+
+    /**
+     * @brief List positions of the first prefix group of each leading
+     * character, ordered by word; ties, if any, stay in list order.
+     */
+    std::vector<quint32> sortedPositions(){
+        std::array<bool, 256> seen = {};
+        std::vector<quint32> positions;
+
+        for(quint32 i = 0; i < JSC::prefixSize; i++){
+            auto &group = seen[static_cast<unsigned char>(JSC::prefix[i].str[0])];
+            if(group){
+                continue;
+            }
+            group = true;
+
+            for(int j = 0; j < JSC::prefix[i].size; j++){
+                positions.push_back(JSC::prefix[i].index + j);
+            }
+        }
+
+        std::stable_sort(positions.begin(), positions.end(), [](quint32 a, quint32 b){
+            return std::string_view(JSC::list[a].str, JSC::list[a].size) <
+                   std::string_view(JSC::list[b].str, JSC::list[b].size);
+        });
+
+        return positions;
+    }
+}
+
+int main(int argc, char **argv){
+    if(argc != 2){
+        std::fprintf(stderr, "usage: %s <output>\n", argv[0]);
+        return 1;
+    }
+
+    Packer packer;
+    packer.add(JSCBlob::Map, JSC::map, JSC::size);
+    packer.add(JSCBlob::List, JSC::list, JSC::size);
+    packer.add(JSCBlob::Prefix, JSC::prefix, JSC::prefixSize);
+    packer.sorted(sortedPositions());
+
+    if(!packer.write(argv[1])){
+        std::perror(argv[1]);
+        return 1;
+    }
+
+    return 0;
+}
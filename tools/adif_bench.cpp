@@ -0,0 +1,134 @@
+// Load-time and correctness check of the ADIF reader.
+// This is a standalone command-line tool that writes a synthetic ADIF log
+// of 500,000 QSOs, loads it as the logbook does at startup, reports the
+// time taken, and checks what was loaded: the QSO count, worked-before by
+// callsign and by band, and the details found for a callsign.
+//
+// The log mixes tag case, carries typed fields (<CALL:6:S>), values that
+// contain '<', QSOs without a band, a header, and a final record without
+// an <EOR>, all of which the reader must take in its stride.
+//
+// Build example (adjust Qt include/library paths as needed):
+//   g++ -std=c++20 -O2 -I. -fPIC tools/adif_bench.cpp JS8_Logbook/adif.cpp \
+//       JS8_Main/Intern.cpp JS8_Main/fileutils.cpp -lQt6Gui -lQt6Core
+//
+// Usage: adif_bench [qsos]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QString>
+#include <QTemporaryDir>
+
+#include "JS8_Logbook/adif.h"
+
+namespace
+{
+    char const * const bands[] = {"160m", "80m", "40m", "30m", "20m", "17m", "15m", "10m"};
+
+    QString call(int const n)
+    {
+        return QString("W%1XY").arg(n);
+    }
+
+    QByteArray field(QByteArray const & name, QString const & value)
+    {
+        auto const v = value.toUtf8();
+        return "<" + name + ":" + QByteArray::number(v.size()) + ">" + v + " ";
+    }
+
+    // QSO n is with call n % calls, on band n % 8; every 100th has no band,
+    // and every 7th is written with lower-case tags. The number of calls is
+    // chosen so that a call's QSOs fall on different bands.
+
+    bool write(QString const & path,
+               int     const   qsos,
+               int     const   calls)
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly)) return false;
+
+        file.write("Synthetic ADIF log\n<ADIF_VER:5>3.1.0 <PROGRAMID:9>adif_bench <EOH>\n");
+
+        for (int n = 0; n < qsos; ++n)
+        {
+            auto const tag = [n](char const * name)
+            {
+                return n % 7 ? QByteArray(name) : QByteArray(name).toLower();
+            };
+
+            QByteArray record;
+            record += "<" + tag("CALL") + ":" + QByteArray::number(call(n % calls).size()) + ":S>" + call(n % calls).toUtf8() + " ";
+            if (n % 100) record += field(tag("BAND"), bands[n % 8]);
+            record += field(tag("MODE"), "MFSK");
+            record += field(tag("SUBMODE"), "JS8");
+            record += field(tag("GRIDSQUARE"), "FN42");
+            record += field(tag("QSO_DATE"), QString("202406%1").arg(1 + n % 28, 2, 10, QChar('0')));
+            record += field(tag("NAME"), QString("OP %1").arg(n));
+            record += field(tag("COMMENT"), "<tnx> for the QSO");
+
+            file.write(record);
+            if (n + 1 < qsos) file.write(n % 7 ? "<EOR>\n" : "<eor>\n");
+        }
+
+        return true;
+    }
+
+    int failures = 0;
+
+    void check(bool const ok, char const * what)
+    {
+        if (!ok) ++failures;
+        std::cout << (ok ? "  ok   " : "  FAIL ") << what << "\n";
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    int const qsos  = argc > 1 ? std::atoi(argv[1]) : 500000;
+    int const calls = qsos / 5 + 1;
+
+    QTemporaryDir dir;
+    auto const path = dir.filePath("js8call_log.adi");
+
+    std::cout << "Writing " << qsos << " QSOs...\n";
+    if (qsos < 1000 || !write(path, qsos, calls))
+    {
+        std::cerr << "adif_bench: need at least 1000 QSOs, and a writable temporary directory\n";
+        return 1;
+    }
+
+    ADIF adif;
+    adif.init(path);
+
+    auto const start = std::chrono::steady_clock::now();
+    adif.load();
+    auto const ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Loaded in " << ms << " ms\n";
+
+    auto const last = qsos - 1;
+    ADIF::QSO details;
+
+    check(adif.getCount() == qsos, "every QSO loaded, the last without <EOR> too");
+    check(adif.getCallList().size() == calls, "each callsign listed once");
+    check(adif.match(call(1), ""), "worked before, on any band");
+    check(adif.match(call(1), bands[1]), "worked before, on the band");
+    check(adif.match(call(1), "80M"), "bands compare without regard to case");
+    check(!adif.match(call(calls), ""), "never worked");
+    check(adif.match(call(100 % calls), "6m"), "QSO without a band matches any band");
+    check(adif.match(call(7 % calls), bands[7]), "lower-case tags");
+    check(adif.details(call(last % calls), details) &&
+          details.name == QString("OP %1").arg(last) &&
+          details.comment == "<tnx> for the QSO",
+          "details are the most recent, values may contain '<'");
+    check(adif.find(call(1)).size() == (qsos - 2) / calls + 1,
+          "every QSO found for the callsign");
+
+    return failures ? 1 : 0;
+}
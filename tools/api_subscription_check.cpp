@@ -0,0 +1,388 @@
+// Check of the TCP API's subscriptions and framings.
+// This is a standalone command-line tool that starts a MessageServer on the
+// loopback interface and connects clients that subscribe, in JSON and in
+// CBOR, with filters by type, by type prefix, and by callsign, and one that
+// subscribes more widely and then unsubscribes back down. It then sends a
+// fixed sequence of events that each filter should let through, or not:
+// events of other types, directed messages to and from other stations, a
+// callsign in lower case, and events that carry no callsign at all. Each
+// event is numbered, so that what arrives can be told apart. It checks:
+//
+//   - that each subscription is acknowledged, with the filters and format
+//     that are now in effect, in the format asked for;
+//   - that each client receives the events its filters let through, in
+//     order, and no others, as the API's rules have it: a type matches,
+//     or begins with a prefix ending in '.', and FROM, TO, or CALL is one
+//     of the callsigns, or the event carries none of those;
+//   - that every JSON line is a single message object;
+//   - that every CBOR frame is a 4-byte big-endian length, followed by
+//     exactly that many bytes, which are a single CBOR map, and that the
+//     stream ends on a frame boundary.
+//
+// Build example (adjust Qt include/library paths as needed):
+//   moc JS8_Main/MessageServer.h -o moc_MessageServer.cpp
+//   g++ -std=c++20 -O2 -I. -fPIC tools/api_subscription_check.cpp \
+//       JS8_Main/MessageServer.cpp moc_MessageServer.cpp JS8_Main/Message.cpp \
+//       JS8_Main/MessageError.cpp JS8_Main/DriftingDateTime.cpp \
+//       -lQt6Network -lQt6Core
+//
+// Usage: api_subscription_check [events] [port]
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <QCborMap>
+#include <QCborStreamReader>
+#include <QCborValue>
+#include <QCoreApplication>
+#include <QJsonDocument>
+#include <QTcpSocket>
+#include <QtEndian>
+
+#include "JS8_Main/MessageServer.h"
+
+namespace
+{
+    using Clock  = std::chrono::steady_clock;
+    using Filter = std::function<bool(Message const &)>;
+
+    // Runs the event loop until the condition holds, or the timeout passes;
+    // returns whether the condition held.
+
+    template <typename F>
+    bool waitFor(F                 && condition,
+                 std::chrono::seconds const timeout)
+    {
+        auto const until = Clock::now() + timeout;
+        while (!condition())
+        {
+            if (Clock::now() > until) return false;
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        }
+        return true;
+    }
+
+    // The events, in turn; numbered by N. Events are sent with an _ID of
+    // -1, as MainWindow sends them.
+
+    Message event(int const n)
+    {
+        auto params = QVariantMap{{"_ID", -1}, {"N", n}};
+
+        switch (n % 8)
+        {
+        case 0:
+            return Message("RX.ACTIVITY", "W1AW: K1ABC SNR -12 ♢", params);
+        case 1:
+            params.insert("FROM", "W1AW");
+            params.insert("TO", "K1ABC");
+            return Message("RX.DIRECTED", "W1AW: K1ABC SNR -12 ♢", params);
+        case 2:
+            params.insert("FROM", "K1ABC");
+            params.insert("TO", "W9XYZ");
+            return Message("RX.DIRECTED", "K1ABC: W9XYZ ACK ♢", params);
+        case 3:
+            params.insert("FROM", "W1AW");
+            params.insert("TO", "W9XYZ");
+            return Message("RX.DIRECTED", "W1AW: W9XYZ HEARING? ♢", params);
+        case 4:
+            params.insert("FROM", "w1aw");
+            params.insert("TO", "k1abc");
+            return Message("RX.DIRECTED", "W1AW: K1ABC 73 ♢", params);
+        case 5:
+            params.insert("CALL", "K1ABC");
+            params.insert("GRID", "FN42");
+            return Message("RX.SPOT", "", params);
+        case 6:
+            params.insert("CALL", "W9XYZ");
+            params.insert("GRID", "EN52");
+            return Message("RX.SPOT", "", params);
+        default:
+            return Message("STATION.STATUS", "", params);
+        }
+    }
+
+    // The filters, as the API documents them, written out here rather than
+    // taken from the server.
+
+    bool typeIs(Message const & m, QStringList const & types)
+    {
+        for (auto const & type : types)
+        {
+            if (m.type() == type) return true;
+            if (type.endsWith('.') && m.type().startsWith(type)) return true;
+        }
+        return false;
+    }
+
+    bool callIs(Message const & m, QStringList const & calls)
+    {
+        auto const params  = m.params();
+        bool       hasCall = false;
+        for (auto const key : {"FROM", "TO", "CALL"})
+        {
+            if (!params.contains(key)) continue;
+            if (calls.contains(params.value(key).toString().toUpper())) return true;
+            hasCall = true;
+        }
+        return !hasCall;
+    }
+
+    // A subscribing client; takes its frames apart, strictly, as they
+    // arrive.
+
+    struct Subscriber
+    {
+        char const *              name;
+        bool                      cbor;
+        std::vector<Message>      requests;
+        QVariantMap               acknowledged;
+        Filter                    wanted;
+
+        QTcpSocket                socket;
+        QByteArray                buffer;
+        std::vector<Message>      received;
+        bool                      framed = true;
+
+        void read()
+        {
+            buffer.append(socket.readAll());
+            qsizetype at = 0;
+
+            if (!cbor)
+            {
+                for (qsizetype end; (end = buffer.indexOf('\n', at)) >= 0; at = end + 1)
+                {
+                    QJsonParseError error;
+                    auto const document = QJsonDocument::fromJson(buffer.mid(at, end - at), &error);
+                    if (error.error != QJsonParseError::NoError || !document.isObject())
+                    {
+                        framed = false;
+                        continue;
+                    }
+                    received.push_back(Message::fromJson(document.object()));
+                }
+                buffer.remove(0, at);
+                return;
+            }
+
+            while (buffer.size() - at >= 4)
+            {
+                auto const size = qFromBigEndian<quint32>(buffer.constData() + at);
+                if (buffer.size() - at - 4 < qsizetype(size)) break;
+
+                auto const        payload = buffer.mid(at + 4, size);
+                QCborStreamReader reader(payload);
+                auto const        value   = QCborValue::fromCbor(reader);
+                if (reader.lastError() != QCborError::NoError ||
+                    reader.currentOffset() != payload.size()  ||
+                    !value.isMap())
+                {
+                    framed = false;
+                }
+                else
+                {
+                    received.push_back(Message::fromJson(value.toMap().toJsonObject()));
+                }
+                at += 4 + size;
+            }
+            buffer.remove(0, at);
+        }
+
+        // The events received, as their numbers, once the acknowledgements
+        // have been taken off the front.
+
+        std::vector<int> events() const
+        {
+            std::vector<int> numbers;
+            for (auto const & m : received)
+            {
+                if (m.type() != "API.SUBSCRIPTION") numbers.push_back(m.params().value("N").toInt());
+            }
+            return numbers;
+        }
+    };
+
+    int failures = 0;
+
+    void check(bool const ok, std::string const & what)
+    {
+        if (!ok) ++failures;
+        std::cout << (ok ? "  ok   " : "  FAIL ") << what << "\n";
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    int     const events = argc > 1 ? std::atoi(argv[1]) : 4000;
+    quint16 const port   = argc > 2 ? std::atoi(argv[2]) : 24421;
+
+    MessageServer server;
+    server.setServer("127.0.0.1", port);
+    if (!server.start())
+    {
+        std::cerr << "api_subscription_check: can't listen on port " << port << "\n";
+        return 1;
+    }
+
+    auto const subscribe = [](QVariantMap const & params)
+    {
+        return Message("API.SUBSCRIBE", "", params);
+    };
+
+    QStringList const directed = {"RX.DIRECTED"};
+    QStringList const k1abc    = {"K1ABC"};
+
+    std::vector<std::unique_ptr<Subscriber>> subscribers;
+
+    auto const add = [&](char const * name, bool const cbor, std::vector<Message> requests,
+                         QVariantMap acknowledged, Filter wanted)
+    {
+        auto & s = subscribers.emplace_back(std::make_unique<Subscriber>());
+        s->name         = name;
+        s->cbor         = cbor;
+        s->requests     = std::move(requests);
+        s->acknowledged = std::move(acknowledged);
+        s->wanted       = std::move(wanted);
+    };
+
+    add("JSON, RX.DIRECTED for K1ABC", false,
+        {subscribe({{"TYPES", directed}, {"CALLS", k1abc}})},
+        {{"TYPES", directed}, {"CALLS", k1abc}, {"FORMAT", "JSON"}},
+        [&](Message const & m) { return typeIs(m, directed) && callIs(m, k1abc); });
+
+    add("CBOR, RX.DIRECTED for K1ABC", true,
+        {subscribe({{"TYPES", directed}, {"CALLS", k1abc}, {"FORMAT", "CBOR"}})},
+        {{"TYPES", directed}, {"CALLS", k1abc}, {"FORMAT", "CBOR"}},
+        [&](Message const & m) { return typeIs(m, directed) && callIs(m, k1abc); });
+
+    add("CBOR, RX. for any call", true,
+        {subscribe({{"TYPES", QStringList{"rx."}}, {"FORMAT", "cbor"}})},
+        {{"TYPES", QStringList{"RX."}}, {"CALLS", QStringList{}}, {"FORMAT", "CBOR"}},
+        [](Message const & m) { return typeIs(m, {"RX."}); });
+
+    add("JSON, K1ABC of any type", false,
+        {subscribe({{"CALLS", k1abc}})},
+        {{"TYPES", QStringList{}}, {"CALLS", k1abc}, {"FORMAT", "JSON"}},
+        [&](Message const & m) { return callIs(m, k1abc); });
+
+    add("CBOR, widened, then narrowed", true,
+        {subscribe({{"TYPES", QStringList{"RX.DIRECTED", "STATION."}},
+                     {"CALLS", QStringList{"K1ABC", "W9XYZ"}},
+                     {"FORMAT", "CBOR"}}),
+         Message("API.UNSUBSCRIBE", "", {{"TYPES", QStringList{"STATION."}},
+                                         {"CALLS", QStringList{"W9XYZ"}}})},
+        {{"TYPES", directed}, {"CALLS", k1abc}, {"FORMAT", "CBOR"}},
+        [&](Message const & m) { return typeIs(m, directed) && callIs(m, k1abc); });
+
+    add("JSON, unsubscribed from all", false,
+        {subscribe({{"TYPES", directed}, {"CALLS", k1abc}}),
+         Message("API.UNSUBSCRIBE", "", QVariantMap{})},
+        {{"TYPES", QStringList{}}, {"CALLS", QStringList{}}, {"FORMAT", "JSON"}},
+        [](Message const &) { return true; });
+
+    for (auto const & s : subscribers)
+    {
+        QObject::connect(&s->socket, &QTcpSocket::readyRead, [p = s.get()]() { p->read(); });
+        s->socket.connectToHost("127.0.0.1", port);
+    }
+
+    auto const connected = [&]()
+    {
+        for (auto const & s : subscribers)
+        {
+            if (s->socket.state() != QAbstractSocket::ConnectedState) return false;
+        }
+        return true;
+    };
+
+    if (!waitFor(connected, std::chrono::seconds(10)))
+    {
+        std::cerr << "api_subscription_check: clients failed to connect\n";
+        return 1;
+    }
+
+    // Requests are lines of JSON, whatever the format of the replies.
+
+    for (auto const & s : subscribers)
+    {
+        for (auto const & request : s->requests) s->socket.write(request.toJson() + "\n");
+    }
+
+    auto const acknowledged = [&]()
+    {
+        for (auto const & s : subscribers)
+        {
+            if (s->received.size() < s->requests.size()) return false;
+        }
+        return true;
+    };
+
+    if (!waitFor(acknowledged, std::chrono::seconds(10)))
+    {
+        std::cerr << "api_subscription_check: subscriptions weren't acknowledged\n";
+        return 1;
+    }
+
+    std::vector<Message> sent;
+    for (int n = 0; n < events; ++n) sent.push_back(event(n));
+    for (auto const & m : sent) server.send(m);
+
+    // Wait for each to have had what it wants, and then a while longer, so
+    // that anything it shouldn't have had has a chance to arrive too.
+
+    std::vector<std::vector<int>> expected;
+    for (auto const & s : subscribers)
+    {
+        auto & numbers = expected.emplace_back();
+        for (int n = 0; n < events; ++n)
+        {
+            if (s->wanted(sent[n])) numbers.push_back(n);
+        }
+    }
+
+    waitFor([&]()
+    {
+        for (std::size_t i = 0; i < subscribers.size(); ++i)
+        {
+            if (subscribers[i]->events().size() < expected[i].size()) return false;
+        }
+        return true;
+    }, std::chrono::seconds(30));
+    waitFor([]() { return false; }, std::chrono::seconds(1));
+
+    std::cout << "Sent " << events << " events to " << subscribers.size() << " clients\n";
+
+    for (std::size_t i = 0; i < subscribers.size(); ++i)
+    {
+        auto const & s = *subscribers[i];
+
+        auto const & ack = s.received.size() >= s.requests.size()
+                         ? s.received[s.requests.size() - 1]
+                         : Message();
+        bool matches = ack.type() == "API.SUBSCRIPTION";
+        for (auto const & [key, value] : s.acknowledged.asKeyValueRange())
+        {
+            matches = matches && ack.params().value(key).toStringList() == value.toStringList();
+        }
+
+        auto const got = s.events();
+
+        std::cout << s.name << ": " << got.size() << " of " << events << " events\n";
+        check(matches, "acknowledged with the filters and format in effect");
+        check(got == expected[i], "received just the events its filters let through, in order");
+        check(s.framed && s.buffer.isEmpty(),
+              s.cbor ? "every frame a big-endian length and a single CBOR map"
+                     : "every line a single JSON message");
+    }
+
+    server.stop();
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,203 @@
+// Fuzz of BitBuffer against the QVector<bool> semantics it replaced.
+// This is a standalone command-line tool that builds random buffers of up
+// to the full capacity, from random runs of single bits and fields of up
+// to 64 bits, and builds the same bits in a vector of bools, in the way
+// the frame packers previously did. For each buffer, it checks:
+//
+//   - that the bits are the same, bit for bit, after every append;
+//   - field() at random positions and widths, against the bits read one
+//     at a time, most significant first;
+//   - mid() at random positions and lengths, including the negative and
+//     overlong lengths, that QVector::mid() takes as "the rest", and the
+//     unpackers rely on;
+//   - that a buffer split by mid() and joined by append() is unchanged;
+//   - lastIndexOf() for both values, including on empty buffers;
+//   - JS8 compression codewords appended in order, as JSC::codeword()
+//     now builds them, against the same codewords built by prepending
+//     each continuation byte, as it previously did.
+//
+// Build with assertions enabled, so that any append past capacity fails.
+//
+// Build example (adjust Qt include paths as needed; only QtGlobal is used):
+//   g++ -std=c++20 -O2 -I. -I/usr/include/qt6 -I/usr/include/qt6/QtCore \
+//       tools/bitbuffer_fuzz.cpp
+//
+// Usage: bitbuffer_fuzz [buffers]
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "JS8_Main/BitBuffer.h"
+
+namespace
+{
+    using Bits = std::vector<bool>;
+
+    // The previous helpers, on vectors of bools.
+
+    Bits intToBits(quint64 value, int const width)
+    {
+        Bits bits;
+        for (int i = width - 1; i >= 0; --i) bits.push_back((value >> i) & 1);
+        return bits;
+    }
+
+    quint64 bitsToInt(Bits const & bits, int const pos, int const width)
+    {
+        quint64 value = 0;
+        for (int i = 0; i < width; ++i) value = (value << 1) | bits[pos + i];
+        return value;
+    }
+
+    Bits mid(Bits const & bits, int const pos, int len)
+    {
+        int const size = bits.size();
+        if (len < 0 || len > size - pos) len = size - pos;
+        return Bits(bits.begin() + pos, bits.begin() + pos + len);
+    }
+
+    int lastIndexOf(Bits const & bits, bool const value)
+    {
+        for (int i = int(bits.size()) - 1; i >= 0; --i)
+        {
+            if (bits[i] == value) return i;
+        }
+        return -1;
+    }
+
+    bool same(BitBuffer const & buffer, Bits const & bits)
+    {
+        if (buffer.size() != int(bits.size())) return false;
+        for (int i = 0; i < buffer.size(); ++i)
+        {
+            if (buffer.at(i) != bits[i]) return false;
+        }
+        return true;
+    }
+
+    // Codewords of the compression dictionary, with the parameters the
+    // compressor uses, built each way.
+
+    constexpr quint32 BYTESIZE = 4;
+    constexpr quint32 S        = 7;
+    constexpr quint32 C        = 9;
+
+    Bits prependedCodeword(quint32 const index, bool const separate)
+    {
+        auto word = intToBits(((index % S) << 1) + separate, BYTESIZE + 1);
+        for (quint32 x = index / S; x > 0; x /= C)
+        {
+            x -= 1;
+            auto const byte = intToBits((x % C) + S, BYTESIZE);
+            word.insert(word.begin(), byte.begin(), byte.end());
+        }
+        return word;
+    }
+
+    BitBuffer appendedCodeword(quint32 const index, bool const separate)
+    {
+        quint32 bytes[32];
+        int     count = 0;
+        for (quint32 x = index / S; x > 0; x /= C)
+        {
+            x -= 1;
+            bytes[count++] = (x % C) + S;
+        }
+
+        BitBuffer word;
+        while (count > 0) word.append(bytes[--count], BYTESIZE);
+        word.append(((index % S) << 1) + separate, BYTESIZE + 1);
+        return word;
+    }
+
+    int failures = 0;
+
+    void check(bool const ok, char const * what)
+    {
+        if (!ok) ++failures;
+        std::cout << (ok ? "  ok   " : "  FAIL ") << what << "\n";
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    int const buffers = argc > 1 ? std::atoi(argv[1]) : 300000;
+
+    std::mt19937_64                    rng(32);
+    std::uniform_int_distribution<int> size(0, BitBuffer::Capacity);
+    std::uniform_int_distribution<int> width(0, 64);
+    std::uniform_int_distribution<int> length(-10, BitBuffer::Capacity + 10);
+    std::uniform_int_distribution<int> third(0, 2);
+
+    bool appends  = true;
+    bool fields   = true;
+    bool mids     = true;
+    bool joins    = true;
+    bool lasts    = true;
+    bool words    = true;
+    long checks   = 0;
+
+    for (int n = 0; n < buffers; ++n)
+    {
+        BitBuffer buffer;
+        Bits      bits;
+
+        for (auto const target = size(rng); int(bits.size()) < target;)
+        {
+            if (third(rng) == 0)
+            {
+                bool const bit = rng() & 1;
+                buffer.append(bit);
+                bits.push_back(bit);
+            }
+            else
+            {
+                auto const w     = std::min(width(rng), target - int(bits.size()));
+                auto const value = rng();
+                buffer.append(value, w);
+                auto const field = intToBits(value, w);
+                bits.insert(bits.end(), field.begin(), field.end());
+            }
+
+            if (!same(buffer, bits)) appends = false;
+        }
+
+        if (buffer.lastIndexOf(false) != lastIndexOf(bits, false) ||
+            buffer.lastIndexOf(true)  != lastIndexOf(bits, true)) lasts = false;
+
+        for (int i = 0; i < 4 && !bits.empty(); ++i)
+        {
+            int const pos = rng() % (bits.size() + 1);
+            int const w   = std::min(width(rng), int(bits.size()) - pos);
+            int const len = length(rng);
+
+            if (buffer.field(pos, w) != bitsToInt(bits, pos, w)) fields = false;
+            if (!same(buffer.mid(pos, len), mid(bits, pos, len))) mids = false;
+
+            auto joined = buffer.mid(0, pos);
+            joined.append(buffer.mid(pos));
+            if (!(joined == buffer)) joins = false;
+
+            ++checks;
+        }
+
+        quint32 const index    = rng() % 262144;
+        bool const    separate = rng() & 1;
+        if (!same(appendedCodeword(index, separate), prependedCodeword(index, separate))) words = false;
+    }
+
+    std::cout << "Built " << buffers << " buffers, " << checks
+              << " field, mid and join checks\n";
+
+    check(appends, "appends as a vector of bools");
+    check(fields,  "fields read as bits, most significant first");
+    check(mids,    "mid() as QVector::mid(), negative and overlong lengths included");
+    check(joins,   "split and joined, unchanged");
+    check(lasts,   "lastIndexOf() as on a vector of bools");
+    check(words,   "codewords appended in order match those prepended");
+
+    return failures ? 1 : 0;
+}
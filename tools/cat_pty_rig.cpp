@@ -0,0 +1,432 @@
+// Check of CAT request scheduling, against a slow rig on a pseudo-terminal.
+// This is a standalone command-line tool that emulates enough of a Kenwood
+// TS-2000's CAT protocol, on a pseudo-terminal, for Hamlib's backend to open
+// and poll it, taking the latency given to act on each command, as a slow
+// serial rig does. It drives a HamlibTransceiver against it, on a thread of
+// its own, as the configuration does, and drags the dial: 40 frequency
+// changes, 25 ms apart, then PTT on, as if a transmission were due. It does
+// so twice: first with each request queued to the transceiver's thread, as
+// earlier versions did, then by way of the CATScheduler, which coalesces
+// requests the rig has yet to act on.
+//
+// It then keys up while the rig is polled, at times part way through a
+// frequency read, which the rig takes longer over, by the read latency
+// given, as some do; again twice, queued and scheduled. Queued, PTT on
+// waits for the rest of the poll, each read of it; scheduled, the poll
+// gives way, and PTT on waits only for the read in progress.
+//
+// It reports, for each, the QSYs the rig saw, and the time from the PTT
+// request to the rig being keyed, after the drag, and during a read, and
+// checks that scheduling cut them all, and that the rig ended up on the
+// last frequency requested. The scheduler's per-request timings are
+// logged, to the catscheduler.js8 category.
+//
+// POSIX only.
+//
+// Build example (adjust Qt and Hamlib include/library paths as needed):
+//   for h in Transceiver TransceiverBase PollingTransceiver HamlibTransceiver; do
+//       moc JS8_Transceiver/$h.h -o moc_$h.cpp; done
+//   g++ -std=c++20 -O2 -I. -IJS8_Transceiver -fPIC tools/cat_pty_rig.cpp \
+//       JS8_Transceiver/CATScheduler.cpp JS8_Transceiver/Transceiver.cpp \
+//       JS8_Transceiver/TransceiverBase.cpp \
+//       JS8_Transceiver/PollingTransceiver.cpp \
+//       JS8_Transceiver/HamlibTransceiver.cpp JS8_Main/Radio.cpp \
+//       JS8_Main/qt_helpers.cpp -lhamlib -lQt6Core -lutil -lpthread
+//
+// Usage: cat_pty_rig [latency, ms] [frequency read latency, ms]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <poll.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <QCoreApplication>
+#include <QLoggingCategory>
+#include <QThread>
+
+#include "JS8_Transceiver/CATScheduler.h"
+#include "JS8_Transceiver/HamlibTransceiver.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int TS2000 = 2014; // Hamlib model number
+
+    // The rig, at the master end of the pseudo-terminal. Commands are
+    // terminated by ';', and those of two letters alone are queries.
+
+    struct Rig
+    {
+        int                       fd;
+        std::chrono::milliseconds latency;
+        std::chrono::milliseconds readLatency;
+        std::atomic<bool>         running{true};
+        std::atomic<bool>         reading{false};
+
+        std::mutex                mutex;
+        unsigned long long        frequency = 14078000;
+        bool                      tx        = false;
+        Clock::time_point         keyed;
+
+        std::atomic<int>          commands{0};
+        std::atomic<int>          qsys{0};
+
+        std::string answer(std::string const & cmd)
+        {
+            std::lock_guard lock(mutex);
+            auto const name  = cmd.substr(0, 2);
+            auto const query = cmd.size() == 2;
+            char       reply[64];
+
+            if (name == "ID") return "ID019;";
+            if (name == "PS") return query ? "PS1;" : "";
+            if (name == "AI") return query ? "AI0;" : "";
+            if (name == "FV") return "FV1.00;";
+            if (name == "FR" || name == "FT") return query ? name + "0;" : "";
+            if (name == "MD") return query ? "MD2;" : "";
+
+            if (name == "FA" || name == "FB")
+            {
+                if (query)
+                {
+                    std::snprintf(reply, sizeof reply, "%s%011llu;", name.c_str(), frequency);
+                    return reply;
+                }
+                if (name == "FA")
+                {
+                    frequency = std::stoull(cmd.substr(2));
+                    ++qsys;
+                }
+                return "";
+            }
+
+            if (name == "IF")
+            {
+                // frequency, step, RIT/XIT offset, RIT, XIT, bank, channel,
+                // TX, mode, VFO, scan, split, tone, tone number, shift
+                std::snprintf(reply, sizeof reply, "IF%011llu     +00000000000%c20000000;",
+                              frequency, tx ? '1' : '0');
+                return reply;
+            }
+
+            if (name == "TX")
+            {
+                if (!tx) keyed = Clock::now();
+                tx = true;
+                return "";
+            }
+            if (name == "RX")
+            {
+                tx = false;
+                return "";
+            }
+
+            return query ? "?;" : "";
+        }
+
+        void run()
+        {
+            std::string buffer;
+            char        chunk[256];
+
+            while (running)
+            {
+                pollfd p{fd, POLLIN, 0};
+                if (::poll(&p, 1, 50) <= 0) continue;
+
+                auto const n = ::read(fd, chunk, sizeof chunk);
+                if (n <= 0) continue;
+                buffer.append(chunk, n);
+
+                for (std::size_t at; (at = buffer.find(';')) != std::string::npos;)
+                {
+                    auto const cmd = buffer.substr(0, at);
+                    buffer.erase(0, at + 1);
+                    ++commands;
+
+                    // reads of the frequency are the slow ones
+                    bool const read = cmd == "FA" || cmd == "FB" || cmd == "IF";
+                    reading = read;
+
+                    std::this_thread::sleep_for(read ? latency + readLatency : latency);
+                    auto const reply = answer(cmd);
+                    if (!reply.empty()) ::write(fd, reply.data(), reply.size());
+                    reading = false;
+                }
+            }
+        }
+
+        bool transmitting()
+        {
+            std::lock_guard lock(mutex);
+            return tx;
+        }
+    };
+
+    // Runs the event loop until the condition holds, or the timeout passes;
+    // returns whether the condition held.
+
+    template <typename F>
+    bool waitFor(F                 && condition,
+                 std::chrono::seconds const timeout)
+    {
+        auto const until = Clock::now() + timeout;
+        while (!condition())
+        {
+            if (Clock::now() > until) return false;
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        }
+        return true;
+    }
+
+    struct Result
+    {
+        int    qsys;
+        double ptt; // ms
+        bool   keyed;
+        bool   tuned;
+    };
+
+    // Drags the dial, then keys up, making each request by the function
+    // given; then unkeys, and lets the rig settle.
+
+    template <typename Set>
+    Result drag(Rig & rig, Set && set, unsigned & sequence)
+    {
+        Transceiver::TransceiverState state;
+        state.online(true);
+
+        rig.qsys = 0;
+        auto last = Radio::Frequency{};
+
+        for (int n = 1; n <= 40; ++n)
+        {
+            last = 7078000 + n * 100;
+            state.frequency(last);
+            set(state, ++sequence);
+            QCoreApplication::processEvents();
+            QThread::msleep(25);
+        }
+
+        state.ptt(true);
+        auto const requested = Clock::now();
+        set(state, ++sequence);
+
+        Result result{};
+        result.keyed = waitFor([&]() { return rig.transmitting(); }, std::chrono::seconds(60));
+        {
+            std::lock_guard lock(rig.mutex);
+            result.ptt   = std::chrono::duration<double, std::milli>(rig.keyed - requested).count();
+            result.tuned = rig.frequency == last;
+        }
+        result.qsys = rig.qsys;
+
+        state.ptt(false);
+        set(state, ++sequence);
+        waitFor([&]() { return !rig.transmitting(); }, std::chrono::seconds(60));
+        QThread::msleep(2000);
+
+        return result;
+    }
+
+    struct Keying
+    {
+        double mean  = 0; // ms
+        double worst = 0; // ms
+        bool   keyed = true;
+    };
+
+    // Keys up, and down again, making each request by the function given,
+    // a number of times, each part way through a frequency read of a poll.
+
+    template <typename Set>
+    Keying keyDuringRead(Rig & rig, Set && set, unsigned & sequence)
+    {
+        Transceiver::TransceiverState state;
+        state.online(true);
+        {
+            std::lock_guard lock(rig.mutex);
+            state.frequency(rig.frequency);
+        }
+
+        Keying    result;
+        int const times = 8;
+
+        for (int n = 0; n < times; ++n)
+        {
+            if (!waitFor([&]() { return rig.reading.load(); }, std::chrono::seconds(10)))
+            {
+                result.keyed = false;
+                break;
+            }
+            QThread::msleep(rig.readLatency.count() * (n % 4) / 5);
+
+            state.ptt(true);
+            auto const requested = Clock::now();
+            set(state, ++sequence);
+            if (!waitFor([&]() { return rig.transmitting(); }, std::chrono::seconds(60)))
+            {
+                result.keyed = false;
+                break;
+            }
+
+            double latency;
+            {
+                std::lock_guard lock(rig.mutex);
+                latency = std::chrono::duration<double, std::milli>(rig.keyed - requested).count();
+            }
+            result.mean  += latency / times;
+            result.worst  = std::max(result.worst, latency);
+
+            state.ptt(false);
+            set(state, ++sequence);
+            waitFor([&]() { return !rig.transmitting(); }, std::chrono::seconds(60));
+            QThread::msleep(1500);
+        }
+        return result;
+    }
+
+    int failures = 0;
+
+    void check(bool const ok, char const * what)
+    {
+        if (!ok) ++failures;
+        std::cout << (ok ? "  ok   " : "  FAIL ") << what << "\n";
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    QCoreApplication app(argc, argv);
+    QLoggingCategory::setFilterRules("catscheduler.js8.debug=true");
+    qRegisterMetaType<Transceiver::TransceiverState>("Transceiver::TransceiverState");
+
+    auto const latency     = std::chrono::milliseconds(argc > 1 ? std::atoi(argv[1]) : 100);
+    auto const readLatency = std::chrono::milliseconds(argc > 2 ? std::atoi(argv[2]) : 1000);
+
+    int  master = -1, slave = -1;
+    char name[256];
+    if (::openpty(&master, &slave, name, nullptr, nullptr) < 0)
+    {
+        std::perror("cat_pty_rig: openpty");
+        return 1;
+    }
+
+    termios tio;
+    ::tcgetattr(master, &tio);
+    ::cfmakeraw(&tio);
+    ::tcsetattr(master, TCSANOW, &tio);
+
+    Rig rig{master, latency, readLatency};
+    std::thread emulator([&]() { rig.run(); });
+
+    TransceiverFactory::ParameterPack params{};
+    params.serial_port   = name;
+    params.baud          = 9600;
+    params.data_bits     = TransceiverFactory::default_data_bits;
+    params.stop_bits     = TransceiverFactory::default_stop_bits;
+    params.handshake     = TransceiverFactory::handshake_none;
+    params.ptt_type      = TransceiverFactory::PTT_method_CAT;
+    params.poll_interval = 1;
+
+    QThread thread;
+    thread.start();
+
+    auto const transceiver = new HamlibTransceiver(TS2000, params);
+    transceiver->moveToThread(&thread);
+
+    bool    online = false;
+    QString failure;
+    QObject::connect(transceiver, &Transceiver::update, &app,
+                     [&](Transceiver::TransceiverState const & s, unsigned)
+                     {
+                         online = s.online();
+                     });
+    QObject::connect(transceiver, &Transceiver::failure, &app,
+                     [&](QString const & reason) { failure = reason; });
+
+    QMetaObject::invokeMethod(transceiver, [transceiver]() { transceiver->start(1); });
+
+    auto const cleanup = [&]()
+    {
+        QMetaObject::invokeMethod(transceiver, [transceiver]() { transceiver->stop(); });
+        QMetaObject::invokeMethod(transceiver, [transceiver]() { delete transceiver; });
+        thread.quit();
+        thread.wait();
+        rig.running = false;
+        emulator.join();
+        ::close(slave);
+        ::close(master);
+    };
+
+    if (!waitFor([&]() { return online || !failure.isEmpty(); }, std::chrono::seconds(30)) ||
+        !failure.isEmpty())
+    {
+        std::cerr << "cat_pty_rig: transceiver failed to start: "
+                  << failure.toStdString() << "\n";
+        cleanup();
+        return 1;
+    }
+
+    std::cout << "Rig on " << name << ", " << latency.count() << " ms a command, "
+              << (latency + readLatency).count() << " ms a frequency read\n";
+
+    unsigned sequence = 1;
+
+    auto const queue = [&](Transceiver::TransceiverState const & s, unsigned n)
+    {
+        QMetaObject::invokeMethod(transceiver, [transceiver, s, n]() { transceiver->set(s, n); },
+                                  Qt::QueuedConnection);
+    };
+
+    auto const queued     = drag(rig, queue, sequence);
+    auto const queuedRead = keyDuringRead(rig, queue, sequence);
+
+    std::cout << "Queued:    " << queued.qsys << " QSYs, keyed "
+              << queued.ptt << " ms after the PTT request; during a read, keyed "
+              << queuedRead.mean << " ms after on average, " << queuedRead.worst
+              << " ms at worst\n";
+
+    Result scheduled;
+    Keying scheduledRead;
+    {
+        CATScheduler scheduler(transceiver);
+        auto const schedule = [&](Transceiver::TransceiverState const & s, unsigned n)
+        {
+            scheduler.set(s, n);
+        };
+
+        scheduled     = drag(rig, schedule, sequence);
+        scheduledRead = keyDuringRead(rig, schedule, sequence);
+    }
+
+    std::cout << "Scheduled: " << scheduled.qsys << " QSYs, keyed "
+              << scheduled.ptt << " ms after the PTT request; during a read, keyed "
+              << scheduledRead.mean << " ms after on average, " << scheduledRead.worst
+              << " ms at worst\n";
+
+    check(queued.keyed && scheduled.keyed, "keyed both times");
+    check(queued.tuned && scheduled.tuned, "on the last frequency requested, both times");
+    check(scheduled.qsys < queued.qsys, "fewer QSYs scheduled");
+    check(scheduled.ptt < queued.ptt, "keyed sooner scheduled");
+    check(queuedRead.keyed && scheduledRead.keyed, "keyed during reads, both times");
+    check(scheduledRead.worst < queuedRead.worst, "keyed sooner during a read, scheduled");
+
+    // the read in progress, at worst, then a few commands ahead of PTT's
+    auto const bound = (latency + readLatency + 4 * latency).count();
+    check(scheduledRead.worst < bound, "waited on no more than the read in progress, scheduled");
+
+    cleanup();
+    return failures ? 1 : 0;
+}
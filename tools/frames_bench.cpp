@@ -0,0 +1,136 @@
+// Benchmark of Varicode::buildMessageFrames() on long messages.
+// This is a standalone command-line tool that builds the frames of long
+// messages, as the main window does when a message is typed or sent, a
+// number of times each, and reports the frames each takes, the time taken
+// to build them, and per frame, and a checksum of the frames built. The
+// messages are:
+//
+//   - free text of 500 characters, which is JSC compressed, and for the
+//     most part sent as data frames;
+//   - the same, directed to a selected call, so that the first frame is
+//     a directed frame, and the rest data;
+//   - a directed command with a long payload, from a compound call;
+//   - the free text again, forced to be sent as data;
+//   - sixty short directed messages and heartbeats, built one after the
+//     other, which take the compound and directed packers.
+//
+// The frame packers built the frames a bit at a time, in vectors of bools,
+// before 66081d5, which moved them onto BitBuffer. To compare, build this
+// same tool against a checkout of 66081d5^, whose JSC tables are compiled
+// into jsc.cpp, so leaving out the rcc step and qrc_jsc.cpp, and run both;
+// the checksums are the same if the frames are, and the times compare.
+//
+// Build example (adjust Qt include/library paths as needed; jsc.bin is
+// built by jsc_pack, as in the application's build tree):
+//   printf '<RCC><qresource prefix="/"><file>jsc.bin</file></qresource></RCC>' \
+//       > jsc.qrc
+//   rcc --no-compress jsc.qrc -o qrc_jsc.cpp
+//   moc JS8_Main/varicode.h -o moc_varicode.cpp
+//   g++ -std=c++20 -O2 -I. -IJS8_Main -fPIC tools/frames_bench.cpp \
+//       JS8_Main/varicode.cpp JS8_Main/Bands.cpp JS8_Main/Radio.cpp \
+//       JS8_Mode/DecodedText.cpp JS8_jsc/jsc.cpp moc_varicode.cpp \
+//       qrc_jsc.cpp -lQt6Core
+//
+// Usage: frames_bench [repetitions]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QString>
+#include <QStringList>
+
+#include "JS8_Main/varicode.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Message
+    {
+        char const * name;
+        QString      mycall;
+        QString      selectedCall;
+        QStringList  texts;
+        bool         forceData;
+    };
+
+    QString prose(int const length)
+    {
+        static QStringList const words = {
+            "THE", "BAND", "IS", "OPEN", "TO", "EUROPE", "THIS", "MORNING",
+            "AND", "SIGNALS", "ARE", "GOOD", "RUNNING", "50W", "INTO", "A",
+            "DIPOLE", "AT", "30FT", "WX", "HERE", "SUNNY", "TEMP", "18C",
+            "THANKS", "FOR", "THE", "REPORT", "HOPE", "TO", "HEAR", "YOU",
+            "AGAIN", "SOON", "73", "QSL", "VIA", "LOTW", "PSE", "QRZ?"};
+
+        QString text;
+        for (int n = 0; text.size() < length; ++n)
+        {
+            if (!text.isEmpty()) text += ' ';
+            text += words[(n * 7 + n / 3) % words.size()];
+        }
+        return text.left(length);
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    int const repetitions = argc > 1 ? std::atoi(argv[1]) : 200;
+
+    QString const text = prose(500);
+
+    QStringList queued;
+    for (int n = 0; n < 20; ++n)
+    {
+        queued << QString("W%1XYZ SNR -%2").arg(n).arg(n % 20 + 1)
+               << QString("@HB HEARTBEAT FN42")
+               << QString("W%1XYZ QUERY CALL VE3/W%1XYZ?").arg(n);
+    }
+
+    Message const messages[] = {
+        {"free text", "K1ABC", "", {text}, false},
+        {"directed text", "K1ABC", "W1XYZ", {text}, false},
+        {"compound command", "VE3/K1ABC", "", {"W1XYZ MSG " + text}, false},
+        {"forced data", "K1ABC", "", {text}, true},
+        {"short messages", "K1ABC", "", queued, false},
+    };
+
+    for (auto const & m : messages)
+    {
+        QList<QPair<QString, int>> frames;
+        Clock::duration            total{};
+
+        for (int r = 0; r < repetitions; ++r)
+        {
+            frames.clear();
+
+            auto const start = Clock::now();
+            for (auto const & text : m.texts)
+            {
+                frames += Varicode::buildMessageFrames(m.mycall, "FN42", m.selectedCall, text,
+                                                       false, m.forceData,
+                                                       Varicode::JS8CallNormal);
+            }
+            total += Clock::now() - start;
+        }
+
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        for (auto const & [frame, type] : frames)
+        {
+            hash.addData(frame.toUtf8());
+            hash.addData(QByteArray::number(type));
+        }
+
+        auto const us = std::chrono::duration<double, std::micro>(total).count() / repetitions;
+
+        std::cout << m.name << ": " << m.texts.join("").size() << " characters, "
+                  << frames.size() << " frames; " << us << " us a build, "
+                  << (frames.isEmpty() ? 0 : us / frames.size()) << " us a frame; "
+                  << hash.result().toHex().left(12).toStdString() << "\n";
+    }
+}
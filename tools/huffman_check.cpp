@@ -0,0 +1,250 @@
+// Check of the data frame Huffman code against the algorithms it replaced.
+// This is a standalone command-line tool that encodes random texts, into
+// frames with random prefixes and limits, and decodes random bit strings,
+// both well formed and not, through the table driven code in Huffman.h,
+// and again by the previous method: a map of codes as strings of '0' and
+// '1', matched a character at a time when encoding, and by prefix when
+// decoding. It checks that:
+//
+//   - encoding appends the same bits, and counts the same characters, for
+//     every text, prefix and limit, including characters without a code;
+//   - decoding gives the same text for every bit string, including those
+//     that end part way through a code;
+//   - every text of characters having a code decodes to itself.
+//
+// It reports the time taken per case by each method.
+//
+// Build example (adjust Qt include paths as needed; only QtGlobal is used):
+//   g++ -std=c++20 -O2 -I. -I/usr/include/qt6 -I/usr/include/qt6/QtCore \
+//       tools/huffman_check.cpp
+//
+// Usage: huffman_check [cases]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "JS8_Main/Huffman.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    using Table = std::map<std::u16string, std::string>;
+
+    Table previousTable()
+    {
+        Table table;
+        for (auto const & [ch, code] : Huffman::CODES)
+        {
+            table[std::u16string(1, ch)] = std::string(code);
+        }
+        return table;
+    }
+
+    // The previous encoder; keys longest first, then in descending order,
+    // matched at each position in turn, skipping characters that match
+    // none, and the frame packer's loop that appended codes while they
+    // fit below the limit.
+
+    int previousEncode(Table const         & table,
+                       std::u16string const & text,
+                       std::string          & bits,
+                       int const              limit)
+    {
+        std::vector<std::u16string> keys;
+        for (auto const & entry : table) keys.push_back(entry.first);
+        std::sort(keys.begin(), keys.end(), [](auto const & a, auto const & b)
+        {
+            if (b.size() < a.size()) return true;
+            if (a.size() < b.size()) return false;
+            return b < a;
+        });
+
+        std::vector<std::pair<int, std::string>> codes;
+        for (std::size_t i = 0; i < text.size();)
+        {
+            bool found = false;
+            for (auto const & key : keys)
+            {
+                if (text.compare(i, key.size(), key) == 0)
+                {
+                    codes.push_back({int(key.size()), table.at(key)});
+                    i    += key.size();
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) ++i;
+        }
+
+        int n = 0;
+        for (auto const & [count, code] : codes)
+        {
+            if (int(bits.size() + code.size()) < limit)
+            {
+                bits += code;
+                n    += count;
+                continue;
+            }
+            break;
+        }
+        return n;
+    }
+
+    // The previous decoder; each pass over the keys, in order, takes off
+    // every code it finds at the front, until a pass finds none.
+
+    std::u16string previousDecode(Table const & table,
+                                  std::string   bits)
+    {
+        std::u16string text;
+
+        while (!bits.empty())
+        {
+            bool found = false;
+            for (auto const & [key, code] : table)
+            {
+                if (bits.starts_with(code))
+                {
+                    text += key;
+                    bits  = bits.substr(code.size());
+                    found = true;
+                }
+            }
+            if (!found) break;
+        }
+        return text;
+    }
+
+    std::string toString(BitBuffer const & bits)
+    {
+        std::string s;
+        for (int i = 0; i < bits.size(); ++i) s += bits.at(i) ? '1' : '0';
+        return s;
+    }
+
+    BitBuffer toBits(std::string const & s)
+    {
+        BitBuffer bits;
+        for (auto const c : s) bits.append(c == '1');
+        return bits;
+    }
+
+    std::u16string decode(BitBuffer const & bits)
+    {
+        std::u16string text;
+        Huffman::decode(bits, [&text](char const ch) { text += char16_t(ch); });
+        return text;
+    }
+
+    double us(Clock::duration const d, int const cases)
+    {
+        return std::chrono::duration<double, std::micro>(d).count() / cases;
+    }
+
+    int failures = 0;
+
+    void check(bool const ok, char const * what)
+    {
+        if (!ok) ++failures;
+        std::cout << (ok ? "  ok   " : "  FAIL ") << what << "\n";
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    int const cases = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+    auto const table = previousTable();
+
+    // Characters having a code, and some that don't, lower case among them.
+
+    std::u16string alphabet;
+    for (auto const & [ch, code] : Huffman::CODES) alphabet += char16_t(ch);
+    std::u16string const others = u"abz~@#\x04\x00e9";
+
+    std::mt19937                        rng(31);
+    std::uniform_int_distribution<int>  length(0, 40);
+    std::uniform_int_distribution<int>  limit(1, 72);
+    std::uniform_int_distribution<int>  prefix(0, 3);
+    std::uniform_int_distribution<int>  bit(0, 1);
+    std::uniform_int_distribution<int>  percent(0, 99);
+
+    bool            encodes   = true;
+    bool            decodes   = true;
+    bool            roundTrip = true;
+    Clock::duration tableTime{};
+    Clock::duration mapTime{};
+
+    for (int n = 0; n < cases; ++n)
+    {
+        std::u16string text;
+        bool           valid = percent(rng) < 50;
+        for (int i = length(rng); i > 0; --i)
+        {
+            text += valid || percent(rng) < 90
+                  ? alphabet[rng() % alphabet.size()]
+                  : others[rng() % others.size()];
+        }
+
+        std::string head;
+        for (int i = prefix(rng); i > 0; --i) head += bit(rng) ? '1' : '0';
+
+        auto const frameLimit = limit(rng);
+
+        // Either the bits just encoded, perhaps cut short or run on, or
+        // noise.
+
+        std::string noise;
+        for (int i = length(rng) * 2; i > 0; --i) noise += bit(rng) ? '1' : '0';
+
+        auto start = Clock::now();
+        auto       bits    = toBits(head);
+        auto const count   = Huffman::encode(text, bits, frameLimit);
+        tableTime += Clock::now() - start;
+
+        auto const encoded = toString(bits).substr(head.size());
+        auto       input   = noise;
+        if (percent(rng) < 50)
+        {
+            input = encoded.substr(0, encoded.size() - std::min<std::size_t>(encoded.size(), prefix(rng)))
+                  + noise.substr(0, prefix(rng));
+        }
+        auto const inputBits = toBits(input);
+
+        start = Clock::now();
+        auto const decoded = decode(inputBits);
+        tableTime += Clock::now() - start;
+
+        start = Clock::now();
+        auto       previousBits    = head;
+        auto const previousCount   = previousEncode(table, text, previousBits, frameLimit);
+        auto const previousDecoded = previousDecode(table, input);
+        mapTime += Clock::now() - start;
+
+        if (count != previousCount || head + encoded != previousBits) encodes = false;
+        if (decoded != previousDecoded) decodes = false;
+
+        if (valid)
+        {
+            BitBuffer all;
+            auto const m = Huffman::encode(text, all, BitBuffer::Capacity + 1);
+            if (decode(all) != text.substr(0, m)) roundTrip = false;
+        }
+    }
+
+    std::cout << "Checked " << cases << " cases\n"
+              << "Tables: " << us(tableTime, cases) << " us/case, map: "
+              << us(mapTime, cases) << " us/case\n";
+
+    check(encodes, "encodes as the previous method");
+    check(decodes, "decodes as the previous method");
+    check(roundTrip, "decodes what it encodes");
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,256 @@
+// Benchmark of the inbox's queries.
+// This is a standalone command-line tool that fills an inbox with 100,000
+// messages, in the schema of earlier versions, then times count(), values(),
+// and value() against it, first as earlier versions ran them, opening the
+// database for each query and extracting fields from the JSON row by row,
+// and then through an Inbox held open, which migrates the database to the
+// indexed, generated columns and caches its prepared statements.
+//
+// Build example (adjust Qt include/library paths as needed):
+//   gcc -O2 -c vendor/sqlite3/sqlite3.c -o sqlite3.o
+//   g++ -std=c++20 -O2 -I. -fPIC tools/inbox_bench.cpp JS8_Main/Inbox.cpp \
+//       JS8_Main/Message.cpp JS8_Main/DriftingDateTime.cpp sqlite3.o \
+//       -lQt6Core -lpthread -ldl
+//
+// Usage: inbox_bench [messages] [queries]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QString>
+#include <QTemporaryDir>
+
+#include "JS8_Main/Inbox.h"
+#include "vendor/sqlite3/sqlite3.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Schema of earlier versions; indexes on the bare expressions.
+
+    constexpr char LEGACY_SCHEMA[] =
+        "CREATE TABLE IF NOT EXISTS inbox_v1 ("
+        "  id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "  blob TEXT"
+        ");"
+        "CREATE INDEX IF NOT EXISTS idx_inbox_v1__type ON"
+        "  inbox_v1(json_extract(blob, '$.type'));"
+        "CREATE INDEX IF NOT EXISTS idx_inbox_v1__params_from ON"
+        "  inbox_v1(json_extract(blob, '$.params.FROM'));"
+        "CREATE INDEX IF NOT EXISTS idx_inbox_v1__params_to ON"
+        "  inbox_v1(json_extract(blob, '$.params.TO'));"
+        "CREATE TABLE IF NOT EXISTS inbox_group_recip_v1 ("
+        "  id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "  msg_id INTEGER, "
+        "  callsign VARCHAR(255), "
+        "  FOREIGN KEY(msg_id) REFERENCES inbox_v1(id) ON DELETE CASCADE"
+        ");"
+        "CREATE INDEX IF NOT EXISTS idx_inbox_group_recip_v1__callsign ON"
+        "  inbox_group_recip_v1(callsign);";
+
+    QString call(int const n)
+    {
+        return QString("K%1ABC").arg(n);
+    }
+
+    bool populate(QString const & path,
+                  int const       messages,
+                  int const       calls)
+    {
+        sqlite3 * db = nullptr;
+        if (sqlite3_open(path.toLocal8Bit().data(), &db) != SQLITE_OK ||
+            sqlite3_exec(db, LEGACY_SCHEMA, nullptr, nullptr, nullptr) != SQLITE_OK ||
+            sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr) != SQLITE_OK)
+        {
+            std::cerr << "populate: " << sqlite3_errmsg(db) << "\n";
+            sqlite3_close(db);
+            return false;
+        }
+
+        sqlite3_stmt * stmt = nullptr;
+        sqlite3_prepare_v2(db, "INSERT INTO inbox_v1 (blob) VALUES (?);", -1, &stmt, nullptr);
+
+        char const * types[] = {"UNREAD", "READ", "STORE", "DELIVERED"};
+        std::mt19937 rng(1);
+
+        for (int i = 0; i < messages; ++i)
+        {
+            auto const m = Message(types[rng() % 4], "", {
+                {"UTC",  QString("2024-06-%1 12:00:00").arg(1 + i % 28, 2, 10, QChar('0'))},
+                {"FROM", call(rng() % calls)},
+                {"TO",   call(rng() % calls)},
+                {"TEXT", "HELLO WORLD"},
+                {"SNR",  -10}
+            });
+            auto const j8 = m.toJson();
+            sqlite3_bind_text(stmt, 1, j8.data(), -1, SQLITE_TRANSIENT);
+            sqlite3_step(stmt);
+            sqlite3_reset(stmt);
+        }
+
+        sqlite3_finalize(stmt);
+        sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+        sqlite3_close(db);
+        return true;
+    }
+
+    // The queries as earlier versions ran them; a fresh connection, schema,
+    // and statement for each.
+
+    int legacyCount(QString const & path,
+                    QString const & type,
+                    QString const & query,
+                    QString const & match)
+    {
+        sqlite3 * db = nullptr;
+        sqlite3_open(path.toLocal8Bit().data(), &db);
+        sqlite3_exec(db, LEGACY_SCHEMA, nullptr, nullptr, nullptr);
+
+        sqlite3_stmt * stmt = nullptr;
+        sqlite3_prepare_v2(db,
+                           "SELECT COUNT(*) FROM inbox_v1 "
+                           "WHERE json_extract(blob, '$.type') = ? "
+                           "AND json_extract(blob, ?) LIKE ?;",
+                           -1, &stmt, nullptr);
+
+        auto const t8 = type.toLocal8Bit();
+        auto const q8 = query.toLocal8Bit();
+        auto const m8 = match.toLocal8Bit();
+        sqlite3_bind_text(stmt, 1, t8.data(), -1, nullptr);
+        sqlite3_bind_text(stmt, 2, q8.data(), -1, nullptr);
+        sqlite3_bind_text(stmt, 3, m8.data(), -1, nullptr);
+
+        int count = 0;
+        if (sqlite3_step(stmt) == SQLITE_ROW) count = sqlite3_column_int(stmt, 0);
+
+        sqlite3_finalize(stmt);
+        sqlite3_close(db);
+        return count;
+    }
+
+    int legacyValues(QString const & path,
+                     QString const & type,
+                     QString const & query,
+                     QString const & match)
+    {
+        sqlite3 * db = nullptr;
+        sqlite3_open(path.toLocal8Bit().data(), &db);
+        sqlite3_exec(db, LEGACY_SCHEMA, nullptr, nullptr, nullptr);
+
+        sqlite3_stmt * stmt = nullptr;
+        sqlite3_prepare_v2(db,
+                           "SELECT id, blob FROM inbox_v1 "
+                           "WHERE json_extract(blob, '$.type') = ? "
+                           "AND json_extract(blob, ?) LIKE ? "
+                           "ORDER BY id ASC "
+                           "LIMIT ? OFFSET ?;",
+                           -1, &stmt, nullptr);
+
+        auto const t8 = type.toLocal8Bit();
+        auto const q8 = query.toLocal8Bit();
+        auto const m8 = match.toLocal8Bit();
+        sqlite3_bind_text(stmt, 1, t8.data(), -1, nullptr);
+        sqlite3_bind_text(stmt, 2, q8.data(), -1, nullptr);
+        sqlite3_bind_text(stmt, 3, m8.data(), -1, nullptr);
+        sqlite3_bind_int(stmt, 4, 1000);
+        sqlite3_bind_int(stmt, 5, 0);
+
+        int rows = 0;
+        while (sqlite3_step(stmt) == SQLITE_ROW)
+        {
+            Message::fromJson(QByteArray((char const *)sqlite3_column_text(stmt, 1),
+                                         sqlite3_column_bytes(stmt, 1)));
+            ++rows;
+        }
+
+        sqlite3_finalize(stmt);
+        sqlite3_close(db);
+        return rows;
+    }
+
+    int legacyValue(QString const & path,
+                    int     const   key)
+    {
+        sqlite3 * db = nullptr;
+        sqlite3_open(path.toLocal8Bit().data(), &db);
+        sqlite3_exec(db, LEGACY_SCHEMA, nullptr, nullptr, nullptr);
+
+        sqlite3_stmt * stmt = nullptr;
+        sqlite3_prepare_v2(db, "SELECT blob FROM inbox_v1 WHERE id = ? LIMIT 1;",
+                           -1, &stmt, nullptr);
+        sqlite3_bind_int(stmt, 1, key);
+
+        int rows = 0;
+        while (sqlite3_step(stmt) == SQLITE_ROW)
+        {
+            Message::fromJson(QByteArray((char const *)sqlite3_column_text(stmt, 0),
+                                         sqlite3_column_bytes(stmt, 0)));
+            ++rows;
+        }
+
+        sqlite3_finalize(stmt);
+        sqlite3_close(db);
+        return rows;
+    }
+
+    // Run the function the number of times given, and report the mean time
+    // per run, in microseconds, along with a checksum of its results, so
+    // that the two implementations can be seen to agree.
+
+    template <typename F>
+    void measure(char const * name,
+                 int          runs,
+                 F         && fn)
+    {
+        long long sum   = 0;
+        auto const start = Clock::now();
+        for (int i = 0; i < runs; ++i) sum += fn(i);
+        auto const us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+        std::cout << "  " << name << ": " << us / runs << " us/query"
+                  << " (checksum " << sum << ")\n";
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    int const messages = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int const queries  = argc > 2 ? std::atoi(argv[2]) : 200;
+    int const calls    = 1000;
+
+    QTemporaryDir dir;
+    auto const path = dir.filePath("inbox.db3");
+
+    std::cout << "Populating " << messages << " messages...\n";
+    if (!populate(path, messages, calls)) return 1;
+
+    std::cout << "Legacy, per-query connection, json_extract():\n";
+    measure("count ", queries, [&](int i) { return legacyCount (path, "UNREAD", "$.params.FROM", call(i % calls)); });
+    measure("values", queries, [&](int i) { return legacyValues(path, "STORE",  "$.params.TO",   call(i % calls)); });
+    measure("value ", queries, [&](int i) { return legacyValue (path, 1 + (i * 7919) % messages); });
+
+    Inbox inbox(path);
+    auto const start = Clock::now();
+    if (!inbox.open())
+    {
+        std::cerr << "open: " << inbox.error().toStdString() << "\n";
+        return 1;
+    }
+    std::cout << "Migrated in "
+              << std::chrono::duration<double, std::milli>(Clock::now() - start).count()
+              << " ms\n";
+
+    std::cout << "Held connection, cached statements, generated columns:\n";
+    measure("count ", queries, [&](int i) { return inbox.count("UNREAD", "$.params.FROM", call(i % calls)); });
+    measure("values", queries, [&](int i) { return inbox.values("STORE", "$.params.TO", call(i % calls), 0, 1000).size(); });
+    measure("value ", queries, [&](int i) { return inbox.value(1 + (i * 7919) % messages).params().size() ? 1 : 0; });
+
+    return 0;
+}
@@ -0,0 +1,412 @@
+// Differential check of IPFIXWriter against the encoder it replaced.
+// This is a standalone command-line tool that feeds the same spots, in
+// reports of random sizes, some of them flushed, through IPFIXWriter, and
+// through the QDataStream encoder that PSKReporter previously used, copied
+// here as it was, and compares the messages each sends, byte for byte, but
+// for the export time. The spots are random, and cover:
+//
+//   - frequencies of up to 40 bits, the top byte included;
+//   - calls, grids, and modes longer than the 254 bytes a string may take,
+//     in multi-byte characters, so that truncation can't fall evenly;
+//   - enough spots, some reports, to fill a message past 10,000 bytes, and
+//     too few, others, to reach the 508 below which a message waits;
+//   - receiver information that, between flushed reports, changes, at
+//     times to strings long enough to push a message of no spots past 508
+//     bytes on its own;
+//   - the record format descriptors, asked for again between flushed
+//     reports, and counted down message by message.
+//
+// So it checks the set lengths and their padding, the frequency's layout,
+// where messages are split, and which of them carry the descriptors. The
+// previous encoder is flushed a second time where it didn't send all the
+// spots it had been asked to flush, see below. The
+// receiver information and the descriptors are only changed after a flush,
+// as the previous encoder took them when it started a message, not when it
+// sent it.
+//
+// It reports the time taken to encode a spot by each.
+//
+// Build example (adjust Qt include/library paths as needed):
+//   g++ -std=c++20 -O2 -I. -fPIC tools/ipfix_check.cpp \
+//       JS8_Network/IPFIXWriter.cpp JS8_Main/DriftingDateTime.cpp -lQt6Core
+//
+// Usage: ipfix_check [reports]
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QDateTime>
+#include <QQueue>
+#include <QString>
+
+#include "JS8_Network/IPFIXWriter.h"
+
+namespace
+{
+    using Clock    = std::chrono::steady_clock;
+    using Messages = std::vector<QByteArray>;
+
+    struct Spot
+    {
+        QString          call;
+        QString          grid;
+        Radio::Frequency freq;
+        QString          mode;
+        int              snr;
+        QDateTime        time;
+    };
+
+    // The previous encoder, from PSKReporter.cpp, but for the socket, and
+    // for the export time, which is left as zero.
+
+    constexpr int MIN_PAYLOAD_LENGTH = 508;
+    constexpr int MAX_PAYLOAD_LENGTH = 10000;
+    constexpr int MAX_STRING_LENGTH  = 254;
+
+    void writeUtfString(QDataStream & out, QString const & s)
+    {
+        auto utf = s.toUtf8();
+
+        if (utf.size() > MAX_STRING_LENGTH)
+        {
+            auto const truncatePosition = [&utf]() -> qsizetype
+            {
+                for (auto i = MAX_STRING_LENGTH; i > 0; i--)
+                {
+                    if (auto const byte = static_cast<std::byte>(utf.at(i));
+                        (byte & std::byte{0xC0}) != std::byte{0x80})
+                    {
+                        return i;
+                    }
+                }
+                return 0;
+            };
+            utf.truncate(truncatePosition());
+        }
+
+        out << quint8(utf.size());
+        out.writeRawData(utf, utf.size());
+    }
+
+    qsizetype num_pad_bytes(qsizetype const n) { return ((n + 3) & ~0x3) - n; }
+
+    void set_length(QDataStream & out, QByteArray const & b)
+    {
+        if (auto const padSize = num_pad_bytes(b.size()); padSize != 0)
+        {
+            out.writeRawData(QByteArray(padSize, '\0'), padSize);
+        }
+
+        auto const pos = out.device()->pos();
+        out.device()->seek(sizeof(quint16));
+        out << static_cast<quint16>(b.size());
+        out.device()->seek(pos);
+    }
+
+    void appendSIDTo(QDataStream & message)
+    {
+        QByteArray  buffer;
+        QDataStream stream{&buffer, QIODevice::WriteOnly};
+
+        stream << quint16(2u) << quint16(0u) << quint16(0x50e3) << quint16(7u)
+               << quint16(0x8000 + 1u)  << quint16(0xffff) << quint32(30351u)
+               << quint16(0x8000 + 5u)  << quint16(5u)     << quint32(30351u)
+               << quint16(0x8000 + 6u)  << quint16(1u)     << quint32(30351u)
+               << quint16(0x8000 + 10u) << quint16(0xffff) << quint32(30351u)
+               << quint16(0x8000 + 3u)  << quint16(0xffff) << quint32(30351u)
+               << quint16(0x8000 + 11u) << quint16(1u)     << quint32(30351u)
+               << quint16(150u)         << quint16(4u);
+
+        set_length(stream, buffer);
+        message.writeRawData(buffer, buffer.size());
+    }
+
+    void appendRIDTo(QDataStream & message)
+    {
+        QByteArray  buffer;
+        QDataStream stream{&buffer, QIODevice::WriteOnly};
+
+        stream << quint16(3u) << quint16(0u) << quint16(0x50e2) << quint16(4u) << quint16(0u)
+               << quint16(0x8000 + 2u) << quint16(0xffff) << quint32(30351u)
+               << quint16(0x8000 + 4u) << quint16(0xffff) << quint32(30351u)
+               << quint16(0x8000 + 8u) << quint16(0xffff) << quint32(30351u)
+               << quint16(0x8000 + 9u) << quint16(0xffff) << quint32(30351u);
+
+        set_length(stream, buffer);
+        message.writeRawData(buffer, buffer.size());
+    }
+
+    struct Previous
+    {
+        std::function<void(QByteArray const &)> send;
+
+        quint32     observation_id_;
+        quint32     sequence_number_  = 0u;
+        unsigned    send_descriptors_ = 0u;
+        QString     rx_call_;
+        QString     rx_grid_;
+        QString     prog_id_;
+        QString     rx_ant_;
+        QQueue<Spot> spots_;
+        QByteArray  payload_;
+        QByteArray  tx_data_;
+        QByteArray  tx_residue_;
+
+        void build_preamble(QDataStream & message)
+        {
+            message << quint16(10u) << quint16(0u) << quint32(0u)
+                    << ++sequence_number_ << observation_id_;
+
+            if (send_descriptors_)
+            {
+                --send_descriptors_;
+                appendSIDTo(message);
+                appendRIDTo(message);
+            }
+
+            QByteArray  record;
+            QDataStream stream{&record, QIODevice::WriteOnly};
+
+            stream << quint16(0x50e2) << quint16(0u);
+
+            writeUtfString(stream, rx_call_);
+            writeUtfString(stream, rx_grid_);
+            writeUtfString(stream, prog_id_);
+            writeUtfString(stream, rx_ant_);
+
+            set_length(stream, record);
+            message.writeRawData(record, record.size());
+        }
+
+        void send_report(bool const send_residue)
+        {
+            QDataStream message{&payload_, QIODevice::WriteOnly | QIODevice::Append};
+            QDataStream tx_out{&tx_data_, QIODevice::WriteOnly | QIODevice::Append};
+
+            if (!payload_.size()) build_preamble(message);
+
+            auto flush = send_residue;
+            while (spots_.size() || flush)
+            {
+                if (!payload_.size()) build_preamble(message);
+
+                if (!tx_data_.size() && (spots_.size() || tx_residue_.size()))
+                {
+                    tx_out << quint16(0x50e3) << quint16(0u);
+                }
+
+                if (tx_residue_.size())
+                {
+                    tx_out.writeRawData(tx_residue_, tx_residue_.size());
+                    tx_residue_.clear();
+                }
+
+                while (spots_.size() || flush)
+                {
+                    auto tx_data_size = tx_data_.size();
+                    if (spots_.size())
+                    {
+                        auto const & spot = spots_.dequeue();
+
+                        writeUtfString(tx_out, spot.call);
+                        tx_out << static_cast<quint8>(spot.freq >> 32)
+                               << static_cast<quint8>(spot.freq >> 24)
+                               << static_cast<quint8>(spot.freq >> 16)
+                               << static_cast<quint8>(spot.freq >> 8)
+                               << static_cast<quint8>(spot.freq)
+                               << static_cast<qint8>(spot.snr);
+                        writeUtfString(tx_out, spot.mode);
+                        writeUtfString(tx_out, spot.grid);
+                        tx_out << quint8(1u) << static_cast<quint32>(spot.time.toSecsSinceEpoch());
+                    }
+
+                    auto len = payload_.size() + tx_data_.size();
+                    len += num_pad_bytes(tx_data_.size());
+                    len += num_pad_bytes(len);
+
+                    if (len > MAX_PAYLOAD_LENGTH ||
+                        (!spots_.size() && len > MIN_PAYLOAD_LENGTH) ||
+                        (flush && !spots_.size()))
+                    {
+                        if (tx_data_.size())
+                        {
+                            if (len <= MAX_PAYLOAD_LENGTH) tx_data_size = tx_data_.size();
+                            QByteArray  tx{tx_data_.left(tx_data_size)};
+                            QDataStream out{&tx, QIODevice::WriteOnly | QIODevice::Append};
+                            set_length(out, tx);
+                            message.writeRawData(tx, tx.size());
+                        }
+
+                        set_length(message, payload_);
+                        send(payload_);
+                        flush = false;
+                        message.device()->seek(0u);
+                        payload_.clear();
+                        tx_residue_ = tx_data_.right(tx_data_.size() - tx_data_size);
+                        tx_out.device()->seek(0u);
+                        tx_data_.clear();
+                        break;
+                    }
+                }
+            }
+        }
+    };
+
+    // The export time, at bytes 4 to 7 of the header, is the time sent.
+
+    QByteArray timeless(QByteArray message)
+    {
+        if (message.size() >= 8) message.replace(4, 4, QByteArray(4, '\0'));
+        return message;
+    }
+
+    // A string of the length given, in characters of 1 to 3 bytes in UTF-8.
+
+    QString text(std::mt19937 & rng, int const length)
+    {
+        static char16_t const chars[] = {u'A', u'7', u'/', 0x00e9, 0x20ac};
+        QString s;
+        for (int i = 0; i < length; ++i) s += QChar(chars[rng() % 5]);
+        return s;
+    }
+
+    int failures = 0;
+
+    void check(bool const ok, char const * what)
+    {
+        if (!ok) ++failures;
+        std::cout << (ok ? "  ok   " : "  FAIL ") << what << "\n";
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    int const reports = argc > 1 ? std::atoi(argv[1]) : 2000;
+
+    Messages now;
+    Messages before;
+
+    IPFIXWriter writer(0x4a533843, [&now](QByteArray const & m) { now.push_back(timeless(m)); });
+    Previous    previous;
+    previous.observation_id_ = 0x4a533843;
+    previous.send            = [&before](QByteArray const & m) { before.push_back(m); };
+
+    std::mt19937                       rng(48);
+    std::uniform_int_distribution<int> few(0, 20);
+    std::uniform_int_distribution<int> many(300, 1200);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    auto const time = QDateTime::fromSecsSinceEpoch(1718000000);
+
+    Clock::duration nowTime{};
+    Clock::duration beforeTime{};
+    long            total       = 0;
+    long            descriptors = 0;
+
+    for (int report = 0; report < reports; ++report)
+    {
+        std::vector<Spot> batch(percent(rng) < 25 ? many(rng) : few(rng));
+        for (auto & spot : batch)
+        {
+            bool const longer = percent(rng) < 3;
+            spot.call = text(rng, longer ? 100 + rng() % 60 : 3 + rng() % 6);
+            spot.grid = text(rng, longer ? 100 + rng() % 60 : 4 + 2 * (rng() % 2));
+            spot.mode = percent(rng) < 3 ? text(rng, 200 + rng() % 60) : QString("JS8");
+            spot.freq = rng() % 2 ? 14078000 + rng() % 3000 : (quint64(rng() % 256) << 32) | rng();
+            spot.snr  = -30 + int(rng() % 60);
+            spot.time = time.addSecs(total);
+            ++total;
+        }
+
+        bool const flush = percent(rng) < 20;
+
+        auto start = Clock::now();
+        for (auto const & s : batch) writer.add(s.call, s.grid, s.freq, s.mode, s.snr, s.time);
+        writer.finish(flush);
+        nowTime += Clock::now() - start;
+
+        start = Clock::now();
+        for (auto const & s : batch) previous.spots_.enqueue(s);
+        previous.send_report(flush);
+
+        // Once it had sent a message, the previous encoder forgot it was
+        // flushing, and held what was left over to the next report, which,
+        // on closing, never came; IPFIXWriter sends it, as this does.
+
+        if (flush && (previous.tx_data_.size() || previous.tx_residue_.size()))
+        {
+            previous.send_report(true);
+        }
+        beforeTime += Clock::now() - start;
+
+        // Neither holds a message under way after a flush; change what goes
+        // in the next one.
+
+        if (flush && percent(rng) < 30)
+        {
+            auto const longer = percent(rng) < 30;
+            QString const call = text(rng, 3 + rng() % 6);
+            QString const grid = text(rng, 6);
+            QString const software = longer ? text(rng, 250) : QString("JS8Call");
+            QString const antenna  = longer ? text(rng, 250) : text(rng, rng() % 20);
+
+            writer.setReceiver(call, grid, software, antenna);
+            previous.rx_call_ = call;
+            previous.rx_grid_ = grid;
+            previous.prog_id_ = software;
+            previous.rx_ant_  = antenna;
+        }
+        if (flush && percent(rng) < 10)
+        {
+            unsigned const n = 1 + rng() % 3;
+            writer.sendDescriptors(n);
+            previous.send_descriptors_ = n;
+            ++descriptors;
+        }
+    }
+
+    // A spot record takes at most 777 bytes, so a message over 9,223 bytes
+    // was split where the next wouldn't fit.
+
+    std::size_t same    = 0;
+    std::size_t largest = 0;
+    std::size_t full    = 0;
+    while (same < now.size() && same < before.size() && now[same] == before[same]) ++same;
+    for (auto const & m : now)
+    {
+        largest = std::max<std::size_t>(largest, m.size());
+        if (m.size() > 9223) ++full;
+    }
+
+    auto const us = [total](Clock::duration const d)
+    {
+        return std::chrono::duration<double, std::micro>(d).count() / total;
+    };
+
+    std::cout << "Encoded " << total << " spots in " << reports << " reports, "
+              << descriptors << " times asking for the descriptors again\n"
+              << "IPFIXWriter: " << now.size() << " messages, " << full
+              << " of them split at the limit, the largest " << largest
+              << " bytes, " << us(nowTime) << " us/spot\n"
+              << "Previous:    " << before.size() << " messages, "
+              << us(beforeTime) << " us/spot\n";
+
+    if (same < now.size() || same < before.size())
+    {
+        std::cout << "First difference at message " << same << "\n";
+    }
+
+    check(now.size() == before.size(), "as many messages as the previous encoder");
+    check(same == now.size() && same == before.size(),
+          "every message identical, but for the export time");
+
+    return failures ? 1 : 0;
+}
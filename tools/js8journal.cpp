@@ -0,0 +1,176 @@
+// Command-line reader for the decode journal; see JS8_Main/DecodeJournal.h.
+//
+// Lists the decodes in the journal, in the format of ALL.TXT, preceded by
+// the dial frequency, optionally restricted to a time range, a callsign,
+// or a band, e.g.,
+//
+//   js8journal --call KN4CRD --band 20m --from 2024-06-01 --to 2024-06-07
+//
+// With --replay, the matching decodes are instead sent to a running
+// JS8Call, through its TCP API, as RX.REPLAY messages, to be shown there
+// and passed on to its API clients.
+//
+// The journal is read from the JS8Call data directory unless another is
+// given.
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include <QTcpSocket>
+#include <QTextStream>
+#include <QTimeZone>
+
+#include "JS8_Main/DecodeJournal.h"
+#include "JS8_Main/Radio.h"
+#include "JS8_Mode/DecodedText.h"
+
+namespace {
+// Dates, or date-times, in ISO 8601, in UTC; a bare date at the end of a
+// range means the whole of that day.
+
+QDateTime parseTime(QString const &text, bool const end) {
+    if (text.isEmpty()) {
+        return {};
+    }
+    if (auto const date = QDate::fromString(text, Qt::ISODate);
+        date.isValid()) {
+        return end ? QDateTime(date.addDays(1), QTime(0, 0), QTimeZone::utc())
+                         .addMSecs(-1)
+                   : QDateTime(date, QTime(0, 0), QTimeZone::utc());
+    }
+
+    auto time = QDateTime::fromString(text, Qt::ISODate);
+    if (time.timeSpec() == Qt::LocalTime) {
+        time.setTimeZone(QTimeZone::utc());
+    }
+    return time;
+}
+
+QString line(DecodeJournal::Record const &record) {
+    DecodedText const text(record.decoded());
+    auto line =
+        QDateTime::fromMSecsSinceEpoch(record.utc, QTimeZone::utc())
+            .toString("yyyy-MM-dd ") +
+        Radio::frequency_MHz_string(record.dial) + " " + text.string() +
+        text.message();
+
+    if (record.receiver) {
+        line += QString(" [RX%1]").arg(record.receiver);
+    }
+    return line;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("JS8Call");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("List or replay the JS8Call decode "
+                                     "journal.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("directory",
+                                 "Journal directory; by default, that of "
+                                 "JS8Call.",
+                                 "[directory]");
+
+    QCommandLineOption const fromOption(
+        "from", "Decodes at or after <time>, in ISO 8601 UTC.", "time");
+    QCommandLineOption const toOption(
+        "to", "Decodes at or before <time>, in ISO 8601 UTC.", "time");
+    QCommandLineOption const callOption(
+        "call", "Decodes from or to <callsign>.", "callsign");
+    QCommandLineOption const bandOption("band", "Decodes on <band>, e.g., 20m.",
+                                        "band");
+    QCommandLineOption const countOption(
+        "count", "Print only the number of matching decodes.");
+    QCommandLineOption const replayOption(
+        "replay",
+        "Replay decodes to the JS8Call API at <host[:port]>, by default "
+        "127.0.0.1:2442.",
+        "host[:port]");
+
+    parser.addOptions({fromOption, toOption, callOption, bandOption,
+                       countOption, replayOption});
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    auto const positional = parser.positionalArguments();
+    auto const directory =
+        positional.isEmpty()
+            ? QDir(QStandardPaths::writableLocation(
+                       QStandardPaths::AppLocalDataLocation))
+                  .absoluteFilePath("journal")
+            : positional.first();
+
+    DecodeJournal::Query query;
+    query.from = parseTime(parser.value(fromOption), false);
+    query.to = parseTime(parser.value(toOption), true);
+    query.call = parser.value(callOption);
+    query.band = parser.value(bandOption);
+
+    if ((parser.isSet(fromOption) && !query.from.isValid()) ||
+        (parser.isSet(toOption) && !query.to.isValid())) {
+        err << "js8journal: invalid time\n";
+        return 1;
+    }
+
+    DecodeJournal::Reader const reader(directory);
+
+    if (parser.isSet(countOption)) {
+        out << reader.scan(query, [](auto const &) { return true; }) << "\n";
+        return 0;
+    }
+
+    if (!parser.isSet(replayOption)) {
+        reader.scan(query, [&out](auto const &record) {
+            out << line(record) << "\n";
+            return true;
+        });
+        return 0;
+    }
+
+    // Replay; one message per line, as the API expects.
+
+    auto const target = parser.value(replayOption).split(':');
+    auto const host = target.value(0, "127.0.0.1");
+    auto const port = target.size() > 1 ? target.at(1).toUShort() : 2442;
+
+    QTcpSocket socket;
+    socket.connectToHost(host.isEmpty() ? "127.0.0.1" : host, port);
+    if (!socket.waitForConnected(5000)) {
+        err << "js8journal: " << socket.errorString() << "\n";
+        return 1;
+    }
+
+    auto const replayed = reader.scan(query, [&socket](auto const &record) {
+        auto const message =
+            QJsonObject{{"type", "RX.REPLAY"},
+                        {"value", ""},
+                        {"params", QJsonObject::fromVariantMap(
+                                       record.toVariantMap())}};
+
+        socket.write(QJsonDocument(message).toJson(QJsonDocument::Compact) +
+                     '\n');
+        return socket.state() == QAbstractSocket::ConnectedState;
+    });
+
+    while (socket.bytesToWrite() && socket.waitForBytesWritten(5000)) {
+    }
+    socket.disconnectFromHost();
+
+    if (socket.error() != QAbstractSocket::UnknownSocketError &&
+        socket.error() != QAbstractSocket::RemoteHostClosedError) {
+        err << "js8journal: " << socket.errorString() << "\n";
+        return 1;
+    }
+
+    err << "js8journal: replayed " << replayed << " decodes\n";
+    return 0;
+}
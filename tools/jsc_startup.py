@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+#
+# Startup cost of the JSC dictionary tables, as pointer-bearing arrays and
+# as the packed blob that jsc_pack writes.
+#
+# The generated tables aren't part of every source tree, so this builds two
+# stand-ins of the same shape: 262,144 map and 262,144 list entries, plus
+# the 103 prefix entries, of random words of 2 to 12 letters. One program
+# holds them as arrays of { const char *, int, int }, as jsc_map.cpp and
+# jsc_list.cpp do; the other carries the same words in the layout of
+# jsc_blob.h, included as read-only data. Both are built as position
+# independent executables, and neither touches the tables at startup.
+#
+# It reports, for each, the dynamic relocations the loader must apply, the
+# median time to run the program to the end of main(), and the resident
+# set at the end of main().
+#
+# Needs a C++ compiler and readelf; Linux only, for /proc/self/status.
+#
+# Usage: python3 tools/jsc_startup.py [compiler] [runs]
+
+import os
+import random
+import statistics
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+
+N = 262144
+PREFIX = 103
+
+MAIN = r'''
+#include <cstdio>
+#include <cstring>
+extern const unsigned char %(symbol)s[];
+int main(int argc, char **) {
+    if (argc > 1) std::printf("%%p\n", (void const *)%(symbol)s);
+    std::FILE *f = std::fopen("/proc/self/status", "r");
+    char line[256];
+    while (std::fgets(line, sizeof line, f))
+        if (!std::strncmp(line, "VmRSS", 5)) std::fputs(line, stdout);
+}
+'''
+
+
+def words():
+    rng = random.Random(34)
+    found = set()
+    while len(found) < N:
+        found.add(''.join(rng.choice('ABCDEFGHIJKLMNOPQRSTUVWXYZ')
+                          for _ in range(rng.randint(2, 12))))
+    listed = sorted(found)
+    mapped = sorted(found, key=lambda w: (len(w), w))
+    return mapped, listed, listed[:PREFIX]
+
+
+def write_tables(path, sections):
+    with open(path, 'w') as f:
+        f.write('struct Tuple { char const *str; int size; int index; };\n')
+        for name, entries in sections:
+            f.write('extern const Tuple %s[];\n' % name)
+            f.write('const Tuple %s[%d] = {\n' % (name, len(entries)))
+            for i, w in enumerate(entries):
+                f.write('{"%s", %d, %d},\n' % (w, len(w), i))
+            f.write('};\n')
+        # Referenced by main() as the start of the tables.
+        f.write('extern const unsigned char tables[];\n'
+                'const unsigned char tables[] = {0};\n')
+
+
+def write_blob(path, sections):
+    pool = bytearray()
+    offsets = {}
+    entries = bytearray()
+    for _, section in sections:
+        for i, w in enumerate(section):
+            if w not in offsets:
+                offsets[w] = len(pool)
+                pool += w.encode() + b'\0'
+            entries += struct.pack('<III', offsets[w], len(w), i)
+    counts = [len(s) for _, s in sections] + [0, len(pool)]
+    with open(path, 'wb') as f:
+        f.write(struct.pack('<6I', 0x3143534a, *counts))
+        f.write(entries)
+        f.write(pool)
+
+
+def build(compiler, directory, name, sources):
+    binary = os.path.join(directory, name)
+    subprocess.run([compiler, '-O2', '-fPIE', '-pie', '-o', binary] + sources,
+                   check=True)
+    return binary
+
+
+def relocations(binary):
+    out = subprocess.run(['readelf', '-r', '-W', binary], check=True,
+                         capture_output=True, text=True).stdout
+    return sum(1 for line in out.splitlines() if '_RELATIVE' in line or
+               '_GLOB_DAT' in line or '_JUMP_SLOT' in line)
+
+
+def measure(binary, runs):
+    times = []
+    rss = ''
+    for _ in range(runs):
+        start = time.perf_counter()
+        rss = subprocess.run([binary], check=True, capture_output=True,
+                             text=True).stdout.split()[1]
+        times.append(time.perf_counter() - start)
+    return statistics.median(times) * 1000, int(rss)
+
+
+def main():
+    compiler = sys.argv[1] if len(sys.argv) > 1 else 'c++'
+    runs = int(sys.argv[2]) if len(sys.argv) > 2 else 50
+
+    mapped, listed, prefix = words()
+    sections = [('map', mapped), ('list', listed), ('prefix', prefix)]
+
+    with tempfile.TemporaryDirectory() as directory:
+        def path(name):
+            return os.path.join(directory, name)
+
+        write_tables(path('tables.cpp'), sections)
+        write_blob(path('jsc.bin'), sections)
+        with open(path('blob.S'), 'w') as f:
+            f.write('    .section .rodata\n    .global blob\n    .balign 4\n'
+                    'blob:\n    .incbin "%s"\n'
+                    '    .section .note.GNU-stack,"",@progbits\n'
+                    % path('jsc.bin'))
+        for symbol in ('tables', 'blob'):
+            with open(path('main_%s.cpp' % symbol), 'w') as f:
+                f.write(MAIN % {'symbol': symbol})
+
+        binaries = [
+            ('Pointer tables', build(compiler, directory, 'tables',
+                                     [path('tables.cpp'),
+                                      path('main_tables.cpp')])),
+            ('Packed blob', build(compiler, directory, 'blob',
+                                  [path('blob.S'), path('main_blob.cpp')])),
+        ]
+
+        for label, binary in binaries:
+            ms, rss = measure(binary, runs)
+            print('%-15s %7d relocations, %6.2f ms to run, %6d kB resident'
+                  % (label + ':', relocations(binary), ms, rss))
+
+
+if __name__ == '__main__':
+    main()
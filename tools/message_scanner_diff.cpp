@@ -0,0 +1,233 @@
+// Differential check of the message scanners against the expressions they
+// replaced. This is a standalone command-line tool that generates messages
+// from the tokens of the directed, heartbeat, and compound grammars, mixed
+// with stray characters, whitespace of each kind, and non-ASCII text, and
+// matches each through the scanners in MessageScanner.h, and through the
+// original expressions, under Boost.Regex's Perl syntax. Boost differs from
+// the PCRE behind QRegularExpression in two ways that matter here: its \s
+// leaves out vertical tab, and its $ doesn't match before a final newline.
+// So, in the expressions as given to Boost, each \s is spelled out as the
+// ASCII class PCRE has, and each $ as the lookahead PCRE takes it to be.
+// It checks, for every message and each grammar:
+//
+//   - that both match, or neither does;
+//   - that every capture is the same, and is absent in both or neither;
+//   - that the match is the same length.
+//
+// It reports the first few differences, if any, and the time taken per
+// message by each method.
+//
+// Build example (adjust Qt include paths as needed; only QStringView is
+// used; Boost.Regex is header only from Boost 1.77, add -lboost_regex for
+// earlier versions):
+//   g++ -std=c++20 -O2 -I. -I/usr/include/qt6 -I/usr/include/qt6/QtCore \
+//       -fPIC tools/message_scanner_diff.cpp -lQt6Core
+//
+// Usage: message_scanner_diff [messages]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/regex.hpp>
+
+#include "JS8_Main/MessageScanner.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // The expressions, as varicode.cpp had them, and as Boost must have
+    // them to match as PCRE does.
+
+    std::wstring const CALLSIGN = LR"((?<callsign>[@]?[A-Z0-9/]+))";
+    std::wstring const CMD =
+        LR"((?<cmd>\s?(?:AGN[?]|QSL[?]|HW CPY[?]|MSG TO[:]|SNR[?]|INFO[?]|GRID[?]|STATUS[?]|QUERY MSGS[?]|HEARING[?]|)"
+        LR"((?:(?:STATUS|HEARING|QUERY CALL|QUERY MSGS|QUERY|CMD|MSG|NACK|ACK|73|YES|NO|HEARTBEAT SNR|SNR|QSL|RR|SK|FB|INFO|GRID|DIT DIT)(?=[ ]|$))|[?> ]))?)";
+    std::wstring const GRID = LR"((?<grid>\s?[A-R]{2}[0-9]{2})?)";
+    std::wstring const NUM  = LR"((?<num>(?<=SNR)\s?[-+]?(?:3[01]|[0-2]?[0-9]))?)";
+
+    std::wstring const DIRECTED_PATTERN = L"^" + CALLSIGN + CMD + NUM;
+    std::wstring const HEARTBEAT_PATTERN =
+        LR"(^\s*(?<callsign>[@](?:ALLCALL|HB)\s+)?(?<type>CQ CQ CQ|CQ DX|CQ QRP|CQ CONTEST|CQ FIELD|CQ FD|CQ CQ|CQ|HB|HEARTBEAT(?!\s+SNR))(?:\s(?<grid>[A-R]{2}[0-9]{2}))?\b)";
+    std::wstring const COMPOUND_PATTERN = L"^\\s*[`]" + CALLSIGN + L"(?<extra>" + GRID + CMD + NUM + L")";
+
+    boost::wregex pcre(std::wstring pattern)
+    {
+        auto const replace = [&pattern](std::wstring const & from, std::wstring const & to)
+        {
+            for (auto at = pattern.find(from); at != std::wstring::npos; at = pattern.find(from, at + to.size()))
+            {
+                pattern.replace(at, from.size(), to);
+            }
+        };
+        replace(L"\\s", L"[\\t\\n\\v\\f\\r ]");
+        replace(L"$", L"(?=\\n?\\z)");
+        return boost::wregex(pattern, boost::regex::perl);
+    }
+
+    boost::wregex const DIRECTED  = pcre(DIRECTED_PATTERN);
+    boost::wregex const HEARTBEAT = pcre(HEARTBEAT_PATTERN);
+    boost::wregex const COMPOUND  = pcre(COMPOUND_PATTERN);
+
+    // A capture, or a match, as text; "-" if absent.
+
+    std::string show(QStringView const view)
+    {
+        if (view.isNull()) return "-";
+        std::string s = "'";
+        for (qsizetype i = 0; i < view.size(); ++i) s += char(view[i].unicode());
+        return s + "'";
+    }
+
+    std::string show(boost::wssub_match const & group)
+    {
+        if (!group.matched) return "-";
+        std::string s = "'";
+        for (auto const c : group.str()) s += char(c);
+        return s + "'";
+    }
+
+    std::string scanned(std::u16string const & text)
+    {
+        QStringView const view(text.data(), text.size());
+        std::string       out;
+
+        if (auto const m = MessageScanner::matchDirected(view))
+            out += "D " + show(m->callsign) + " " + show(m->cmd) + " " + show(m->num) + " " + std::to_string(m->length);
+        else
+            out += "D -";
+
+        if (auto const m = MessageScanner::matchHeartbeat(view))
+            out += " | H " + show(m->type) + " " + show(m->grid) + " " + std::to_string(m->length);
+        else
+            out += " | H -";
+
+        if (auto const m = MessageScanner::matchCompound(view))
+            out += " | C " + show(m->callsign) + " " + show(m->grid) + " " + show(m->cmd) + " " + show(m->num) + " " + std::to_string(m->length);
+        else
+            out += " | C -";
+
+        return out;
+    }
+
+    std::string expected(std::wstring const & text)
+    {
+        std::string    out;
+        boost::wsmatch m;
+
+        if (boost::regex_search(text, m, DIRECTED, boost::match_continuous))
+            out += "D " + show(m["callsign"]) + " " + show(m["cmd"]) + " " + show(m["num"]) + " " + std::to_string(m.length(0));
+        else
+            out += "D -";
+
+        if (boost::regex_search(text, m, HEARTBEAT, boost::match_continuous))
+            out += " | H " + show(m["type"]) + " " + show(m["grid"]) + " " + std::to_string(m.length(0));
+        else
+            out += " | H -";
+
+        if (boost::regex_search(text, m, COMPOUND, boost::match_continuous))
+            out += " | C " + show(m["callsign"]) + " " + show(m["grid"]) + " " + show(m["cmd"]) + " " + show(m["num"]) + " " + std::to_string(m.length(0));
+        else
+            out += " | C -";
+
+        return out;
+    }
+
+    std::string printable(std::u16string const & text)
+    {
+        std::string s;
+        for (auto const c : text)
+        {
+            if (c == '\n')       s += "\\n";
+            else if (c == '\t')  s += "\\t";
+            else if (c < 0x20 || c > 0x7e) s += "\\x" + std::to_string(int(c));
+            else                 s += char(c);
+        }
+        return s;
+    }
+
+    double us(Clock::duration const d, int const n)
+    {
+        return std::chrono::duration<double, std::micro>(d).count() / n;
+    }
+
+    int failures = 0;
+
+    void check(bool const ok, char const * what)
+    {
+        if (!ok) ++failures;
+        std::cout << (ok ? "  ok   " : "  FAIL ") << what << "\n";
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    int const messages = argc > 1 ? std::atoi(argv[1]) : 300000;
+
+    std::vector<std::u16string> const tokens = {
+        u"AGN?", u"QSL?", u"HW CPY?", u"MSG TO:", u"SNR?", u"INFO?", u"GRID?", u"STATUS?",
+        u"QUERY MSGS?", u"HEARING?", u"STATUS", u"HEARING", u"QUERY CALL", u"QUERY MSGS",
+        u"QUERY", u"CMD", u"MSG", u"NACK", u"ACK", u"73", u"YES", u"NO", u"HEARTBEAT SNR",
+        u"HEARTBEAT", u"SNR", u"QSL", u"RR", u"SK", u"FB", u"INFO", u"GRID", u"DIT DIT",
+        u"CQ", u"CQ CQ", u"CQ CQ CQ", u"CQ DX", u"CQ QRP", u"CQ CONTEST", u"CQ FIELD", u"CQ FD",
+        u"HB", u"@ALLCALL", u"@HB", u"@", u"`", u"KN4CRD", u"EM73", u"FN42AB", u"J1Y", u"/P",
+        u"?", u">", u" ", u"  ", u"\t", u"\n", u"\v", u"+", u"-", u"3", u"31", u"30", u"29",
+        u"5", u"12", u"0", u"X", u"a", u"_", u"é", u"SNR 5", u"SNR-10", u"SNR +31"};
+    std::u16string const strays  = u"ABRSXZ0129/ @`?>\t\n-+a_";
+    std::vector<std::u16string> const leads = {u"", u"`", u" `", u"@HB ", u"@ALLCALL  "};
+    std::vector<std::u16string> const grids = {u" EM73", u"\tAR09", u" EM73X", u" EM7", u" EM73 SNR -5"};
+
+    std::mt19937                       rng(35);
+    std::uniform_int_distribution<int> count(0, 7);
+    std::uniform_real_distribution<>   unit;
+
+    int             differences = 0;
+    Clock::duration scanTime{};
+    Clock::duration regexTime{};
+
+    for (int n = 0; n < messages; ++n)
+    {
+        std::u16string text = n % 2 ? leads[rng() % leads.size()] : u"";
+        for (int i = count(rng); i > 0; --i)
+        {
+            if (unit(rng) < 0.8) text += tokens[rng() % tokens.size()];
+            else                 text += strays[rng() % strays.size()];
+        }
+        if (n % 3 == 0)
+        {
+            if (auto const at = text.find(u"KN4CRD"); at != std::u16string::npos)
+            {
+                text.insert(at + 6, grids[rng() % grids.size()]);
+            }
+        }
+
+        std::wstring const wide(text.begin(), text.end());
+
+        auto start = Clock::now();
+        auto const got = scanned(text);
+        scanTime += Clock::now() - start;
+
+        start = Clock::now();
+        auto const want = expected(wide);
+        regexTime += Clock::now() - start;
+
+        if (got != want && ++differences <= 10)
+        {
+            std::cout << "\"" << printable(text) << "\"\n"
+                      << "  scanned:  " << got << "\n"
+                      << "  expected: " << want << "\n";
+        }
+    }
+
+    std::cout << "Matched " << messages << " messages against each grammar\n"
+              << "Scanners: " << us(scanTime, messages) << " us/message, expressions: "
+              << us(regexTime, messages) << " us/message\n";
+
+    check(differences == 0, "matches, captures and lengths as the expressions");
+
+    return failures ? 1 : 0;
+}
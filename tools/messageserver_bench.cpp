@@ -0,0 +1,293 @@
+// Loopback load test of the TCP API server.
+// This is a standalone command-line tool that starts a MessageServer on the
+// loopback interface and connects 50 clients that read everything sent to
+// them, and one that reads nothing. It then floods the server with events,
+// in bursts, as a busy band's decodes would arrive: RX.ACTIVITY for the
+// most part, with an RX.DIRECTED every tenth, half of those to K1ABC.
+//
+// The reading clients are of three kinds, in turn:
+//
+//   - unfiltered, as lines of JSON;
+//   - subscribed to RX.DIRECTED for K1ABC only, as lines of JSON;
+//   - unfiltered, as length-prefixed CBOR.
+//
+// It reports, for each kind, the events and bytes per second received by
+// each client, and checks that each received just what it asked for, and
+// that the client that reads nothing was dropped, rather than left to
+// queue without bound.
+//
+// Build example (adjust Qt include/library paths as needed):
+//   moc JS8_Main/MessageServer.h -o moc_MessageServer.cpp
+//   g++ -std=c++20 -O2 -I. -fPIC tools/messageserver_bench.cpp \
+//       JS8_Main/MessageServer.cpp moc_MessageServer.cpp JS8_Main/Message.cpp \
+//       JS8_Main/MessageError.cpp JS8_Main/DriftingDateTime.cpp \
+//       -lQt6Network -lQt6Core
+//
+// Usage: messageserver_bench [messages] [clients] [port]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QtEndian>
+
+#include "JS8_Main/MessageServer.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    enum Kind { All, Directed, Cbor, Kinds };
+
+    char const * const names[] = {"JSON, unfiltered     ",
+                                  "JSON, RX.DIRECTED    ",
+                                  "CBOR, unfiltered     "};
+
+    // Runs the event loop until the condition holds, or the timeout passes;
+    // returns whether the condition held.
+
+    template <typename F>
+    bool waitFor(F                 && condition,
+                 std::chrono::seconds const timeout)
+    {
+        auto const until = Clock::now() + timeout;
+        while (!condition())
+        {
+            if (Clock::now() > until) return false;
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        }
+        return true;
+    }
+
+    // Events are sent with an _ID of -1, as MainWindow sends them; any
+    // other is taken as the answer to a client's request.
+
+    Message event(int const n)
+    {
+        if (n % 10)
+        {
+            return Message("RX.ACTIVITY", "W1AW: K1ABC SNR -12 ♢", {
+                {"_ID",    -1},
+                {"DIAL",   14078000},
+                {"FREQ",   14078000 + 500 + n % 2000},
+                {"OFFSET", 500 + n % 2000},
+                {"SNR",    -12},
+                {"SPEED",  0},
+                {"TDRIFT", 0.1},
+                {"UTC",    1718000000000LL + n}
+            });
+        }
+
+        auto const to = n % 20 ? "W9XYZ" : "K1ABC";
+        return Message("RX.DIRECTED", QString("W1AW: %1 SNR -12 ♢").arg(to), {
+            {"_ID",    -1},
+            {"FROM",   "W1AW"},
+            {"TO",     to},
+            {"CMD",    " SNR"},
+            {"OFFSET", 500 + n % 2000},
+            {"SNR",    -12},
+            {"UTC",    1718000000000LL + n}
+        });
+    }
+
+    // A reading client; counts the events and bytes it receives.
+
+    struct Reader
+    {
+        Kind       kind;
+        QTcpSocket socket;
+        QByteArray buffer;
+        qint64     events = 0;
+        qint64     bytes  = 0;
+
+        void read()
+        {
+            auto const data = socket.readAll();
+            bytes += data.size();
+
+            if (kind != Cbor)
+            {
+                events += data.count('\n');
+                return;
+            }
+
+            buffer.append(data);
+            qsizetype at = 0;
+            while (buffer.size() - at >= 4)
+            {
+                auto const size = qFromBigEndian<quint32>(buffer.constData() + at);
+                if (buffer.size() - at - 4 < qsizetype(size)) break;
+                at += 4 + size;
+                ++events;
+            }
+            buffer.remove(0, at);
+        }
+    };
+
+    int failures = 0;
+
+    void check(bool const ok, char const * what)
+    {
+        if (!ok) ++failures;
+        std::cout << (ok ? "  ok   " : "  FAIL ") << what << "\n";
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    int     const messages = argc > 1 ? std::atoi(argv[1]) : 200000;
+    int     const clients  = argc > 2 ? std::atoi(argv[2]) : 50;
+    quint16 const port     = argc > 3 ? std::atoi(argv[3]) : 24420;
+    int     const burst    = 100;
+
+    MessageServer server;
+    server.setServer("127.0.0.1", port);
+    if (!server.start())
+    {
+        std::cerr << "messageserver_bench: can't listen on port " << port << "\n";
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<Reader>> readers;
+
+    for (int i = 0; i < clients; ++i)
+    {
+        auto & reader = readers.emplace_back(std::make_unique<Reader>());
+        reader->kind = Kind(i % Kinds);
+        QObject::connect(&reader->socket, &QTcpSocket::readyRead,
+                         [r = reader.get()]() { r->read(); });
+        reader->socket.connectToHost("127.0.0.1", port);
+    }
+
+    // The client that reads nothing; the read buffer's limited, so that
+    // what's sent to it backs up in the server.
+
+    QTcpSocket idle;
+    idle.setReadBufferSize(1024);
+    idle.connectToHost("127.0.0.1", port);
+
+    auto const connected = [&]()
+    {
+        for (auto const & reader : readers)
+        {
+            if (reader->socket.state() != QAbstractSocket::ConnectedState) return false;
+        }
+        return idle.state() == QAbstractSocket::ConnectedState;
+    };
+
+    if (!waitFor(connected, std::chrono::seconds(10)))
+    {
+        std::cerr << "messageserver_bench: clients failed to connect\n";
+        return 1;
+    }
+
+    // Subscribe, and wait for each subscription to be acknowledged, then
+    // start counting afresh.
+
+    for (auto const & reader : readers)
+    {
+        QVariantMap params;
+        if (reader->kind == Directed)
+        {
+            params = {{"TYPES", QStringList{"RX.DIRECTED"}},
+                      {"CALLS", QStringList{"K1ABC"}}};
+        }
+        else
+        {
+            params = {{"FORMAT", reader->kind == Cbor ? "CBOR" : "JSON"}};
+        }
+        reader->socket.write(Message("API.SUBSCRIBE", "", params).toJson() + "\n");
+    }
+
+    auto const subscribed = [&]()
+    {
+        for (auto const & reader : readers)
+        {
+            if (reader->events < 1) return false;
+        }
+        return true;
+    };
+
+    if (!waitFor(subscribed, std::chrono::seconds(10)))
+    {
+        std::cerr << "messageserver_bench: subscriptions weren't acknowledged\n";
+        return 1;
+    }
+
+    for (auto const & reader : readers) reader->events = reader->bytes = 0;
+
+    std::cout << "Sending " << messages << " events to "
+              << clients << " reading clients and 1 idle client...\n";
+
+    int const directed = (messages + 19) / 20;
+    auto const expected = [&](Kind const kind)
+    {
+        return kind == Directed ? directed : messages;
+    };
+
+    auto const start = Clock::now();
+    int        sent  = 0;
+
+    QTimer flood;
+    QObject::connect(&flood, &QTimer::timeout, [&]()
+    {
+        for (int i = 0; i < burst && sent < messages; ++i) server.send(event(sent++));
+        if (sent == messages) flood.stop();
+    });
+    flood.start(0);
+
+    auto const received = [&]()
+    {
+        for (auto const & reader : readers)
+        {
+            if (reader->events < expected(reader->kind)) return false;
+        }
+        return true;
+    };
+
+    bool const done = waitFor(received, std::chrono::seconds(120));
+    auto const s    = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << "Delivered in " << s << " s; per client:\n";
+
+    for (int kind = 0; kind < Kinds; ++kind)
+    {
+        qint64 events = 0, bytes = 0, count = 0;
+        for (auto const & reader : readers)
+        {
+            if (reader->kind != kind) continue;
+            events += reader->events;
+            bytes  += reader->bytes;
+            ++count;
+        }
+        if (!count) continue;
+
+        std::cout << "  " << names[kind]
+                  << events / count / s << " events/s, "
+                  << bytes / count / s / 1024 << " KiB/s\n";
+    }
+
+    waitFor([&]() { return idle.state() == QAbstractSocket::UnconnectedState; },
+            std::chrono::seconds(5));
+
+    bool exact = true;
+    for (auto const & reader : readers)
+    {
+        exact = exact && reader->events == expected(reader->kind);
+    }
+
+    check(done,  "every client received what it subscribed to");
+    check(exact, "and nothing more");
+    check(idle.state() == QAbstractSocket::UnconnectedState,
+          "the idle client was dropped");
+
+    server.stop();
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,215 @@
+// Check of the TX tone synthesizer against the per-sample sine it replaced.
+// This is a standalone command-line tool that renders frames of 79 random
+// tones, for each submode, through the ToneOscillator the modulator uses,
+// in the runs the modulator renders them in: never crossing a 1024-frame
+// block, a symbol, or the start of the fade out. It renders each frame
+// again by the previous method, a phase accumulator and qSin() per sample,
+// and checks:
+//
+//   - that up to the fade out, no sample differs from the previous method
+//     by more than 1 LSB, i.e. that phase is continuous across symbols;
+//   - that rendering is deterministic, bit for bit, from run to run, and
+//     however the frame is divided into runs, to within 1 LSB;
+//   - that the fade out never raises the level, and ends in silence.
+//
+// It reports the time taken per sample by each method.
+//
+// Build example (adjust Qt include/library paths as needed):
+//   g++ -std=c++20 -O2 -I. -fPIC tools/modulator_tones.cpp \
+//       JS8_Mode/ToneOscillator.cpp -lQt6Core
+//
+// Usage: modulator_tones [frames per submode]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include <QtGlobal>
+
+#include "JS8_Include/commons.h"
+#include "JS8_Mode/ToneOscillator.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int         FRAME_RATE   = 48000;
+    constexpr std::size_t BLOCK_FRAMES = 1024;
+    constexpr double      TAU          = 2 * std::numbers::pi;
+    constexpr double      AMPLITUDE    = std::numeric_limits<qint16>::max();
+
+    constexpr unsigned SYMBOL_SAMPLES[] = {JS8A_SYMBOL_SAMPLES, JS8B_SYMBOL_SAMPLES,
+                                           JS8C_SYMBOL_SAMPLES, JS8E_SYMBOL_SAMPLES,
+                                           JS8I_SYMBOL_SAMPLES};
+
+    using Tones = std::vector<int>;
+    using PCM   = std::vector<qint16>;
+
+    // Fade out bounds, as the modulator has them.
+
+    std::pair<std::size_t, std::size_t> fadeBounds(std::size_t const framesPerSymbol)
+    {
+        return {static_cast<std::size_t>((JS8_NUM_SYMBOLS - 0.017) * framesPerSymbol),
+                JS8_NUM_SYMBOLS * framesPerSymbol};
+    }
+
+    // Renders a frame as the modulator does, in runs that are also cut
+    // every `cut` frames, if given, to show that the division into runs
+    // doesn't matter.
+
+    PCM render(Tones const & tones,
+               double const  frequency,
+               unsigned const symbolSamples,
+               std::size_t const cut = 0)
+    {
+        std::size_t const framesPerSymbol = symbolSamples * (FRAME_RATE / JS8_RX_SAMPLE_RATE);
+        auto const [i0, i1] = fadeBounds(framesPerSymbol);
+
+        std::vector<double> ramp(i1 - i0);
+        for (std::size_t i = 0; i < ramp.size(); ++i)
+        {
+            ramp[i] = 0.5 * (1.0 + std::cos(std::numbers::pi * (i + 1) / ramp.size()));
+        }
+
+        ToneOscillator oscillator;
+        oscillator.prepare(frequency, double(JS8_RX_SAMPLE_RATE) / symbolSamples, FRAME_RATE);
+
+        PCM pcm(i1);
+
+        for (std::size_t ic = 0; ic < i1;)
+        {
+            auto frames = std::min({BLOCK_FRAMES - ic % BLOCK_FRAMES,
+                                    framesPerSymbol - ic % framesPerSymbol,
+                                    (ic < i0 ? i0 : i1) - ic});
+            if (cut) frames = std::min(frames, cut - ic % cut);
+
+            oscillator.render(pcm.data() + ic, frames, tones[ic / framesPerSymbol],
+                              ic < i0 ? nullptr : ramp.data() + (ic - i0));
+            ic += frames;
+        }
+
+        return pcm;
+    }
+
+    // The previous method, up to the start of the fade out.
+
+    PCM reference(Tones const & tones,
+                  double const  frequency,
+                  unsigned const symbolSamples)
+    {
+        std::size_t const framesPerSymbol = symbolSamples * (FRAME_RATE / JS8_RX_SAMPLE_RATE);
+        double const      spacing         = double(JS8_RX_SAMPLE_RATE) / symbolSamples;
+        auto const        i0              = fadeBounds(framesPerSymbol).first;
+
+        PCM    pcm(i0);
+        double phi = 0.0;
+
+        for (std::size_t ic = 0; ic < i0; ++ic)
+        {
+            phi += TAU * (frequency + tones[ic / framesPerSymbol] * spacing) / FRAME_RATE;
+            if (phi > TAU) phi -= TAU;
+            pcm[ic] = qRound(AMPLITUDE * std::sin(phi));
+        }
+
+        return pcm;
+    }
+
+    int maxError(PCM const & a, PCM const & b, std::size_t const n)
+    {
+        int error = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            error = std::max(error, std::abs(a[i] - b[i]));
+        }
+        return error;
+    }
+
+    double ns(Clock::duration const d, std::size_t const samples)
+    {
+        return std::chrono::duration<double, std::nano>(d).count() / samples;
+    }
+
+    int failures = 0;
+
+    void check(bool const ok, char const * what)
+    {
+        if (!ok) ++failures;
+        std::cout << (ok ? "  ok   " : "  FAIL ") << what << "\n";
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    int const frames = argc > 1 ? std::atoi(argv[1]) : 20;
+
+    std::mt19937                       rng(27);
+    std::uniform_int_distribution<int> tone(0, 7);
+    std::uniform_real_distribution<>   offset(500.0, 2500.0);
+
+    int              worst          = 0;
+    int              worstCut       = 0;
+    bool             deterministic  = true;
+    bool             fades          = true;
+    std::size_t      samples        = 0;
+    Clock::duration  renderTime{};
+    Clock::duration  referenceTime{};
+
+    for (auto const symbolSamples : SYMBOL_SAMPLES)
+    {
+        for (int n = 0; n < frames; ++n)
+        {
+            Tones tones(JS8_NUM_SYMBOLS);
+            std::generate(tones.begin(), tones.end(), [&]() { return tone(rng); });
+            auto const frequency = offset(rng);
+
+            auto start = Clock::now();
+            auto const pcm = render(tones, frequency, symbolSamples);
+            renderTime += Clock::now() - start;
+
+            start = Clock::now();
+            auto const ref = reference(tones, frequency, symbolSamples);
+            referenceTime += Clock::now() - start;
+
+            samples += ref.size();
+            worst    = std::max(worst, maxError(pcm, ref, ref.size()));
+            worstCut = std::max(worstCut, maxError(pcm, render(tones, frequency, symbolSamples, 997),
+                                                   pcm.size()));
+
+            if (render(tones, frequency, symbolSamples) != pcm) deterministic = false;
+
+            // The envelope of the fade out; the largest magnitude in each
+            // cycle or so never rises, and the last sample is silent.
+
+            int        peak = std::numeric_limits<qint16>::max() + 1;
+            auto const step = std::size_t(FRAME_RATE / frequency) + 1;
+            for (auto i = ref.size(); i < pcm.size(); i += step)
+            {
+                int p = 0;
+                for (auto j = i; j < std::min(i + step, pcm.size()); ++j) p = std::max(p, std::abs(int(pcm[j])));
+                if (p > peak + 1) fades = false;
+                peak = p;
+            }
+            if (pcm.back() != 0) fades = false;
+        }
+    }
+
+    std::cout << "Rendered " << frames * std::size(SYMBOL_SAMPLES) << " frames, "
+              << samples << " samples before the fade out\n"
+              << "Oscillator: " << ns(renderTime, samples) << " ns/sample, qSin: "
+              << ns(referenceTime, samples) << " ns/sample\n"
+              << "Largest difference from qSin: " << worst << " LSB, between divisions into runs: "
+              << worstCut << " LSB\n";
+
+    check(worst <= 1, "within 1 LSB of the per-sample sine");
+    check(deterministic, "identical from run to run");
+    check(worstCut <= 1, "within 1 LSB however divided into runs");
+    check(fades, "fades out without rising, to silence");
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,236 @@
+// Polls made, and changes noticed, by PollingTransceiver's schedule, against
+// the fixed interval it replaced.
+// This is a standalone command-line tool that runs PollSchedule on a
+// simulated clock, a millisecond at a time, against a simulated rig, and
+// the same rig polled at a fixed interval, as PollingTransceiver used to.
+// The transceiver's side is modelled as PollingTransceiver has it: a 50 ms
+// tick, a poll soon after each command, three polls for a command to take
+// effect, and a change signalled when it's polled. The rig takes 30 ms to
+// act on a command. Each run is of an hour, at polling intervals of 1, 3
+// and 10 s, and:
+//
+//   - idle, with nothing asked of the rig, nor done to it;
+//   - operating, transmitting one 15 s period in four, so PTT on and off
+//     once a minute, and the dial turned at the rig in one minute in two,
+//     at a random time while receiving.
+//
+// The schedule is run as polled, as a rig that doesn't report its own
+// changes is, and as reported, as one that does, in Hamlib's transceive
+// mode, and that reports each change, its own and those commanded, at
+// once; its polls then back off to 30 s.
+//
+// It reports, for each, the polls made, the timer's wakeups, and the time
+// taken to notice a change, mean and worst, from a command being sent, and
+// from the dial being turned. Each poll is a handful of CAT commands, as
+// many as the rig needs asked to learn its frequencies, mode, split and
+// PTT; see tools/rigctld_sim.cpp for the commands a rig sees.
+//
+// Build example:
+//   g++ -std=c++20 -O2 -I. tools/poll_schedule_check.cpp
+//
+// Usage: poll_schedule_check [seed]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "JS8_Transceiver/PollSchedule.h"
+
+namespace
+{
+    using Time = PollSchedule::Time;
+
+    // as PollingTransceiver has them
+    int      constexpr TICK      = 50;
+    int      constexpr REPORTED  = 30000;
+    unsigned constexpr RETRIES   = 3;
+
+    // time the rig takes to act on a command
+    int      constexpr SETTLE    = 30;
+    Time     constexpr HOUR      = 3600 * 1000;
+
+    enum class Policy { Fixed, Polled, Reported };
+
+    char const * name(Policy const policy)
+    {
+        switch (policy)
+        {
+            case Policy::Fixed:  return "fixed";
+            case Policy::Polled: return "polled";
+            default:             return "reported";
+        }
+    }
+
+    // A change of the rig's state, to a value no earlier change had; a
+    // command sent to it, or the dial turned at it.
+    struct Event
+    {
+        Time at;
+        int  value;
+        bool dial;
+    };
+
+    struct Latency
+    {
+        long   count = 0;
+        double total = 0;
+        Time   worst = 0;
+
+        void add(Time const t)
+        {
+            ++count;
+            total += t;
+            worst  = std::max(worst, t);
+        }
+
+        double mean() const { return count ? total / count : 0; }
+    };
+
+    struct Result
+    {
+        long    polls   = 0;
+        long    wakeups = 0;
+        Latency command;
+        Latency dial;
+    };
+
+    Result run(Policy const              policy,
+               int const                 interval,
+               std::vector<Event> const & events)
+    {
+        Result       result;
+        PollSchedule schedule{policy == Policy::Reported ? std::max(interval, REPORTED) : interval};
+        schedule.soon(0);
+
+        // the rig, and the commands it's yet to act on
+        int                               rig = 0;
+        std::vector<std::pair<Time, int>> acting;
+
+        // the transceiver, and the changes it's yet to notice
+        int                state     = 0;
+        int                next      = 0;
+        int                signalled = 0;
+        unsigned           retries   = 0;
+        bool               changed   = false;
+        std::vector<Event> unnoticed;
+
+        auto event = events.begin();
+
+        for (Time now = 0; now < HOUR; ++now)
+        {
+            for (; event != events.end() && event->at == now; ++event)
+            {
+                unnoticed.push_back(*event);
+                if (event->dial)
+                {
+                    rig     = event->value;
+                    changed = policy == Policy::Reported;
+                }
+                else
+                {
+                    acting.emplace_back(now + SETTLE, event->value);
+                    next    = event->value;
+                    retries = RETRIES;
+                    if (policy != Policy::Fixed) schedule.soon(now);
+                }
+            }
+            while (!acting.empty() && acting.front().first == now)
+            {
+                rig     = acting.front().second;
+                changed = changed || policy == Policy::Reported;
+                acting.erase(acting.begin());
+            }
+
+            bool poll;
+            if (policy == Policy::Fixed)
+            {
+                poll = now && !(now % interval);
+                result.wakeups += poll;
+            }
+            else
+            {
+                if (now % TICK) continue;
+                ++result.wakeups;
+                poll = std::exchange(changed, false) || schedule.due(now);
+            }
+            if (!poll) continue;
+
+            // PollingTransceiver::do_sync()
+            ++result.polls;
+            int const before = state;
+            state = rig;
+
+            bool signal;
+            if (retries)
+            {
+                --retries;
+                signal = state == next || !retries;
+            }
+            else
+            {
+                signal = state != signalled;
+            }
+            if (signal)
+            {
+                retries   = 0;
+                next      = state;
+                signalled = state;
+                std::erase_if(unnoticed, [&](Event const & e)
+                {
+                    if (e.value > state) return false;
+                    (e.dial ? result.dial : result.command).add(now - e.at);
+                    return true;
+                });
+            }
+
+            if (policy != Policy::Fixed) schedule.polled(now, retries || state != before);
+        }
+        return result;
+    }
+
+    std::vector<Event> operating(std::mt19937 & rng)
+    {
+        std::uniform_int_distribution<Time> receiving(20000, 58000);
+
+        std::vector<Event> events;
+        int                value = 0;
+
+        for (Time minute = 0; minute < HOUR; minute += 60000)
+        {
+            events.push_back({minute + 1000, ++value, false});  // PTT on
+            events.push_back({minute + 13600, ++value, false}); // PTT off
+            if (rng() % 2) events.push_back({minute + receiving(rng), ++value, true});
+        }
+        return events;
+    }
+
+    void report(char const * const         scenario,
+                std::vector<Event> const & events)
+    {
+        std::printf("%s\n", scenario);
+        std::printf("  %-8s %-9s %8s %9s %20s %20s\n", "interval", "schedule",
+                    "polls", "wakeups", "command ms mean/max", "dial ms mean/max");
+        for (int const seconds : {1, 3, 10})
+        {
+            for (auto const policy : {Policy::Fixed, Policy::Polled, Policy::Reported})
+            {
+                auto const r = run(policy, seconds * 1000, events);
+                std::printf("  %6d s %-9s %8ld %9ld %12.0f/%-7lld %12.0f/%-7lld\n",
+                            seconds, name(policy), r.polls, r.wakeups,
+                            r.command.mean(), static_cast<long long>(r.command.worst),
+                            r.dial.mean(), static_cast<long long>(r.dial.worst));
+            }
+        }
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    std::mt19937 rng(argc > 1 ? std::atoi(argv[1]) : 49);
+
+    report("idle, an hour", {});
+    report("operating, an hour", operating(rng));
+}
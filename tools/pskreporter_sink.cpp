@@ -0,0 +1,295 @@
+// Loopback check of the IPFIX messages sent to PSK Reporter.
+// This is a standalone command-line tool that encodes an hour of spots, as
+// a busy band might bring, 10,000 of them by default, through the writer the
+// reporter uses, reporting every 10 minutes, as the reporter does, and sends
+// each message by UDP to a sink on the loopback interface, which takes it
+// apart, set by set, and checks it against what PSK Reporter expects:
+//
+//   - a version 10 header, whose length is that of the datagram, and whose
+//     sequence numbers run on without a gap;
+//   - the record format descriptors in the first 3 messages, and no others;
+//   - the receiver information record in every message;
+//   - sets padded to 4 bytes, and counted as such in their lengths;
+//   - spot records that parse exactly, and that arrive in the order added;
+//   - strings that are valid UTF-8, no longer than 254 bytes, even when
+//     the strings they were made from were longer;
+//   - no datagram over 10,000 bytes.
+//
+// It reports the time taken to encode a spot.
+//
+// Build example (adjust Qt include/library paths as needed):
+//   g++ -std=c++20 -O2 -I. -fPIC tools/pskreporter_sink.cpp \
+//       JS8_Network/IPFIXWriter.cpp JS8_Main/DriftingDateTime.cpp \
+//       -lQt6Network -lQt6Core
+//
+// Usage: pskreporter_sink [spots] [port]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include <QCoreApplication>
+#include <QNetworkDatagram>
+#include <QUdpSocket>
+#include <QtEndian>
+
+#include "JS8_Network/IPFIXWriter.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr Radio::Frequency BASE = 14078000;
+
+    // Spot n is from a call of its own, on its own frequency; every 500th
+    // has a mode, and every 700th a grid, longer than PSK Reporter allows,
+    // in multi-byte characters, so that truncation can't fall evenly.
+
+    QString call(int const n)
+    {
+        return QString("W%1XY").arg(n);
+    }
+
+    QString mode(int const n)
+    {
+        return n % 500 ? QString("JS8") : QString(200, QChar(0x00e9)) + "x";
+    }
+
+    QString grid(int const n)
+    {
+        return n % 700 ? QString("FN42") : "x" + QString(100, QChar(0x20ac));
+    }
+
+    // Reads big-endian values and strings from a datagram, noting any
+    // attempt to read past the end of the range it's given.
+
+    struct Reader
+    {
+        char const * at;
+        char const * end;
+        bool         ok = true;
+
+        qsizetype left() const { return end - at; }
+
+        template <typename T>
+        T get()
+        {
+            if (left() < qsizetype(sizeof(T))) { ok = false; at = end; return T{}; }
+            auto const value = qFromBigEndian<T>(at);
+            at += sizeof(T);
+            return value;
+        }
+
+        QByteArray string()
+        {
+            auto const size = get<quint8>();
+            if (left() < size) { ok = false; at = end; return {}; }
+            QByteArray const value(at, size);
+            at += size;
+            return value;
+        }
+    };
+
+    bool validUtf8(QByteArray const & s)
+    {
+        return s.size() <= 254 && QString::fromUtf8(s).toUtf8() == s;
+    }
+
+    // Checks of the messages received, as counts of those that failed.
+
+    struct Sink
+    {
+        QUdpSocket socket;
+        qint64     messages    = 0;
+        qint64     spots       = 0;
+        qint64     descriptors = 0;
+        qint64     bad         = 0;
+        qint64     misordered  = 0;
+        qint64     badStrings  = 0;
+        qint64     truncated   = 0;
+        qint64     largest     = 0;
+        quint32    sequence    = 0;
+
+        void read()
+        {
+            while (socket.hasPendingDatagrams())
+            {
+                take(socket.receiveDatagram().data());
+            }
+        }
+
+        void take(QByteArray const & message)
+        {
+            ++messages;
+            largest = std::max<qint64>(largest, message.size());
+
+            Reader header{message.constData(), message.constData() + message.size()};
+            auto const version = header.get<quint16>();
+            auto const length  = header.get<quint16>();
+            header.get<quint32>(); // Export Time
+            auto const seq     = header.get<quint32>();
+            header.get<quint32>(); // Observation Domain ID
+
+            if (!header.ok || version != 10 || length != message.size() ||
+                message.size() % 4 || message.size() > 10000 ||
+                seq != sequence + 1)
+            {
+                ++bad;
+            }
+            sequence = seq;
+
+            bool receiver = false;
+            bool templates = false;
+
+            while (header.ok && header.left() > 0)
+            {
+                auto const set  = header.get<quint16>();
+                auto const size = header.get<quint16>();
+
+                if (!header.ok || size < 4 || size % 4 || size - 4 > header.left())
+                {
+                    ++bad;
+                    return;
+                }
+
+                Reader r{header.at, header.at + size - 4};
+                header.at = r.end;
+
+                switch (set)
+                {
+                    case 2:
+                        templates = r.get<quint16>() == 0x50e3 && r.get<quint16>() == 7;
+                        r.at = r.end;
+                        break;
+
+                    case 3:
+                        templates = templates && r.get<quint16>() == 0x50e2 && r.get<quint16>() == 4;
+                        r.at = r.end;
+                        break;
+
+                    case 0x50e2:
+                        receiver = r.string() == "K1ABC" && r.string() == "FN42" &&
+                                   r.string() == "pskreporter_sink" && r.string() == "Dipole";
+                        break;
+
+                    case 0x50e3:
+                        // A record takes at least 14 bytes; less than 4 left
+                        // must be padding.
+                        while (r.ok && r.left() >= 4)
+                        {
+                            auto const from = r.string();
+                            auto const high = Radio::Frequency(r.get<quint8>()) << 32;
+                            auto const freq = high | r.get<quint32>();
+                            r.get<qint8>();
+                            auto const m = r.string();
+                            auto const g = r.string();
+                            auto const source = r.get<quint8>();
+                            r.get<quint32>();
+
+                            if (!r.ok || source != 1) break;
+
+                            if (from != call(spots).toUtf8() || freq != BASE + spots) ++misordered;
+                            if (!validUtf8(from) || !validUtf8(m) || !validUtf8(g)) ++badStrings;
+                            if (m.size() > 4 || g.size() > 4) ++truncated;
+                            ++spots;
+                        }
+                        break;
+
+                    default:
+                        ++bad;
+                        return;
+                }
+
+                if (!r.ok) { ++bad; return; }
+
+                // Padding, if any, is NUL bytes.
+                for (; r.at < r.end; ++r.at)
+                {
+                    if (*r.at) { ++bad; return; }
+                }
+            }
+
+            if (!receiver) ++bad;
+            if (templates) ++descriptors;
+        }
+    };
+
+    int failures = 0;
+
+    void check(bool const ok, char const * what)
+    {
+        if (!ok) ++failures;
+        std::cout << (ok ? "  ok   " : "  FAIL ") << what << "\n";
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    int     const total   = argc > 1 ? std::atoi(argv[1]) : 10000;
+    quint16 const port    = argc > 2 ? std::atoi(argv[2]) : 24739;
+    int     const reports = 6; // an hour, every 10 minutes
+
+    Sink sink;
+    if (!sink.socket.bind(QHostAddress::LocalHost, port))
+    {
+        std::cerr << "pskreporter_sink: can't bind port " << port << "\n";
+        return 1;
+    }
+    sink.socket.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 1 << 22);
+    QObject::connect(&sink.socket, &QUdpSocket::readyRead, [&]() { sink.read(); });
+
+    QUdpSocket out;
+    qint64     sent = 0;
+
+    IPFIXWriter writer(0x4a533843, [&](QByteArray const & message)
+    {
+        out.writeDatagram(message, QHostAddress::LocalHost, port);
+        ++sent;
+    });
+    writer.setReceiver("K1ABC", "FN42", "pskreporter_sink", "Dipole");
+    writer.sendDescriptors(3);
+
+    std::cout << "Encoding " << total << " spots in " << reports << " reports...\n";
+
+    auto const time = QDateTime::currentDateTimeUtc();
+    Clock::duration encoding{};
+    int n     = 0;
+    int longs = 0;
+
+    for (int report = 1; report <= reports; ++report)
+    {
+        auto const start = Clock::now();
+        for (; n < total * report / reports; ++n)
+        {
+            if (!(n % 500) || !(n % 700)) ++longs;
+            writer.add(call(n), grid(n), BASE + n, mode(n), -12 + n % 20, time.addSecs(n * 3600 / total));
+        }
+        writer.finish(report == reports);
+        encoding += Clock::now() - start;
+
+        // Let the sink keep up, as it would across 10 minutes.
+        auto const until = Clock::now() + std::chrono::seconds(5);
+        while (sink.messages < sent && Clock::now() < until)
+        {
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        }
+    }
+
+    auto const us = std::chrono::duration<double, std::micro>(encoding).count();
+    std::cout << "Encoded in " << us / 1000 << " ms, " << us / total << " us/spot; "
+              << sent << " messages, the largest " << sink.largest << " bytes\n";
+
+    check(sink.messages == sent, "every message received");
+    check(sink.bad == 0, "headers, sets, lengths, and padding well formed");
+    check(sink.descriptors == 3, "descriptors in the first 3 messages only");
+    check(sink.spots == total, "every spot record parsed");
+    check(sink.misordered == 0, "spots in the order added");
+    check(sink.badStrings == 0, "strings valid UTF-8 of at most 254 bytes");
+    check(sink.truncated == longs, "long strings truncated, not dropped");
+    check(writer.pending() == 0, "nothing left unsent after the flush");
+
+    return failures ? 1 : 0;
+}
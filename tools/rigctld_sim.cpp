@@ -0,0 +1,358 @@
+// Latency and CAT traffic check of transceiver polling, against a simulated
+// rigctld.
+// This is a standalone command-line tool that serves enough of the rigctld
+// protocol, on the loopback interface, for Hamlib's network rig (model 2) to
+// open and poll it, and drives a HamlibTransceiver against it, as the main
+// window does, with the polling interval given. It then measures:
+//
+//   - the commands the rig sees while idle, in a minute by default, which
+//     back off to one poll per interval once the state holds still;
+//   - the time taken to notice the dial being turned, which is at most an
+//     interval, and is less the more recently the state last moved;
+//   - the time from a command to the first poll that follows it, and the
+//     commands sent in the interval after, as polls come quickly to check
+//     that the rig has done as asked.
+//
+// rigctld reports no changes of its own, so changes are only ever noticed
+// by polling; rigs that do report them, in Hamlib's transceive mode, can
+// be asked to with "transceive": true in hamlib_settings.json.
+//
+// Build example (adjust Qt and Hamlib include/library paths as needed):
+//   for h in Transceiver TransceiverBase PollingTransceiver HamlibTransceiver; do
+//       moc JS8_Transceiver/$h.h -o moc_$h.cpp; done
+//   g++ -std=c++20 -O2 -I. -IJS8_Transceiver -fPIC tools/rigctld_sim.cpp \
+//       JS8_Transceiver/Transceiver.cpp JS8_Transceiver/TransceiverBase.cpp \
+//       JS8_Transceiver/PollingTransceiver.cpp \
+//       JS8_Transceiver/HamlibTransceiver.cpp JS8_Main/Radio.cpp \
+//       JS8_Main/qt_helpers.cpp -lhamlib -lQt6Network -lQt6Core
+//
+// Usage: rigctld_sim [poll interval, s] [idle time, s] [port]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+
+#include "JS8_Transceiver/HamlibTransceiver.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // What rigctld sends in reply to \dump_state, protocol version 0, for
+    // an HF rig without frills.
+
+    constexpr char DUMP_STATE[] =
+        "0\n"
+        "2\n"
+        "2\n"
+        "150000.000000 30000000.000000 0x1ff -1 -1 0x10000003 0x3\n"
+        "0 0 0 0 0 0 0\n"
+        "150000.000000 30000000.000000 0x1ff 5000 100000 0x10000003 0x3\n"
+        "0 0 0 0 0 0 0\n"
+        "0x1ff 1\n"
+        "0 0\n"
+        "0x1ff 2400\n"
+        "0 0\n"
+        "9990\n"
+        "9990\n"
+        "10000\n"
+        "0\n"
+        "10\n"
+        "10 20 30\n"
+        "0x0\n"
+        "0x0\n"
+        "0x0\n"
+        "0x0\n"
+        "0x0\n"
+        "0x0\n";
+
+    // The simulated rig, served on a thread of its own, since Hamlib's
+    // calls block the thread that makes them until they're answered.
+
+    struct Rig
+    {
+        std::mutex          mutex;
+        Radio::Frequency    frequency = 14078000;
+        bool                ptt       = false;
+
+        std::atomic<int>    commands{0};
+        std::atomic<int>    gets{0};
+        std::atomic<int>    sets{0};
+
+        Clock::time_point   lastSet;
+        Clock::time_point   firstGetAfterSet;
+        bool                awaitingGet = false;
+
+        void dial(Radio::Frequency const f)
+        {
+            std::lock_guard lock(mutex);
+            frequency = f;
+        }
+
+        QByteArray reply(QByteArray line)
+        {
+            while (!line.isEmpty() && QByteArray("+;|,").contains(line[0])) line.remove(0, 1);
+
+            auto const args = line.simplified().split(' ');
+            auto const cmd  = args.value(0);
+
+            ++commands;
+            std::lock_guard lock(mutex);
+
+            auto const get = [&]()
+            {
+                ++gets;
+                if (awaitingGet)
+                {
+                    firstGetAfterSet = Clock::now();
+                    awaitingGet      = false;
+                }
+            };
+
+            auto const set = [&]()
+            {
+                ++sets;
+                lastSet     = Clock::now();
+                awaitingGet = true;
+                return QByteArray("RPRT 0\n");
+            };
+
+            if (cmd == "\\chk_vfo")       return "CHKVFO 0\n";
+            if (cmd == "\\dump_state")    return DUMP_STATE;
+            if (cmd == "\\get_powerstat") return "1\n";
+
+            if (cmd == "f" || cmd == "\\get_freq")
+            {
+                get();
+                return QByteArray::number(frequency) + "\n";
+            }
+            if (cmd == "i" || cmd == "\\get_split_freq")
+            {
+                get();
+                return QByteArray::number(frequency) + "\n";
+            }
+            if (cmd == "m" || cmd == "\\get_mode" || cmd == "x" || cmd == "\\get_split_mode")
+            {
+                get();
+                return "USB\n2400\n";
+            }
+            if (cmd == "v" || cmd == "\\get_vfo")
+            {
+                get();
+                return "VFOA\n";
+            }
+            if (cmd == "s" || cmd == "\\get_split_vfo")
+            {
+                get();
+                return "0\nVFOA\n";
+            }
+            if (cmd == "t" || cmd == "\\get_ptt")
+            {
+                get();
+                return ptt ? "1\n" : "0\n";
+            }
+
+            if (cmd == "F" || cmd == "\\set_freq")
+            {
+                frequency = Radio::Frequency(args.value(1).toDouble());
+                return set();
+            }
+            if (cmd == "T" || cmd == "\\set_ptt")
+            {
+                ptt = args.value(1).toInt();
+                return set();
+            }
+            if (cmd == "M" || cmd == "\\set_mode" || cmd == "V" || cmd == "\\set_vfo" ||
+                cmd == "S" || cmd == "\\set_split_vfo" || cmd == "I" || cmd == "\\set_split_freq" ||
+                cmd == "X" || cmd == "\\set_split_mode")
+            {
+                return set();
+            }
+
+            return "RPRT -11\n"; // -RIG_ENAVAIL
+        }
+
+        void serve(quint16 const port)
+        {
+            QTcpServer server;
+            if (!server.listen(QHostAddress::LocalHost, port))
+            {
+                std::cerr << "rigctld_sim: can't listen on port " << port << "\n";
+                return;
+            }
+
+            QObject::connect(&server, &QTcpServer::newConnection, &server, [&]()
+            {
+                while (auto const socket = server.nextPendingConnection())
+                {
+                    QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, socket]()
+                    {
+                        while (socket->canReadLine())
+                        {
+                            socket->write(reply(socket->readLine()));
+                        }
+                    });
+                    QObject::connect(socket, &QTcpSocket::disconnected,
+                                     socket, &QObject::deleteLater);
+                }
+            });
+
+            QEventLoop loop;
+            loop.exec();
+        }
+    };
+
+    // Runs the event loop until the condition holds, or the timeout passes;
+    // returns whether the condition held.
+
+    template <typename F>
+    bool waitFor(F                      && condition,
+                 std::chrono::milliseconds const timeout)
+    {
+        auto const until = Clock::now() + timeout;
+        while (!condition())
+        {
+            if (Clock::now() > until) return false;
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 5);
+        }
+        return true;
+    }
+
+    void idle(std::chrono::milliseconds const time)
+    {
+        waitFor([]() { return false; }, time);
+    }
+
+    double ms(Clock::duration const d)
+    {
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+
+    int failures = 0;
+
+    void check(bool const ok, char const * what)
+    {
+        if (!ok) ++failures;
+        std::cout << (ok ? "  ok   " : "  FAIL ") << what << "\n";
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    int     const interval = argc > 1 ? std::atoi(argv[1]) : 1;
+    int     const idleTime = argc > 2 ? std::atoi(argv[2]) : 60;
+    quint16 const port     = argc > 3 ? std::atoi(argv[3]) : 24532;
+    auto    const period   = std::chrono::milliseconds(interval * 1000);
+
+    Rig  rig;
+    auto server = QThread::create([&]() { rig.serve(port); });
+    server->start();
+    QThread::msleep(200);
+
+    TransceiverFactory::ParameterPack params{};
+    params.network_port  = QString("127.0.0.1:%1").arg(port);
+    params.ptt_type      = TransceiverFactory::PTT_method_CAT;
+    params.poll_interval = interval;
+
+    HamlibTransceiver transceiver(2, params); // RIG_MODEL_NETRIGCTL
+
+    Transceiver::TransceiverState state;
+    Clock::time_point             updated;
+    QString                       failure;
+
+    QObject::connect(&transceiver, &Transceiver::update,
+                     [&](Transceiver::TransceiverState const & s, unsigned)
+                     {
+                         state   = s;
+                         updated = Clock::now();
+                     });
+    QObject::connect(&transceiver, &Transceiver::failure,
+                     [&](QString const & reason) { failure = reason; });
+
+    transceiver.start(1);
+
+    if (!waitFor([&]() { return state.online() || !failure.isEmpty(); },
+                 std::chrono::seconds(10)) || !failure.isEmpty())
+    {
+        std::cerr << "rigctld_sim: transceiver failed to start: "
+                  << failure.toStdString() << "\n";
+        server->quit();
+        server->wait();
+        return 1;
+    }
+
+    // Idle; let the polls back off, and count what the rig sees.
+
+    idle(period * 4);
+    rig.commands = rig.gets = 0;
+    idle(std::chrono::seconds(idleTime));
+
+    double const idlePerMinute = rig.commands * 60.0 / idleTime;
+    std::cout << "Idle: " << idlePerMinute << " commands/min, at most "
+              << 60 / interval << " polls/min expected\n";
+
+    // Turn the dial, at various times since the state last moved.
+
+    double worst = 0, total = 0;
+    int    const turns = 10;
+
+    for (int n = 1; n <= turns; ++n)
+    {
+        auto const f = 14078000 + n * 1000;
+        auto const start = Clock::now();
+        rig.dial(f);
+
+        waitFor([&]() { return state.frequency() == Radio::Frequency(f); }, period * 3);
+        auto const latency = ms(updated - start);
+        worst  = std::max(worst, latency);
+        total += latency;
+
+        idle(period * (n % 4) / 2);
+    }
+
+    std::cout << "Dial turned: " << total / turns << " ms to notice on average, "
+              << worst << " ms at worst\n";
+
+    // Command the rig, and see how soon it's polled, and how much.
+
+    idle(period * 4);
+    rig.commands = 0;
+
+    auto desired = state;
+    desired.frequency(7078000);
+    transceiver.set(desired, 2);
+
+    waitFor([&]() { std::lock_guard lock(rig.mutex); return !rig.awaitingGet; }, period * 2);
+    Clock::duration followUp;
+    {
+        std::lock_guard lock(rig.mutex);
+        followUp = rig.firstGetAfterSet - rig.lastSet;
+    }
+    idle(period);
+
+    std::cout << "Commanded: first poll after " << ms(followUp) << " ms, "
+              << rig.commands << " commands in the interval after\n";
+
+    check(idlePerMinute > 0, "polled while idle");
+    check(worst <= interval * 1000 + 250, "dial turns noticed within an interval");
+    check(ms(followUp) < interval * 1000, "polled sooner than an interval after a command");
+    check(state.frequency() == 7078000, "the commanded frequency reported");
+
+    transceiver.stop();
+    server->quit();
+    server->wait();
+    delete server;
+
+    return failures ? 1 : 0;
+}
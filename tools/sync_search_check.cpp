@@ -0,0 +1,246 @@
+// Differential check, and benchmark, of the sync search that syncjs8() makes.
+// This is a standalone command-line tool that fills the symbol spectra with
+// random power, and runs the sync search over them, for each submode, over
+// the whole of the wideband range, as js8::syncSearch() does it, and as it
+// was done before, copied here as it was, with the spectra held by
+// frequency, then time, and each bin searched on its own. It compares the
+// sync metric of every bin, bit for bit, and the offset at which it was
+// found. The spectra hold:
+//
+//   - noise, exponentially distributed, as the power of Gaussian noise is;
+//   - signals, each the Costas arrays at an offset and a bin, strong and
+//     weak, so that the metric peaks, and at times ties;
+//   - a band of nothing but zeros, whose metric is NaN at every offset,
+//     so that the bins in it are left with no metric at all.
+//
+// It reports the time taken by each search, and the speed-up.
+//
+// Build example:
+//   g++ -std=c++20 -O3 -I. tools/sync_search_check.cpp
+//
+// Usage: sync_search_check [repetitions]
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "JS8_Mode/sync_search.h"
+
+namespace
+{
+    using Clock  = std::chrono::steady_clock;
+    using Costas = std::array<std::array<int, 7>, 3>;
+
+    constexpr int NFOS = 2;
+    constexpr int NSSY = 4;
+
+    constexpr Costas ORIGINAL = {{{4, 2, 5, 6, 1, 3, 0},
+                                  {4, 2, 5, 6, 1, 3, 0},
+                                  {4, 2, 5, 6, 1, 3, 0}}};
+    constexpr Costas MODIFIED = {{{0, 6, 2, 3, 5, 4, 1},
+                                  {1, 5, 0, 2, 3, 6, 4},
+                                  {2, 5, 0, 6, 4, 1, 3}}};
+
+    struct Found
+    {
+        float sync;
+        int   offset;
+    };
+
+    // As JS8.cpp has each submode, but for what the search doesn't use.
+
+    template <int SPS, int TXDUR, int Z, int START_MS, Costas const & ARRAY>
+    struct Mode
+    {
+        static constexpr int    NSPS   = SPS;
+        static constexpr int    NMAX   = TXDUR * 12000;
+        static constexpr int    NSTEP  = NSPS / NSSY;
+        static constexpr int    NHSYM  = NMAX / NSTEP - 3;
+        static constexpr int    JZ     = Z;
+        static constexpr float  ASTART = START_MS / 1000.0f;
+        static constexpr float  TSTEP  = NSTEP / 12000.0f;
+        static constexpr int    JSTRT  = ASTART / TSTEP;
+        static constexpr auto & COSTAS = ARRAY;
+    };
+
+    using ModeA = Mode<1920, 15,  62, 500, ORIGINAL>;
+    using ModeB = Mode<1200, 10, 144, 200, MODIFIED>;
+    using ModeC = Mode< 600,  6, 172, 100, MODIFIED>;
+    using ModeE = Mode<3840, 30,  32, 500, MODIFIED>;
+    using ModeI = Mode< 384,  4, 250, 100, MODIFIED>;
+
+    // The search as syncjs8() made it, with s[frequency][time].
+
+    template <typename M>
+    void previous(std::array<std::array<float, M::NHSYM>, M::NSPS> const & s,
+                  int const                                               ia,
+                  int const                                               ib,
+                  std::vector<Found>                                    & found)
+    {
+        for (int i = ia; i <= ib; ++i) {
+            float max_value = -std::numeric_limits<float>::infinity();
+            int max_index = -M::JZ;
+
+            for (int j = -M::JZ; j <= M::JZ; ++j) {
+                std::array<std::array<float, 3>, 2> t{};
+
+                for (int p = 0; p < 3; ++p) {
+                    for (int n = 0; n < 7; ++n) {
+                        int const offset =
+                            j + M::JSTRT + NSSY * n + p * 36 * NSSY;
+
+                        if (offset >= 0 && offset < M::NHSYM) {
+                            t[0][p] += s[i + NFOS * M::COSTAS[p][n]][offset];
+
+                            for (int freq = 0; freq < 7; ++freq) {
+                                t[1][p] += s[i + NFOS * freq][offset];
+                            }
+                        }
+                    }
+                }
+
+                auto const compute_sync = [&t](int start, int end) {
+                    float tx = 0.0f;
+                    float t0 = 0.0f;
+
+                    for (int i = start; i <= end; ++i) {
+                        tx += t[0][i];
+                        t0 += t[1][i];
+                    }
+
+                    return tx / ((t0 - tx) / 6.0f);
+                };
+
+                if (auto const sync_value =
+                        std::max({compute_sync(0, 2), compute_sync(0, 1),
+                                  compute_sync(1, 2)});
+                    sync_value > max_value) {
+                    max_value = sync_value;
+                    max_index = j;
+                }
+            }
+
+            found.push_back({max_value, max_index});
+        }
+    }
+
+    double ms(Clock::duration const d)
+    {
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+
+    int failures = 0;
+
+    template <typename M>
+    void check(char const * const name,
+               int const          repetitions,
+               std::mt19937     & rng)
+    {
+        using ByFrequency = std::array<std::array<float, M::NHSYM>, M::NSPS>;
+        using ByTime      = std::array<std::array<float, M::NSPS>, M::NHSYM>;
+
+        auto const before = std::make_unique<ByFrequency>();
+        auto const now    = std::make_unique<ByTime>();
+
+        std::exponential_distribution<float> noise(1.0f);
+        for (auto & row : *before)
+            for (auto & power : row) power = noise(rng);
+
+        // signals, strong and weak, all over
+        std::uniform_int_distribution<int> bin(0, M::NSPS - 1 - NFOS * 7);
+        std::uniform_int_distribution<int> offset(-M::JZ, M::JZ);
+        for (int k = 0; k < M::NSPS / 20; ++k)
+        {
+            int const   i     = bin(rng);
+            int const   j     = offset(rng);
+            float const power = k % 2 ? 2.0f : 50.0f;
+
+            for (int p = 0; p < 3; ++p)
+                for (int n = 0; n < 7; ++n)
+                {
+                    int const at = j + M::JSTRT + NSSY * n + p * 36 * NSSY;
+                    if (at >= 0 && at < M::NHSYM) (*before)[i + NFOS * M::COSTAS[p][n]][at] += power;
+                }
+        }
+
+        // a band of nothing at all
+        for (int i = M::NSPS / 2; i < M::NSPS / 2 + 40; ++i) (*before)[i].fill(0.0f);
+
+        for (int i = 0; i < M::NSPS; ++i)
+            for (int j = 0; j < M::NHSYM; ++j) (*now)[j][i] = (*before)[i][j];
+
+        // the wideband range, as syncjs8() clamps it
+        int const ia = 0;
+        int const ib = M::NSPS - 1 - NFOS * 7;
+
+        std::vector<Found> was;
+        std::vector<Found> is;
+        Clock::duration    wasTime{};
+        Clock::duration    isTime{};
+
+        for (int r = 0; r < repetitions; ++r)
+        {
+            was.clear();
+            is.clear();
+
+            auto const start = Clock::now();
+            previous<M>(*before, ia, ib, was);
+            auto const middle = Clock::now();
+            js8::syncSearch<M::NHSYM, M::NSPS, NFOS, NSSY, M::JZ, M::JSTRT>(
+                *now, M::COSTAS, ia, ib,
+                [&is](int, float sync, int offset) { is.push_back({sync, offset}); });
+            auto const end = Clock::now();
+
+            wasTime += middle - start;
+            isTime  += end - middle;
+        }
+
+        int differences = 0;
+        int nans        = 0;
+        for (std::size_t k = 0; k < was.size(); ++k)
+        {
+            nans += !std::isfinite(was[k].sync);
+            if (std::memcmp(&was[k].sync, &is[k].sync, sizeof(float)) ||
+                was[k].offset != is[k].offset)
+            {
+                if (!differences)
+                {
+                    std::printf("  bin %zu: %.9g at %d before, %.9g at %d now\n", k,
+                                was[k].sync, was[k].offset, is[k].sync, is[k].offset);
+                }
+                ++differences;
+            }
+        }
+
+        bool const ok = was.size() == is.size() && !differences;
+        if (!ok) ++failures;
+
+        std::printf("%s: %zu bins, %d offsets, %d with no metric; %s; %.2f ms before, %.2f ms now, %.1fx\n",
+                    name, was.size(), 2 * M::JZ + 1, nans,
+                    ok ? "identical" : "DIFFERENT",
+                    ms(wasTime) / repetitions, ms(isTime) / repetitions,
+                    ms(wasTime) / ms(isTime));
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    int const    repetitions = argc > 1 ? std::atoi(argv[1]) : 5;
+    std::mt19937 rng(30);
+
+    check<ModeA>("Normal", repetitions, rng);
+    check<ModeB>("Fast  ", repetitions, rng);
+    check<ModeC>("Turbo ", repetitions, rng);
+    check<ModeE>("Slow  ", repetitions, rng);
+    check<ModeI>("Ultra ", repetitions, rng);
+
+    return failures ? 1 : 0;
+}